@@ -183,6 +183,8 @@ int main(int argc, char* argv[]) {
     }
 
     shader.clean();
+    glDeleteTextures(1, &specularMap);
+    glDeleteTextures(1, &diffuseMap);
     glDeleteBuffers(1, &vbo);
     glDeleteVertexArrays(1, &vaoLight);
     glDeleteVertexArrays(1, &vaoCube);
@@ -0,0 +1,53 @@
+#version 430 core
+
+// Average luminance of the frame from the histogram, one invocation per bin, and eye adaptation
+// towards it. Clears the histogram for the next frame on the way, so no separate clear is needed.
+
+layout(local_size_x = 256) in;
+
+layout(std430, binding = 0) buffer Histogram {
+    uint bins[256];
+};
+
+layout(std430, binding = 1) buffer Exposure {
+    float adaptedLuminance;
+    float exposure;
+};
+
+uniform float minLogLuminance;
+uniform float logRange;
+uniform float pixelCount;
+uniform float adaptation;       // Fraction of the way to the metered luminance this frame
+uniform bool autoExposure;
+uniform float compensation;     // EV
+
+shared float weighted[256];
+
+void main() {
+    uint i = gl_LocalInvocationIndex;
+    uint count = bins[i];
+    weighted[i] = float(count) * float(i);
+    bins[i] = 0;
+    memoryBarrierShared();
+    barrier();
+
+    for (uint stride = 128; stride > 0; stride >>= 1) {
+        if (i < stride) {
+            weighted[i] += weighted[i + stride];
+        }
+        memoryBarrierShared();
+        barrier();
+    }
+
+    if (i == 0) {
+        // count is bin 0 here, the pixels too dark to meter.
+        float metered = pixelCount - float(count);
+        if (metered > 0.0f) {
+            float meanBin = weighted[0] / metered;
+            float luminance = exp2((meanBin - 1.0f) / 254.0f * logRange + minLogLuminance);
+            adaptedLuminance += (luminance - adaptedLuminance) * adaptation;
+        }
+        // Maps the average to middle grey.
+        exposure = autoExposure ? 0.18f / max(adaptedLuminance, 1e-4f) * exp2(compensation) : exp2(compensation);
+    }
+}
@@ -0,0 +1,99 @@
+#version 430 core
+
+// Shading rate of each tile, one invocation per tile. A tile is shaded once where the light of the
+// tiles around it varies little, every 2 pixels where it varies more, and at every pixel across a
+// depth or normal edge, where one sample cannot stand for the others. Motion raises the contrast
+// allowed, moving detail is smeared by TAA and by the eye anyway. The samples a rate adds to the
+// tile's first pixel are appended to the sample list.
+
+layout (local_size_x = 8, local_size_y = 8) in;
+
+#include "include/frame.glsl"
+#include "include/coarse.glsl"
+
+layout (binding = 2, r8ui) uniform writeonly uimage2D rates;
+layout (binding = 3, r16f) uniform readonly image2D tileLuminance;
+
+uniform mat4 inverseViewProjection; // of the projection the scene was drawn with
+uniform float contrastThreshold;    // spread of the luminance over its mean still shaded every 2 pixels
+uniform float motionScale;          // pixels of motion per frame that double the contrast allowed
+
+const float DEPTH_EDGE = 0.1f;      // relative view depth difference
+const float NORMAL_EDGE = 0.9f;     // cosine
+
+void main() {
+    ivec2 size = textureSize(sceneDepth, 0);
+    ivec2 tile = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 tileCount = (size + COARSE_TILE - 1) / COARSE_TILE;
+    if (any(greaterThanEqual(tile, tileCount))) {
+        return;
+    }
+    ivec2 origin = tile * COARSE_TILE;
+
+    // Edges inside the tile, background counts as infinitely far
+    float nearest = 1e30f;
+    float farthest = 0.0f;
+    vec3 firstNormal = vec3(0.0f);
+    float minCosine = 1.0f;
+    for (int y = 0; y < COARSE_TILE; y++) {
+        for (int x = 0; x < COARSE_TILE; x++) {
+            ivec2 pixel = min(origin + ivec2(x, y), size - 1);
+            float depth = texelFetch(sceneDepth, pixel, 0).r;
+            float distance = 1e30f;
+            if (depth < 1.0f) {
+                distance = -view_position(pixel, depth).z;
+                vec3 normal = texelFetch(surfaceNormals, pixel, 0).xyz;
+                firstNormal = firstNormal == vec3(0.0f) ? normal : firstNormal;
+                minCosine = min(minCosine, dot(normal, firstNormal));
+            }
+            nearest = min(nearest, distance);
+            farthest = max(farthest, distance);
+        }
+    }
+    bool edge = farthest > nearest * (1.0f + DEPTH_EDGE) || minCosine < NORMAL_EDGE;
+
+    // Contrast of the light of the 3 x 3 tiles around
+    float sum = 0.0f;
+    float sumSquares = 0.0f;
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            float luminance = imageLoad(tileLuminance, clamp(tile + ivec2(x, y), ivec2(0), tileCount - 1)).r;
+            sum += luminance;
+            sumSquares += luminance * luminance;
+        }
+    }
+    float mean = sum / 9.0f;
+    float contrast = sqrt(max(sumSquares / 9.0f - mean * mean, 0.0f)) / (mean + 1e-3f);
+
+    // Screen motion of the tile center since the last frame, from its depth
+    ivec2 center = min(origin + COARSE_TILE / 2, size - 1);
+    float centerDepth = texelFetch(sceneDepth, center, 0).r;
+    float motion = 0.0f;
+    if (centerDepth < 1.0f) {
+        vec4 ndc = vec4((vec2(center) + 0.5f) / vec2(size) * 2.0f - 1.0f, centerDepth * 2.0f - 1.0f, 1.0f);
+        vec4 world = inverseViewProjection * ndc;
+        vec4 current = currentViewProjection * world;
+        vec4 previous = previousViewProjection * world;
+        motion = length((current.xy / current.w - previous.xy / previous.w) * 0.5f * vec2(size));
+    }
+
+    float allowed = contrastThreshold * (1.0f + motion / motionScale);
+    int rate = edge ? 1 : contrast < allowed * 0.5f ? 4 : contrast < allowed ? 2 : 1;
+    imageStore(rates, tile, uvec4(rate));
+
+    int perSide = COARSE_TILE / rate;
+    uint added = uint(perSide * perSide - 1);
+    if (added == 0u) {
+        return;
+    }
+    uint first = atomicAdd(sampleCount, added);
+    atomicMax(groups[0], (first + added + 63u) / 64u);
+    for (int y = 0; y < perSide; y++) {
+        for (int x = 0; x < perSide; x++) {
+            if (x + y > 0) {
+                ivec2 pixel = origin + ivec2(x, y) * rate;
+                samples[first++] = uint(pixel.x) | uint(pixel.y) << 16;
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#version 430 core
+
+// Full resolution lighting of the scene from the coarse samples, one invocation per pixel. A pixel
+// blends the light of the 4 samples around it at its tile's spacing, leaving out samples that were
+// not shaded or lie on another surface (falling back to the sample its own lattice cell starts
+// at), and multiplies it with its own diffuse and specular colors, so textures keep their detail
+// where the light is coarse. The surface's color target receives the lit color.
+
+layout (local_size_x = 8, local_size_y = 8) in;
+
+#include "include/frame.glsl"
+#include "include/coarse.glsl"
+
+layout (binding = 0, rgba16f) uniform readonly image2D diffuseLight;
+layout (binding = 1, rgba16f) uniform readonly image2D specularLight;
+layout (binding = 2, r8ui) uniform readonly uimage2D rates;
+layout (binding = 4, rgba16f) uniform image2D sceneColor;
+layout (binding = 5, r11f_g11f_b10f) uniform writeonly image2D sceneAmbient;
+
+uniform bool writeAmbient;          // for SSAO
+uniform bool sunLight;
+
+void main() {
+    ivec2 size = textureSize(sceneDepth, 0);
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    if (any(greaterThanEqual(pixel, size))) {
+        return;
+    }
+
+    // The clear color stays where nothing was drawn, unlit surfaces keep theirs.
+    float depth = texelFetch(sceneDepth, pixel, 0).r;
+    vec4 surface = imageLoad(sceneColor, pixel);
+    if (depth >= 1.0f || surface.a <= 0.0f) {
+        if (depth < 1.0f) {
+            imageStore(sceneColor, pixel, vec4(surface.rgb, 1.0f));
+        }
+        if (writeAmbient) {
+            imageStore(sceneAmbient, pixel, vec4(0.0f));
+        }
+        return;
+    }
+
+    vec3 position = view_position(pixel, depth);
+    int rate = int(imageLoad(rates, pixel / COARSE_TILE).r);
+    ivec2 base = pixel - pixel % rate;
+    vec3 diffuse = imageLoad(diffuseLight, base).rgb;
+    vec3 specular = imageLoad(specularLight, base).rgb;
+    if (base != pixel) {
+        vec3 norm = texelFetch(surfaceNormals, pixel, 0).xyz;
+        vec2 f = vec2(pixel - base) / float(rate);
+        vec3 diffuseSum = vec3(0.0f);
+        vec3 specularSum = vec3(0.0f);
+        float total = 0.0f;
+        for (int i = 0; i < 4; i++) {
+            ivec2 offset = ivec2(i & 1, i >> 1);
+            ivec2 p = base + offset * rate;
+            float weight = mix(1.0f - f.x, f.x, float(offset.x)) * mix(1.0f - f.y, f.y, float(offset.y));
+            if (weight <= 0.0f || any(greaterThanEqual(p, size))) {
+                continue;
+            }
+            int spacing = int(imageLoad(rates, p / COARSE_TILE).r);
+            vec4 sampleDiffuse = imageLoad(diffuseLight, p);
+            if (any(notEqual(p % spacing, ivec2(0))) || sampleDiffuse.a <= 0.0f) {
+                continue;
+            }
+            float sampleZ = view_depth(texelFetch(sceneDepth, p, 0).r);
+            if (abs(sampleZ - position.z) > -position.z * 0.1f || dot(texelFetch(surfaceNormals, p, 0).xyz, norm) < 0.9f) {
+                continue;
+            }
+            diffuseSum += weight * sampleDiffuse.rgb;
+            specularSum += weight * imageLoad(specularLight, p).rgb;
+            total += weight;
+        }
+        if (total > 0.0f) {
+            diffuse = diffuseSum / total;
+            specular = specularSum / total;
+        }
+    }
+
+    vec3 specularColor = texelFetch(surfaceSpecular, pixel, 0).rgb;
+    imageStore(sceneColor, pixel, vec4(diffuse * surface.rgb + specular * specularColor, 1.0f));
+
+    if (writeAmbient) {
+        float distance = length(vec3(view * vec4(lightPos, 1.0f)) - position);
+        vec3 ambient = light.ambient / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+        if (sunLight) {
+            ambient += sun.ambient;
+        }
+        imageStore(sceneAmbient, pixel, vec4(ambient * surface.rgb, 0.0f));
+    }
+}
@@ -0,0 +1,65 @@
+#version 430 core
+
+// Lighting of the coarse shading samples, as fragmentShader.glsl lights a pixel. With 'tiles' one
+// invocation per tile shades its first pixel and stores the luminance the classification compares
+// between tiles; otherwise each invocation shades a sample of the list the classification filled.
+// The light is stored at the sample's pixel, its alpha is 0 where there was nothing to light.
+// Permutation keys: SUN_LIGHT and POINT_SHADOWS (include/lighting.glsl).
+
+layout (local_size_x = 64) in;
+
+#include "include/lighting.glsl"
+#include "include/coarse.glsl"
+
+layout (binding = 0, rgba16f) uniform writeonly image2D diffuseLight;
+layout (binding = 1, rgba16f) uniform writeonly image2D specularLight;
+layout (binding = 3, r16f) uniform writeonly image2D tileLuminance;
+
+uniform bool tiles;
+uniform mat4 inverseView;
+
+const vec3 LUMA = vec3(0.2126f, 0.7152f, 0.0722f);
+
+void main() {
+    ivec2 size = textureSize(sceneDepth, 0);
+    ivec2 pixel;
+    if (tiles) {
+        ivec2 tileCount = (size + COARSE_TILE - 1) / COARSE_TILE;
+        int index = int(gl_GlobalInvocationID.x);
+        if (index >= tileCount.x * tileCount.y) {
+            return;
+        }
+        pixel = ivec2(index % tileCount.x, index / tileCount.x) * COARSE_TILE;
+    }
+    else {
+        if (gl_GlobalInvocationID.x >= sampleCount) {
+            return;
+        }
+        uint packedPixel = samples[gl_GlobalInvocationID.x];
+        pixel = ivec2(packedPixel & 0xffffu, packedPixel >> 16);
+        if (any(greaterThanEqual(pixel, size))) {
+            return;
+        }
+    }
+
+    float depth = texelFetch(sceneDepth, pixel, 0).r;
+    vec4 surface = texelFetch(surfaceColor, pixel, 0);
+    vec4 diffuse = vec4(0.0f);
+    vec4 specular = vec4(0.0f);
+    float luminance = depth < 1.0f ? dot(surface.rgb, LUMA) : 0.0f;
+    if (depth < 1.0f && surface.a > 0.0f) {
+        vec3 position = view_position(pixel, depth);
+        vec3 norm = normalize(texelFetch(surfaceNormals, pixel, 0).xyz);
+        vec3 worldPos = vec3(inverseView * vec4(position, 1.0f));
+        vec3 worldNorm = mat3(inverseView) * norm;
+        SurfaceLight lit = shade_surface(position, norm, worldPos, worldNorm, surface.a);
+        diffuse = vec4(lit.diffuse, 1.0f);
+        specular = vec4(lit.specular, 1.0f);
+        luminance = dot(lit.diffuse * surface.rgb + lit.specular * texelFetch(surfaceSpecular, pixel, 0).rgb, LUMA);
+    }
+    imageStore(diffuseLight, pixel, diffuse);
+    imageStore(specularLight, pixel, specular);
+    if (tiles) {
+        imageStore(tileLuminance, pixel / COARSE_TILE, vec4(luminance));
+    }
+}
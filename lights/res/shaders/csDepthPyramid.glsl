@@ -0,0 +1,41 @@
+#version 430 core
+
+// One level of the depth pyramid: every texel keeps the farthest depth of the 2 x 2 texels below
+// it, plus the extra row and column when the level below has an odd size.
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+uniform sampler2D source;
+uniform int sourceLevel;
+
+layout(r32f, binding = 0) uniform writeonly image2D destination;
+
+float fetch(ivec2 p) {
+    return texelFetch(source, min(p, textureSize(source, sourceLevel) - 1), sourceLevel).r;
+}
+
+void main() {
+    ivec2 sourceSize = textureSize(source, sourceLevel);
+    ivec2 p = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = imageSize(destination);
+    if (any(greaterThanEqual(p, size))) {
+        return;
+    }
+
+    ivec2 s = p * 2;
+    float depth = max(max(fetch(s), fetch(s + ivec2(1, 0))), max(fetch(s + ivec2(0, 1)), fetch(s + ivec2(1, 1))));
+
+    bool oddX = (sourceSize.x & 1) != 0 && p.x == size.x - 1;
+    bool oddY = (sourceSize.y & 1) != 0 && p.y == size.y - 1;
+    if (oddX) {
+        depth = max(depth, max(fetch(s + ivec2(2, 0)), fetch(s + ivec2(2, 1))));
+    }
+    if (oddY) {
+        depth = max(depth, max(fetch(s + ivec2(0, 2)), fetch(s + ivec2(1, 2))));
+    }
+    if (oddX && oddY) {
+        depth = max(depth, fetch(s + ivec2(2, 2)));
+    }
+
+    imageStore(destination, p, vec4(depth));
+}
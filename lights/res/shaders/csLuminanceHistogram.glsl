@@ -0,0 +1,41 @@
+#version 430 core
+
+// Histogram of the HDR scene's luminance in log2 steps. Each work group counts its 16 x 16 tile
+// in shared memory and only then adds to the global bins, so global atomics stay few. Bin 0 holds
+// pixels too dark to meter.
+
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(binding = 0, rgba16f) readonly uniform image2D scene;
+
+layout(std430, binding = 0) buffer Histogram {
+    uint bins[256];
+};
+
+uniform float minLogLuminance;
+uniform float inverseLogRange;
+
+shared uint localBins[256];
+
+void main() {
+    localBins[gl_LocalInvocationIndex] = 0;
+    memoryBarrierShared();
+    barrier();
+
+    ivec2 p = ivec2(gl_GlobalInvocationID.xy);
+    if (all(lessThan(p, imageSize(scene)))) {
+        float luminance = dot(imageLoad(scene, p).rgb, vec3(0.2126f, 0.7152f, 0.0722f));
+        uint bin = 0;
+        if (luminance > 1e-5f) {
+            bin = uint(clamp((log2(luminance) - minLogLuminance) * inverseLogRange, 0.0f, 1.0f) * 254.0f + 1.0f);
+        }
+        atomicAdd(localBins[bin], 1);
+    }
+    memoryBarrierShared();
+    barrier();
+
+    uint count = localBins[gl_LocalInvocationIndex];
+    if (count > 0) {
+        atomicAdd(bins[gl_LocalInvocationIndex], count);
+    }
+}
@@ -0,0 +1,125 @@
+#version 430 core
+
+// Per meshlet culling. Writes one indirect draw command per meshlet, with an instance count of 0
+// when the meshlet is outside the frustum, faces away from the camera or is hidden behind the
+// depth of the previous frame.
+
+layout(local_size_x = 64) in;
+
+struct Meshlet {
+    vec4 sphere;        // Model space centre, radius
+    vec4 cone;          // Axis, cutoff
+    uvec4 range;        // First index, index count, vertex count
+};
+
+struct DrawCommand {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+layout(std430, binding = 0) readonly buffer Meshlets {
+    Meshlet meshlets[];
+};
+
+layout(std430, binding = 1) writeonly buffer Commands {
+    DrawCommand commands[];
+};
+
+layout(std430, binding = 2) buffer Stats {
+    uint visibleMeshlets;
+    uint visibleTriangles;
+};
+
+uniform int firstMeshlet;
+uniform int meshletCount;
+uniform int indexBase;          // Start of the index stream, in indices from the buffer start
+
+uniform mat4 model;
+uniform float modelScale;       // Largest axis scale of model
+uniform vec3 cameraPosition;
+uniform vec4 frustum[6];        // World space planes, normals point inwards
+
+uniform bool cullFrustum;
+uniform bool cullCone;
+uniform bool cullOcclusion;
+uniform bool countStats;        // Off for a second level culled in the same frame
+
+uniform sampler2D depthPyramid; // Farthest depth of each texel's footprint, half resolution
+uniform vec2 pyramidSize;
+uniform mat4 depthViewProjection;   // Matrices the pyramid was rendered with
+
+
+bool outsideFrustum(vec3 center, float radius) {
+    for (int i = 0; i < 6; i++) {
+        if (dot(frustum[i].xyz, center) + frustum[i].w < -radius) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Every triangle faces away when the view direction is within the cone's cutoff of its axis.
+bool backfacing(vec3 center, float radius, vec3 axis, float cutoff) {
+    vec3 view = center - cameraPosition;
+    return dot(view, axis) >= cutoff * length(view) + radius;
+}
+
+// The sphere's box is projected with last frame's matrices, the pyramid level where it covers at
+// most 2 x 2 texels gives the farthest depth behind it. Static geometry is tested exactly, moving
+// geometry may pop in for a frame.
+bool occluded(vec3 center, float radius) {
+    vec2 lo = vec2(1.0);
+    vec2 hi = vec2(0.0);
+    float nearest = 1.0;
+    for (int i = 0; i < 8; i++) {
+        vec3 corner = center + radius * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);
+        vec4 clip = depthViewProjection * vec4(corner, 1.0);
+        if (clip.w <= 0.0) {
+            return false;
+        }
+        vec3 ndc = clip.xyz / clip.w * 0.5 + 0.5;
+        lo = min(lo, ndc.xy);
+        hi = max(hi, ndc.xy);
+        nearest = min(nearest, ndc.z);
+    }
+    lo = clamp(lo, 0.0, 1.0);
+    hi = clamp(hi, 0.0, 1.0);
+
+    vec2 extent = (hi - lo) * pyramidSize;
+    float level = ceil(log2(max(max(extent.x, extent.y), 1.0)));
+    float farthest = max(max(textureLod(depthPyramid, lo, level).r, textureLod(depthPyramid, vec2(hi.x, lo.y), level).r),
+                         max(textureLod(depthPyramid, vec2(lo.x, hi.y), level).r, textureLod(depthPyramid, hi, level).r));
+    return nearest > farthest;
+}
+
+void main() {
+    int index = int(gl_GlobalInvocationID.x);
+    if (index >= meshletCount) {
+        return;
+    }
+    index += firstMeshlet;
+
+    Meshlet meshlet = meshlets[index];
+    vec3 center = (model * vec4(meshlet.sphere.xyz, 1.0)).xyz;
+    float radius = meshlet.sphere.w * modelScale;
+    // Uniform scale is assumed, so the model matrix also transforms the cone axis.
+    vec3 axis = normalize(mat3(model) * meshlet.cone.xyz);
+
+    bool visible = !(cullFrustum && outsideFrustum(center, radius)) &&
+                   !(cullCone && backfacing(center, radius, axis, meshlet.cone.w)) &&
+                   !(cullOcclusion && occluded(center, radius));
+
+    commands[index].count = meshlet.range.y;
+    commands[index].instanceCount = visible ? 1 : 0;
+    commands[index].firstIndex = uint(indexBase) + meshlet.range.x;
+    commands[index].baseVertex = 0;
+    commands[index].baseInstance = 0;
+
+    if (visible && countStats) {
+        atomicAdd(visibleMeshlets, 1);
+        atomicAdd(visibleTriangles, meshlet.range.y / 3);
+    }
+}
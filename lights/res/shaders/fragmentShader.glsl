@@ -1,60 +1,68 @@
 #version 420 core
 
-out vec4 fragColor;
+// Point and directional light shading of the cubes and models, with materials from a texture array.
+// Permutation keys: SUN_LIGHT and POINT_SHADOWS (include/lighting.glsl), MOTION_VECTORS
+// (include/velocity.glsl), COARSE_SHADING (include/surface.glsl) and LOD_FADE.
 
 struct Material {
-    sampler2D diffuse;
-    sampler2D specular;
+    int diffuseLayer;
+    int specularLayer;
     float shininess;
 };
 
-struct Light {
-    vec3 position;
-    // vec3 direction;
+#include "include/lighting.glsl"
+#include "include/surface.glsl"
+#include "include/velocity.glsl"
 
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
+in vec3 fragPos;
+in vec3 normal;
+in vec2 texCoords;
+in vec3 worldPos;
+in vec3 worldNormal;
+flat in uint materialIndex;
 
-    float constant;
-    float linear;
-    float quadratic;
+// Material table, indexed by the per instance material index.
+layout (std140, binding = 0) uniform Materials {
+    Material materials[64];
 };
 
+layout (binding = 0) uniform sampler2DArray materialTextures;
 
-in vec3 fragPos;
-in vec3 normal;
-in vec3 LightPos;
-in vec2 texCoords;
+#ifdef LOD_FADE
+// Dithered cross-fade between two levels of detail. The incoming level keeps the pixels whose
+// threshold is below lodFade, the outgoing one (lodFadeOut) keeps the others. Only the variant
+// drawing a fading model has the discard, which would turn off early depth testing elsewhere.
+uniform float lodFade = 1.0f;
+uniform bool lodFadeOut = false;
 
-uniform Material material;
-uniform Light light;
+const float bayer[16] = float[16](0.0f, 8.0f, 2.0f, 10.0f, 12.0f, 4.0f, 14.0f, 6.0f,
+                                  3.0f, 11.0f, 1.0f, 9.0f, 15.0f, 7.0f, 13.0f, 5.0f);
+#endif
 
 void main() {
-    // ambient
-    vec3 ambient = light.ambient * vec3(texture(material.diffuse, texCoords));
+#ifdef LOD_FADE
+    ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+    bool visible = (bayer[p.y * 4 + p.x] + 0.5f) / 16.0f < lodFade;
+    if (visible == lodFadeOut) {
+        discard;
+    }
+#endif
+
+    Material material = materials[materialIndex];
+    vec3 diffuseColor = vec3(texture(materialTextures, vec3(texCoords, material.diffuseLayer)));
+    if (decodeSrgb) {
+        diffuseColor = decode_srgb(diffuseColor);
+    }
+    vec3 specularColor = vec3(texture(materialTextures, vec3(texCoords, material.specularLayer)));
 
-    // diffuse
     vec3 norm = normalize(normal);
-    vec3 lightDir = normalize(LightPos - fragPos);
-    // vec3 lightDir = normalize(-light.direction);
-    float diff = max(dot(norm, lightDir), 0.0f);
-    vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, texCoords));
-
-    // specular
-    vec3 viewDir = normalize(-fragPos);
-    vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0f), material.shininess);
-    vec3 specular = light.specular * spec * vec3(texture(material.specular, texCoords));
-
-    float distance = length(LightPos - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance +
-                        light.quadratic * (distance * distance));
-
-    ambient *= attenuation;
-    diffuse *= attenuation;
-    specular *= attenuation;
-
-    vec3 result = ambient + diffuse + specular;
-    fragColor = vec4(result, 1.0f);
+
+#ifdef COARSE_SHADING
+    writeSurface(diffuseColor, specularColor, material.shininess, norm);
+#else
+    SurfaceLight lit = shade_surface(fragPos, norm, worldPos, normalize(worldNormal), material.shininess);
+    fragColor = vec4(lit.diffuse * diffuseColor + lit.specular * specularColor, 1.0f);
+    ambientColor = vec4(lit.ambient * diffuseColor, 0.0f);
+#endif
+    writeVelocity();
 }
@@ -0,0 +1,32 @@
+#version 420 core
+
+// Separable depth aware blur of the half resolution occlusion. Wide enough to cover the 4x4 tile
+// of sampling patterns, and it does not blur across depth discontinuities.
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D occlusion;
+layout (binding = 1) uniform sampler2D viewDepth;
+
+uniform vec2 direction;     // (1, 0) or (0, 1)
+uniform float sharpness;    // falloff with the relative depth difference
+
+const int KERNEL_RADIUS = 3;
+const float WEIGHTS[4] = float[4](0.266f, 0.213f, 0.11f, 0.036f);
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 last = textureSize(occlusion, 0) - 1;
+    float depth = texelFetch(viewDepth, pixel, 0).r;
+
+    float sum = 0.0f;
+    float total = 0.0f;
+    for (int i = -KERNEL_RADIUS; i <= KERNEL_RADIUS; i++) {
+        ivec2 tap = clamp(pixel + ivec2(direction) * i, ivec2(0), last);
+        float difference = (texelFetch(viewDepth, tap, 0).r - depth) / depth;
+        float w = WEIGHTS[abs(i)] * exp(-difference * difference * sharpness);
+        sum += texelFetch(occlusion, tap, 0).r * w;
+        total += w;
+    }
+    fragColor = vec4(sum / total);
+}
@@ -0,0 +1,21 @@
+#version 420 core
+
+// Half resolution linear view depth for SSAO. Takes one texel of each 2x2 quad, the farthest, so
+// silhouettes do not pull the background forward.
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D depth;
+
+uniform vec2 depthParams;   // projection[2][2], projection[3][2]
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy) * 2;
+    ivec2 last = textureSize(depth, 0) - 1;
+    vec4 z = vec4(texelFetch(depth, min(pixel, last), 0).r,
+                  texelFetch(depth, min(pixel + ivec2(1, 0), last), 0).r,
+                  texelFetch(depth, min(pixel + ivec2(0, 1), last), 0).r,
+                  texelFetch(depth, min(pixel + ivec2(1, 1), last), 0).r);
+    float farthest = max(max(z.x, z.y), max(z.z, z.w));
+    fragColor = vec4(depthParams.y / (farthest * 2.0f - 1.0f + depthParams.x));
+}
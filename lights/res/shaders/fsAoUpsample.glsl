@@ -0,0 +1,50 @@
+#version 420 core
+
+// Bilateral upsample of the half resolution occlusion to the scene. Of the 4 nearest half
+// resolution texels, those at a different depth than the pixel are weighed down. Writes the
+// ambient light to take away, subtracted from the scene by the blend equation.
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D occlusion;
+layout (binding = 1) uniform sampler2D viewDepth;   // half resolution, linear
+layout (binding = 2) uniform sampler2D depth;       // full resolution depth buffer
+layout (binding = 3) uniform sampler2D ambient;
+
+uniform vec2 depthParams;   // projection[2][2], projection[3][2]
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float z = texelFetch(depth, pixel, 0).r;
+    if (z >= 1.0f) {
+        discard;
+    }
+    float d = depthParams.y / (z * 2.0f - 1.0f + depthParams.x);
+
+    vec2 position = (vec2(pixel) + 0.5f) * 0.5f - 0.5f;
+    ivec2 base = ivec2(floor(position));
+    vec2 f = position - vec2(base);
+    ivec2 last = textureSize(occlusion, 0) - 1;
+
+    float sum = 0.0f;
+    float total = 0.0f;
+    float nearest = 1.0f;
+    float nearestDifference = 1e30f;
+    for (int i = 0; i < 4; i++) {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 tap = clamp(base + offset, ivec2(0), last);
+        float bilinear = (offset.x == 1 ? f.x : 1.0f - f.x) * (offset.y == 1 ? f.y : 1.0f - f.y);
+        float difference = abs(texelFetch(viewDepth, tap, 0).r - d) / d;
+        float ao = texelFetch(occlusion, tap, 0).r;
+        float w = bilinear / (difference * 100.0f + 1e-3f);
+        sum += ao * w;
+        total += w;
+        if (difference < nearestDifference) {
+            nearestDifference = difference;
+            nearest = ao;
+        }
+    }
+    // No texel on this surface, take the closest in depth.
+    float ao = nearestDifference > 0.1f ? nearest : sum / total;
+    fragColor = vec4(texelFetch(ambient, pixel, 0).rgb * (1.0f - ao), 0.0f);
+}
@@ -0,0 +1,51 @@
+#version 420 core
+
+// 13 tap downsample of the bloom chain, as 4 overlapping 2x2 boxes and a centre one. The first
+// level weighs each box by its luminance (Karis average), so single bright pixels do not flicker.
+
+in vec2 uv;
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D source;
+
+uniform vec2 texelSize;     // of the source
+uniform bool karisAverage;
+
+float box_weight(vec3 c) {
+    return 1.0f / (1.0f + dot(c, vec3(0.2126f, 0.7152f, 0.0722f)));
+}
+
+void main() {
+    vec3 a = texture(source, uv + texelSize * vec2(-2.0f, 2.0f)).rgb;
+    vec3 b = texture(source, uv + texelSize * vec2(0.0f, 2.0f)).rgb;
+    vec3 c = texture(source, uv + texelSize * vec2(2.0f, 2.0f)).rgb;
+    vec3 d = texture(source, uv + texelSize * vec2(-2.0f, 0.0f)).rgb;
+    vec3 e = texture(source, uv).rgb;
+    vec3 f = texture(source, uv + texelSize * vec2(2.0f, 0.0f)).rgb;
+    vec3 g = texture(source, uv + texelSize * vec2(-2.0f, -2.0f)).rgb;
+    vec3 h = texture(source, uv + texelSize * vec2(0.0f, -2.0f)).rgb;
+    vec3 i = texture(source, uv + texelSize * vec2(2.0f, -2.0f)).rgb;
+    vec3 j = texture(source, uv + texelSize * vec2(-1.0f, 1.0f)).rgb;
+    vec3 k = texture(source, uv + texelSize * vec2(1.0f, 1.0f)).rgb;
+    vec3 l = texture(source, uv + texelSize * vec2(-1.0f, -1.0f)).rgb;
+    vec3 m = texture(source, uv + texelSize * vec2(1.0f, -1.0f)).rgb;
+
+    vec3 boxes[5] = vec3[5](
+        (j + k + l + m) * 0.25f,
+        (a + b + d + e) * 0.25f,
+        (b + c + e + f) * 0.25f,
+        (d + e + g + h) * 0.25f,
+        (e + f + h + i) * 0.25f
+    );
+    float weights[5] = float[5](0.5f, 0.125f, 0.125f, 0.125f, 0.125f);
+
+    vec3 color = vec3(0.0f);
+    float total = 0.0f;
+    for (int n = 0; n < 5; n++) {
+        float w = weights[n] * (karisAverage ? box_weight(boxes[n]) : 1.0f);
+        color += boxes[n] * w;
+        total += w;
+    }
+    fragColor = vec4(max(color / total, 0.0f), 1.0f);
+}
@@ -0,0 +1,22 @@
+#version 420 core
+
+// 3x3 tent upsample of the next smaller bloom level, blended additively into this one.
+
+in vec2 uv;
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D source;
+
+uniform vec2 texelSize;     // of the source
+uniform float radius;       // in source texels
+
+void main() {
+    vec2 r = texelSize * radius;
+    vec3 color = texture(source, uv).rgb * 4.0f;
+    color += (texture(source, uv + vec2(-r.x, 0.0f)).rgb + texture(source, uv + vec2(r.x, 0.0f)).rgb +
+              texture(source, uv + vec2(0.0f, -r.y)).rgb + texture(source, uv + vec2(0.0f, r.y)).rgb) * 2.0f;
+    color += texture(source, uv - r).rgb + texture(source, uv + r).rgb +
+             texture(source, uv + vec2(-r.x, r.y)).rgb + texture(source, uv + vec2(r.x, -r.y)).rgb;
+    fragColor = vec4(color / 16.0f, 1.0f);
+}
@@ -0,0 +1,40 @@
+#version 420 core
+
+// Floor decals, lit diffusely with the color sampled from a texture atlas page. The texture
+// coordinates are already remapped into the page by TextureAtlas::remapUVs. Permutation keys:
+// SUN_LIGHT and POINT_SHADOWS (include/lighting.glsl), MOTION_VECTORS and COARSE_SHADING
+// (include/surface.glsl).
+
+#include "include/lighting.glsl"
+#include "include/surface.glsl"
+#include "include/velocity.glsl"
+
+in vec3 fragPos;
+in vec3 normal;
+in vec2 texCoords;
+in vec3 worldPos;
+in vec3 worldNormal;
+
+layout (binding = 1) uniform sampler2D atlasPage;
+
+void main() {
+    vec4 texel = texture(atlasPage, texCoords);
+    if (texel.a < 0.5f) {
+        discard;
+    }
+    vec3 diffuseColor = texel.rgb;
+    if (decodeSrgb) {
+        diffuseColor = decode_srgb(diffuseColor);
+    }
+
+    vec3 norm = normalize(normal);
+
+#ifdef COARSE_SHADING
+    writeSurface(diffuseColor, vec3(0.0f), 1.0f, norm);
+#else
+    SurfaceLight lit = shade_surface(fragPos, norm, worldPos, normalize(worldNormal), 1.0f);
+    fragColor = vec4(lit.diffuse * diffuseColor, 1.0f);
+    ambientColor = vec4(lit.ambient * diffuseColor, 0.0f);
+#endif
+    writeVelocity();
+}
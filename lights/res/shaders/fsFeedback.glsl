@@ -0,0 +1,36 @@
+#version 420 core
+
+// Virtual texture feedback pass. Writes the tile and mip level each pixel needs, the
+// application reads it back to decide which tiles to stream in. The tile is packed as tile_key
+// does (VirtualTexture.cpp): the level in the top 4 bits, then 14 bits each of y and x, so page
+// tables up to 16384 tiles wide do not alias. Pixels without the virtual texture keep the clear
+// value, whose level is past any tile file.
+
+out uint feedback;
+
+struct VirtualTexture {
+    usampler2D pageTable;
+    sampler2D cache;
+    vec2 size;
+    float tileSize;
+    float border;
+    float cacheSize;
+    float maxLevel;
+    float mipBias;
+};
+
+in vec2 texCoords;
+
+uniform VirtualTexture vt;
+
+void main() {
+    vec2 dx = dFdx(texCoords * vt.size);
+    vec2 dy = dFdy(texCoords * vt.size);
+    int level = int(clamp(0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8)) + vt.mipBias, 0.0, vt.maxLevel));
+
+    // Wrap with the tile counts of the level itself, the size of the page table at that level.
+    ivec2 tiles = textureSize(vt.pageTable, level);
+    uvec2 tile = uvec2(min(ivec2(fract(texCoords) * vec2(tiles)), tiles - 1));
+
+    feedback = (uint(level) << 28) | (tile.y << 14) | tile.x;
+}
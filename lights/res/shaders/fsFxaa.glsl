@@ -0,0 +1,50 @@
+#version 420 core
+
+// FXAA, console variant: the edge direction from 4 diagonal taps, then a blend of 2 or 4 taps
+// along the edge. Works on the tone mapped, sRGB encoded image.
+
+in vec2 uv;
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D source;
+
+uniform vec2 texelSize;
+uniform float edgeThreshold;        // contrast needed, relative to the brightest tap
+uniform float edgeThresholdMin;     // contrast needed in dark areas
+uniform float spanMax;              // longest blend, in texels
+
+const float REDUCE_MUL = 1.0f / 8.0f;
+const float REDUCE_MIN = 1.0f / 128.0f;
+
+float luma(vec3 c) {
+    return dot(c, vec3(0.299f, 0.587f, 0.114f));
+}
+
+void main() {
+    vec3 colorM = texture(source, uv).rgb;
+    float lumaM = luma(colorM);
+    float lumaNW = luma(texture(source, uv + vec2(-0.5f, 0.5f) * texelSize).rgb);
+    float lumaNE = luma(texture(source, uv + vec2(0.5f, 0.5f) * texelSize).rgb);
+    float lumaSW = luma(texture(source, uv + vec2(-0.5f, -0.5f) * texelSize).rgb);
+    float lumaSE = luma(texture(source, uv + vec2(0.5f, -0.5f) * texelSize).rgb);
+
+    float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+    float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+    if (lumaMax - lumaMin < max(edgeThresholdMin, lumaMax * edgeThreshold)) {
+        fragColor = vec4(colorM, 1.0f);
+        return;
+    }
+
+    vec2 dir = vec2(-((lumaNW + lumaNE) - (lumaSW + lumaSE)), (lumaNW + lumaSW) - (lumaNE + lumaSE));
+    float dirReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.25f * REDUCE_MUL, REDUCE_MIN);
+    float rcpDirMin = 1.0f / (min(abs(dir.x), abs(dir.y)) + dirReduce);
+    dir = clamp(dir * rcpDirMin, -spanMax, spanMax) * texelSize;
+
+    vec3 colorA = 0.5f * (texture(source, uv + dir * (1.0f / 3.0f - 0.5f)).rgb +
+                          texture(source, uv + dir * (2.0f / 3.0f - 0.5f)).rgb);
+    vec3 colorB = colorA * 0.5f + 0.25f * (texture(source, uv - dir * 0.5f).rgb +
+                                           texture(source, uv + dir * 0.5f).rgb);
+    float lumaB = luma(colorB);
+    fragColor = vec4(lumaB < lumaMin || lumaB > lumaMax ? colorA : colorB, 1.0f);
+}
@@ -0,0 +1,71 @@
+#version 420 core
+
+// Horizon based ambient occlusion at half resolution. Each pixel marches 4 directions of 4 steps,
+// rotated and jittered by its position in a 4x4 tile, so neighbours sample different directions
+// and the blur that follows averages them to 64 samples worth of occlusion.
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D viewDepth;   // linear, half resolution
+
+uniform vec2 projScale;     // 1 / projection[0][0], 1 / projection[1][1]
+uniform float radiusScale;  // pixels covered by one unit at depth 1
+uniform float radius;       // world units
+uniform float bias;         // cosine of the ignored horizon angle
+uniform float intensity;    // exponent of the result
+
+const int DIRECTIONS = 4;
+const int STEPS = 4;
+const float MAX_RADIUS_PIXELS = 48.0f;
+const float PI = 3.14159265f;
+
+const float BAYER[16] = float[16](0.0f, 8.0f, 2.0f, 10.0f, 12.0f, 4.0f, 14.0f, 6.0f,
+                                  3.0f, 11.0f, 1.0f, 9.0f, 15.0f, 7.0f, 13.0f, 5.0f);
+
+vec3 view_position(vec2 pixel) {
+    vec2 uv = pixel / vec2(textureSize(viewDepth, 0));
+    float d = textureLod(viewDepth, uv, 0.0f).r;
+    return vec3((uv * 2.0f - 1.0f) * projScale * d, -d);
+}
+
+void main() {
+    vec2 pixel = gl_FragCoord.xy;
+    vec3 p = view_position(pixel);
+    float radiusPixels = min(radiusScale * radius / -p.z, MAX_RADIUS_PIXELS);
+    if (radiusPixels < 1.0f) {
+        fragColor = vec4(1.0f);
+        return;
+    }
+
+    // Normal from the neighbours on the same surface, the closer one on each axis.
+    vec3 right = view_position(pixel + vec2(1.0f, 0.0f)) - p;
+    vec3 left = p - view_position(pixel - vec2(1.0f, 0.0f));
+    vec3 up = view_position(pixel + vec2(0.0f, 1.0f)) - p;
+    vec3 down = p - view_position(pixel - vec2(0.0f, 1.0f));
+    vec3 dx = abs(right.z) < abs(left.z) ? right : left;
+    vec3 dy = abs(up.z) < abs(down.z) ? up : down;
+    vec3 n = normalize(cross(dx, dy));
+
+    ivec2 tile = ivec2(pixel) & 3;
+    float rotation = BAYER[tile.x + tile.y * 4] / 16.0f;
+    float jitter = fract(rotation * 4.0f + 0.5f * float(tile.y & 1));
+    float stepPixels = radiusPixels / float(STEPS + 1);
+    float falloff = 1.0f / (radius * radius);
+
+    float occlusion = 0.0f;
+    for (int d = 0; d < DIRECTIONS; d++) {
+        float angle = (float(d) + rotation) * (2.0f * PI / float(DIRECTIONS));
+        vec2 direction = vec2(cos(angle), sin(angle));
+        float ray = 1.0f + jitter * stepPixels;
+        for (int s = 0; s < STEPS; s++) {
+            vec3 v = view_position(pixel + direction * ray) - p;
+            float vv = dot(v, v);
+            float cosine = dot(n, v) * inversesqrt(max(vv, 1e-6f));
+            occlusion += clamp(cosine - bias, 0.0f, 1.0f) * clamp(1.0f - vv * falloff, 0.0f, 1.0f);
+            ray += stepPixels;
+        }
+    }
+    // Scaled so that a full hemisphere above the bias is fully occluded, as HBAO+ does.
+    occlusion *= 2.0f / (float(DIRECTIONS * STEPS) * (1.0f - bias));
+    fragColor = vec4(pow(clamp(1.0f - occlusion, 0.0f, 1.0f), intensity));
+}
@@ -1,9 +1,18 @@
 #version 420 core
 
-out vec4 fragColor;
+// Unlit light markers. Permutation keys: MOTION_VECTORS and COARSE_SHADING.
+
+#include "include/surface.glsl"
+#include "include/velocity.glsl"
 
 uniform vec3 color;
 
 void main() {
+#ifdef COARSE_SHADING
+    writeSurface(color, vec3(0.0f), 0.0f, vec3(0.0f, 0.0f, 1.0f));
+#else
     fragColor = vec4(color, 1.0f);
+    ambientColor = vec4(0.0f);
+#endif
+    writeVelocity();
 }
@@ -0,0 +1,35 @@
+#version 420 core
+
+// Resolve of the multisampled scene. Color samples are averaged weighed by inverse luminance, so a
+// very bright sample in HDR does not leave the edge aliased, depth keeps the closest sample.
+
+layout (location = 0) out vec4 fragColor;
+layout (location = 1) out vec4 ambientColor;
+
+layout (binding = 0) uniform sampler2DMS color;
+layout (binding = 1) uniform sampler2DMS ambient;
+layout (binding = 2) uniform sampler2DMS depth;
+
+uniform int samples;
+uniform bool resolveAmbient;
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec3 sum = vec3(0.0f);
+    vec3 ambientSum = vec3(0.0f);
+    float total = 0.0f;
+    float closest = 1.0f;
+    for (int i = 0; i < samples; i++) {
+        vec3 c = texelFetch(color, pixel, i).rgb;
+        float w = 1.0f / (1.0f + dot(c, vec3(0.2126f, 0.7152f, 0.0722f)));
+        sum += c * w;
+        total += w;
+        if (resolveAmbient) {
+            ambientSum += texelFetch(ambient, pixel, i).rgb;
+        }
+        closest = min(closest, texelFetch(depth, pixel, i).r);
+    }
+    fragColor = vec4(sum / total, 1.0f);
+    ambientColor = vec4(ambientSum / float(samples), 0.0f);
+    gl_FragDepth = closest;
+}
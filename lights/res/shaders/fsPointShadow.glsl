@@ -0,0 +1,13 @@
+#version 420 core
+
+// Stores the distance to the light over its range, the same value for every face, so lookups
+// only need the direction.
+
+in vec3 worldPos;
+
+uniform vec3 lightPosition;
+uniform float lightRange;
+
+void main() {
+    gl_FragDepth = length(worldPos - lightPosition) / lightRange;
+}
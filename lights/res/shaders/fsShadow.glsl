@@ -0,0 +1,6 @@
+#version 420 core
+
+// Depth only, the fixed function depth write is all a shadow map needs.
+
+void main() {
+}
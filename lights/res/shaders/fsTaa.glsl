@@ -0,0 +1,82 @@
+#version 420 core
+
+// Temporal anti-aliasing resolve. The history is reprojected with the motion vector of the closest
+// surface around the pixel, clipped to the colors of the current 3x3 neighbourhood so that
+// disoccluded and changed pixels do not ghost, and blended with the current jittered sample.
+
+in vec2 uv;
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D scene;
+layout (binding = 1) uniform sampler2D history;
+layout (binding = 2) uniform sampler2D velocity;
+layout (binding = 3) uniform sampler2D depth;
+
+uniform float feedback;     // share of the history
+uniform bool historyValid;
+
+vec3 to_ycocg(vec3 c) {
+    return vec3(dot(c, vec3(0.25f, 0.5f, 0.25f)), dot(c, vec3(0.5f, 0.0f, -0.5f)), dot(c, vec3(-0.25f, 0.5f, -0.25f)));
+}
+
+vec3 to_rgb(vec3 c) {
+    return vec3(c.x + c.y - c.z, c.x + c.z, c.x - c.y - c.z);
+}
+
+// Moves the history towards the centre of the box until it is inside.
+vec3 clip_aabb(vec3 boxMin, vec3 boxMax, vec3 color) {
+    vec3 center = 0.5f * (boxMax + boxMin);
+    vec3 extent = 0.5f * (boxMax - boxMin) + 1e-5f;
+    vec3 offset = color - center;
+    vec3 units = abs(offset / extent);
+    float largest = max(units.x, max(units.y, units.z));
+    return largest > 1.0f ? center + offset / largest : color;
+}
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 last = textureSize(scene, 0) - 1;
+
+    vec3 current = texelFetch(scene, pixel, 0).rgb;
+    vec3 m1 = vec3(0.0f);
+    vec3 m2 = vec3(0.0f);
+    vec3 boxMin = vec3(1e30f);
+    vec3 boxMax = vec3(-1e30f);
+    float closest = 1.0f;
+    ivec2 closestPixel = pixel;
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            ivec2 tap = clamp(pixel + ivec2(x, y), ivec2(0), last);
+            vec3 c = to_ycocg(texelFetch(scene, tap, 0).rgb);
+            m1 += c;
+            m2 += c * c;
+            boxMin = min(boxMin, c);
+            boxMax = max(boxMax, c);
+            float z = texelFetch(depth, tap, 0).r;
+            if (z < closest) {
+                closest = z;
+                closestPixel = tap;
+            }
+        }
+    }
+
+    vec2 previousUv = uv - texelFetch(velocity, closestPixel, 0).rg;
+    if (!historyValid || any(lessThan(previousUv, vec2(0.0f))) || any(greaterThan(previousUv, vec2(1.0f)))) {
+        fragColor = vec4(current, 1.0f);
+        return;
+    }
+
+    // Variance clipping, the box of mean +- 1.25 standard deviations within the min max box.
+    vec3 mean = m1 / 9.0f;
+    vec3 sigma = sqrt(max(m2 / 9.0f - mean * mean, 0.0f));
+    boxMin = max(boxMin, mean - 1.25f * sigma);
+    boxMax = min(boxMax, mean + 1.25f * sigma);
+    vec3 previous = texture(history, previousUv).rgb;
+    previous = to_rgb(clip_aabb(boxMin, boxMax, to_ycocg(previous)));
+
+    // Weighed by inverse luminance, so a bright sample does not flicker through the average.
+    float currentWeight = (1.0f - feedback) / (1.0f + to_ycocg(current).x);
+    float historyWeight = feedback / (1.0f + to_ycocg(previous).x);
+    fragColor = vec4((current * currentWeight + previous * historyWeight) / (currentWeight + historyWeight), 1.0f);
+}
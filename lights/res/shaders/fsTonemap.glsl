@@ -0,0 +1,41 @@
+#version 430 core
+
+// Bloom, exposure, tone curve and sRGB encoding of the HDR scene in a single pass.
+
+in vec2 uv;
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D scene;
+layout (binding = 1) uniform sampler2D bloom;    // half resolution, filtered up
+
+layout (std430, binding = 1) readonly buffer Exposure {
+    float adaptedLuminance;
+    float exposure;
+};
+
+uniform int toneMap;    // 0 Reinhard, 1 ACES
+uniform float bloomStrength;
+
+// Narkowicz's fit of the ACES reference rendering transform.
+vec3 aces(vec3 x) {
+    return clamp((x * (2.51f * x + 0.03f)) / (x * (2.43f * x + 0.59f) + 0.14f), 0.0f, 1.0f);
+}
+
+vec3 reinhard(vec3 x) {
+    return x / (1.0f + x);
+}
+
+vec3 encode_srgb(vec3 c) {
+    return mix(c * 12.92f, 1.055f * pow(c, vec3(1.0f / 2.4f)) - 0.055f, step(0.0031308f, c));
+}
+
+void main() {
+    vec3 color = texelFetch(scene, ivec2(gl_FragCoord.xy), 0).rgb;
+    if (bloomStrength > 0.0f) {
+        color = mix(color, texture(bloom, uv).rgb, bloomStrength);
+    }
+    color *= exposure;
+    color = toneMap == 1 ? aces(color) : reinhard(color);
+    fragColor = vec4(encode_srgb(clamp(color, 0.0f, 1.0f)), 1.0f);
+}
@@ -0,0 +1,31 @@
+#version 420 core
+
+// Upscale of the scaled scene to the window: a bilinear tap, sharpened by contrast adaptive
+// sharpening. The 4 neighbours one source texel away are subtracted with a weight that shrinks
+// where the local contrast is already high, so edges get crisper without halos. Works on the tone
+// mapped, sRGB encoded image.
+
+in vec2 uv;
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2D source;
+
+uniform vec2 texelSize;             // of the source
+uniform float sharpness;            // 0 to 1
+
+void main() {
+    vec3 c = texture(source, uv).rgb;
+    vec3 n = texture(source, uv + vec2(0.0f, texelSize.y)).rgb;
+    vec3 s = texture(source, uv - vec2(0.0f, texelSize.y)).rgb;
+    vec3 e = texture(source, uv + vec2(texelSize.x, 0.0f)).rgb;
+    vec3 w = texture(source, uv - vec2(texelSize.x, 0.0f)).rgb;
+
+    vec3 lo = min(c, min(min(n, s), min(e, w)));
+    vec3 hi = max(c, max(max(n, s), max(e, w)));
+    vec3 amount = sqrt(clamp(min(lo, 1.0f - hi) / max(hi, 1e-4f), 0.0f, 1.0f));
+    vec3 weight = amount * mix(-0.125f, -0.2f, sharpness);
+
+    vec3 color = (c + weight * (n + s + e + w)) / (1.0f + 4.0f * weight);
+    fragColor = vec4(clamp(color, 0.0f, 1.0f), 1.0f);
+}
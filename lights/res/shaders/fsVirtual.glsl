@@ -0,0 +1,64 @@
+#version 420 core
+
+// Point and directional light shading with the diffuse color sampled from a virtual texture.
+// Permutation keys: SUN_LIGHT and POINT_SHADOWS (include/lighting.glsl), MOTION_VECTORS and
+// COARSE_SHADING (include/surface.glsl).
+
+struct VirtualTexture {
+    usampler2D pageTable;
+    sampler2D cache;
+    vec2 size;
+    float tileSize;
+    float border;
+    float cacheSize;
+    float maxLevel;
+    float mipBias;
+};
+
+#include "include/lighting.glsl"
+#include "include/surface.glsl"
+#include "include/velocity.glsl"
+
+in vec3 fragPos;
+in vec3 normal;
+in vec2 texCoords;
+in vec3 worldPos;
+in vec3 worldNormal;
+
+uniform VirtualTexture vt;
+
+vec3 sampleVirtual(vec2 uv) {
+    vec2 dx = dFdx(uv * vt.size);
+    vec2 dy = dFdy(uv * vt.size);
+    int level = int(clamp(0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8)) + vt.mipBias, 0.0, vt.maxLevel));
+
+    // The page table entry points at the requested tile or at its closest resident ancestor.
+    vec2 wrapped = fract(uv);
+    ivec2 pages = textureSize(vt.pageTable, level);
+    uvec4 entry = texelFetch(vt.pageTable, min(ivec2(wrapped * pages), pages - 1), level);
+
+    vec2 levelSize = max(vt.size / exp2(float(entry.b)), vec2(1.0));
+    vec2 inTile = mod(wrapped * levelSize, vt.tileSize);
+    vec2 texel = vec2(entry.rg) * (vt.tileSize + 2.0 * vt.border) + vt.border + inTile;
+
+    return textureLod(vt.cache, texel / vt.cacheSize, 0.0).rgb;
+}
+
+void main() {
+    vec3 diffuseColor = sampleVirtual(texCoords);
+    if (decodeSrgb) {
+        diffuseColor = decode_srgb(diffuseColor);
+    }
+
+    vec3 norm = normalize(normal);
+
+    // No specular map, the floor is lit diffusely.
+#ifdef COARSE_SHADING
+    writeSurface(diffuseColor, vec3(0.0f), 1.0f, norm);
+#else
+    SurfaceLight lit = shade_surface(fragPos, norm, worldPos, normalize(worldNormal), 1.0f);
+    fragColor = vec4(lit.diffuse * diffuseColor, 1.0f);
+    ambientColor = vec4(lit.ambient * diffuseColor, 0.0f);
+#endif
+    writeVelocity();
+}
@@ -0,0 +1,35 @@
+#version 420 core
+
+// One invocation per cube face, so a single draw fills all six faces of a shadow cube.
+
+layout (triangles, invocations = 6) in;
+layout (triangle_strip, max_vertices = 3) out;
+
+uniform mat4 faceMatrices[6];   // World to clip space of each face
+
+out vec3 worldPos;
+
+// Whether all three vertices are outside the same clip plane.
+bool outside(vec4 a, vec4 b, vec4 c) {
+    return (a.x < -a.w && b.x < -b.w && c.x < -c.w) || (a.x > a.w && b.x > b.w && c.x > c.w) ||
+           (a.y < -a.w && b.y < -b.w && c.y < -c.w) || (a.y > a.w && b.y > b.w && c.y > c.w) ||
+           (a.z < -a.w && b.z < -b.w && c.z < -c.w) || (a.z > a.w && b.z > b.w && c.z > c.w);
+}
+
+void main() {
+    vec4 clip[3];
+    for (int i = 0; i < 3; i++) {
+        clip[i] = faceMatrices[gl_InvocationID] * gl_in[i].gl_Position;
+    }
+    if (outside(clip[0], clip[1], clip[2])) {
+        return;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        gl_Layer = gl_InvocationID;
+        gl_Position = clip[i];
+        worldPos = gl_in[i].gl_Position.xyz;
+        EmitVertex();
+    }
+    EndPrimitive();
+}
@@ -0,0 +1,33 @@
+// Shared by the coarse shading passes (CoarseShading): the surface the scene pass wrote with
+// COARSE_SHADING (include/surface.glsl), and the list of samples the classification adds to the
+// first pixel of each tile.
+
+const int COARSE_TILE = 4;
+
+layout (binding = 5) uniform sampler2D surfaceColor;     // diffuse color, shininess (0 if unlit)
+layout (binding = 6) uniform sampler2D surfaceNormals;   // view space
+layout (binding = 7) uniform sampler2D surfaceSpecular;
+layout (binding = 8) uniform sampler2D sceneDepth;
+
+// Indirect dispatch arguments of the shading pass, then the samples, x | y << 16 each.
+layout (std430, binding = 0) buffer Samples {
+    uint groups[3];
+    uint sampleCount;
+    uint samples[];
+};
+
+uniform mat4 inverseProjection;     // of the projection the scene was drawn with, TAA jitter included
+
+vec3 view_position(ivec2 pixel, float depth) {
+    vec2 size = vec2(textureSize(sceneDepth, 0));
+    vec4 ndc = vec4((vec2(pixel) + 0.5f) / size * 2.0f - 1.0f, depth * 2.0f - 1.0f, 1.0f);
+    vec4 position = inverseProjection * ndc;
+    return position.xyz / position.w;
+}
+
+// View space z of a depth buffer value, only the z and w rows matter.
+float view_depth(float depth) {
+    vec4 ndc = vec4(0.0f, 0.0f, depth * 2.0f - 1.0f, 1.0f);
+    return dot(vec4(inverseProjection[0][2], inverseProjection[1][2], inverseProjection[2][2], inverseProjection[3][2]), ndc) /
+           dot(vec4(inverseProjection[0][3], inverseProjection[1][3], inverseProjection[2][3], inverseProjection[3][3]), ndc);
+}
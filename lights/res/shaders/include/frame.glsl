@@ -0,0 +1,43 @@
+// Per frame constants of the programs built from vertexShader.glsl, one uniform buffer shared by
+// every variant (glsl::Frame, generated by shaderreflect). Its layout must not depend on the
+// permutation keys.
+
+struct Light {
+    vec3 position;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    float constant;
+    float linear;
+    float quadratic;
+};
+
+// Directional light, shadowed by cascaded shadow maps with SUN_LIGHT.
+struct DirectionalLight {
+    vec3 direction;     // View space, the direction the light travels
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+layout (std140, binding = 3) uniform Frame {
+    mat4 view;
+    mat4 projection;                // With the TAA jitter
+    mat4 currentViewProjection;     // Without it, for the motion vectors
+    mat4 previousViewProjection;
+
+    Light light;
+    DirectionalLight sun;
+
+    // Shadow of the main point light.
+    vec3 lightPos;                  // World space
+    float lightRange;
+    int lightShadowSlot;            // Cube of pointShadowMaps, -1 if unshadowed
+
+    // Color textures hold sRGB values. Lighting into the HDR target happens in linear light, so
+    // they are decoded first; the tone map pass encodes the result again.
+    bool decodeSrgb;
+};
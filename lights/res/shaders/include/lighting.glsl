@@ -0,0 +1,162 @@
+// Lights and shadows shared by the lit shaders: fragmentShader.glsl, fsVirtual.glsl and
+// csCoarseShade.glsl.
+// Permutation keys, set by ShaderCache:
+//   SUN_LIGHT       the directional light and its cascaded shadows
+//   POINT_SHADOWS   shadow cubes of the point lights, unshadowed without it
+
+#include "frame.glsl"
+
+vec3 decode_srgb(vec3 c) {
+    return mix(c / 12.92f, pow((c + 0.055f) / 1.055f, vec3(2.4f)), step(0.04045f, c));
+}
+
+// Additional point lights, glsl::PointLights in the generated ShaderBlocks.hpp.
+struct PointLight {
+    vec4 viewPosition;      // xyz view space, w range
+    vec4 worldPosition;
+    vec3 color;
+    int shadowSlot;         // Cube of pointShadowMaps, -1 if unshadowed
+};
+
+layout (std140, binding = 2) uniform PointLights {
+    PointLight pointLights[16];
+    int pointLightCount;
+};
+
+#ifdef POINT_SHADOWS
+// Distance to the light over its range, one cube per shadowed point light (PointShadowAtlas).
+layout (binding = 4) uniform samplerCubeArrayShadow pointShadowMaps;
+#endif
+
+// Fraction of a point light reaching a point. As for the cascades, the lookup is pushed along the
+// normal by about a texel and a half of the cube face at that distance.
+float pointShadow(int slot, vec3 lightPosition, float range, vec3 position, vec3 worldNorm) {
+#ifdef POINT_SHADOWS
+    if (slot < 0) {
+        return 1.0f;
+    }
+
+    float texel = 2.0f * length(position - lightPosition) / float(textureSize(pointShadowMaps, 0).x);
+    vec3 toPosition = position + worldNorm * texel * 1.5f - lightPosition;
+    float depth = length(toPosition) / range;
+    if (depth >= 1.0f) {
+        return 1.0f;
+    }
+    return texture(pointShadowMaps, vec4(toPosition, slot), depth);
+#else
+    return 1.0f;
+#endif
+}
+
+#ifdef SUN_LIGHT
+// Cascade table, see CascadedShadowMap.
+layout (std140, binding = 1) uniform Cascades {
+    mat4 cascadeMatrices[4];    // World to shadow map texture space
+    vec4 cascadeSplits;         // Far view depth of each cascade
+    vec4 cascadeTexelSizes;     // World units per shadow map texel
+    int cascadeCount;
+    int shadowFilter;           // 0 single tap, 1 3x3 PCF, 2 5x5 PCF
+    bool showCascades;
+};
+
+layout (binding = 3) uniform sampler2DArrayShadow shadowMap;
+
+const vec3 cascadeColors[4] = vec3[4](vec3(1.0f, 0.3f, 0.3f), vec3(0.3f, 1.0f, 0.3f),
+                                      vec3(0.3f, 0.3f, 1.0f), vec3(1.0f, 1.0f, 0.3f));
+
+// Cascade covering a view depth, -1 beyond the last one.
+int selectCascade(float viewDepth) {
+    for (int i = 0; i < cascadeCount; i++) {
+        if (viewDepth <= cascadeSplits[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Fraction of the directional light reaching a point. The lookup position is pushed along the
+// normal by a couple of texels of its cascade, which removes acne at grazing angles without a
+// large constant bias. Every tap compares 2 x 2 texels with bilinear weights.
+float cascadeShadow(int cascade, vec3 position, vec3 worldNorm) {
+    if (cascade < 0) {
+        return 1.0f;
+    }
+
+    vec3 offset = worldNorm * cascadeTexelSizes[cascade] * 1.5f;
+    vec3 coords = vec3(cascadeMatrices[cascade] * vec4(position + offset, 1.0f));
+    int radius = shadowFilter;
+    vec2 texel = 1.0f / vec2(textureSize(shadowMap, 0).xy);
+
+    float lit = 0.0f;
+    for (int y = -radius; y <= radius; y++) {
+        for (int x = -radius; x <= radius; x++) {
+            lit += texture(shadowMap, vec4(coords.xy + vec2(x, y) * texel, cascade, coords.z));
+        }
+    }
+    return lit / float((2 * radius + 1) * (2 * radius + 1));
+}
+#endif
+
+// Light reaching a surface point, split by the color it is multiplied with: the diffuse color
+// (ambient included) and the specular color. 'ambient' is the part of 'diffuse' SSAO darkens.
+// Evaluated per pixel by the forward shaders and per coarse sample by csCoarseShade.glsl.
+struct SurfaceLight {
+    vec3 diffuse;
+    vec3 specular;
+    vec3 ambient;
+};
+
+// 'position' and 'norm' in view space, 'norm' normalized.
+SurfaceLight shade_surface(vec3 position, vec3 norm, vec3 worldPos, vec3 worldNorm, float shininess) {
+    SurfaceLight lit;
+    vec3 viewDir = normalize(-position);
+
+    // main light
+    vec3 toLight = vec3(view * vec4(lightPos, 1.0f)) - position;
+    float distance = length(toLight);
+    vec3 lightDir = toLight / distance;
+    float diff = max(dot(norm, lightDir), 0.0f);
+    float spec = pow(max(dot(viewDir, reflect(-lightDir, norm)), 0.0f), shininess);
+    float attenuation = 1.0 / (light.constant + light.linear * distance +
+                        light.quadratic * (distance * distance));
+    float shadow = pointShadow(lightShadowSlot, lightPos, lightRange, worldPos, worldNorm);
+
+    lit.ambient = light.ambient * attenuation;
+    lit.diffuse = lit.ambient + light.diffuse * diff * attenuation * shadow;
+    lit.specular = light.specular * spec * attenuation * shadow;
+
+    // additional point lights
+    for (int i = 0; i < pointLightCount; i++) {
+        vec3 toPoint = pointLights[i].viewPosition.xyz - position;
+        float d = length(toPoint);
+        if (d >= pointLights[i].viewPosition.w) {
+            continue;
+        }
+        vec3 dir = toPoint / d;
+        float pointDiff = max(dot(norm, dir), 0.0f);
+        float pointSpec = pow(max(dot(viewDir, reflect(-dir, norm)), 0.0f), shininess);
+        float pointAttenuation = 1.0 / (light.constant + light.linear * d + light.quadratic * (d * d));
+        float pointLit = pointShadow(pointLights[i].shadowSlot, pointLights[i].worldPosition.xyz,
+                                     pointLights[i].viewPosition.w, worldPos, worldNorm);
+        vec3 radiance = pointLights[i].color * pointAttenuation * pointLit;
+        lit.diffuse += radiance * pointDiff;
+        lit.specular += radiance * pointSpec;
+    }
+
+    // directional light
+#ifdef SUN_LIGHT
+    int cascade = selectCascade(-position.z);
+    float sunShadow = cascadeShadow(cascade, worldPos, worldNorm);
+    vec3 sunDir = normalize(-sun.direction);
+    float sunDiff = max(dot(norm, sunDir), 0.0f);
+    float sunSpec = pow(max(dot(viewDir, reflect(-sunDir, norm)), 0.0f), shininess);
+    lit.ambient += sun.ambient;
+    lit.diffuse += sun.ambient + sunShadow * sun.diffuse * sunDiff;
+    lit.specular += sunShadow * sun.specular * sunSpec;
+    if (showCascades && cascade >= 0) {
+        lit.diffuse *= cascadeColors[cascade];
+        lit.specular *= cascadeColors[cascade];
+    }
+#endif
+    return lit;
+}
@@ -0,0 +1,18 @@
+// Color outputs of the scene shaders. Forward shading writes the lit color and its ambient part.
+// With COARSE_SHADING the scene pass only describes the surface and CoarseShading lights it later:
+// the diffuse color and shininess go to the color target, the view space normal and the specular
+// color to targets of their own. A shininess of 0 marks an unlit surface, its color is final.
+
+layout (location = 0) out vec4 fragColor;
+#ifdef COARSE_SHADING
+layout (location = 1) out vec4 surfaceNormal;
+layout (location = 3) out vec4 surfaceSpecular;
+
+void writeSurface(vec3 diffuseColor, vec3 specularColor, float shininess, vec3 norm) {
+    fragColor = vec4(diffuseColor, shininess);
+    surfaceNormal = vec4(norm, 0.0f);
+    surfaceSpecular = vec4(specularColor, 0.0f);
+}
+#else
+layout (location = 1) out vec4 ambientColor;  // ambient light, darkened by SSAO afterwards
+#endif
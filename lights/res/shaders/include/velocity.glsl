@@ -0,0 +1,15 @@
+// Screen space motion since the last frame, for TAA. Only written with the MOTION_VECTORS key,
+// the clip positions come from vertexShader.glsl.
+
+#ifdef MOTION_VECTORS
+layout (location = 2) out vec2 velocity;
+
+in vec4 currentClip;
+in vec4 previousClip;
+#endif
+
+void writeVelocity() {
+#ifdef MOTION_VECTORS
+    velocity = (currentClip.xy / currentClip.w - previousClip.xy / previousClip.w) * 0.5f;
+#endif
+}
@@ -4,22 +4,57 @@ out vec3 fragPos;
 out vec3 normal;
 out vec3 LightPos;
 out vec2 texCoords;
+out vec3 worldPos;
+out vec3 worldNormal;
+flat out uint materialIndex;
+#ifdef MOTION_VECTORS
+out vec4 currentClip;
+out vec4 previousClip;
+#endif
 
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 vsNormal;
 layout (location = 2) in vec2 tCoords;
 
-uniform vec3 lightPos;
+// Per instance attributes
+layout (location = 3) in mat4 model;
+layout (location = 7) in uint material;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+#include "include/frame.glsl"
+
+// Quantized meshes store positions as unorm16 relative to their bounds and may store
+// octahedral normals. The defaults leave float vertices untouched.
+uniform vec3 positionScale = vec3(1.0f);
+uniform vec3 positionOffset = vec3(0.0f);
+uniform bool octahedralNormals = false;
+
+#ifdef MOTION_VECTORS
+// Motion vectors, from clip positions without the TAA jitter in this frame and the last one.
+uniform mat4 previousTransform = mat4(1.0f);    // world now to world last frame, for moving objects
+#endif
+
+vec3 decode_octahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0f - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0f);
+    n.xy += vec2(n.x >= 0.0f ? -t : t, n.y >= 0.0f ? -t : t);
+    return normalize(n);
+}
 
 void main() {
-    gl_Position = projection * view * model * vec4(position, 1.0f);
-    fragPos = vec3(view * model * vec4(position, 1.0f));
-    normal = mat3(transpose(inverse(view * model))) * vsNormal;
+    vec3 p = positionOffset + position * positionScale;
+    vec3 n = octahedralNormals ? decode_octahedral(vsNormal.xy) : vsNormal;
+
+    gl_Position = projection * view * model * vec4(p, 1.0f);
+    fragPos = vec3(view * model * vec4(p, 1.0f));
+    normal = mat3(transpose(inverse(view * model))) * n;
     //normal = vsNormal;
     LightPos = vec3(view * vec4(lightPos, 1.0f));
     texCoords = tCoords;
+    worldPos = vec3(model * vec4(p, 1.0f));
+#ifdef MOTION_VECTORS
+    currentClip = currentViewProjection * vec4(worldPos, 1.0f);
+    previousClip = previousViewProjection * previousTransform * vec4(worldPos, 1.0f);
+#endif
+    worldNormal = mat3(transpose(inverse(model))) * n;
+    materialIndex = material;
 }
@@ -0,0 +1,11 @@
+#version 420 core
+
+// Triangle covering the screen, drawn with 3 vertices and no attributes.
+
+out vec2 uv;
+
+void main() {
+    vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    uv = p;
+    gl_Position = vec4(p * 2.0f - 1.0f, 0.0f, 1.0f);
+}
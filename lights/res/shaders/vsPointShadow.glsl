@@ -0,0 +1,17 @@
+#version 420 core
+
+// Point light shadow pass, with the instance layout of vertexShader.glsl. Positions stay in
+// world space, gsPointShadow.glsl projects them onto the cube faces.
+
+layout (location = 0) in vec3 position;
+
+// Per instance attributes
+layout (location = 3) in mat4 model;
+
+// Quantized mesh positions, see vertexShader.glsl.
+uniform vec3 positionScale = vec3(1.0f);
+uniform vec3 positionOffset = vec3(0.0f);
+
+void main() {
+    gl_Position = model * vec4(positionOffset + position * positionScale, 1.0f);
+}
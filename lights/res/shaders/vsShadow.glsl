@@ -0,0 +1,18 @@
+#version 420 core
+
+// Depth only pass into a shadow map, with the instance layout of vertexShader.glsl.
+
+layout (location = 0) in vec3 position;
+
+// Per instance attributes
+layout (location = 3) in mat4 model;
+
+// Quantized mesh positions, see vertexShader.glsl.
+uniform vec3 positionScale = vec3(1.0f);
+uniform vec3 positionOffset = vec3(0.0f);
+
+uniform mat4 lightViewProjection;
+
+void main() {
+    gl_Position = lightViewProjection * model * vec4(positionOffset + position * positionScale, 1.0f);
+}
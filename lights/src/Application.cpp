@@ -21,6 +21,7 @@ int g_height = 640; /** window height */
 float g_deltaTime = 0.0f;   /** time between two frames */
 
 Camera cam(glm::vec3(-0.7f, 0.7f, 3.9f), glm::vec3(0.0f, 1.0f, 0.0f), -63.5f, -6.5f);
+Simulation simulation;      /** Steps cam and the animations, cam holds the interpolated pose. */
 
 glm::vec3 lightPos(1.0f, 0.5f, 2.0f);   /** Position of light source. */
 
@@ -28,21 +29,6 @@ glm::vec3 lightPos(1.0f, 0.5f, 2.0f);   /** Position of light source. */
 float g_lastX = g_width / 2, g_lastY = g_height / 2;
 bool firstMouse = true;
 
-// Cube positions
-glm::vec3 cubePositions[] = {
-    glm::vec3(0.0f,  0.0f,  0.0f),
-    glm::vec3(2.0f,  5.0f, -15.0f),
-    glm::vec3(-1.5f, -2.2f, -2.5f),
-    glm::vec3(-3.8f, -2.0f, -12.3f),
-    glm::vec3(2.4f, -0.4f, -3.5f),
-    glm::vec3(-1.7f,  3.0f, -7.5f),
-    glm::vec3(1.3f, -2.0f, -2.5f),
-    glm::vec3(1.5f,  2.0f, -2.5f),
-    glm::vec3(1.5f,  0.2f, -1.5f),
-    glm::vec3(-1.3f,  1.0f, -1.5f)
-};
-
-
 /**
  * @brief GLFW error callback function. This function is called whenever an error occurs in GLFW.
  * Prints GLFW error code with default description associated with it.
@@ -59,33 +45,29 @@ void error_callback(int error, const char* message) {
 
 
 /**
- * @brief This function is called every frame to process the keyboard inputs.
+ * @brief This function is called every frame to process the keyboard inputs. The held keys go to
+ * the simulation thread, which moves the camera in fixed steps.
  * 
  * @param window Pointer to the target window.
  * @return void
  */
 void process_input(GLFWwindow* window) {
-	if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
-		cam.keyInput(Command::FORWARD, g_deltaTime);
-	}
-	if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
-		cam.keyInput(Command::BACKWARD, g_deltaTime);
-	}
-	if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
-		cam.keyInput(Command::LEFT, g_deltaTime);
-	}
-	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
-		cam.keyInput(Command::RIGHT, g_deltaTime);
-	}
-	if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) {
-		cam.keyInput(Command::UP, g_deltaTime);
-	}
-	if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) {
-		cam.keyInput(Command::DOWN, g_deltaTime);
-	}
-    if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS) {
-        cam.keyInput(Command::RESET, g_deltaTime);
+    const std::pair<int, Command> bindings[] = {
+        { GLFW_KEY_W, Command::FORWARD },
+        { GLFW_KEY_S, Command::BACKWARD },
+        { GLFW_KEY_A, Command::LEFT },
+        { GLFW_KEY_D, Command::RIGHT },
+        { GLFW_KEY_E, Command::UP },
+        { GLFW_KEY_Q, Command::DOWN },
+        { GLFW_KEY_F, Command::RESET }
+    };
+    uint32_t keys = 0;
+    for (const auto& [key, command] : bindings) {
+        if (glfwGetKey(window, key) == GLFW_PRESS) {
+            keys |= 1u << (int)command;
+        }
     }
+    simulation.setKeys(keys);
 }
 
 
@@ -103,7 +85,7 @@ int main(int argc, char* argv[]) {
 
     // Set window parameters
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
     glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
@@ -122,7 +104,6 @@ int main(int argc, char* argv[]) {
     }
 
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(1);
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 
     // Setup Dear ImGui context
@@ -151,18 +132,54 @@ int main(int argc, char* argv[]) {
 
     glEnable(GL_DEPTH_TEST);
 
+    // Every program is checked against the uniform block layouts generated from the shaders.
+    Shader::expectBlocks(glsl::BLOCKS, std::size(glsl::BLOCKS));
+
 
     // Initialize Buffers
     //--------------------
-    GLuint vaoCube, vaoLight, vbo;
+    GLuint vaoCube, vaoLight, vaoFloor, vbo, vboFloor;
 
     glGenVertexArrays(1, &vaoCube);
     glGenVertexArrays(1, &vaoLight);
+    glGenVertexArrays(1, &vaoFloor);
     glGenBuffers(1, &vbo);
+    glGenBuffers(1, &vboFloor);
 
     glBindVertexArray(vaoCube);
+    // The cube's vertices are 16 bytes instead of 32 and decode exactly, see quantize_cube_vertices.
+    // Every program that draws them rescales the positions with cube_decode.
+    glm::vec3 cubeOffset, cubeScale;
+    std::vector<MeshVertexQuantized> cubeVertices = quantize_cube_vertices(cubeData, std::size(cubeData), cubeOffset, cubeScale);
+    auto cube_decode = [&](Shader& program, bool enable) {
+        program.setVec3("positionScale", enable ? cubeScale : glm::vec3(1.0f));
+        program.setVec3("positionOffset", enable ? cubeOffset : glm::vec3(0.0f));
+    };
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeData), cubeData, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(MeshVertexQuantized) * cubeVertices.size(), cubeVertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(MeshVertexQuantized), (const void*)offsetof(MeshVertexQuantized, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(MeshVertexQuantized), (const void*)offsetof(MeshVertexQuantized, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(MeshVertexQuantized), (const void*)offsetof(MeshVertexQuantized, uv));
+    glEnableVertexAttribArray(2);
+
+    glBindVertexArray(vaoLight);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(MeshVertexQuantized), (const void*)offsetof(MeshVertexQuantized, position));
+    glEnableVertexAttribArray(0);
+
+    // Cubes in the shadow pass only need positions, their instances are the casters of each cascade.
+    GLuint vaoShadowCube;
+    glGenVertexArrays(1, &vaoShadowCube);
+    glBindVertexArray(vaoShadowCube);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(MeshVertexQuantized), (const void*)offsetof(MeshVertexQuantized, position));
+    glEnableVertexAttribArray(0);
+
+    glBindVertexArray(vaoFloor);
+    glBindBuffer(GL_ARRAY_BUFFER, vboFloor);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(floorData), floorData, GL_STATIC_DRAW);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void*)(sizeof(float) * 3));
@@ -170,33 +187,241 @@ int main(int argc, char* argv[]) {
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void*)(sizeof(float) * 6));
     glEnableVertexAttribArray(2);
 
-    glBindVertexArray(vaoLight);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    // Every texture counts against one VRAM budget. Streamable textures keep their mip chain
+    // on the CPU and only the levels their on screen size needs are resident.
+    TextureManager textures;
+
+    // Materials
+    MaterialLibrary materials;
+    materials.addMaterial("container1", "res/textures/container1.png", "res/textures/container1_specular.png", 32.0f);
+    materials.addMaterial("container1 (glossy)", "res/textures/container1.png", "res/textures/container1_specular.png", 128.0f);
+    materials.addMaterial("container", "res/textures/container.jpg", nullptr, 8.0f);
+    materials.build(textures);
+
+    // Small textures (decals, icons) share atlas pages instead of owning a texture each.
+    TextureAtlas atlas;
+    std::vector<int> atlasImages;
+    atlasImages.push_back(atlas.insert("res/textures/container1.png"));
+    atlasImages.push_back(atlas.insert("res/textures/container1_specular.png"));
+    int atlasMemory = textures.track("texture atlas", atlas.videoMemory());
+
+    // Each atlas image is shown as a decal on the floor, with its texture coordinates remapped
+    // into the atlas page. Repacking moves images, the decals are rebuilt when it does.
+    GLuint vaoDecal, vboDecal;
+    glGenVertexArrays(1, &vaoDecal);
+    glGenBuffers(1, &vboDecal);
+    std::vector<float> decalVertices;
+    build_decals(decalVertices, atlas, atlasImages);
+    glBindVertexArray(vaoDecal);
+    glBindBuffer(GL_ARRAY_BUFFER, vboDecal);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * decalVertices.size(), decalVertices.data(), GL_DYNAMIC_DRAW);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void*)0);
     glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void*)(sizeof(float) * 3));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (const void*)(sizeof(float) * 6));
+    glEnableVertexAttribArray(2);
 
-    // Load Textures
-    GLuint diffuseMap = load_texture("res/textures/container1.png");
-    GLuint specularMap = load_texture("res/textures/container1_specular.png");
+    // The floor is virtually textured. Only the tiles the feedback pass asks for are streamed
+    // from the tile file into a fixed size cache.
+    VirtualTexture floorTexture;
+    if (!floorTexture.open("res/textures/container.vt")) {
+        VirtualTexture::buildTileFile("res/textures/container.jpg", "res/textures/container.vt");
+        if (!floorTexture.open("res/textures/container.vt")) {
+            std::cerr << "Failed to open virtual texture" << std::endl;
+        }
+    }
+    int floorMemory = textures.track("floor virtual texture", floorTexture.videoMemory());
+
+    // Directional light with cascaded shadow maps.
+    CascadedShadowMap shadows;
+    bool sunEnabled = shadows.init();
+    glm::vec3 sunDirection(-0.2f, -1.0f, -0.3f);
+    glm::vec3 sunColor(0.6f);
+    textures.track("cascaded shadow map", shadows.videoMemory());
+
+    // At most two frames queued for the GPU, adaptive vsync where the driver has it.
+    FramePacer pacer;
+    pacer.init();
+
+    // The scene is lit in linear HDR, metered by a luminance histogram and tone mapped to the
+    // window. Every pass of the frame is timed on the GPU.
+    GpuProfiler profiler;
+    HdrPipeline hdr;
+    bool canRenderHdr = hdr.init();
+    bool hdrEnabled = canRenderHdr;
+
+    // The frame is declared as a render graph every frame. Passes nothing reads are culled, their
+    // intermediate targets share memory when their lifetimes allow, and barriers are derived.
+    RenderGraph graph;
+    int graphMemory = textures.track("Render graph", 0);
+    Bloom bloom;
+    bool bloomEnabled = bloom.init();
+    Fxaa fxaa;
+    bool canFxaa = fxaa.init();
+    Taa taa;
+    bool canTaa = canRenderHdr && taa.init();
+    Msaa msaa;
+    bool canMsaa = canRenderHdr && msaa.init();
+    int antiAliasing = canFxaa ? AA_FXAA : AA_NONE;
+    int taaMemory = textures.track("TAA history", 0);
+    Ssao ssao;
+    bool ssaoEnabled = ssao.init();
+
+    // Dynamic resolution: the scene is drawn at a scale of the window steered by the GPU time and
+    // upscaled before the UI, which stays at full resolution.
+    DynamicResolution resolution;
+    bool canScale = resolution.init();
+
+    // Coarse shading: the scene pass writes the surface and compute passes light it at a rate
+    // chosen per tile, for fill rate bound GPUs. Off by default.
+    CoarseShading coarse;
+    bool canCoarseShade = canRenderHdr && coarse.init();
+    bool coarseEnabled = false;
+
+    // Point lights with cube shadow maps. A fixed budget of cubes is handed to the lights closest
+    // to the camera, and a cube is only re-rendered when its light or a caster in range moved.
+    PointShadowAtlas pointShadows;
+    bool canShadowPointLights = pointShadows.init();
+    bool pointShadowsEnabled = canShadowPointLights;
+    textures.track("point shadow atlas", pointShadows.videoMemory());
+    int extraLights = 0;
+    bool animateLights = false;
+    float lightsAngle = 0.0f;
+    glsl::PointLights pointLightBlock {};
+    GLuint pointLightBuffer;
+    glGenBuffers(1, &pointLightBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, pointLightBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(pointLightBlock), &pointLightBlock, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Per frame constants of the lit programs: camera, main light and sun, in one uniform buffer
+    // shared by every variant.
+    glsl::Frame frameBlock {};
+    GLuint frameBuffer;
+    glGenBuffers(1, &frameBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, frameBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(frameBlock), &frameBlock, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Instances
+    // Every cube carries its own model matrix and material index, so all of them are drawn
+    // with a single indirect call.
+    GLuint cubeInstances, lightInstance, floorInstance, indirectBuffer, shadowInstances;
+    glGenBuffers(1, &cubeInstances);
+    glGenBuffers(1, &lightInstance);
+    glGenBuffers(1, &floorInstance);
+    glGenBuffers(1, &indirectBuffer);
+    glGenBuffers(1, &shadowInstances);
+
+    setup_instance_attributes(vaoCube, cubeInstances);
+    setup_instance_attributes(vaoShadowCube, shadowInstances);
+    setup_instance_attributes(vaoLight, lightInstance);
+    setup_instance_attributes(vaoFloor, floorInstance);
+    setup_instance_attributes(vaoDecal, floorInstance);
+
+    // Imported model, given as a *.mesh file on the command line. It is scaled to fit a 2 unit
+    // cube and placed to the left of the first container.
+    Mesh model;
+    GLuint modelInstance;
+    glGenBuffers(1, &modelInstance);
+    glm::vec3 modelPosition(-3.0f, 0.0f, 0.0f);
+    float modelScale = 1.0f;
+    float modelRadius = 0.0f;
+    InstanceData modelData {};
+    bool hasModel = argc > 1 && model.load(argv[1]);
+    if (hasModel) {
+        setup_instance_attributes(model.getVAO(), modelInstance);
+
+        glm::vec3 extent = model.boundsMax() - model.boundsMin();
+        modelScale = 2.0f / std::max(std::max(extent.x, extent.y), std::max(extent.z, 1e-6f));
+        modelRadius = glm::length(extent) * 0.5f * modelScale;
+        modelData.model = glm::translate(glm::mat4(1.0f), modelPosition);
+        modelData.model = glm::scale(modelData.model, glm::vec3(modelScale));
+        modelData.model = glm::translate(modelData.model, -(model.boundsMin() + model.boundsMax()) * 0.5f);
+        glBindBuffer(GL_ARRAY_BUFFER, modelInstance);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(modelData), &modelData, GL_STATIC_DRAW);
+    }
+
+    // Level of detail selection. A level is good enough while its simplification error stays
+    // below lodThreshold pixels on screen.
+    LodState modelLod;
+    float lodThreshold = 1.0f;
+    float lodHysteresis = 0.25f;
+    bool lodCrossFade = true;
+    int forcedLod = -1;
+
+    // Models with meshlets are culled cluster by cluster on the GPU before they are drawn.
+    MeshletCuller culler;
+    bool canCullMeshlets = hasModel && model.hasMeshlets() && culler.init();
+    bool meshletCulling = canCullMeshlets;
+
+    InstanceData floorModel {};
+    floorModel.model = glm::mat4(1.0f);
+    glBindBuffer(GL_ARRAY_BUFFER, floorInstance);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(floorModel), &floorModel, GL_STATIC_DRAW);
+
+    std::vector<InstanceData> instances;
+    int cubeCount = 10;
+    build_cube_instances(instances, cubeCount, (int)materials.getMaterials().size());
+    glBindBuffer(GL_ARRAY_BUFFER, cubeInstances);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(InstanceData) * instances.size(), instances.data(), GL_DYNAMIC_DRAW);
+
+    DrawArraysIndirectCommand drawCommand { 36, (GLuint)instances.size(), 0, 0 };
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(drawCommand), &drawCommand, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
 
     // Create Shader
-    Shader shader;
-    shader.addShader(GL_VERTEX_SHADER, "res/shaders/vertexShader.glsl");
-    shader.addShader(GL_FRAGMENT_SHADER, "res/shaders/fragmentShader.glsl");
-    shader.createProgram();
-    shader.use();
-    shader.setInt("material.diffuse", 0);
-    shader.setInt("material.specular", 1);
+    // The lit shaders come in variants, one per combination of the features they handle (the sun,
+    // point light shadows, motion vectors, LOD cross-fade), so the hot fragment shaders do not branch
+    // on them. The variants in the manifest are compiled now, any other on its first use.
+    ShaderCache shaders;
+    shaders.prewarm("res/shaders/variants.txt");
+
+    // Saving a file under res/shaders rebuilds the programs that use it in the background and
+    // swaps them in between frames. A program that no longer compiles keeps its old version.
+    ShaderReloader shaderReloader;
+    shaderReloader.init("res/shaders", (GLADloadproc)glfwGetProcAddress);
+
+    Shader feedbackShader;
+    feedbackShader.addShader(GL_VERTEX_SHADER, "res/shaders/vertexShader.glsl");
+    feedbackShader.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsFeedback.glsl");
+    feedbackShader.createProgram();
+
+    Shader shadowShader;
+    shadowShader.addShader(GL_VERTEX_SHADER, "res/shaders/vsShadow.glsl");
+    shadowShader.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsShadow.glsl");
+    shadowShader.createProgram();
+
+    Shader pointShadowShader;
+    pointShadowShader.addShader(GL_VERTEX_SHADER, "res/shaders/vsPointShadow.glsl");
+    pointShadowShader.addShader(GL_GEOMETRY_SHADER, "res/shaders/gsPointShadow.glsl");
+    pointShadowShader.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsPointShadow.glsl");
+    pointShadowShader.createProgram();
+
+    // Casters of every cascade, one range of shadowInstances per cascade.
+    std::vector<InstanceData> shadowCasters;
+    int cascadeFirst[CSM_MAX_CASCADES] = {};
+    int cascadeCasters[CSM_MAX_CASCADES] = {};
+    bool cascadeModel[CSM_MAX_CASCADES] = {};
+
+    // Shadow cubes to re-render this frame, their casters follow the cascades' in shadowInstances.
+    std::vector<PointShadowPass> pointShadowPasses;
+
+    // Last frame's camera and light markers, for the motion vectors of TAA.
+    glm::mat4 previousViewProjection(1.0f);
+    std::vector<glm::mat4> previousMarkers;
 
-    Shader lightShader;
-    lightShader.addShader(GL_VERTEX_SHADER, "res/shaders/vertexShader.glsl");
-    lightShader.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsLight.glsl");
-    lightShader.createProgram();
+    simulation.start(cam, lightsAngle);
 
 
     // Main Loop
     //-----------
     while (!glfwWindowShouldClose(window)) {
+        // Hold the CPU back before sampling input, so the input is as fresh as possible.
+        pacer.beginFrame();
+
         // Delta Time
         //------------
         static float lastTime;  /** Time of last frame. */
@@ -206,6 +431,17 @@ int main(int argc, char* argv[]) {
 
         glfwPollEvents();
         process_input(window);
+        simulation.setAnimateLights(animateLights);
+        SimulationState simulated = simulation.interpolate();
+        cam.setPose(simulated.position, simulated.yaw, simulated.pitch);
+        cam.fov = simulated.fov;
+        lightsAngle = simulated.lightsAngle;
+
+        // Render size of this frame, from the GPU time of a recent one
+        resolution.update(profiler.total());
+        int renderWidth, renderHeight;
+        resolution.renderSize(g_width, g_height, renderWidth, renderHeight);
+        shaderReloader.update();
 
         static ImVec4 clearColor = ImVec4(0.0f, 0.0f, 0.0f, 1.0f);
         static glm::vec3 lightColor(1.0f);     /** Light Color */
@@ -231,10 +467,12 @@ int main(int argc, char* argv[]) {
             ImGui::Text("Camera");
             ImGui::Text("Position: x = %.2f, y = %.2f, z = %.2f", cam.position.x, cam.position.y, cam.position.z);
             ImGui::Text("Rotation: pitch = %.2f, yaw = %.2f", cam.pitch, cam.yaw);
+            ImGui::Text("Simulation: %d Hz, step %llu, blend %.2f, %llu dropped", SIMULATION_RATE,
+                (unsigned long long)simulated.step, simulation.blend(), (unsigned long long)simulation.dropped());
 
             if (initFlag) {
                 ImGui::SetWindowPos(ImVec2{ 5, 5 });
-                ImGui::SetWindowSize(ImVec2{ 350, 180 });
+                ImGui::SetWindowSize(ImVec2{ 350, 220 });
                 initFlag = false;
             }
 
@@ -244,90 +482,731 @@ int main(int argc, char* argv[]) {
             ImGui::Text("Light");
             ImGui::ColorEdit3("Light Color", (float*)&light);
             lightColor = {light.x, light.y, light.z};
+            ImGui::DragFloat3("Light Position", glm::value_ptr(lightPos), 0.05f);
+
+            ImGui::Text("Cubes");
+            if (ImGui::SliderInt("Count", &cubeCount, 10, 10000)) {
+                build_cube_instances(instances, cubeCount, (int)materials.getMaterials().size());
+                glBindBuffer(GL_ARRAY_BUFFER, cubeInstances);
+                glBufferData(GL_ARRAY_BUFFER, sizeof(InstanceData) * instances.size(), instances.data(), GL_DYNAMIC_DRAW);
+
+                drawCommand.instanceCount = (GLuint)instances.size();
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+                glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(drawCommand), &drawCommand);
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+                pointShadows.invalidate();
+            }
             
+            if (ImGui::CollapsingHeader("Texture Atlas")) {
+                ImGui::Text("%d images in %d pages", atlas.entryCount(), atlas.pageCount());
+                for (int i = 0; i < atlas.pageCount(); i++) {
+                    ImGui::Text("Page %d: %.1f%% used", i, atlas.occupancy(i) * 100.0f);
+                    ImGui::Image((ImTextureID)(intptr_t)atlas.pageTexture(i), ImVec2(128, 128));
+                }
+
+                // Each image drawn from its page with the region the atlas reports for it.
+                for (int handle : atlasImages) {
+                    if (handle < 0) {
+                        continue;
+                    }
+                    AtlasRegion r = atlas.region(handle);
+                    ImVec2 uv0(r.offset.x, r.offset.y);
+                    ImVec2 uv1(r.offset.x + r.scale.x, r.offset.y + r.scale.y);
+                    ImGui::Image((ImTextureID)(intptr_t)atlas.pageTexture(r.page), ImVec2(64, 64), uv0, uv1);
+                    ImGui::SameLine();
+                }
+                ImGui::NewLine();
+            }
+
+            if (ImGui::CollapsingHeader("Virtual Texture")) {
+                ImGui::Text("Resident tiles: %d / %d slots (%zu tiles total)", floorTexture.residentTiles(),
+                    floorTexture.cacheSlots(), floorTexture.totalTiles());
+                ImGui::Text("Pending: %d, uploaded this frame: %d", floorTexture.pendingTiles(), floorTexture.uploads());
+                ImGui::Text("VRAM: %.2f MB", floorTexture.videoMemory() / (1024.0f * 1024.0f));
+            }
+
+            if (ImGui::CollapsingHeader("Textures")) {
+                static int budgetMB = (int)(textures.getBudget() / (1024 * 1024));
+                if (ImGui::SliderInt("Budget (MB)", &budgetMB, 1, 512)) {
+                    textures.setBudget((size_t)budgetMB * 1024 * 1024);
+                }
+                ImGui::Text("Resident: %.2f MB, uploaded this frame: %.2f MB", textures.residentBytes() / (1024.0f * 1024.0f),
+                    textures.lastUploadBytes() / (1024.0f * 1024.0f));
+
+                for (const TextureInfo& texture : textures.getTextures()) {
+                    if (texture.target) {
+                        ImGui::Text("%s: %dx%d, mip %d (wants %d), %.2f MB", texture.name.c_str(),
+                            std::max(1, texture.width >> texture.residentLevel), std::max(1, texture.height >> texture.residentLevel),
+                            texture.residentLevel, texture.desiredLevel, texture.bytes / (1024.0f * 1024.0f));
+                    }
+                    else {
+                        ImGui::Text("%s: %.2f MB", texture.name.c_str(), texture.bytes / (1024.0f * 1024.0f));
+                    }
+                }
+            }
+
+            if (ImGui::CollapsingHeader("Sun")) {
+                ImGui::Checkbox("Enabled", &sunEnabled);
+                ImGui::SliderFloat3("Direction", glm::value_ptr(sunDirection), -1.0f, 1.0f);
+                ImGui::ColorEdit3("Sun Color", glm::value_ptr(sunColor));
+                ImGui::SliderFloat("Shadow distance", &shadows.shadowDistance, 5.0f, 200.0f);
+                ImGui::SliderFloat("Split lambda", &shadows.splitLambda, 0.0f, 1.0f);
+                ImGui::Combo("Filter", &shadows.filter, "Single tap\0PCF 3x3\0PCF 5x5\0");
+                ImGui::Checkbox("Show cascades", &shadows.showCascades);
+                for (int c = 0; c < shadows.getCascadeCount(); c++) {
+                    ImGui::Text("Cascade %d: to %.1f, %d / %zu cube casters%s", c, shadows.split(c), cascadeCasters[c],
+                        instances.size(), cascadeModel[c] ? " + model" : "");
+                }
+            }
+
+            if (ImGui::CollapsingHeader("Point Lights")) {
+                if (canShadowPointLights) {
+                    ImGui::Checkbox("Shadows", &pointShadowsEnabled);
+                }
+                ImGui::SliderInt("Extra lights", &extraLights, 0, MAX_POINT_LIGHTS);
+                ImGui::Checkbox("Animate", &animateLights);
+                ImGui::Text("Shadow cubes: %d / %d slots, %d rendered", pointShadows.requestedSlots(),
+                    pointShadows.slotCount(), pointShadows.renderedSlots());
+                ImGui::Text("VRAM: %.2f MB", pointShadows.videoMemory() / (1024.0f * 1024.0f));
+            }
+
+            if (canRenderHdr && ImGui::CollapsingHeader("HDR")) {
+                ImGui::Checkbox("Render in HDR", &hdrEnabled);
+                ImGui::Combo("Tone map", &hdr.toneMap, "Reinhard\0ACES\0");
+                ImGui::Checkbox("Auto exposure", &hdr.autoExposure);
+                ImGui::SliderFloat(hdr.autoExposure ? "Compensation (EV)" : "Exposure (EV)", &hdr.exposureCompensation, -8.0f, 8.0f);
+                ImGui::SliderFloat("Adaptation speed", &hdr.adaptationSpeed, 0.1f, 10.0f);
+                ImGui::Checkbox("Bloom", &bloomEnabled);
+                ImGui::SliderFloat("Bloom strength", &hdr.bloomStrength, 0.0f, 0.2f);
+                ImGui::SliderFloat("Bloom radius", &bloom.radius, 0.5f, 3.0f);
+            }
+
+            if (ImGui::CollapsingHeader("Ambient Occlusion")) {
+                ImGui::Checkbox("SSAO", &ssaoEnabled);
+                if (!hdrEnabled && antiAliasing != AA_FXAA) {
+                    ImGui::TextDisabled("Needs HDR or FXAA");
+                }
+                ImGui::SliderFloat("Radius", &ssao.radius, 0.1f, 4.0f);
+                ImGui::SliderFloat("Intensity", &ssao.intensity, 0.0f, 4.0f);
+                ImGui::SliderFloat("Bias", &ssao.bias, 0.0f, 0.5f);
+                ImGui::SliderFloat("Blur sharpness", &ssao.sharpness, 0.0f, 1000.0f);
+                float cost = 0.0f;
+                for (const char* name : { "AO depth", "HBAO", "AO blur X", "AO blur Y", "AO upsample" }) {
+                    cost += profiler.milliseconds(name);
+                }
+                ImGui::Text("Cost: %.3f ms", cost);
+            }
+
+            if (canCoarseShade && ImGui::CollapsingHeader("Coarse Shading")) {
+                ImGui::Checkbox("Coarse shading", &coarseEnabled);
+                if (!hdrEnabled || antiAliasing == AA_MSAA) {
+                    ImGui::TextDisabled("Needs HDR, without MSAA");
+                }
+                ImGui::SliderFloat("Contrast threshold", &coarse.contrastThreshold, 0.0f, 0.5f);
+                ImGui::SliderFloat("Motion scale (px)", &coarse.motionScale, 1.0f, 64.0f);
+                ImGui::Text("Shaded: %.1f %% of the pixels", coarse.shadedShare() * 100.0f);
+                float cost = 0.0f;
+                for (const char* name : { "Scene", "Coarse tiles", "Coarse classify", "Coarse shading", "Coarse resolve" }) {
+                    cost += profiler.milliseconds(name);
+                }
+                ImGui::Text("Scene and lighting: %.3f ms", cost);
+            }
+
+            if (ImGui::CollapsingHeader("Anti-Aliasing")) {
+                ImGui::Combo("Method", &antiAliasing, "None\0FXAA\0TAA\0MSAA 4x\0");
+                if ((antiAliasing == AA_TAA || antiAliasing == AA_MSAA) && !hdrEnabled) {
+                    ImGui::TextDisabled("Needs HDR");
+                }
+                ImGui::SliderFloat("TAA feedback", &taa.feedback, 0.5f, 0.98f);
+                // MSAA pays in the scene pass (4 samples per pixel), the others in a resolve pass.
+                ImGui::Text("Scene: %.3f ms", profiler.milliseconds("Scene"));
+                ImGui::Text("Resolve: %.3f ms", profiler.milliseconds("FXAA") + profiler.milliseconds("TAA") +
+                    profiler.milliseconds("MSAA resolve"));
+                ImGui::Text("History: %.2f MB", taa.videoMemory() / (1024.0f * 1024.0f));
+            }
+
+            if (ImGui::CollapsingHeader("Shaders")) {
+                ImGui::Text("%d variants, %d compiled on first use, %.1f ms compiling", shaders.variantCount(),
+                    shaders.lazyCompileCount(), shaders.compileTime());
+                ImGui::Text("Hot reload: %s%s", shaderReloader.watching() ? "inotify" : "polling",
+                    shaderReloader.parallelCompile() ? ", parallel compile" : "");
+                ImGui::Text("%d reloads (last %.1f ms), %d failed%s", shaderReloader.reloadCount(), shaderReloader.lastReloadTime(),
+                    shaderReloader.failureCount(), shaderReloader.busy() ? ", compiling..." : "");
+                for (const std::string& name : shaders.variantNames()) {
+                    ImGui::Text("%s", name.c_str());
+                }
+            }
+
+            if (ImGui::CollapsingHeader("Render Graph")) {
+                for (int p : graph.executionOrder()) {
+                    ImGui::Text("%s", graph.passName(p).c_str());
+                }
+                for (int p = 0; p < graph.passCount(); p++) {
+                    if (graph.isCulled(p)) {
+                        ImGui::TextDisabled("%s (culled)", graph.passName(p).c_str());
+                    }
+                }
+                ImGui::Text("Barriers: %d", graph.barrierCount());
+                ImGui::Text("Transients: %.2f MB in %d textures, %.2f MB", graph.transientMemory() / (1024.0f * 1024.0f),
+                    graph.physicalTextures(), graph.videoMemory() / (1024.0f * 1024.0f));
+            }
+
+            if (canScale && ImGui::CollapsingHeader("Dynamic Resolution")) {
+                ImGui::Checkbox("Enabled", &resolution.enabled);
+                ImGui::SliderFloat("GPU budget (ms)", &resolution.budget, 2.0f, 33.0f);
+                ImGui::SliderFloat("Min scale", &resolution.minScale, 0.25f, 1.0f);
+                ImGui::SliderFloat("Sharpness", &resolution.sharpness, 0.0f, 1.0f);
+                ImGui::Text("Scale: %.2f (%d x %d of %d x %d)", resolution.getScale(), renderWidth, renderHeight, g_width, g_height);
+                ImGui::Text("GPU: %.3f ms, upscale %.3f ms", profiler.total(), profiler.milliseconds("Upscale"));
+            }
+
+            if (ImGui::CollapsingHeader("Frame Pacing")) {
+                ImGui::Combo("Sync", &pacer.syncMode, "Off\0Vsync\0Adaptive vsync\0");
+                if (pacer.syncMode == SYNC_ADAPTIVE && !pacer.hasAdaptiveSync()) {
+                    ImGui::TextDisabled("Adaptive vsync unsupported, using vsync");
+                }
+                ImGui::SliderInt("Frames in flight", &pacer.maxFramesInFlight, 1, PACER_MAX_FRAMES_IN_FLIGHT);
+                ImGui::SliderFloat("FPS limit", &pacer.maxFps, 0.0f, 240.0f, pacer.maxFps > 0.0f ? "%.0f" : "Off");
+                ImGui::Text("Input to photon: ~%.1f ms (refresh %.1f ms)", pacer.latency(), pacer.refresh());
+                ImGui::Text("Waits: GPU %.2f ms, sleep %.2f ms, spin %.2f ms", pacer.fenceWait(), pacer.sleepTime(), pacer.spinTime());
+            }
+
+            if (ImGui::CollapsingHeader("GPU Timings")) {
+                for (int i = 0; i < profiler.scopeCount(); i++) {
+                    ImGui::Text("%s: %.3f ms", profiler.name(i).c_str(), profiler.milliseconds(i));
+                }
+                ImGui::Text("Total: %.3f ms", profiler.total());
+            }
+
+            if (hasModel && ImGui::CollapsingHeader("Model")) {
+                ImGui::Text("%s", argv[1]);
+                ImGui::Text("%u vertices, %u triangles", model.vertexCount(), model.triangleCount());
+                ImGui::Text("%u bytes per vertex (%s)", model.vertexStride(),
+                    model.vertexFormat() == MESH_VERTEX_FLOAT ? "float" : "quantized");
+                ImGui::Text("Loaded in %.2f ms", model.getLoadTime());
+
+                ImGui::SliderFloat("LOD error (px)", &lodThreshold, 0.25f, 16.0f, "%.2f", ImGuiSliderFlags_Logarithmic);
+                ImGui::SliderFloat("LOD hysteresis", &lodHysteresis, 0.0f, 1.0f);
+                ImGui::Checkbox("LOD cross-fade", &lodCrossFade);
+                ImGui::SliderInt("Force LOD", &forcedLod, -1, (int)model.getLods().size() - 1);
+                for (size_t i = 0; i < model.getLods().size(); i++) {
+                    ImGui::Text("%s LOD %zu: %u triangles, error %.5f, %u meshlets", (int)i == modelLod.current ? ">" : " ",
+                        i, model.triangleCount((int)i), model.getLods()[i].error, model.meshletCount((int)i));
+                }
+
+                if (canCullMeshlets) {
+                    ImGui::Checkbox("Meshlet culling", &meshletCulling);
+                    ImGui::Checkbox("Frustum", &culler.cullFrustum);
+                    ImGui::SameLine();
+                    ImGui::Checkbox("Backface cone", &culler.cullCone);
+                    ImGui::SameLine();
+                    ImGui::Checkbox("Occlusion", &culler.cullOcclusion);
+                    ImGui::Text("Visible: %u / %u meshlets, %u / %u triangles", culler.getVisibleMeshlets(),
+                        model.meshletCount(modelLod.current), culler.getVisibleTriangles(), model.triangleCount(modelLod.current));
+                }
+            }
+
             ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
             ImGui::End();
         }
 
-        // Cubes
-        shader.use();
-        shader.setVec3("lightPos", lightPos);
-        shader.setVec3("light.position", lightPos);
-        // shader.setVec3("light.direction", -0.2f, -1.0f, -0.3f);
-        shader.setVec3("light.ambient", lightColor * 0.2f);
-        shader.setVec3("light.diffuse", lightColor * 0.5f);
-        shader.setVec3("light.specular", lightColor);
-        shader.setFloat("light.constant", 1.0f);
-        shader.setFloat("light.linear", 0.09f);
-        shader.setFloat("light.quadratic", 0.032f);
+        bool fxaaEnabled = antiAliasing == AA_FXAA && canFxaa;
+        bool scaled = canScale && resolution.isScaling();
+        bool taaEnabled = antiAliasing == AA_TAA && canTaa && hdrEnabled;
+        bool msaaEnabled = antiAliasing == AA_MSAA && canMsaa && hdrEnabled;
+        bool coarseShading = coarseEnabled && canCoarseShade && hdrEnabled && !msaaEnabled;
 
-        // Material
-        shader.setFloat("material.shininess", 32.0f);
+        // Shader variants of this frame
+        std::vector<std::string> litKeys;
+        if (sunEnabled) {
+            litKeys.push_back("SUN_LIGHT");
+        }
+        if (pointShadowsEnabled) {
+            litKeys.push_back("POINT_SHADOWS");
+        }
+        if (taaEnabled) {
+            litKeys.push_back("MOTION_VECTORS");
+        }
+        if (coarseShading) {
+            litKeys.push_back("COARSE_SHADING");
+        }
+        std::vector<std::string> lightKeys;
+        for (const char* key : { "MOTION_VECTORS", "COARSE_SHADING" }) {
+            if (std::find(litKeys.begin(), litKeys.end(), key) != litKeys.end()) {
+                lightKeys.push_back(key);
+            }
+        }
+        Shader& shader = shaders.get("res/shaders/vertexShader.glsl", "res/shaders/fragmentShader.glsl", litKeys);
+        Shader& floorShader = shaders.get("res/shaders/vertexShader.glsl", "res/shaders/fsVirtual.glsl", litKeys);
+        Shader& decalShader = shaders.get("res/shaders/vertexShader.glsl", "res/shaders/fsDecal.glsl", litKeys);
+        Shader& lightShader = shaders.get("res/shaders/vertexShader.glsl", "res/shaders/fsLight.glsl", lightKeys);
+        litKeys.push_back("LOD_FADE");
+        Shader& fadeShader = hasModel ? shaders.get("res/shaders/vertexShader.glsl", "res/shaders/fragmentShader.glsl", litKeys) : shader;
+
+        // Lighting
+        frameBlock.lightPos = lightPos;
+        frameBlock.light.position = lightPos;
+        frameBlock.light.ambient = lightColor * 0.2f;
+        frameBlock.light.diffuse = lightColor * 0.5f;
+        frameBlock.light.specular = lightColor;
+        frameBlock.light.constant = 1.0f;
+        frameBlock.light.linear = 0.09f;
+        frameBlock.light.quadratic = 0.032f;
 
         // Transformation
-        glm::mat4 view = cam.getViewMatrix();
-        shader.setMat4("view", glm::value_ptr(view));
-        glm::mat4 projection = glm::perspective(glm::radians(cam.fov), (float)g_width / g_height, 0.1f, 1000.0f);
-        shader.setMat4("projection", glm::value_ptr(projection));
+        // With TAA the scene is drawn with a jittered projection. Culling, SSAO and the motion
+        // vectors use the plain one.
+        cam.setPerspective((float)g_width / g_height, 0.1f, 1000.0f);
+        const CameraMatrices& cameraMatrices = cam.getMatrices();
+        glm::mat4 view = cameraMatrices.view;
+        glm::mat4 projection = cameraMatrices.projection;
+        glm::mat4 viewProjection = cameraMatrices.viewProjection;
+        glm::mat4 sceneProjection = taaEnabled ? taa.jitterProjection(projection, renderWidth, renderHeight) : projection;
+        frameBlock.view = view;
+        frameBlock.projection = sceneProjection;
+        frameBlock.currentViewProjection = viewProjection;
+        frameBlock.previousViewProjection = previousViewProjection;
+
+        // Directional light, in view space like the point light
+        if (glm::dot(sunDirection, sunDirection) < 1e-6f) {
+            sunDirection = glm::vec3(0.0f, -1.0f, 0.0f);
+        }
+        frameBlock.sun.direction = glm::mat3(view) * glm::normalize(sunDirection);
+        frameBlock.sun.ambient = sunColor * 0.1f;
+        frameBlock.sun.diffuse = sunColor;
+        frameBlock.sun.specular = sunColor;
+
+        // Point lights. The main light comes first, then the extra lights on a ring around the
+        // cubes by distance to the camera; the shadow atlas serves them in that order.
+        float pointRange = light_range(1.0f, 0.09f, 0.032f, 1.0f / 64.0f);
+        std::vector<int> byDistance(extraLights);
+        for (int i = 0; i < extraLights; i++) {
+            float angle = lightsAngle + glm::two_pi<float>() * i / extraLights;
+            glm::vec3 position = glm::vec3(0.0f, -2.5f, -6.0f) + 6.0f * glm::vec3(std::cos(angle), 0.0f, std::sin(angle));
+            glsl::PointLight& data = pointLightBlock.pointLights[i];
+            data.viewPosition = glm::vec4(glm::vec3(view * glm::vec4(position, 1.0f)), pointRange);
+            data.worldPosition = glm::vec4(position, 1.0f);
+            data.color = 0.5f + 0.5f * glm::cos(glm::two_pi<float>() * ((float)i / MAX_POINT_LIGHTS + glm::vec3(0.0f, 0.33f, 0.67f)));
+            byDistance[i] = i;
+        }
+        std::sort(byDistance.begin(), byDistance.end(), [&](int a, int b) {
+            return glm::length(glm::vec3(pointLightBlock.pointLights[a].worldPosition) - cam.position) <
+                   glm::length(glm::vec3(pointLightBlock.pointLights[b].worldPosition) - cam.position);
+        });
+
+        pointShadows.beginFrame();
+        pointShadowPasses.clear();
+        auto request_shadow = [&](int light, glm::vec3 position) {
+            int slot = pointShadowsEnabled ? pointShadows.request(light, position, pointRange) : -1;
+            if (slot >= 0 && pointShadows.needsRender(slot)) {
+                pointShadowPasses.push_back({ slot, position, 0, 0, false });
+            }
+            return slot;
+        };
+        int lightSlot = request_shadow(0, lightPos);
+        for (int i : byDistance) {
+            pointLightBlock.pointLights[i].shadowSlot = request_shadow(i + 1, glm::vec3(pointLightBlock.pointLights[i].worldPosition));
+        }
+        pointLightBlock.pointLightCount = extraLights;
+        glBindBuffer(GL_UNIFORM_BUFFER, pointLightBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(pointLightBlock), &pointLightBlock);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glBindBufferBase(GL_UNIFORM_BUFFER, POINT_LIGHT_BLOCK_BINDING, pointLightBuffer);
+
+        frameBlock.lightRange = pointRange;
+        frameBlock.lightShadowSlot = lightSlot;
+        frameBlock.decodeSrgb = hdrEnabled;
+        glBindBuffer(GL_UNIFORM_BUFFER, frameBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(frameBlock), &frameBlock);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BLOCK_BINDING, frameBuffer);
+
+        // Level of detail
+        if (hasModel) {
+            float distance = std::max(glm::length(modelPosition - cam.position) - modelRadius, 0.1f);
+            float pixelsPerUnit = TextureManager::screenSize(modelScale, distance, cam.fov, g_height);
+            int lod = forcedLod >= 0 ? forcedLod : model.selectLod(pixelsPerUnit, modelLod.current, lodThreshold, lodHysteresis);
+            if (lod != modelLod.current) {
+                pointShadows.invalidate(modelPosition, modelRadius);
+                modelLod.previous = lodCrossFade ? modelLod.current : -1;
+                modelLod.current = lod;
+                modelLod.fadeStart = currentTime;
+            }
+        }
+
+        // Texture residency
+        // A cube face maps the whole material texture, so the closest cube decides how many
+        // texels are worth keeping.
+        float closest = 1000.0f;
+        for (const InstanceData& instance : instances) {
+            closest = std::min(closest, glm::length(glm::vec3(instance.model[3]) - cam.position));
+        }
+        textures.requestSize(materials.textureHandle(), TextureManager::screenSize(1.0f, closest - CUBE_RADIUS, cam.fov, g_height));
+        textures.setTrackedBytes(atlasMemory, atlas.videoMemory());
+        textures.setTrackedBytes(floorMemory, floorTexture.videoMemory());
+        textures.setTrackedBytes(graphMemory, graph.videoMemory());
+        textures.setTrackedBytes(taaMemory, taa.videoMemory());
+        textures.update();
 
         // Light source object
         lightShader.use();
         lightShader.setVec3("color", lightColor);
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::mat4(1.0f);
-        model = glm::translate(model, lightPos);
-        model = glm::scale(model, glm::vec3(0.2f));
-        lightShader.setMat4("model", glm::value_ptr(model));
-        lightShader.setMat4("view", glm::value_ptr(view));
-        lightShader.setMat4("projection", glm::value_ptr(projection));
+        InstanceData lightData {};
+        lightData.model = glm::translate(glm::mat4(1.0f), lightPos);
+        lightData.model = glm::scale(lightData.model, glm::vec3(0.2f));
+        std::vector<InstanceData> lightMarkers(1 + extraLights, lightData);
+        for (int i = 0; i < extraLights; i++) {
+            lightMarkers[1 + i].model = glm::translate(glm::mat4(1.0f), glm::vec3(pointLightBlock.pointLights[i].worldPosition));
+            lightMarkers[1 + i].model = glm::scale(lightMarkers[1 + i].model, glm::vec3(0.1f));
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, lightInstance);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(InstanceData) * lightMarkers.size(), lightMarkers.data(), GL_STREAM_DRAW);
+
+        // The markers are the only objects that move, each gets the transform back to where it was.
+        std::vector<glm::mat4> markerMotion(lightMarkers.size(), glm::mat4(1.0f));
+        for (size_t i = 0; i < std::min(lightMarkers.size(), previousMarkers.size()); i++) {
+            markerMotion[i] = previousMarkers[i] * glm::inverse(lightMarkers[i].model);
+        }
+        previousMarkers.resize(lightMarkers.size());
+        for (size_t i = 0; i < lightMarkers.size(); i++) {
+            previousMarkers[i] = lightMarkers[i].model;
+        }
 
 
         // Render
         //---------
-        glClearColor(clearColor.x, clearColor.y, clearColor.z, clearColor.w);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        // Render Cubes
-        shader.use();
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, diffuseMap);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, specularMap);
-
-        glBindVertexArray(vaoCube);
-        for (int i = 0; i < 10; i++) {
-            model = glm::mat4(1.0f);
-            model = glm::translate(model, cubePositions[i]);
-            float angle = 20.0f * i;
-            model = glm::rotate(model, glm::radians(angle), glm::vec3(1.0f, 0.3, 0.5));
-            shader.setMat4("model", glm::value_ptr(model));
+        atlas.update();
+        if (!atlas.takeMoved().empty()) {
+            build_decals(decalVertices, atlas, atlasImages);
+            glBindBuffer(GL_ARRAY_BUFFER, vboDecal);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * decalVertices.size(), decalVertices.data());
+        }
 
+        // Shadow maps. Each cascade and cube only draws the casters that can reach it, so the cost
+        // follows the casters near the camera and the lights rather than the size of the scene.
+        shadowCasters.clear();
+        if (sunEnabled) {
+            shadows.update(view, cam.fov, (float)g_width / g_height, 0.1f, sunDirection);
+
+            for (int c = 0; c < shadows.getCascadeCount(); c++) {
+                cascadeFirst[c] = (int)shadowCasters.size();
+                for (const InstanceData& instance : instances) {
+                    if (shadows.casts(c, glm::vec3(instance.model[3]), CUBE_RADIUS)) {
+                        shadowCasters.push_back(instance);
+                    }
+                }
+                cascadeCasters[c] = (int)shadowCasters.size() - cascadeFirst[c];
+                cascadeModel[c] = hasModel && shadows.casts(c, modelPosition, modelRadius);
+            }
+        }
+        for (PointShadowPass& pass : pointShadowPasses) {
+            pass.firstCaster = (int)shadowCasters.size();
+            for (const InstanceData& instance : instances) {
+                if (glm::length(glm::vec3(instance.model[3]) - pass.position) < pointRange + CUBE_RADIUS) {
+                    shadowCasters.push_back(instance);
+                }
+            }
+            pass.casterCount = (int)shadowCasters.size() - pass.firstCaster;
+            pass.model = hasModel && glm::length(modelPosition - pass.position) < pointRange + modelRadius;
+        }
+        if (!shadowCasters.empty()) {
+            glBindBuffer(GL_ARRAY_BUFFER, shadowInstances);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(InstanceData) * shadowCasters.size(), shadowCasters.data(), GL_STREAM_DRAW);
+        }
+
+        graph.reset();
+        int backbuffer = graph.importTexture("Backbuffer", 0, { g_width, g_height, GL_RGBA8 });
+        graph.output(backbuffer);
+        int output = scaled ? graph.createTexture("Scaled color", { renderWidth, renderHeight, GL_RGBA8 }) : backbuffer;
+        int cascadeMaps = graph.importTexture("Cascaded shadow map", shadows.getTexture(), {});
+        int cubeMaps = graph.importTexture("Point shadow maps", pointShadows.getTexture(), {});
+
+        int pass = graph.addPass("Shadows", [&]() {
+            if (sunEnabled) {
+                shadowShader.use();
+                for (int c = 0; c < shadows.getCascadeCount(); c++) {
+                    shadows.begin(c);
+                    shadowShader.setMat4("lightViewProjection", glm::value_ptr(shadows.matrix(c)));
+                    glBindVertexArray(vaoShadowCube);
+                    cube_decode(shadowShader, true);
+                    glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 36, cascadeCasters[c], cascadeFirst[c]);
+                    cube_decode(shadowShader, false);
+                    if (cascadeModel[c]) {
+                        model.draw(shadowShader, 1, modelLod.current);
+                    }
+                    shadows.end();
+                }
+                shadows.bind();
+            }
+
+            // All six faces of a cube in one draw, the geometry shader routes triangles to faces.
+            if (!pointShadowPasses.empty()) {
+                pointShadowShader.use();
+                for (const PointShadowPass& pass : pointShadowPasses) {
+                    pointShadows.begin(pass.slot, pointShadowShader);
+                    glBindVertexArray(vaoShadowCube);
+                    cube_decode(pointShadowShader, true);
+                    glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 36, pass.casterCount, pass.firstCaster);
+                    cube_decode(pointShadowShader, false);
+                    if (pass.model) {
+                        model.draw(pointShadowShader, 1, modelLod.current);
+                    }
+                    pointShadows.end(pass.slot);
+                }
+            }
+            if (pointShadowsEnabled) {
+                pointShadows.bind();
+            }
+        });
+        graph.write(pass, cascadeMaps, ACCESS_CUSTOM);
+        graph.write(pass, cubeMaps, ACCESS_CUSTOM);
+
+        // Virtual texture feedback, read back asynchronously and consumed by update()
+        graph.addPass("Texture feedback", [&]() {
+            feedbackShader.use();
+            floorTexture.beginFeedback(g_width, g_height);
+            floorTexture.bind(feedbackShader, 1, 2, true);
+            glBindVertexArray(vaoFloor);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+            floorTexture.endFeedback();
+            floorTexture.update();
+        }, true);
+
+        // The scene goes to the output directly unless something post processes it. The output is
+        // the backbuffer, or the scaled image to upscale.
+        int sceneColor = output;
+        int sceneDepth = -1;
+        if (hdrEnabled || fxaaEnabled) {
+            sceneColor = graph.createTexture("Scene color", { renderWidth, renderHeight, hdrEnabled ? (GLenum)GL_RGBA16F : (GLenum)GL_RGBA8 });
+        }
+        if (sceneColor != backbuffer) {
+            sceneDepth = graph.createTexture("Scene depth", { renderWidth, renderHeight, GL_DEPTH_COMPONENT32F });
+        }
+        int sceneAmbient = -1;
+        if (sceneDepth >= 0 && ssaoEnabled) {
+            sceneAmbient = graph.createTexture("Scene ambient", { renderWidth, renderHeight, GL_R11F_G11F_B10F });
+        }
+        int sceneVelocity = -1;
+        if (taaEnabled) {
+            sceneVelocity = graph.createTexture("Scene velocity", { renderWidth, renderHeight, GL_RG16F });
+        }
+        // With coarse shading the scene color holds the diffuse color and shininess until the
+        // coarse passes light it, and the ambient light is written by them.
+        int sceneNormal = -1, sceneSpecular = -1;
+        if (coarseShading) {
+            sceneNormal = graph.createTexture("Scene normal", { renderWidth, renderHeight, GL_RGBA16F });
+            sceneSpecular = graph.createTexture("Scene specular", { renderWidth, renderHeight, GL_RGBA8 });
+        }
+
+        // With MSAA the scene is drawn into multisampled copies, resolved before anything reads it.
+        int drawColor = sceneColor, drawDepth = sceneDepth, drawAmbient = sceneAmbient;
+        if (msaaEnabled) {
+            drawColor = graph.createTexture("Scene color MSAA", { renderWidth, renderHeight, GL_RGBA16F, MSAA_SAMPLES });
+            drawDepth = graph.createTexture("Scene depth MSAA", { renderWidth, renderHeight, GL_DEPTH_COMPONENT32F, MSAA_SAMPLES });
+            if (sceneAmbient >= 0) {
+                drawAmbient = graph.createTexture("Scene ambient MSAA", { renderWidth, renderHeight, GL_R11F_G11F_B10F, MSAA_SAMPLES });
+            }
+        }
+        pass = graph.addPass("Scene", [&]() {
+            glClearColor(clearColor.x, clearColor.y, clearColor.z, clearColor.w);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            // Render Cubes
+            shader.use();
+            materials.bind(0);
+
+            glBindVertexArray(vaoCube);
+            cube_decode(shader, true);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+            glDrawArraysIndirect(GL_TRIANGLES, nullptr);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            cube_decode(shader, false);
+
+            // Model, dithered between the old and new level while a switch fades
+            if (hasModel) {
+                // Only the current level counts towards the culling statistics.
+                auto draw_model = [&](Shader& program, int lod) {
+                    if (meshletCulling) {
+                        culler.cull(model, lod, modelData.model, cameraMatrices.frustum, cam.position, lod == modelLod.current);
+                        program.use();
+                        model.drawMeshlets(program, lod);
+                    }
+                    else {
+                        program.use();
+                        model.draw(program, 1, lod);
+                    }
+                };
+
+                float fade = (currentTime - modelLod.fadeStart) / LOD_FADE_TIME;
+                if (modelLod.previous >= 0 && fade < 1.0f) {
+                    fadeShader.use();
+                    fadeShader.setFloat("lodFade", fade);
+                    fadeShader.setInt("lodFadeOut", 0);
+                    draw_model(fadeShader, modelLod.current);
+                    fadeShader.setInt("lodFadeOut", 1);
+                    draw_model(fadeShader, modelLod.previous);
+                }
+                else {
+                    modelLod.previous = -1;
+                    draw_model(shader, modelLod.current);
+                }
+            }
+
+            // Render floor
+            floorShader.use();
+            floorTexture.bind(floorShader, 1, 2, false);
+            glBindVertexArray(vaoFloor);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+
+            // Render decals, each from the atlas page its image lives on
+            decalShader.use();
+            glBindVertexArray(vaoDecal);
+            glEnable(GL_POLYGON_OFFSET_FILL);
+            glPolygonOffset(-1.0f, -1.0f);
+            glActiveTexture(GL_TEXTURE1);
+            for (size_t i = 0; i < atlasImages.size(); i++) {
+                if (atlasImages[i] >= 0) {
+                    glBindTexture(GL_TEXTURE_2D, atlas.pageTexture(atlas.region(atlasImages[i]).page));
+                    glDrawArrays(GL_TRIANGLES, (GLint)(i * 6), 6);
+                }
+            }
+            glActiveTexture(GL_TEXTURE0);
+            glDisable(GL_POLYGON_OFFSET_FILL);
+
+            // Render light source objects
+            lightShader.use();
+            glBindVertexArray(vaoLight);
+            cube_decode(lightShader, true);
+            lightShader.setMat4("previousTransform", glm::value_ptr(markerMotion[0]));
             glDrawArrays(GL_TRIANGLES, 0, 36);
+            for (int i = 0; i < extraLights; i++) {
+                lightShader.setVec3("color", pointLightBlock.pointLights[i].color);
+                lightShader.setMat4("previousTransform", glm::value_ptr(markerMotion[1 + i]));
+                glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 36, 1, 1 + i);
+            }
+            cube_decode(lightShader, false);
+        });
+        graph.read(pass, cascadeMaps, ACCESS_SAMPLED);
+        graph.read(pass, cubeMaps, ACCESS_SAMPLED);
+        graph.write(pass, drawColor, ACCESS_TARGET, 0);
+        if (drawDepth >= 0) {
+            graph.write(pass, drawDepth, ACCESS_TARGET);
+        }
+        if (coarseShading) {
+            graph.write(pass, sceneNormal, ACCESS_TARGET, 1);
+            graph.write(pass, sceneSpecular, ACCESS_TARGET, 3);
+        }
+        else if (drawAmbient >= 0) {
+            graph.write(pass, drawAmbient, ACCESS_TARGET, 1);
+        }
+        if (sceneVelocity >= 0) {
+            graph.write(pass, sceneVelocity, ACCESS_TARGET, 2);
+        }
+        if (msaaEnabled) {
+            msaa.addPass(graph, drawColor, drawAmbient, drawDepth, sceneColor, sceneAmbient, sceneDepth);
+        }
+        if (coarseShading) {
+            coarse.addPasses(graph, sceneColor, sceneNormal, sceneSpecular, sceneDepth, sceneAmbient, view,
+                sceneProjection, sunEnabled, pointShadowsEnabled);
         }
 
-        // Render light source object
-        lightShader.use();
-        glBindVertexArray(vaoLight);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        // Depth pyramid for next frame's meshlet occlusion test, copied from the resolved depth.
+        if (meshletCulling) {
+            pass = graph.addPass("Depth pyramid", [&]() {
+                culler.endFrame(renderWidth, renderHeight, viewProjection);
+            }, true);
+            graph.read(pass, sceneDepth >= 0 ? sceneDepth : backbuffer, ACCESS_TARGET);
+        }
+
+        if (sceneAmbient >= 0) {
+            ssao.addPasses(graph, sceneDepth, sceneAmbient, sceneColor, projection);
+        }
+        if (taaEnabled) {
+            sceneColor = taa.addPass(graph, sceneColor, sceneVelocity, sceneDepth);
+        }
+
+        // Post processing. Bloom is always declared, and culled when the tone map does not use it.
+        if (hdrEnabled) {
+            int resolved = fxaaEnabled ? graph.createTexture("LDR color", { renderWidth, renderHeight, GL_RGBA8 }) : output;
+            int bloomTexture = bloom.addPasses(graph, sceneColor);
+            hdr.addPasses(graph, sceneColor, bloomEnabled ? bloomTexture : -1, resolved, g_deltaTime);
+            if (fxaaEnabled) {
+                fxaa.addPass(graph, resolved, output);
+            }
+        }
+        else if (fxaaEnabled) {
+            fxaa.addPass(graph, sceneColor, output);
+        }
+        if (scaled) {
+            resolution.addPass(graph, output, backbuffer);
+        }
+
+        if (graph.compile()) {
+            graph.execute(profiler);
+        }
+        glViewport(0, 0, g_width, g_height);
+        taa.endFrame();
+        previousViewProjection = viewProjection;
 
         // Render ImGui
+        int scope = profiler.begin("Dear ImGui");
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        profiler.end(scope);
+        profiler.endFrame();
 
         glfwSwapBuffers(window);
+        pacer.endFrame();
     }
 
     // Cleanup
     //---------
-    shader.clean();
+    shaderReloader.clean();
+    shaders.clean();
+    feedbackShader.clean();
+    shadowShader.clean();
+    pointShadowShader.clean();
+    shadows.clean();
+    pointShadows.clean();
+    hdr.clean();
+    bloom.clean();
+    fxaa.clean();
+    resolution.clean();
+    coarse.clean();
+    taa.clean();
+    msaa.clean();
+    ssao.clean();
+    graph.clean();
+    profiler.clean();
+    pacer.clean();
+    materials.clean();
+    floorTexture.clean();
+    textures.clean();
+    atlas.clean();
+    culler.clean();
+    model.clean();
+    glDeleteBuffers(1, &modelInstance);
+    glDeleteBuffers(1, &shadowInstances);
+    glDeleteBuffers(1, &pointLightBuffer);
+    glDeleteBuffers(1, &frameBuffer);
+    glDeleteBuffers(1, &indirectBuffer);
+    glDeleteBuffers(1, &floorInstance);
+    glDeleteBuffers(1, &lightInstance);
+    glDeleteBuffers(1, &cubeInstances);
+    glDeleteBuffers(1, &vboDecal);
+    glDeleteBuffers(1, &vboFloor);
     glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vaoDecal);
+    glDeleteVertexArrays(1, &vaoFloor);
     glDeleteVertexArrays(1, &vaoLight);
+    glDeleteVertexArrays(1, &vaoShadowCube);
     glDeleteVertexArrays(1, &vaoCube);
 
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
 
+    simulation.stop();
     glfwDestroyWindow(window);
     glfwTerminate();
 
@@ -399,7 +1278,7 @@ void mouse_callback(GLFWwindow* window, double xPos, double yPos) {
 	g_lastX = xPos;
 	g_lastY = yPos;
 
-	cam.mouseInput(xOffset, yOffset);
+	simulation.cursorMoved(xOffset, yOffset);
 }
 
 
@@ -412,46 +1291,166 @@ void mouse_callback(GLFWwindow* window, double xPos, double yPos) {
  * @return void
  */
 void scroll_callback(GLFWwindow* window, double xOffset, double yOffset) {
-	cam.zoom((float)yOffset);
+	simulation.scrolled((float)yOffset);
 }
 
 
 /**
- * @brief Load the texture image located at 'path'.
- * 
- * @param path Path to the texture.
- * @return GLuint [typedef unsigned int GLuint] - Texture ID.
+ * @brief Set up the per instance attributes (model matrix and material index) of a VAO.
+ *
+ * @param vao Target vertex array object.
+ * @param instanceBuffer Buffer holding an array of InstanceData.
+ * @return void
  */
-GLuint load_texture(const char* path) {
-    GLuint id;
-    glGenTextures(1, &id);
-
-    int width, height, nrComponents;
-    unsigned char* img = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (img) {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-        
-        glBindTexture(GL_TEXTURE_2D, id);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, img);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(img);
+void setup_instance_attributes(GLuint vao, GLuint instanceBuffer) {
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+    // mat4 takes four consecutive attribute locations, one per column.
+    for (GLuint i = 0; i < 4; i++) {
+        glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            (const void*)(offsetof(InstanceData, model) + sizeof(glm::vec4) * i));
+        glEnableVertexAttribArray(3 + i);
+        glVertexAttribDivisor(3 + i, 1);
     }
-    else {
-        std::cerr << "Failed to load texture: " << path << std::endl;
-        stbi_image_free(img);
+
+    glVertexAttribIPointer(7, 1, GL_UNSIGNED_INT, sizeof(InstanceData), (const void*)offsetof(InstanceData, material));
+    glEnableVertexAttribArray(7);
+    glVertexAttribDivisor(7, 1);
+
+    glBindVertexArray(0);
+}
+
+
+/**
+ * @brief Pack interleaved float vertices (position, normal, texture coordinates) into
+ * MeshVertexQuantized, like the quantized mesh formats: unorm16 positions relative to the
+ * bounds, GL_INT_2_10_10_10_REV normals and half float texture coordinates. The positions decode
+ * as offset + position * scale, through the positionOffset and positionScale uniforms. The cube's
+ * corners sit on its bounds, so they and its axis aligned normals and 0 / 1 texture coordinates
+ * are all exact.
+ *
+ * @param data Vertex data, eight floats per vertex.
+ * @param floatCount Number of floats.
+ * @param offset Output, the bounds minimum.
+ * @param scale Output, the bounds extent, 1 on degenerate axes.
+ * @return std::vector<MeshVertexQuantized> Packed vertices.
+ */
+std::vector<MeshVertexQuantized> quantize_cube_vertices(const float* data, size_t floatCount, glm::vec3& offset, glm::vec3& scale) {
+    std::vector<MeshVertexQuantized> vertices(floatCount / 8);
+
+    glm::vec3 lo(std::numeric_limits<float>::max());
+    glm::vec3 hi(-std::numeric_limits<float>::max());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        glm::vec3 p = glm::make_vec3(data + i * 8);
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+    offset = lo;
+    scale = glm::vec3(hi.x > lo.x ? hi.x - lo.x : 1.0f, hi.y > lo.y ? hi.y - lo.y : 1.0f, hi.z > lo.z ? hi.z - lo.z : 1.0f);
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const float* v = data + i * 8;
+        MeshVertexQuantized& q = vertices[i];
+        glm::vec3 p = glm::clamp((glm::make_vec3(v) - offset) / scale, 0.0f, 1.0f);
+        q.position[0] = (uint16_t)std::lround(p.x * 65535.0f);
+        q.position[1] = (uint16_t)std::lround(p.y * 65535.0f);
+        q.position[2] = (uint16_t)std::lround(p.z * 65535.0f);
+        q.position[3] = 0;
+        q.normal = glm::packSnorm3x10_1x2(glm::vec4(v[3], v[4], v[5], 0.0f));
+        q.uv = glm::packHalf2x16(glm::vec2(v[6], v[7]));
     }
 
-    return id;
-}
\ No newline at end of file
+    return vertices;
+}
+
+
+/**
+ * @brief Fill 'vertices' with one floor decal per atlas image, side by side behind the
+ * first container. Images that failed to load keep the decal's own texture coordinates and are
+ * not drawn.
+ *
+ * @param vertices Output vertex array, six vertices of decalData's layout per image.
+ * @param atlas Atlas the images live in.
+ * @param images Atlas handles, -1 for a missing image.
+ * @return void
+ */
+void build_decals(std::vector<float>& vertices, const TextureAtlas& atlas, const std::vector<int>& images) {
+    const size_t floats = std::size(decalData);
+    vertices.resize(floats * images.size());
+
+    for (size_t i = 0; i < images.size(); i++) {
+        float* decal = vertices.data() + i * floats;
+        std::copy(decalData, decalData + floats, decal);
+
+        float centerX = 2.0f * i - (images.size() - 1.0f);
+        for (size_t v = 0; v < floats; v += 8) {
+            decal[v + 0] = decal[v + 0] * 1.5f + centerX;
+            decal[v + 2] = decal[v + 2] * 1.5f - 8.0f;
+        }
+
+        if (images[i] >= 0) {
+            atlas.remapUVs(images[i], decal, 6, 8, 6);
+        }
+    }
+}
+
+
+/**
+ * @brief Fill 'instances' with 'count' cubes. The first ten are the classic cubePositions scene,
+ * the rest are scattered behind it with random rotations and materials. The random sequence is
+ * fixed, so increasing the count only appends cubes.
+ *
+ * @param instances Output instance array.
+ * @param count Number of cubes.
+ * @param materialCount Number of materials to pick from.
+ * @return void
+ */
+void build_cube_instances(std::vector<InstanceData>& instances, int count, int materialCount) {
+    instances.clear();
+    instances.reserve(count);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> spreadX(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> spreadY(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> spreadZ(-120.0f, -20.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+    std::uniform_int_distribution<int> material(0, materialCount - 1);
+
+    for (int i = 0; i < count; i++) {
+        InstanceData instance {};
+
+        if (i < 10) {
+            instance.model = glm::translate(glm::mat4(1.0f), cubePositions[i]);
+            instance.model = glm::rotate(instance.model, glm::radians(20.0f * i), glm::vec3(1.0f, 0.3, 0.5));
+            instance.material = 0;
+        }
+        else {
+            glm::vec3 position(spreadX(rng), spreadY(rng), spreadZ(rng));
+            instance.model = glm::translate(glm::mat4(1.0f), position);
+            instance.model = glm::rotate(instance.model, glm::radians(angle(rng)), glm::vec3(1.0f, 0.3, 0.5));
+            instance.material = (GLuint)material(rng);
+        }
+
+        instances.push_back(instance);
+    }
+}
+
+
+/**
+ * @brief Distance at which a point light's attenuation falls to 'cutoff', used as the range its
+ * shadow cube covers and beyond which it is not shaded.
+ *
+ * @param constant Constant attenuation term.
+ * @param linear Linear attenuation term.
+ * @param quadratic Quadratic attenuation term.
+ * @param cutoff Attenuation considered dark.
+ * @return float Range in world units.
+ */
+float light_range(float constant, float linear, float quadratic, float cutoff) {
+    float c = constant - 1.0f / cutoff;
+    if (quadratic <= 0.0f) {
+        return linear > 0.0f ? -c / linear : 1000.0f;
+    }
+    return (-linear + std::sqrt(linear * linear - 4.0f * quadratic * c)) / (2.0f * quadratic);
+}
@@ -12,13 +12,43 @@
 #pragma once
 
 #include "main.hpp"
+#include "SceneData.hpp"
 #include "Shader.hpp"
+#include "ShaderBlocks.hpp"
+#include "ShaderCache.hpp"
+#include "ShaderReloader.hpp"
+#include "Simulation.hpp"
+#include "Ssao.hpp"
+#include "Bloom.hpp"
 #include "Camera.hpp"
+#include "CascadedShadowMap.hpp"
+#include "CoarseShading.hpp"
+#include "DynamicResolution.hpp"
+#include "FramePacer.hpp"
+#include "Fxaa.hpp"
+#include "GpuProfiler.hpp"
+#include "HdrPipeline.hpp"
+#include "Material.hpp"
+#include "Mesh.hpp"
+#include "MeshletCuller.hpp"
+#include "Msaa.hpp"
+#include "PointShadowAtlas.hpp"
+#include "RenderGraph.hpp"
+#include "Taa.hpp"
+#include "TextureAtlas.hpp"
+#include "TextureManager.hpp"
+#include "VirtualTexture.hpp"
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include "stb_image.h"
 #include <imgui.h>
@@ -27,49 +57,57 @@
 
 
 
-float cubeData[] = {
-    // Coords               // Normals              // Texture Coords
-    -0.5f, -0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    0.0f, 0.0f,
-     0.5f, -0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    1.0f, 0.0f,
-     0.5f,  0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    1.0f, 1.0f,
-     0.5f,  0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    1.0f, 1.0f,
-    -0.5f,  0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    0.0f, 1.0f,
-    -0.5f, -0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    0.0f, 0.0f,
+// Per instance vertex attributes (locations 3 to 7 in vertexShader.glsl).
+struct InstanceData {
+    glm::mat4 model;
+    GLuint material;
+    GLuint padding[3];
+};
+
+// Layout of a single command in GL_DRAW_INDIRECT_BUFFER.
+struct DrawArraysIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint first;
+    GLuint baseInstance;
+};
 
-    -0.5f, -0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     0.0f, 0.0f,
-     0.5f, -0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     1.0f, 0.0f,
-     0.5f,  0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     1.0f, 1.0f,
-     0.5f,  0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     1.0f, 1.0f,
-    -0.5f,  0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     0.0f, 1.0f,
-    -0.5f, -0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     0.0f, 0.0f,
+// Uniform blocks of the lit shaders, laid out as glsl::PointLights and glsl::Frame (generated).
+constexpr int MAX_POINT_LIGHTS = 16;
+constexpr GLuint POINT_LIGHT_BLOCK_BINDING = glsl::PointLights::binding;
+constexpr GLuint FRAME_BLOCK_BINDING = glsl::Frame::binding;
+static_assert(sizeof(glsl::PointLights::pointLights) / sizeof(glsl::PointLight) == MAX_POINT_LIGHTS,
+              "MAX_POINT_LIGHTS must match the array size of the PointLights block");
 
-    -0.5f,  0.5f,  0.5f,    -1.0f,  0.0f,  0.0f,    1.0f, 0.0f,
-    -0.5f,  0.5f, -0.5f,    -1.0f,  0.0f,  0.0f,    1.0f, 1.0f,
-    -0.5f, -0.5f, -0.5f,    -1.0f,  0.0f,  0.0f,    0.0f, 1.0f,
-    -0.5f, -0.5f, -0.5f,    -1.0f,  0.0f,  0.0f,    0.0f, 1.0f,
-    -0.5f, -0.5f,  0.5f,    -1.0f,  0.0f,  0.0f,    0.0f, 0.0f,
-    -0.5f,  0.5f,  0.5f,    -1.0f,  0.0f,  0.0f,    1.0f, 0.0f,
+// A point light shadow cube to render this frame, and its range of casters in the shadow
+// instance buffer.
+struct PointShadowPass {
+    int slot;
+    glm::vec3 position;
+    int firstCaster;
+    int casterCount;
+    bool model;
+};
+
+// Anti-aliasing of the scene, picked in the settings window. TAA and MSAA need the HDR path.
+enum AntiAliasing : int {
+    AA_NONE = 0,
+    AA_FXAA = 1,
+    AA_TAA = 2,
+    AA_MSAA = 3
+};
 
-     0.5f,  0.5f,  0.5f,     1.0f,  0.0f,  0.0f,    1.0f, 0.0f,
-     0.5f,  0.5f, -0.5f,     1.0f,  0.0f,  0.0f,    1.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,     1.0f,  0.0f,  0.0f,    0.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,     1.0f,  0.0f,  0.0f,    0.0f, 1.0f,
-     0.5f, -0.5f,  0.5f,     1.0f,  0.0f,  0.0f,    0.0f, 0.0f,
-     0.5f,  0.5f,  0.5f,     1.0f,  0.0f,  0.0f,    1.0f, 0.0f,
+// Bounding sphere radius of a unit cube.
+constexpr float CUBE_RADIUS = 0.87f;
 
-    -0.5f, -0.5f, -0.5f,     0.0f, -1.0f,  0.0f,    0.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,     0.0f, -1.0f,  0.0f,    1.0f, 1.0f,
-     0.5f, -0.5f,  0.5f,     0.0f, -1.0f,  0.0f,    1.0f, 0.0f,
-     0.5f, -0.5f,  0.5f,     0.0f, -1.0f,  0.0f,    1.0f, 0.0f,
-    -0.5f, -0.5f,  0.5f,     0.0f, -1.0f,  0.0f,    0.0f, 0.0f,
-    -0.5f, -0.5f, -0.5f,     0.0f, -1.0f,  0.0f,    0.0f, 1.0f,
+// Seconds a level of detail switch takes to cross-fade.
+constexpr float LOD_FADE_TIME = 0.25f;
 
-    -0.5f,  0.5f, -0.5f,     0.0f,  1.0f,  0.0f,    0.0f, 1.0f,
-     0.5f,  0.5f, -0.5f,     0.0f,  1.0f,  0.0f,    1.0f, 1.0f,
-     0.5f,  0.5f,  0.5f,     0.0f,  1.0f,  0.0f,    1.0f, 0.0f,
-     0.5f,  0.5f,  0.5f,     0.0f,  1.0f,  0.0f,    1.0f, 0.0f,
-    -0.5f,  0.5f,  0.5f,     0.0f,  1.0f,  0.0f,    0.0f, 0.0f,
-    -0.5f,  0.5f, -0.5f,     0.0f,  1.0f,  0.0f,    0.0f, 1.0f
+// Level of detail of an object, and the level it is fading out from (-1 if none).
+struct LodState {
+    int current = 0;
+    int previous = -1;
+    float fadeStart = 0.0f;
 };
 
 
@@ -79,4 +117,8 @@ void mouse_callback(GLFWwindow* window, double xPos, double yPos);
 void scroll_callback(GLFWwindow* window, double xOffset, double yOffset);
 void framebuffersize_callback(GLFWwindow* window, int width, int height);
 
-GLuint load_texture(const char* path);
+void setup_instance_attributes(GLuint vao, GLuint instanceBuffer);
+std::vector<MeshVertexQuantized> quantize_cube_vertices(const float* data, size_t floatCount, glm::vec3& offset, glm::vec3& scale);
+void build_decals(std::vector<float>& vertices, const TextureAtlas& atlas, const std::vector<int>& images);
+void build_cube_instances(std::vector<InstanceData>& instances, int count, int materialCount);
+float light_range(float constant, float linear, float quadratic, float cutoff);
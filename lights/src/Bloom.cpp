@@ -0,0 +1,90 @@
+/**
+ * @file Bloom.cpp
+ * @author Rohan Siddhu
+ * @brief Bloom class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Bloom.hpp"
+#include <algorithm>
+#include <string>
+
+bool Bloom::init() {
+    downsampleProgram.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    downsampleProgram.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsBloomDownsample.glsl");
+    downsampleProgram.createProgram();
+    upsampleProgram.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    upsampleProgram.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsBloomUpsample.glsl");
+    upsampleProgram.createProgram();
+    glGenVertexArrays(1, &emptyVao);
+    return true;
+}
+
+/**
+ * @brief Declare the passes of the chain. The scene is filtered down level by level, then each
+ * level is filtered up and added onto the next larger one in place, so the chain is all the memory
+ * bloom needs. The levels are transients and only live until the tone map pass has read level 0.
+ *
+ * @param graph Graph of the frame.
+ * @param scene HDR scene color.
+ * @return int Level 0, half the scene's resolution. The passes are culled if nothing reads it.
+ */
+int Bloom::addPasses(RenderGraph& graph, int scene) {
+    int levels[BLOOM_LEVELS];
+    RenderTextureDesc desc = graph.desc(scene);
+    for (int i = 0; i < BLOOM_LEVELS; i++) {
+        desc.width = std::max(desc.width / 2, 1);
+        desc.height = std::max(desc.height / 2, 1);
+        desc.format = GL_R11F_G11F_B10F;
+        levels[i] = graph.createTexture(("Bloom " + std::to_string(i)).c_str(), desc);
+    }
+
+    for (int i = 0; i < BLOOM_LEVELS; i++) {
+        int source = i == 0 ? scene : levels[i - 1];
+        int pass = graph.addPass(("Bloom downsample " + std::to_string(i)).c_str(), [this, &graph, source, i]() {
+            const RenderTextureDesc& size = graph.desc(source);
+            glDisable(GL_DEPTH_TEST);
+            downsampleProgram.use();
+            downsampleProgram.setVec2("texelSize", glm::vec2(1.0f / size.width, 1.0f / size.height));
+            downsampleProgram.setInt("karisAverage", i == 0);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, graph.texture(source));
+            glBindVertexArray(emptyVao);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            glEnable(GL_DEPTH_TEST);
+        });
+        graph.read(pass, source, ACCESS_SAMPLED);
+        graph.write(pass, levels[i], ACCESS_TARGET);
+    }
+
+    for (int i = BLOOM_LEVELS - 2; i >= 0; i--) {
+        int source = levels[i + 1];
+        int pass = graph.addPass(("Bloom upsample " + std::to_string(i)).c_str(), [this, &graph, source]() {
+            const RenderTextureDesc& size = graph.desc(source);
+            glDisable(GL_DEPTH_TEST);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE);
+            upsampleProgram.use();
+            upsampleProgram.setVec2("texelSize", glm::vec2(1.0f / size.width, 1.0f / size.height));
+            upsampleProgram.setFloat("radius", radius);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, graph.texture(source));
+            glBindVertexArray(emptyVao);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            glDisable(GL_BLEND);
+            glEnable(GL_DEPTH_TEST);
+        });
+        graph.read(pass, source, ACCESS_SAMPLED);
+        graph.read(pass, levels[i], ACCESS_TARGET);
+        graph.write(pass, levels[i], ACCESS_TARGET);
+    }
+    return levels[0];
+}
+
+void Bloom::clean() {
+    downsampleProgram.clean();
+    upsampleProgram.clean();
+    glDeleteVertexArrays(1, &emptyVao);
+    emptyVao = 0;
+}
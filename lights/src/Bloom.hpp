@@ -0,0 +1,29 @@
+/**
+ * @file Bloom.hpp
+ * @author Rohan Siddhu
+ * @brief Threshold free bloom from a mip chain of the HDR scene, as render graph passes.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "RenderGraph.hpp"
+#include "Shader.hpp"
+#include <glad/glad.h>
+
+// Levels of the chain, the first at half the scene's resolution.
+constexpr int BLOOM_LEVELS = 5;
+
+class Bloom {
+private:
+    Shader downsampleProgram;
+    Shader upsampleProgram;
+    GLuint emptyVao = 0;
+public:
+    float radius = 1.0f;    /** Upsample filter radius, in texels of the smaller level. */
+
+    bool init();
+    int addPasses(RenderGraph& graph, int scene);
+    void clean();
+};
@@ -7,35 +7,196 @@
  */
 
 #include "Camera.hpp"
+#include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CAMERA_SSE2 1
+#endif
 
-glm::mat4 Camera::getViewMatrix() {
-#ifdef CUSTOM_LOOK_AT_MATRIX
-    glm::vec3 zAxis = glm::normalize(-front);
-    glm::vec3 xAxis = glm::normalize(glm::cross(glm::normalize(worldUp), zAxis));
-    glm::vec3 yAxis = glm::normalize(glm::cross(zAxis, xAxis));
-    
-    glm::mat4 translation = glm::mat4(1.0f); // Identity matrix by default
-    translation[3][0] = -position.x; // Third column, first row
-    translation[3][1] = -position.y;
-    translation[3][2] = -position.z;
-    glm::mat4 rotation = glm::mat4(1.0f);
-    rotation[0][0] = xAxis.x; // First column, first row
-    rotation[1][0] = xAxis.y;
-    rotation[2][0] = xAxis.z;
-    rotation[0][1] = yAxis.x; // First column, second row
-    rotation[1][1] = yAxis.y;
-    rotation[2][1] = yAxis.z;
-    rotation[0][2] = zAxis.x; // First column, third row
-    rotation[1][2] = zAxis.y;
-    rotation[2][2] = zAxis.z;
+#ifdef CAMERA_SSE2
+static __m128 load_vec3(glm::vec3 v) {
+    return _mm_set_ps(0.0f, v.z, v.y, v.x);
+}
 
-    return rotation * translation;
-#else 
-    return glm::lookAt(position, position + front, up);
+// Dot product of the xyz lanes, in every lane.
+static __m128 dot3(__m128 a, __m128 b) {
+    __m128 m = _mm_mul_ps(a, b);
+    __m128 x = _mm_shuffle_ps(m, m, _MM_SHUFFLE(0, 0, 0, 0));
+    __m128 y = _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 z = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2));
+    return _mm_add_ps(_mm_add_ps(x, y), z);
+}
+
+static __m128 cross3(__m128 a, __m128 b) {
+    __m128 aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+    return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+// The estimate of rsqrtps refined by a Newton step, about as exact as sqrt and div and much
+// shorter on the dependency chain of the camera basis.
+static __m128 normalize3(__m128 v) {
+    __m128 squared = dot3(v, v);
+    __m128 estimate = _mm_rsqrt_ps(squared);
+    __m128 halfSquared = _mm_mul_ps(squared, _mm_set1_ps(0.5f));
+    __m128 inverse = _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfSquared, _mm_mul_ps(estimate, estimate))));
+    return _mm_mul_ps(v, inverse);
+}
+
+// a * b, column major as glm.
+static void multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& result) {
+    __m128 columns[4];
+    for (int i = 0; i < 4; i++) {
+        columns[i] = _mm_loadu_ps(&a[i][0]);
+    }
+    for (int j = 0; j < 4; j++) {
+        __m128 column = _mm_mul_ps(columns[0], _mm_set1_ps(b[j][0]));
+        column = _mm_add_ps(column, _mm_mul_ps(columns[1], _mm_set1_ps(b[j][1])));
+        column = _mm_add_ps(column, _mm_mul_ps(columns[2], _mm_set1_ps(b[j][2])));
+        column = _mm_add_ps(column, _mm_mul_ps(columns[3], _mm_set1_ps(b[j][3])));
+        _mm_storeu_ps(&result[j][0], column);
+    }
+}
+
+// Planes of the view frustum (Gribb / Hartmann) from the rows of the view projection, normalized
+// so distances are in world units.
+static void frustum_planes(const glm::mat4& viewProjection, glm::vec4 planes[6]) {
+    __m128 r0 = _mm_loadu_ps(&viewProjection[0][0]);
+    __m128 r1 = _mm_loadu_ps(&viewProjection[1][0]);
+    __m128 r2 = _mm_loadu_ps(&viewProjection[2][0]);
+    __m128 r3 = _mm_loadu_ps(&viewProjection[3][0]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    __m128 unnormalized[6] = { _mm_add_ps(r3, r0), _mm_sub_ps(r3, r0), _mm_add_ps(r3, r1),
+                               _mm_sub_ps(r3, r1), _mm_add_ps(r3, r2), _mm_sub_ps(r3, r2) };
+    for (int i = 0; i < 6; i++) {
+        _mm_storeu_ps(&planes[i][0], normalize3(unnormalized[i]));
+    }
+}
+#else
+static void multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& result) {
+    result = a * b;
+}
+
+static void frustum_planes(const glm::mat4& viewProjection, glm::vec4 planes[6]) {
+    glm::mat4 m = glm::transpose(viewProjection);
+    planes[0] = m[3] + m[0];
+    planes[1] = m[3] - m[0];
+    planes[2] = m[3] + m[1];
+    planes[3] = m[3] - m[1];
+    planes[4] = m[3] + m[2];
+    planes[5] = m[3] - m[2];
+    for (int i = 0; i < 6; i++) {
+        planes[i] /= glm::length(glm::vec3(planes[i]));
+    }
+}
+#endif
+
+// View matrix and its inverse, from the camera basis. The view is a rotation and a translation,
+// so the inverse is the transposed rotation and the position, no general inverse is needed.
+static void view_matrices(glm::vec3 position, glm::vec3 front, glm::vec3 worldUp, glm::mat4& view, glm::mat4& inverse) {
+#ifdef CAMERA_SSE2
+    __m128 p = load_vec3(position);
+    __m128 zAxis = normalize3(_mm_sub_ps(_mm_setzero_ps(), load_vec3(front)));
+    __m128 xAxis = normalize3(cross3(load_vec3(worldUp), zAxis));
+    __m128 yAxis = cross3(zAxis, xAxis);
+
+    _mm_storeu_ps(&inverse[0][0], xAxis);
+    _mm_storeu_ps(&inverse[1][0], yAxis);
+    _mm_storeu_ps(&inverse[2][0], zAxis);
+    _mm_storeu_ps(&inverse[3][0], _mm_set_ps(1.0f, position.z, position.y, position.x));
+
+    // Rows x, y, z with the translation in w, transposed into columns
+    __m128 r0 = xAxis, r1 = yAxis, r2 = zAxis, r3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+    __m128 translation = _mm_sub_ps(_mm_setzero_ps(), _mm_unpacklo_ps(
+        _mm_unpacklo_ps(dot3(xAxis, p), dot3(zAxis, p)), _mm_unpacklo_ps(dot3(yAxis, p), _mm_setzero_ps())));
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(&view[0][0], r0);
+    _mm_storeu_ps(&view[1][0], r1);
+    _mm_storeu_ps(&view[2][0], r2);
+    _mm_storeu_ps(&view[3][0], _mm_add_ps(translation, _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f)));
+#else
+#ifdef CUSTOM_LOOK_AT_MATRIX
+    view = Camera::lookAtMatrix(position, front, worldUp);
+#else
+    view = glm::lookAt(position, position + front, worldUp);
+#endif
+    inverse = glm::mat4(glm::transpose(glm::mat3(view)));
+    inverse[3] = glm::vec4(position, 1.0f);
 #endif
 }
 
+// glm::perspective and its inverse. Only 5 entries are not 0, the inverse follows from them.
+static void projection_matrices(float fov, float aspect, float nearPlane, float farPlane, glm::mat4& projection,
+    glm::mat4& inverse) {
+    float f = 1.0f / std::tan(glm::radians(fov) * 0.5f);
+    float a = f / aspect;
+    float c = -(farPlane + nearPlane) / (farPlane - nearPlane);
+    float d = -(2.0f * farPlane * nearPlane) / (farPlane - nearPlane);
+
+    projection = glm::mat4(0.0f);
+    projection[0][0] = a;
+    projection[1][1] = f;
+    projection[2][2] = c;
+    projection[2][3] = -1.0f;
+    projection[3][2] = d;
+
+    inverse = glm::mat4(0.0f);
+    inverse[0][0] = 1.0f / a;
+    inverse[1][1] = 1.0f / f;
+    inverse[2][3] = 1.0f / d;
+    inverse[3][2] = -1.0f;
+    inverse[3][3] = c / d;
+}
+
+glm::mat4 Camera::getViewMatrix() const {
+    return getMatrices().view;
+}
+
+glm::mat4 Camera::getProjectionMatrix() const {
+    return getMatrices().projection;
+}
+
+/**
+ * @brief View and projection matrices with their products, inverses and frustum planes. Only the
+ * matrices whose inputs changed since the last call are rebuilt; an unchanged camera costs a few
+ * compares.
+ *
+ * @return const CameraMatrices& Matrices, valid until the camera changes.
+ */
+const CameraMatrices& Camera::getMatrices() const {
+    bool viewChanged = !viewValid || position != viewPosition || front != viewFront || worldUp != viewUp;
+    glm::vec4 params(fov, aspect, nearPlane, farPlane);
+    bool projectionChanged = !projectionValid || params != projectionParams;
+    if (!viewChanged && !projectionChanged) {
+        return matrices;
+    }
+
+    if (viewChanged) {
+        view_matrices(position, front, worldUp, matrices.view, matrices.inverseView);
+        viewPosition = position;
+        viewFront = front;
+        viewUp = worldUp;
+        viewValid = true;
+    }
+    if (projectionChanged) {
+        projection_matrices(fov, aspect, nearPlane, farPlane, matrices.projection, matrices.inverseProjection);
+        projectionParams = params;
+        projectionValid = true;
+    }
+    multiply(matrices.projection, matrices.view, matrices.viewProjection);
+    multiply(matrices.inverseView, matrices.inverseProjection, matrices.inverseViewProjection);
+    frustum_planes(matrices.viewProjection, matrices.frustum);
+    return matrices;
+}
+
+void Camera::setPerspective(float aspect, float nearPlane, float farPlane) {
+    this->aspect = aspect;
+    this->nearPlane = nearPlane;
+    this->farPlane = farPlane;
+}
+
 void Camera::keyInput(Command command, float deltaTime) {
     float speed = movementSpeed * deltaTime;
     if (command == Command::FORWARD) {
@@ -95,6 +256,45 @@ void Camera::zoom(float yOffset) {
 	}
 }
 
+void Camera::setPose(glm::vec3 position, float yaw, float pitch) {
+    this->position = position;
+    this->yaw = yaw;
+    this->pitch = pitch;
+    updateVectors();
+}
+
+/**
+ * @brief View matrix built from the camera basis with scalar math, as getViewMatrix() did before
+ * the matrices were cached. The fallback where SSE2 is not available.
+ *
+ * @param position Camera position.
+ * @param front Direction the camera looks in.
+ * @param worldUp Up direction of the world.
+ * @return glm::mat4 View matrix.
+ */
+glm::mat4 Camera::lookAtMatrix(glm::vec3 position, glm::vec3 front, glm::vec3 worldUp) {
+    glm::vec3 zAxis = glm::normalize(-front);
+    glm::vec3 xAxis = glm::normalize(glm::cross(glm::normalize(worldUp), zAxis));
+    glm::vec3 yAxis = glm::normalize(glm::cross(zAxis, xAxis));
+    
+    glm::mat4 translation = glm::mat4(1.0f); // Identity matrix by default
+    translation[3][0] = -position.x; // Third column, first row
+    translation[3][1] = -position.y;
+    translation[3][2] = -position.z;
+    glm::mat4 rotation = glm::mat4(1.0f);
+    rotation[0][0] = xAxis.x; // First column, first row
+    rotation[1][0] = xAxis.y;
+    rotation[2][0] = xAxis.z;
+    rotation[0][1] = yAxis.x; // First column, second row
+    rotation[1][1] = yAxis.y;
+    rotation[2][1] = yAxis.z;
+    rotation[0][2] = zAxis.x; // First column, third row
+    rotation[1][2] = zAxis.y;
+    rotation[2][2] = zAxis.z;
+
+    return rotation * translation;
+}
+
 
 /*
 * Private Methods
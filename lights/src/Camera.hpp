@@ -32,6 +32,20 @@ constexpr float DEFAULT_PITCH = -15.0f;
 constexpr float DEFAULT_MOVEMENT_SPEED = 2.0f;
 constexpr float DEFAULT_MOUSE_SENSITIVITY = 0.1f;
 constexpr float DEFAULT_FOV = 45.0f;
+constexpr float DEFAULT_ASPECT = 16.0f / 9.0f;
+constexpr float DEFAULT_NEAR_PLANE = 0.1f;
+constexpr float DEFAULT_FAR_PLANE = 1000.0f;
+
+// View and projection of the camera, with the products, inverses and frustum derived from them.
+struct CameraMatrices {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+    glm::mat4 inverseView;
+    glm::mat4 inverseProjection;
+    glm::mat4 inverseViewProjection;
+    glm::vec4 frustum[6];       /** World space planes: left, right, bottom, top, near, far. Normalized, positive inside. */
+};
 
 class Camera {
 public:
@@ -50,6 +64,21 @@ public:
     float movementSpeed;
     float mouseSensitivity;
     float fov;
+
+    // Projection, see setPerspective()
+    float aspect;
+    float nearPlane;
+    float farPlane;
+private:
+    // Matrices of the last getMatrices(), with the inputs they were built from. The attributes are
+    // public and written directly, so a change is found by comparing the inputs, not flagged.
+    mutable CameraMatrices matrices;
+    mutable glm::vec3 viewPosition { 0.0f };
+    mutable glm::vec3 viewFront { 0.0f };
+    mutable glm::vec3 viewUp { 0.0f };
+    mutable glm::vec4 projectionParams { 0.0f };    /** fov, aspect, near, far. */
+    mutable bool viewValid = false;
+    mutable bool projectionValid = false;
 public:
     // Constructor
     Camera(glm::vec3 position = glm::vec3(0.0f, 1.0f, 3.0f),
@@ -61,7 +90,10 @@ public:
         worldUp(glm::vec3(0.0f, 1.0f, 0.0f)),
         movementSpeed(DEFAULT_MOVEMENT_SPEED),
         mouseSensitivity(DEFAULT_MOUSE_SENSITIVITY),
-        fov(DEFAULT_FOV)
+        fov(DEFAULT_FOV),
+        aspect(DEFAULT_ASPECT),
+        nearPlane(DEFAULT_NEAR_PLANE),
+        farPlane(DEFAULT_FAR_PLANE)
     {
         this->position = position;
         this->up = up;
@@ -71,10 +103,16 @@ public:
     }
 
     // Methods
-    glm::mat4 getViewMatrix();
+    glm::mat4 getViewMatrix() const;
+    glm::mat4 getProjectionMatrix() const;
+    const CameraMatrices& getMatrices() const;
+    void setPerspective(float aspect, float nearPlane, float farPlane);
     void keyInput(Command command, float deltaTime = 1.0f);
     void mouseInput(float xOffset, float yOffset);
     void zoom(float yOffset);
+    void setPose(glm::vec3 position, float yaw, float pitch);
+
+    static glm::mat4 lookAtMatrix(glm::vec3 position, glm::vec3 front, glm::vec3 worldUp);
 private:
     void updateVectors();
 };
@@ -0,0 +1,195 @@
+/**
+ * @file CascadedShadowMap.cpp
+ * @author Rohan Siddhu
+ * @brief CascadedShadowMap class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "CascadedShadowMap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+/**
+ * @brief Create the depth texture array, one square layer per cascade, and the uniform buffer.
+ * The texture compares on lookup, so every tap of the filter is a bilinear 2 x 2 comparison.
+ *
+ * @param resolution Texels per side of a cascade.
+ * @param cascades Number of cascades, at most CSM_MAX_CASCADES.
+ * @return bool true on success.
+ */
+bool CascadedShadowMap::init(int resolution, int cascades) {
+    this->resolution = resolution;
+    cascadeCount = std::min(std::max(cascades, 1), CSM_MAX_CASCADES);
+
+    glGenTextures(1, &depthArray);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, depthArray);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_DEPTH_COMPONENT32F, resolution, resolution, cascadeCount);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    float border[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    GLint previous = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthArray, 0, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, previous);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Failed to create shadow map framebuffer" << std::endl;
+        return false;
+    }
+
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(glsl::Cascades), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return true;
+}
+
+/**
+ * @brief Fit the cascades to the camera. The view frustum up to shadowDistance is split between
+ * a logarithmic and a uniform distribution (splitLambda). Each cascade covers the bounding
+ * sphere of its slice, so its size does not change as the camera turns, and its origin is
+ * snapped to whole shadow map texels, so edges do not shimmer as the camera moves.
+ *
+ * @param view Camera view matrix.
+ * @param fov Vertical field of view in degrees.
+ * @param aspect Viewport width over height.
+ * @param nearPlane Camera near plane.
+ * @param lightDirection Direction the light travels, world space.
+ */
+void CascadedShadowMap::update(const glm::mat4& view, float fov, float aspect, float nearPlane, glm::vec3 lightDirection) {
+    glm::vec3 direction = glm::normalize(lightDirection);
+    glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    lightRotation = glm::lookAt(glm::vec3(0.0f), direction, up);
+
+    glm::mat4 cameraToWorld = glm::inverse(view);
+    float tanY = std::tan(glm::radians(fov) * 0.5f);
+    float tanX = tanY * aspect;
+    float farPlane = std::max(shadowDistance, nearPlane * 2.0f);
+
+    float previous = nearPlane;
+    for (int c = 0; c < cascadeCount; c++) {
+        float t = (float)(c + 1) / cascadeCount;
+        float logarithmic = nearPlane * std::pow(farPlane / nearPlane, t);
+        float uniform = nearPlane + (farPlane - nearPlane) * t;
+        float next = splitLambda * logarithmic + (1.0f - splitLambda) * uniform;
+
+        // Corners of the slice, world space.
+        glm::vec3 corners[8];
+        glm::vec3 center(0.0f);
+        for (int i = 0; i < 8; i++) {
+            float depth = i < 4 ? previous : next;
+            glm::vec3 corner((i & 1 ? 1.0f : -1.0f) * tanX * depth, (i & 2 ? 1.0f : -1.0f) * tanY * depth, -depth);
+            corners[i] = glm::vec3(cameraToWorld * glm::vec4(corner, 1.0f));
+            center += corners[i] / 8.0f;
+        }
+        float radius = 0.0f;
+        for (const glm::vec3& corner : corners) {
+            radius = std::max(radius, glm::length(corner - center));
+        }
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        // Light space box, origin snapped to the texel grid.
+        float texel = 2.0f * radius / resolution;
+        glm::vec3 lightCenter = glm::vec3(lightRotation * glm::vec4(center, 1.0f));
+        lightCenter.x = std::floor(lightCenter.x / texel) * texel;
+        lightCenter.y = std::floor(lightCenter.y / texel) * texel;
+        boundsMin[c] = lightCenter - glm::vec3(radius);
+        boundsMax[c] = lightCenter + glm::vec3(radius);
+
+        // Casters between the light and the near plane are clamped onto it (GL_DEPTH_CLAMP), so
+        // the depth range only has to cover the slice.
+        glm::mat4 projection = glm::ortho(boundsMin[c].x, boundsMax[c].x, boundsMin[c].y, boundsMax[c].y,
+            -boundsMax[c].z, -boundsMin[c].z);
+        viewProjections[c] = projection * lightRotation;
+
+        glm::mat4 toTexture = glm::translate(glm::mat4(1.0f), glm::vec3(0.5f));
+        toTexture = glm::scale(toTexture, glm::vec3(0.5f));
+        block.cascadeMatrices[c] = toTexture * viewProjections[c];
+        block.cascadeSplits[c] = next;
+        block.cascadeTexelSizes[c] = texel;
+        previous = next;
+    }
+    block.cascadeCount = cascadeCount;
+}
+
+/**
+ * @brief Whether a caster can throw a shadow into a cascade: its bounding sphere overlaps the
+ * cascade's light space box, or lies anywhere between the box and the light.
+ *
+ * @param cascade Cascade index.
+ * @param center Bounding sphere centre, world space.
+ * @param radius Bounding sphere radius.
+ * @return bool true if the caster has to be drawn into the cascade.
+ */
+bool CascadedShadowMap::casts(int cascade, glm::vec3 center, float radius) const {
+    glm::vec3 p = glm::vec3(lightRotation * glm::vec4(center, 1.0f));
+    return p.x + radius >= boundsMin[cascade].x && p.x - radius <= boundsMax[cascade].x &&
+           p.y + radius >= boundsMin[cascade].y && p.y - radius <= boundsMax[cascade].y &&
+           p.z + radius >= boundsMin[cascade].z;
+}
+
+/**
+ * @brief Start rendering depth into a cascade. Slope scaled polygon offset keeps the surfaces
+ * from shadowing themselves.
+ *
+ * @param cascade Cascade index.
+ */
+void CascadedShadowMap::begin(int cascade) {
+    glGetIntegerv(GL_VIEWPORT, savedViewport);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &savedFramebuffer);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthArray, 0, cascade);
+    glViewport(0, 0, resolution, resolution);
+    glClear(GL_DEPTH_BUFFER_BIT);
+
+    glEnable(GL_DEPTH_CLAMP);
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(1.5f, 2.0f);
+}
+
+void CascadedShadowMap::end() {
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glDisable(GL_DEPTH_CLAMP);
+    glBindFramebuffer(GL_FRAMEBUFFER, savedFramebuffer);
+    glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+}
+
+/**
+ * @brief Upload the cascade table and bind it with the shadow map for the lighting shaders.
+ */
+void CascadedShadowMap::bind() const {
+    glsl::Cascades data = block;
+    data.shadowFilter = filter;
+    data.showCascades = showCascades;
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(data), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CSM_BLOCK_BINDING, ubo);
+
+    glActiveTexture(GL_TEXTURE0 + CSM_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, depthArray);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void CascadedShadowMap::clean() {
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &depthArray);
+    glDeleteBuffers(1, &ubo);
+    fbo = 0;
+    depthArray = 0;
+    ubo = 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file CascadedShadowMap.hpp
+ * @author Rohan Siddhu
+ * @brief Cascaded shadow maps for the directional light.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "Shader.hpp"
+#include "ShaderBlocks.hpp"
+#include <iostream>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Must match the array size of the Cascades uniform block in the shaders.
+constexpr int CSM_MAX_CASCADES = 4;
+
+// Uniform block binding point of the cascade table, and texture unit of the shadow map.
+constexpr GLuint CSM_BLOCK_BINDING = glsl::Cascades::binding;
+constexpr GLuint CSM_TEXTURE_UNIT = 3;
+
+// Filter applied to shadow map lookups, every tap is a hardware 2 x 2 bilinear comparison.
+enum ShadowFilter : int {
+    SHADOW_FILTER_HARDWARE = 0,     /** Single tap. */
+    SHADOW_FILTER_PCF3 = 1,         /** 3 x 3 taps. */
+    SHADOW_FILTER_PCF5 = 2          /** 5 x 5 taps. */
+};
+
+class CascadedShadowMap {
+private:
+    static_assert(sizeof(glsl::Cascades::cascadeMatrices) / sizeof(glm::mat4) == CSM_MAX_CASCADES,
+                  "CSM_MAX_CASCADES must match the array size of the Cascades block");
+
+    GLuint depthArray = 0;  /** GL_TEXTURE_2D_ARRAY, one layer per cascade. */
+    GLuint fbo = 0;
+    GLuint ubo = 0;
+    int resolution = 0;
+    int cascadeCount = 0;
+
+    glsl::Cascades block {};    /** Cascade table, as uploaded by bind(). */
+    glm::mat4 viewProjections[CSM_MAX_CASCADES];    /** World to cascade clip space. */
+    glm::mat4 lightRotation = glm::mat4(1.0f);  /** World to light space, rotation only. */
+    glm::vec3 boundsMin[CSM_MAX_CASCADES];      /** Light space box of each cascade. */
+    glm::vec3 boundsMax[CSM_MAX_CASCADES];
+    GLint savedViewport[4];
+    GLint savedFramebuffer = 0;
+public:
+    float splitLambda = 0.8f;       /** 1 splits logarithmically, 0 uniformly. */
+    float shadowDistance = 60.0f;   /** View depth covered by the last cascade. */
+    int filter = SHADOW_FILTER_PCF3;
+    bool showCascades = false;
+
+    bool init(int resolution = 2048, int cascades = CSM_MAX_CASCADES);
+    void update(const glm::mat4& view, float fov, float aspect, float nearPlane, glm::vec3 lightDirection);
+    bool casts(int cascade, glm::vec3 center, float radius) const;
+    void begin(int cascade);
+    void end();
+    void bind() const;
+    void clean();
+
+    int getCascadeCount() const { return cascadeCount; }
+    GLuint getTexture() const { return depthArray; }
+    const glm::mat4& matrix(int cascade) const { return viewProjections[cascade]; }
+    float split(int cascade) const { return block.cascadeSplits[cascade]; }
+    size_t videoMemory() const { return (size_t)resolution * resolution * cascadeCount * 4; }
+};
@@ -0,0 +1,247 @@
+/**
+ * @file CoarseShading.cpp
+ * @author Rohan Siddhu
+ * @brief CoarseShading class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "CoarseShading.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <glm/gtc/type_ptr.hpp>
+
+// Header of the sample buffer: indirect dispatch group counts and the sample count.
+static const GLuint SAMPLE_HEADER[4] = { 0, 1, 1, 0 };
+
+/**
+ * @brief Build the programs, one lighting program per combination of the lighting keys.
+ *
+ * @return bool false if the GL context has no compute shaders (before 4.3).
+ */
+bool CoarseShading::init() {
+    if (!GLAD_GL_VERSION_4_3) {
+        std::cerr << "Failed to initialize coarse shading, OpenGL 4.3 is required" << std::endl;
+        return false;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        std::vector<std::string> keys;
+        if (i & 1) {
+            keys.push_back("SUN_LIGHT");
+        }
+        if (i & 2) {
+            keys.push_back("POINT_SHADOWS");
+        }
+        shadePrograms[i].addShader(GL_COMPUTE_SHADER, "res/shaders/csCoarseShade.glsl", keys);
+        shadePrograms[i].createProgram();
+    }
+    classifyProgram.addShader(GL_COMPUTE_SHADER, "res/shaders/csCoarseClassify.glsl");
+    classifyProgram.createProgram();
+    resolveProgram.addShader(GL_COMPUTE_SHADER, "res/shaders/csCoarseResolve.glsl");
+    resolveProgram.createProgram();
+
+    glGenBuffers(PROFILER_LATENCY, counts);
+    for (GLuint buffer : counts) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, sizeof(GLuint), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return true;
+}
+
+/**
+ * @brief Declare the passes that light the surface the scene pass wrote with COARSE_SHADING, and
+ * write the lit color over it. The shadow maps must still be bound to units 3 and 4 from the
+ * scene pass, and the frame uniform buffer to its binding.
+ *
+ * @param graph Graph of the frame.
+ * @param color GL_RGBA16F diffuse color and shininess, the lit color afterwards.
+ * @param normal GL_RGBA16F view space normals.
+ * @param specular Specular colors.
+ * @param depth Scene depth buffer.
+ * @param ambient GL_R11F_G11F_B10F ambient light for SSAO, or -1.
+ * @param view Camera view matrix.
+ * @param sceneProjection Projection the scene was drawn with.
+ * @param sunLight Light with the directional light, as SUN_LIGHT.
+ * @param pointShadows Shadow the point lights, as POINT_SHADOWS.
+ */
+void CoarseShading::addPasses(RenderGraph& graph, int color, int normal, int specular, int depth, int ambient,
+    const glm::mat4& view, const glm::mat4& sceneProjection, bool sunLight, bool pointShadows) {
+    const RenderTextureDesc& full = graph.desc(color);
+    int width = full.width, height = full.height;
+    int tilesX = (width + COARSE_TILE - 1) / COARSE_TILE;
+    int tilesY = (height + COARSE_TILE - 1) / COARSE_TILE;
+    reserve(tilesX * tilesY);
+
+    int diffuseLight = graph.createTexture("Coarse diffuse", { width, height, GL_RGBA16F });
+    int specularLight = graph.createTexture("Coarse specular", { width, height, GL_RGBA16F });
+    int luminance = graph.createTexture("Coarse luminance", { tilesX, tilesY, GL_R16F });
+    int rates = graph.createTexture("Coarse rates", { tilesX, tilesY, GL_R8UI });
+    int samples = graph.importBuffer("Coarse samples", sampleBuffer);
+
+    glm::mat4 inverseView = glm::inverse(view);
+    glm::mat4 inverseProjection = glm::inverse(sceneProjection);
+    glm::mat4 inverseViewProjection = inverseView * inverseProjection;
+    Shader& shadeProgram = shadePrograms[(sunLight ? 1 : 0) | (pointShadows ? 2 : 0)];
+
+    auto bindSurface = [&graph, color, normal, specular, depth]() {
+        const int units[] = { color, normal, specular, depth };
+        for (int i = 0; i < 4; i++) {
+            glActiveTexture(GL_TEXTURE5 + i);
+            glBindTexture(GL_TEXTURE_2D, graph.texture(units[i]));
+        }
+        glActiveTexture(GL_TEXTURE0);
+    };
+    auto shade = [&graph, &shadeProgram, bindSurface, diffuseLight, specularLight, luminance, inverseView,
+        inverseProjection](bool tiles) {
+        shadeProgram.use();
+        shadeProgram.setInt("tiles", tiles);
+        shadeProgram.setMat4("inverseView", glm::value_ptr(inverseView));
+        shadeProgram.setMat4("inverseProjection", glm::value_ptr(inverseProjection));
+        bindSurface();
+        glBindImageTexture(0, graph.texture(diffuseLight), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        glBindImageTexture(1, graph.texture(specularLight), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        glBindImageTexture(3, graph.texture(luminance), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R16F);
+    };
+
+    // First pixel of every tile
+    int pass = graph.addPass("Coarse tiles", [shade, tilesX, tilesY]() {
+        shade(true);
+        glDispatchCompute((tilesX * tilesY + 63) / 64, 1, 1);
+    });
+    for (int surface : { color, normal, specular, depth }) {
+        graph.read(pass, surface, ACCESS_SAMPLED);
+    }
+    graph.write(pass, diffuseLight, ACCESS_IMAGE);
+    graph.write(pass, specularLight, ACCESS_IMAGE);
+    graph.write(pass, luminance, ACCESS_IMAGE);
+
+    pass = graph.addPass("Coarse classify", [this, &graph, bindSurface, rates, luminance, samples,
+        inverseProjection, inverseViewProjection, tilesX, tilesY]() {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, graph.buffer(samples));
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(SAMPLE_HEADER), SAMPLE_HEADER);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, graph.buffer(samples));
+        classifyProgram.use();
+        classifyProgram.setMat4("inverseProjection", glm::value_ptr(inverseProjection));
+        classifyProgram.setMat4("inverseViewProjection", glm::value_ptr(inverseViewProjection));
+        classifyProgram.setFloat("contrastThreshold", contrastThreshold);
+        classifyProgram.setFloat("motionScale", motionScale);
+        bindSurface();
+        glBindImageTexture(2, graph.texture(rates), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R8UI);
+        glBindImageTexture(3, graph.texture(luminance), 0, GL_FALSE, 0, GL_READ_ONLY, GL_R16F);
+        glDispatchCompute((tilesX + 7) / 8, (tilesY + 7) / 8, 1);
+    });
+    graph.read(pass, normal, ACCESS_SAMPLED);
+    graph.read(pass, depth, ACCESS_SAMPLED);
+    graph.read(pass, luminance, ACCESS_IMAGE);
+    graph.write(pass, rates, ACCESS_IMAGE);
+    graph.write(pass, samples, ACCESS_STORAGE);
+
+    // The rest of the samples, as many groups as the classification asked for
+    pass = graph.addPass("Coarse shading", [this, &graph, shade, samples, tilesX, tilesY, width, height]() {
+        readCount();
+        shade(false);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, graph.buffer(samples));
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+        glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, graph.buffer(samples));
+        glDispatchComputeIndirect(0);
+        glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+
+        glBindBuffer(GL_COPY_READ_BUFFER, graph.buffer(samples));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, counts[frame]);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 3 * sizeof(GLuint), 0, sizeof(GLuint));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        countTiles[frame] = tilesX * tilesY;
+        countPixels[frame] = width * height;
+        frame = (frame + 1) % PROFILER_LATENCY;
+    });
+    for (int surface : { color, normal, specular, depth }) {
+        graph.read(pass, surface, ACCESS_SAMPLED);
+    }
+    graph.read(pass, samples, ACCESS_STORAGE);
+    graph.read(pass, diffuseLight, ACCESS_IMAGE);
+    graph.read(pass, specularLight, ACCESS_IMAGE);
+    graph.write(pass, diffuseLight, ACCESS_IMAGE);
+    graph.write(pass, specularLight, ACCESS_IMAGE);
+
+    pass = graph.addPass("Coarse resolve", [this, &graph, bindSurface, color, ambient, diffuseLight, specularLight,
+        rates, inverseProjection, sunLight, width, height]() {
+        resolveProgram.use();
+        resolveProgram.setMat4("inverseProjection", glm::value_ptr(inverseProjection));
+        resolveProgram.setInt("writeAmbient", ambient >= 0);
+        resolveProgram.setInt("sunLight", sunLight);
+        bindSurface();
+        glBindImageTexture(0, graph.texture(diffuseLight), 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA16F);
+        glBindImageTexture(1, graph.texture(specularLight), 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA16F);
+        glBindImageTexture(2, graph.texture(rates), 0, GL_FALSE, 0, GL_READ_ONLY, GL_R8UI);
+        glBindImageTexture(4, graph.texture(color), 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA16F);
+        if (ambient >= 0) {
+            glBindImageTexture(5, graph.texture(ambient), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R11F_G11F_B10F);
+        }
+        glDispatchCompute((width + 7) / 8, (height + 7) / 8, 1);
+    });
+    graph.read(pass, normal, ACCESS_SAMPLED);
+    graph.read(pass, specular, ACCESS_SAMPLED);
+    graph.read(pass, depth, ACCESS_SAMPLED);
+    graph.read(pass, diffuseLight, ACCESS_IMAGE);
+    graph.read(pass, specularLight, ACCESS_IMAGE);
+    graph.read(pass, rates, ACCESS_IMAGE);
+    graph.read(pass, color, ACCESS_IMAGE);
+    graph.write(pass, color, ACCESS_IMAGE);
+    if (ambient >= 0) {
+        graph.write(pass, ambient, ACCESS_IMAGE);
+    }
+}
+
+void CoarseShading::clean() {
+    for (Shader& program : shadePrograms) {
+        program.clean();
+    }
+    classifyProgram.clean();
+    resolveProgram.clean();
+    glDeleteBuffers(1, &sampleBuffer);
+    glDeleteBuffers(PROFILER_LATENCY, counts);
+    sampleBuffer = 0;
+    sampleCapacity = 0;
+    for (int i = 0; i < PROFILER_LATENCY; i++) {
+        counts[i] = 0;
+        countTiles[i] = 0;
+    }
+}
+
+
+/*
+* Private Methods
+*/
+
+// Room for the header and up to 15 added samples per tile, the most a tile at full rate adds.
+void CoarseShading::reserve(int tileCount) {
+    int capacity = tileCount * (COARSE_TILE * COARSE_TILE - 1);
+    if (sampleBuffer != 0 && capacity <= sampleCapacity) {
+        return;
+    }
+    if (sampleBuffer == 0) {
+        glGenBuffers(1, &sampleBuffer);
+    }
+    sampleCapacity = capacity;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, sampleBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, (sizeof(SAMPLE_HEADER) + capacity * sizeof(GLuint)), nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+// Shaded share of the frame whose count was copied PROFILER_LATENCY frames ago, by then long
+// finished, so the read does not wait for the GPU.
+void CoarseShading::readCount() {
+    if (countTiles[frame] == 0) {
+        return;
+    }
+    GLuint count = 0;
+    glBindBuffer(GL_COPY_READ_BUFFER, counts[frame]);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(count), &count);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    float shaded = (float)(countTiles[frame] + count) / (float)countPixels[frame];
+    share += (shaded - share) * 0.1f;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file CoarseShading.hpp
+ * @author Rohan Siddhu
+ * @brief Lighting of the scene at a reduced rate in compute passes, chosen per tile.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "GpuProfiler.hpp"
+#include "RenderGraph.hpp"
+#include "Shader.hpp"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Pixels per side of a tile, COARSE_TILE in include/coarse.glsl.
+constexpr int COARSE_TILE = 4;
+
+// With COARSE_SHADING the scene pass only writes what lighting needs: diffuse color and shininess,
+// normal and specular color. The first pixel of every tile is lit, then each tile picks how densely
+// the rest is lit from the contrast of that light with its neighbours, its motion and its depth and
+// normal edges: once per 4 x 4, per 2 x 2 or at every pixel. The samples are lit by an indirect
+// dispatch and interpolated to every pixel without crossing surfaces, and multiplied with the
+// pixel's own colors. Flat, dimly varying and fast moving areas, most of the screen, pay for a
+// sixteenth of the lights.
+class CoarseShading {
+private:
+    Shader shadePrograms[4];        /** Bit 0 SUN_LIGHT, bit 1 POINT_SHADOWS. */
+    Shader classifyProgram;
+    Shader resolveProgram;
+
+    // Indirect dispatch arguments, sample count and sample list, sized for every tile at full rate.
+    GLuint sampleBuffer = 0;
+    int sampleCapacity = 0;
+
+    // Sample counts copied every frame, read back PROFILER_LATENCY frames later, with the tile and
+    // pixel counts of their frame.
+    GLuint counts[PROFILER_LATENCY] = {};
+    int countTiles[PROFILER_LATENCY] = {};      /** 0 while nothing was copied. */
+    int countPixels[PROFILER_LATENCY] = {};
+    int frame = 0;
+    float share = 1.0f;             /** Shaded pixels over all pixels, smoothed. */
+public:
+    float contrastThreshold = 0.1f;
+    float motionScale = 8.0f;
+
+    bool init();
+    void addPasses(RenderGraph& graph, int color, int normal, int specular, int depth, int ambient,
+        const glm::mat4& view, const glm::mat4& sceneProjection, bool sunLight, bool pointShadows);
+    void clean();
+
+    float shadedShare() const { return share; }
+private:
+    void reserve(int tileCount);
+    void readCount();
+};
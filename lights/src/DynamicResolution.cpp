@@ -0,0 +1,84 @@
+/**
+ * @file DynamicResolution.cpp
+ * @author Rohan Siddhu
+ * @brief DynamicResolution class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "DynamicResolution.hpp"
+#include <algorithm>
+#include <cmath>
+
+bool DynamicResolution::init() {
+    program.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    program.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsUpscale.glsl");
+    program.createProgram();
+    glGenVertexArrays(1, &emptyVao);
+    return true;
+}
+
+/**
+ * @brief Run the controller on the last measured GPU frame time. The error is the share of the
+ * budget left over, so the gains do not depend on the budget. The integral is clamped to the
+ * reachable range, so time spent at the minimum or maximum scale does not wind it up.
+ *
+ * @param gpuMilliseconds GPU time of a recent frame, 0 while none was measured.
+ */
+void DynamicResolution::update(float gpuMilliseconds) {
+    float minArea = minScale * minScale;
+    float maxArea = maxScale * maxScale;
+    if (!enabled || gpuMilliseconds <= 0.0f) {
+        area = maxArea;
+        integral = maxArea - 1.0f;
+        previousError = 0.0f;
+        scale = maxScale;
+        return;
+    }
+
+    float error = (budget - gpuMilliseconds) / budget;
+    integral = std::clamp(integral + ki * error, minArea - 1.0f, maxArea - 1.0f);
+    area = std::clamp(1.0f + integral + kp * error + kd * (error - previousError), minArea, maxArea);
+    previousError = error;
+
+    // Change steps only once the controller is most of a step away, so it does not flip between two.
+    float wanted = std::sqrt(area);
+    if (std::abs(wanted - scale) > RESOLUTION_STEP * 0.75f) {
+        scale = std::clamp(std::round(wanted / RESOLUTION_STEP) * RESOLUTION_STEP, minScale, maxScale);
+    }
+}
+
+void DynamicResolution::renderSize(int width, int height, int& renderWidth, int& renderHeight) const {
+    renderWidth = std::max((int)std::lround(width * getScale()), 1);
+    renderHeight = std::max((int)std::lround(height * getScale()), 1);
+}
+
+/**
+ * @brief Declare the pass that upscales and sharpens source into target.
+ *
+ * @param graph Graph of the frame.
+ * @param source Tone mapped image at the render size, filtered linearly.
+ * @param target Texture or backbuffer at the window size.
+ */
+void DynamicResolution::addPass(RenderGraph& graph, int source, int target) {
+    int pass = graph.addPass("Upscale", [this, &graph, source]() {
+        const RenderTextureDesc& size = graph.desc(source);
+        glDisable(GL_DEPTH_TEST);
+        program.use();
+        program.setVec2("texelSize", glm::vec2(1.0f / size.width, 1.0f / size.height));
+        program.setFloat("sharpness", sharpness);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, graph.texture(source));
+        glBindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glEnable(GL_DEPTH_TEST);
+    });
+    graph.read(pass, source, ACCESS_SAMPLED);
+    graph.write(pass, target, ACCESS_TARGET);
+}
+
+void DynamicResolution::clean() {
+    program.clean();
+    glDeleteVertexArrays(1, &emptyVao);
+    emptyVao = 0;
+}
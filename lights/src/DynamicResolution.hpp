@@ -0,0 +1,48 @@
+/**
+ * @file DynamicResolution.hpp
+ * @author Rohan Siddhu
+ * @brief Render scale steered by GPU time, and the sharpening upscale to the window.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "RenderGraph.hpp"
+#include "Shader.hpp"
+#include <glad/glad.h>
+
+// The scale changes in steps, each change reallocates the scene targets and restarts TAA.
+constexpr float RESOLUTION_STEP = 0.05f;
+
+// A PID controller keeps the GPU time of the frame at the budget by changing the share of the
+// window's pixels the scene is drawn with; GPU time follows the pixel count, the square of the
+// scale. The tone mapped image is then upscaled to the window with sharpening, and the UI is drawn
+// over it at full resolution.
+class DynamicResolution {
+private:
+    Shader program;
+    GLuint emptyVao = 0;
+    float scale = 1.0f;             /** Applied, a multiple of RESOLUTION_STEP. */
+    float area = 1.0f;              /** Controller output, share of the pixels. */
+    float integral = 0.0f;
+    float previousError = 0.0f;
+public:
+    bool enabled = false;
+    float budget = 12.0f;           /** GPU milliseconds per frame. */
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    float kp = 0.1f;
+    float ki = 0.02f;
+    float kd = 0.05f;
+    float sharpness = 0.5f;
+
+    bool init();
+    void update(float gpuMilliseconds);
+    void renderSize(int width, int height, int& renderWidth, int& renderHeight) const;
+    void addPass(RenderGraph& graph, int source, int target);
+    void clean();
+
+    float getScale() const { return enabled ? scale : 1.0f; }
+    bool isScaling() const { return getScale() < 1.0f; }
+};
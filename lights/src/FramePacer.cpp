@@ -0,0 +1,147 @@
+/**
+ * @file FramePacer.cpp
+ * @author Rohan Siddhu
+ * @brief FramePacer class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "FramePacer.hpp"
+#include <algorithm>
+#include <thread>
+
+static float milliseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+static float smooth(float average, float sample) {
+    return average * 0.9f + sample * 0.1f;
+}
+
+/**
+ * @brief Look up adaptive vsync and the refresh rate, and set the swap interval of the current
+ * context.
+ */
+void FramePacer::init() {
+    adaptiveAvailable = glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+                        glfwExtensionSupported("GLX_EXT_swap_control_tear");
+
+    const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    if (mode && mode->refreshRate > 0) {
+        refreshPeriod = 1000.0f / mode->refreshRate;
+    }
+    due = Clock::now();
+    applySwapInterval();
+}
+
+/**
+ * @brief Wait until fewer than maxFramesInFlight frames are queued and for the frame rate limit.
+ * Call at the start of the frame, before polling input.
+ */
+void FramePacer::beginFrame() {
+    maxFramesInFlight = std::clamp(maxFramesInFlight, 1, PACER_MAX_FRAMES_IN_FLIGHT);
+    applySwapInterval();
+
+    Clock::time_point start = Clock::now();
+    retire(true);
+    fenceWaitMs = smooth(fenceWaitMs, milliseconds(Clock::now() - start));
+
+    limit();
+    inputTime = Clock::now();
+}
+
+/**
+ * @brief Fence the frame just swapped. Call right after glfwSwapBuffers().
+ */
+void FramePacer::endFrame() {
+    Frame& frame = frames[(oldest + queued) % PACER_MAX_FRAMES_IN_FLIGHT];
+    frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame.input = inputTime;
+    queued++;
+    retire(false);
+}
+
+void FramePacer::clean() {
+    while (queued > 0) {
+        glDeleteSync(frames[oldest].fence);
+        frames[oldest].fence = nullptr;
+        oldest = (oldest + 1) % PACER_MAX_FRAMES_IN_FLIGHT;
+        queued--;
+    }
+}
+
+
+/*
+* Private Methods
+*/
+
+void FramePacer::applySwapInterval() {
+    int wanted = syncMode == SYNC_OFF ? 0 : (syncMode == SYNC_ADAPTIVE && adaptiveAvailable ? -1 : 1);
+    if (wanted != swapInterval) {
+        glfwSwapInterval(wanted);
+        swapInterval = wanted;
+    }
+}
+
+// Drop the fences of finished frames, oldest first, and take a latency sample from each. With
+// 'wait', block on the oldest until fewer than maxFramesInFlight frames are queued. A frame counts
+// as shown half a refresh after its commands finish, when the scan out reaches the middle of the
+// screen; frames found finished without waiting count from when they were found, so the estimate
+// errs long by up to a frame.
+void FramePacer::retire(bool wait) {
+    while (queued > 0) {
+        Frame& frame = frames[oldest];
+        bool block = wait && queued >= maxFramesInFlight;
+        GLenum status = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, block ? 1000000000 : 0);
+        if (status == GL_TIMEOUT_EXPIRED && !block) {
+            break;
+        }
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+            float ms = milliseconds(Clock::now() - frame.input) + refreshPeriod * 0.5f;
+            latencyMs = latencyMs > 0.0f ? smooth(latencyMs, ms) : ms;
+        }
+        glDeleteSync(frame.fence);
+        frame.fence = nullptr;
+        oldest = (oldest + 1) % PACER_MAX_FRAMES_IN_FLIGHT;
+        queued--;
+    }
+}
+
+// Hold the frame until its slot in the frame rate limit. Sleeping alone wakes late by up to the
+// scheduler's tick, spinning alone keeps a core busy; sleep until shortly before the slot, by as
+// much as recent sleeps overshot, and yield in a loop for the rest.
+void FramePacer::limit() {
+    Clock::time_point now = Clock::now();
+    if (maxFps <= 0.0f) {
+        due = now;
+        sleepMs = smooth(sleepMs, 0.0f);
+        spinMs = smooth(spinMs, 0.0f);
+        return;
+    }
+
+    auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / maxFps));
+    due += period;
+    if (due + period < now) {
+        due = now;      // fell behind, do not rush the next frames to catch up
+    }
+
+    auto margin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(oversleepMs * 1.5f));
+    Clock::time_point wake = due - margin;
+    float slept = 0.0f;
+    if (now < wake) {
+        std::this_thread::sleep_until(wake);
+        Clock::time_point woke = Clock::now();
+        slept = milliseconds(woke - now);
+        float late = std::max(milliseconds(woke - wake), 0.0f);
+        oversleepMs = late > oversleepMs ? late : oversleepMs * 0.99f + late * 0.01f;
+        now = woke;
+    }
+    sleepMs = smooth(sleepMs, slept);
+
+    Clock::time_point spinStart = now;
+    while (now < due) {
+        std::this_thread::yield();
+        now = Clock::now();
+    }
+    spinMs = smooth(spinMs, milliseconds(now - spinStart));
+}
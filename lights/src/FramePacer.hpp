@@ -0,0 +1,74 @@
+/**
+ * @file FramePacer.hpp
+ * @author Rohan Siddhu
+ * @brief Frame pacing: frames in flight, vsync mode, frame rate limit and latency estimate.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <chrono>
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Most frames the CPU may queue ahead of the GPU.
+constexpr int PACER_MAX_FRAMES_IN_FLIGHT = 4;
+
+enum SyncMode {
+    SYNC_OFF,
+    SYNC_VSYNC,
+    SYNC_ADAPTIVE       /** Vsync, but late frames swap at once and tear instead of waiting a refresh. */
+};
+
+// Without a limit the driver lets the CPU queue several frames, and every queued frame adds its
+// duration to the time between reading input and showing the result. A fence after each swap lets
+// the CPU wait until at most maxFramesInFlight frames are queued before it polls input for the
+// next one. The limiter sleeps most of the way to the next frame and spins only the last part,
+// whose length follows how late the sleeps wake.
+class FramePacer {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame {
+        GLsync fence = nullptr;
+        Clock::time_point input;    /** When the frame polled input. */
+    };
+
+    Frame frames[PACER_MAX_FRAMES_IN_FLIGHT];
+    int oldest = 0;
+    int queued = 0;
+    Clock::time_point inputTime;
+    Clock::time_point due;
+    bool adaptiveAvailable = false;
+    int swapInterval = -2;          /** Applied interval, none yet. */
+    float refreshPeriod = 1000.0f / 60.0f;
+
+    // Milliseconds, smoothed.
+    float latencyMs = 0.0f;
+    float fenceWaitMs = 0.0f;
+    float sleepMs = 0.0f;
+    float spinMs = 0.0f;
+    float oversleepMs = 0.5f;
+public:
+    int syncMode = SYNC_ADAPTIVE;
+    int maxFramesInFlight = 2;
+    float maxFps = 0.0f;            /** Frame rate limit, 0 for none. */
+
+    void init();
+    void beginFrame();
+    void endFrame();
+    void clean();
+
+    bool hasAdaptiveSync() const { return adaptiveAvailable; }
+    int interval() const { return swapInterval; }
+    float latency() const { return latencyMs; }
+    float fenceWait() const { return fenceWaitMs; }
+    float sleepTime() const { return sleepMs; }
+    float spinTime() const { return spinMs; }
+    float refresh() const { return refreshPeriod; }
+private:
+    void applySwapInterval();
+    void retire(bool wait);
+    void limit();
+};
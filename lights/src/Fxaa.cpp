@@ -0,0 +1,49 @@
+/**
+ * @file Fxaa.cpp
+ * @author Rohan Siddhu
+ * @brief Fxaa class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Fxaa.hpp"
+
+bool Fxaa::init() {
+    program.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    program.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsFxaa.glsl");
+    program.createProgram();
+    glGenVertexArrays(1, &emptyVao);
+    return true;
+}
+
+/**
+ * @brief Declare the pass that smooths the edges of source into target.
+ *
+ * @param graph Graph of the frame.
+ * @param source Tone mapped image, filtered linearly.
+ * @param target Texture or backbuffer of the same size.
+ */
+void Fxaa::addPass(RenderGraph& graph, int source, int target) {
+    int pass = graph.addPass("FXAA", [this, &graph, source]() {
+        const RenderTextureDesc& size = graph.desc(source);
+        glDisable(GL_DEPTH_TEST);
+        program.use();
+        program.setVec2("texelSize", glm::vec2(1.0f / size.width, 1.0f / size.height));
+        program.setFloat("edgeThreshold", edgeThreshold);
+        program.setFloat("edgeThresholdMin", edgeThresholdMin);
+        program.setFloat("spanMax", spanMax);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, graph.texture(source));
+        glBindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glEnable(GL_DEPTH_TEST);
+    });
+    graph.read(pass, source, ACCESS_SAMPLED);
+    graph.write(pass, target, ACCESS_TARGET);
+}
+
+void Fxaa::clean() {
+    program.clean();
+    glDeleteVertexArrays(1, &emptyVao);
+    emptyVao = 0;
+}
@@ -0,0 +1,27 @@
+/**
+ * @file Fxaa.hpp
+ * @author Rohan Siddhu
+ * @brief FXAA of the tone mapped image, as a render graph pass.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "RenderGraph.hpp"
+#include "Shader.hpp"
+#include <glad/glad.h>
+
+class Fxaa {
+private:
+    Shader program;
+    GLuint emptyVao = 0;
+public:
+    float edgeThreshold = 0.125f;
+    float edgeThresholdMin = 0.0312f;
+    float spanMax = 8.0f;
+
+    bool init();
+    void addPass(RenderGraph& graph, int source, int target);
+    void clean();
+};
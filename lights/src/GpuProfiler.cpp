@@ -0,0 +1,96 @@
+/**
+ * @file GpuProfiler.cpp
+ * @author Rohan Siddhu
+ * @brief GpuProfiler class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "GpuProfiler.hpp"
+
+/**
+ * @brief Start timing a pass. Timestamps rather than GL_TIME_ELAPSED queries, so scopes may nest.
+ *
+ * @param name Pass name, scopes are matched by name from frame to frame.
+ * @return int Scope to pass to end().
+ */
+int GpuProfiler::begin(const char* name) {
+    int scope = -1;
+    for (int i = 0; i < (int)scopes.size() && scope < 0; i++) {
+        if (scopes[i].name == name) {
+            scope = i;
+        }
+    }
+    if (scope < 0) {
+        scopes.emplace_back();
+        scope = (int)scopes.size() - 1;
+        scopes[scope].name = name;
+        glGenQueries(PROFILER_LATENCY * 2, &scopes[scope].queries[0][0]);
+    }
+
+    glQueryCounter(scopes[scope].queries[frame][0], GL_TIMESTAMP);
+    return scope;
+}
+
+void GpuProfiler::end(int scope) {
+    glQueryCounter(scopes[scope].queries[frame][1], GL_TIMESTAMP);
+    scopes[scope].issued[frame] = true;
+    scopes[scope].used = true;
+}
+
+/**
+ * @brief Move on to the next frame's queries and collect the results of the oldest frame, whose
+ * queries are about to be reused. Results that are still not available are dropped.
+ */
+void GpuProfiler::endFrame() {
+    frame = (frame + 1) % PROFILER_LATENCY;
+
+    for (Scope& scope : scopes) {
+        if (!scope.used) {
+            scope.milliseconds = 0.0f;
+        }
+        scope.used = false;
+        if (!scope.issued[frame]) {
+            continue;
+        }
+        scope.issued[frame] = false;
+
+        GLint available = 0;
+        glGetQueryObjectiv(scope.queries[frame][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+        GLuint64 start = 0, stop = 0;
+        glGetQueryObjectui64v(scope.queries[frame][0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(scope.queries[frame][1], GL_QUERY_RESULT, &stop);
+        float ms = (float)(stop - start) / 1.0e6f;
+        scope.milliseconds = scope.milliseconds > 0.0f ? scope.milliseconds * 0.9f + ms * 0.1f : ms;
+    }
+}
+
+float GpuProfiler::milliseconds(const char* name) const {
+    for (const Scope& scope : scopes) {
+        if (scope.name == name) {
+            return scope.milliseconds;
+        }
+    }
+    return 0.0f;
+}
+
+/**
+ * @brief Sum of all scopes. Only meaningful when the scopes do not nest.
+ */
+float GpuProfiler::total() const {
+    float sum = 0.0f;
+    for (const Scope& scope : scopes) {
+        sum += scope.milliseconds;
+    }
+    return sum;
+}
+
+void GpuProfiler::clean() {
+    for (Scope& scope : scopes) {
+        glDeleteQueries(PROFILER_LATENCY * 2, &scope.queries[0][0]);
+    }
+    scopes.clear();
+}
@@ -0,0 +1,41 @@
+/**
+ * @file GpuProfiler.hpp
+ * @author Rohan Siddhu
+ * @brief GPU time of named render passes, from timestamp queries read a few frames late.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+// Frames a query may stay in flight before its result is read. Reading sooner would stall.
+constexpr int PROFILER_LATENCY = 4;
+
+class GpuProfiler {
+private:
+    struct Scope {
+        std::string name;
+        GLuint queries[PROFILER_LATENCY][2] = {};   /** Start and end timestamps, per frame. */
+        bool issued[PROFILER_LATENCY] = {};
+        float milliseconds = 0.0f;                  /** Smoothed over a few frames. */
+        bool used = false;                          /** Measured in the current frame. */
+    };
+
+    std::vector<Scope> scopes;
+    int frame = 0;
+public:
+    int begin(const char* name);
+    void end(int scope);
+    void endFrame();
+    void clean();
+
+    int scopeCount() const { return (int)scopes.size(); }
+    const std::string& name(int scope) const { return scopes[scope].name; }
+    float milliseconds(int scope) const { return scopes[scope].milliseconds; }
+    float milliseconds(const char* name) const;
+    float total() const;
+};
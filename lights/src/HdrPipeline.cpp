@@ -0,0 +1,126 @@
+/**
+ * @file HdrPipeline.cpp
+ * @author Rohan Siddhu
+ * @brief HdrPipeline class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "HdrPipeline.hpp"
+#include <cmath>
+
+/**
+ * @brief Build the programs and the metering buffers.
+ *
+ * @return bool false if the GL context has no compute shaders (before 4.3).
+ */
+bool HdrPipeline::init() {
+    if (!GLAD_GL_VERSION_4_3) {
+        std::cerr << "Failed to initialize HDR rendering, OpenGL 4.3 is required" << std::endl;
+        return false;
+    }
+
+    histogramProgram.addShader(GL_COMPUTE_SHADER, "res/shaders/csLuminanceHistogram.glsl");
+    histogramProgram.createProgram();
+    exposureProgram.addShader(GL_COMPUTE_SHADER, "res/shaders/csAutoExposure.glsl");
+    exposureProgram.createProgram();
+    tonemapProgram.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    tonemapProgram.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsTonemap.glsl");
+    tonemapProgram.createProgram();
+
+    GLuint zero[HDR_HISTOGRAM_BINS] = {};
+    glGenBuffers(1, &histogram);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, histogram);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(zero), zero, GL_DYNAMIC_COPY);
+
+    // Starts at middle grey, so the first frames are not wildly over or under exposed.
+    float exposure[2] = { 0.18f, 1.0f };
+    glGenBuffers(1, &exposureBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, exposureBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(exposure), exposure, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // The fullscreen triangle is generated from gl_VertexID, but core profiles need a VAO bound.
+    glGenVertexArrays(1, &emptyVao);
+    return true;
+}
+
+/**
+ * @brief Declare the passes that meter the scene and resolve it to the target. Three passes: the
+ * histogram reads the scene once, the exposure pass reduces the histogram in a single work group
+ * and clears it for the next frame, and the tone map pass adds the bloom and applies exposure, the
+ * curve and the sRGB encoding in one go, so the scene is only read twice and never written back.
+ * The graph issues the storage barriers between them.
+ *
+ * @param graph Graph of the frame.
+ * @param scene GL_RGBA16F scene color.
+ * @param bloom Bloom to add to the scene, or -1.
+ * @param target Texture or backbuffer the tone mapped image is written to, same size as the scene.
+ * @param deltaTime Seconds since the last frame, for eye adaptation.
+ */
+void HdrPipeline::addPasses(RenderGraph& graph, int scene, int bloom, int target, float deltaTime) {
+    int histogramBuffer = graph.importBuffer("Luminance histogram", histogram);
+    int exposure = graph.importBuffer("Exposure", exposureBuffer);
+
+    int pass = graph.addPass("Luminance histogram", [this, &graph, scene, histogramBuffer]() {
+        const RenderTextureDesc& desc = graph.desc(scene);
+        histogramProgram.use();
+        histogramProgram.setFloat("minLogLuminance", minLogLuminance);
+        histogramProgram.setFloat("inverseLogRange", 1.0f / (maxLogLuminance - minLogLuminance));
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, graph.buffer(histogramBuffer));
+        glBindImageTexture(0, graph.texture(scene), 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA16F);
+        glDispatchCompute((desc.width + 15) / 16, (desc.height + 15) / 16, 1);
+    });
+    graph.read(pass, scene, ACCESS_IMAGE);
+    graph.write(pass, histogramBuffer, ACCESS_STORAGE);
+
+    pass = graph.addPass("Auto exposure", [this, &graph, scene, histogramBuffer, exposure, deltaTime]() {
+        const RenderTextureDesc& desc = graph.desc(scene);
+        exposureProgram.use();
+        exposureProgram.setFloat("minLogLuminance", minLogLuminance);
+        exposureProgram.setFloat("logRange", maxLogLuminance - minLogLuminance);
+        exposureProgram.setFloat("pixelCount", (float)desc.width * desc.height);
+        exposureProgram.setFloat("adaptation", 1.0f - std::exp(-deltaTime * adaptationSpeed));
+        exposureProgram.setInt("autoExposure", autoExposure);
+        exposureProgram.setFloat("compensation", exposureCompensation);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, graph.buffer(histogramBuffer));
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, graph.buffer(exposure));
+        glDispatchCompute(1, 1, 1);
+    });
+    graph.read(pass, histogramBuffer, ACCESS_STORAGE);
+    graph.write(pass, histogramBuffer, ACCESS_STORAGE);
+    graph.write(pass, exposure, ACCESS_STORAGE);
+
+    pass = graph.addPass("Tone map", [this, &graph, scene, bloom, exposure]() {
+        glDisable(GL_DEPTH_TEST);
+        tonemapProgram.use();
+        tonemapProgram.setInt("toneMap", toneMap);
+        tonemapProgram.setFloat("bloomStrength", bloom >= 0 ? bloomStrength : 0.0f);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, graph.buffer(exposure));
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, graph.texture(scene));
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, bloom >= 0 ? graph.texture(bloom) : 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glEnable(GL_DEPTH_TEST);
+    });
+    graph.read(pass, scene, ACCESS_SAMPLED);
+    if (bloom >= 0) {
+        graph.read(pass, bloom, ACCESS_SAMPLED);
+    }
+    graph.read(pass, exposure, ACCESS_STORAGE);
+    graph.write(pass, target, ACCESS_TARGET);
+}
+
+void HdrPipeline::clean() {
+    histogramProgram.clean();
+    exposureProgram.clean();
+    tonemapProgram.clean();
+    glDeleteBuffers(1, &histogram);
+    glDeleteBuffers(1, &exposureBuffer);
+    glDeleteVertexArrays(1, &emptyVao);
+    histogram = exposureBuffer = emptyVao = 0;
+}
+
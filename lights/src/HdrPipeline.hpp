@@ -0,0 +1,45 @@
+/**
+ * @file HdrPipeline.hpp
+ * @author Rohan Siddhu
+ * @brief Histogram auto-exposure and tone mapping of an RGBA16F scene, as render graph passes.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "RenderGraph.hpp"
+#include "Shader.hpp"
+#include <iostream>
+#include <glad/glad.h>
+
+// Bins of the luminance histogram, one per thread of the exposure pass.
+constexpr int HDR_HISTOGRAM_BINS = 256;
+
+enum ToneMapOperator : int {
+    TONEMAP_REINHARD = 0,
+    TONEMAP_ACES = 1
+};
+
+class HdrPipeline {
+private:
+    Shader histogramProgram;
+    Shader exposureProgram;
+    Shader tonemapProgram;
+
+    GLuint histogram = 0;       /** HDR_HISTOGRAM_BINS counters, cleared by the exposure pass. */
+    GLuint exposureBuffer = 0;  /** Adapted average luminance and exposure, never read back. */
+    GLuint emptyVao = 0;
+public:
+    int toneMap = TONEMAP_ACES;
+    bool autoExposure = true;
+    float exposureCompensation = 0.0f;  /** EV added to the metered exposure, or the exposure itself. */
+    float adaptationSpeed = 1.5f;       /** Higher adapts faster, per second. */
+    float minLogLuminance = -8.0f;      /** Histogram range, log2 of luminance. */
+    float maxLogLuminance = 4.0f;
+    float bloomStrength = 0.04f;        /** Share of the bloom in the composite. */
+
+    bool init();
+    void addPasses(RenderGraph& graph, int scene, int bloom, int target, float deltaTime);
+    void clean();
+};
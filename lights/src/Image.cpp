@@ -0,0 +1,542 @@
+/**
+ * @file Image.cpp
+ * @author Rohan Siddhu
+ * @brief CPU side image operations.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Image.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define IMAGE_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define IMAGE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+
+/**
+ * @brief Resample an RGBA8 image. Each destination texel averages a grid of bilinear taps
+ * covering its footprint, so downscaling does not alias.
+ *
+ * @param src Source pixels.
+ * @param width Source width.
+ * @param height Source height.
+ * @param newWidth Destination width.
+ * @param newHeight Destination height.
+ * @return std::vector<unsigned char> Destination pixels.
+ */
+std::vector<unsigned char> resample_image(const unsigned char* src, int width, int height, int newWidth, int newHeight) {
+    std::vector<unsigned char> dst((size_t)newWidth * newHeight * 4);
+
+    float scaleX = (float)width / newWidth;
+    float scaleY = (float)height / newHeight;
+    int tapsX = std::max(1, (int)std::ceil(scaleX));
+    int tapsY = std::max(1, (int)std::ceil(scaleY));
+
+    auto texel = [&](int x, int y, int c) {
+        x = std::clamp(x, 0, width - 1);
+        y = std::clamp(y, 0, height - 1);
+        return (float)src[((size_t)y * width + x) * 4 + c];
+    };
+
+    for (int y = 0; y < newHeight; y++) {
+        for (int x = 0; x < newWidth; x++) {
+            float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+            for (int ty = 0; ty < tapsY; ty++) {
+                for (int tx = 0; tx < tapsX; tx++) {
+                    float u = (x + (tx + 0.5f) / tapsX) * scaleX - 0.5f;
+                    float v = (y + (ty + 0.5f) / tapsY) * scaleY - 0.5f;
+                    int x0 = (int)std::floor(u), y0 = (int)std::floor(v);
+                    float fx = u - x0, fy = v - y0;
+
+                    for (int c = 0; c < 4; c++) {
+                        float top = texel(x0, y0, c) * (1.0f - fx) + texel(x0 + 1, y0, c) * fx;
+                        float bottom = texel(x0, y0 + 1, c) * (1.0f - fx) + texel(x0 + 1, y0 + 1, c) * fx;
+                        sum[c] += top * (1.0f - fy) + bottom * fy;
+                    }
+                }
+            }
+
+            for (int c = 0; c < 4; c++) {
+                dst[((size_t)y * newWidth + x) * 4 + c] = (unsigned char)std::lround(sum[c] / (tapsX * tapsY));
+            }
+        }
+    }
+
+    return dst;
+}
+
+
+// sRGB conversion
+//-----------------
+
+// Decoding is a straight table lookup. Encoding goes through a table indexed by the linear value,
+// fine enough that the darkest sRGB steps are still distinguished. The encoding table has 3 bytes
+// of padding, so the AVX2 kernel can gather it 32 bits at a time.
+constexpr int LINEAR_TO_SRGB_SIZE = 16384;
+
+struct SrgbTables {
+    float toLinear[256];
+    unsigned char toSrgb[LINEAR_TO_SRGB_SIZE + 4] = {};
+
+    SrgbTables() {
+        for (int i = 0; i < 256; i++) {
+            float c = i / 255.0f;
+            toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i <= LINEAR_TO_SRGB_SIZE; i++) {
+            float l = (float)i / LINEAR_TO_SRGB_SIZE;
+            float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            toSrgb[i] = (unsigned char)std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f);
+        }
+    }
+};
+
+static const SrgbTables& srgb_tables() {
+    static const SrgbTables tables;
+    return tables;
+}
+
+/**
+ * @brief Linear value of each 8 bit sRGB value.
+ *
+ * @return const float* 256 entries.
+ */
+const float* srgb_to_linear_table() {
+    return srgb_tables().toLinear;
+}
+
+static unsigned char encode_srgb(float linear) {
+    int i = (int)(std::clamp(linear, 0.0f, 1.0f) * LINEAR_TO_SRGB_SIZE + 0.5f);
+    return srgb_tables().toSrgb[i];
+}
+
+
+// Box filter row kernels
+//------------------------
+// Each kernel averages 2x2 blocks of two source rows into dstWidth pixels and returns how many
+// pixels it has written, the scalar kernel finishes the rest.
+
+static void box_row_scalar(const unsigned char* r0, const unsigned char* r1, unsigned char* dst, int from, int dstWidth) {
+    for (int x = from; x < dstWidth; x++) {
+        for (int c = 0; c < 4; c++) {
+            int sum = r0[x * 8 + c] + r0[x * 8 + 4 + c] + r1[x * 8 + c] + r1[x * 8 + 4 + c];
+            dst[x * 4 + c] = (unsigned char)((sum + 2) >> 2);
+        }
+    }
+}
+
+// The sRGB kernels decode each color channel to linear light, sum the four pixels in the same order
+// as this one and encode the average, so all of them give the same bytes. Alpha is averaged as is.
+static void box_row_srgb(const unsigned char* r0, const unsigned char* r1, unsigned char* dst, int from, int dstWidth) {
+    const float* toLinear = srgb_tables().toLinear;
+    for (int x = from; x < dstWidth; x++) {
+        const unsigned char* a = r0 + x * 8;
+        const unsigned char* b = r1 + x * 8;
+        for (int c = 0; c < 3; c++) {
+            float sum = toLinear[a[c]] + toLinear[a[4 + c]] + toLinear[b[c]] + toLinear[b[4 + c]];
+            dst[x * 4 + c] = encode_srgb(sum * 0.25f);
+        }
+        // Alpha is linear
+        dst[x * 4 + 3] = (unsigned char)((a[3] + a[7] + b[3] + b[7] + 2) >> 2);
+    }
+}
+
+#ifdef IMAGE_SIMD_X86
+// SSE2 is part of x86-64, two output pixels per iteration.
+static int box_row_sse2(const unsigned char* r0, const unsigned char* r1, unsigned char* dst, int dstWidth) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    int x = 0;
+
+    for (; x + 2 <= dstWidth; x += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(r0 + x * 8));
+        __m128i b = _mm_loadu_si128((const __m128i*)(r1 + x * 8));
+
+        // Vertical sums of source pixels 0, 1 (lo) and 2, 3 (hi), as 16 bit channels.
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+        // Horizontal sums: pixel 0 + 1 and pixel 2 + 3.
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+
+        __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), two), 2);
+        _mm_storel_epi64((__m128i*)(dst + x * 4), _mm_packus_epi16(sum, sum));
+    }
+
+    return x;
+}
+
+// Same as the SSE2 kernel on both 128 bit lanes, four output pixels per iteration.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+static int box_row_avx2(const unsigned char* r0, const unsigned char* r1, unsigned char* dst, int dstWidth) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i two = _mm256_set1_epi16(2);
+    int x = 0;
+
+    for (; x + 4 <= dstWidth; x += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(r0 + x * 8));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(r1 + x * 8));
+
+        __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+        __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+
+        lo = _mm256_add_epi16(lo, _mm256_srli_si256(lo, 8));
+        hi = _mm256_add_epi16(hi, _mm256_srli_si256(hi, 8));
+
+        // Each lane now holds two output pixels, in order.
+        __m256i sum = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), two), 2);
+        __m256i packed = _mm256_packus_epi16(sum, sum);
+        _mm_storel_epi64((__m128i*)(dst + x * 4), _mm256_castsi256_si128(packed));
+        _mm_storel_epi64((__m128i*)(dst + x * 4 + 8), _mm256_extracti128_si256(packed, 1));
+    }
+
+    return x;
+}
+
+// Linear color of a pixel, alpha 0.
+static __m128 decode_pixel_sse2(const float* toLinear, const unsigned char* p) {
+    return _mm_set_ps(0.0f, toLinear[p[2]], toLinear[p[1]], toLinear[p[0]]);
+}
+
+// SSE2 has no gather: the table lookups stay scalar, the sums and the encoding index are vectors.
+static int box_row_srgb_sse2(const unsigned char* r0, const unsigned char* r1, unsigned char* dst, int dstWidth) {
+    const SrgbTables& tables = srgb_tables();
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    const __m128 scale = _mm_set1_ps((float)LINEAR_TO_SRGB_SIZE);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    int x = 0;
+
+    for (; x < dstWidth; x++) {
+        const unsigned char* a = r0 + x * 8;
+        const unsigned char* b = r1 + x * 8;
+        __m128 sum = _mm_add_ps(decode_pixel_sse2(tables.toLinear, a), decode_pixel_sse2(tables.toLinear, a + 4));
+        sum = _mm_add_ps(sum, decode_pixel_sse2(tables.toLinear, b));
+        sum = _mm_add_ps(sum, decode_pixel_sse2(tables.toLinear, b + 4));
+        __m128 linear = _mm_min_ps(_mm_max_ps(_mm_mul_ps(sum, quarter), zero), one);
+        __m128i index = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(linear, scale), half));
+
+        dst[x * 4] = tables.toSrgb[_mm_cvtsi128_si32(index)];
+        dst[x * 4 + 1] = tables.toSrgb[_mm_cvtsi128_si32(_mm_srli_si128(index, 4))];
+        dst[x * 4 + 2] = tables.toSrgb[_mm_cvtsi128_si32(_mm_srli_si128(index, 8))];
+        dst[x * 4 + 3] = (unsigned char)((a[3] + a[7] + b[3] + b[7] + 2) >> 2);
+    }
+
+    return x;
+}
+
+// Two output pixels per iteration, both tables gathered. Each 256 bit vector holds one source
+// pixel of each output pixel, the alpha lanes are decoded too and replaced at the end.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+static int box_row_srgb_avx2(const unsigned char* r0, const unsigned char* r1, unsigned char* dst, int dstWidth) {
+    const SrgbTables& tables = srgb_tables();
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+    const __m256 scale = _mm256_set1_ps((float)LINEAR_TO_SRGB_SIZE);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256i byteMask = _mm256_set1_epi32(0xff);
+    int x = 0;
+
+    for (; x + 2 <= dstWidth; x += 2) {
+        // Source pixels 0, 2 then 1, 3 of each row: the left and right pixel of both blocks.
+        __m128i a = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(r0 + x * 8)), _MM_SHUFFLE(3, 1, 2, 0));
+        __m128i b = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(r1 + x * 8)), _MM_SHUFFLE(3, 1, 2, 0));
+        __m256 aLeft = _mm256_i32gather_ps(tables.toLinear, _mm256_cvtepu8_epi32(a), 4);
+        __m256 aRight = _mm256_i32gather_ps(tables.toLinear, _mm256_cvtepu8_epi32(_mm_srli_si128(a, 8)), 4);
+        __m256 bLeft = _mm256_i32gather_ps(tables.toLinear, _mm256_cvtepu8_epi32(b), 4);
+        __m256 bRight = _mm256_i32gather_ps(tables.toLinear, _mm256_cvtepu8_epi32(_mm_srli_si128(b, 8)), 4);
+
+        __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(aLeft, aRight), bLeft), bRight);
+        __m256 linear = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(sum, quarter), zero), one);
+        __m256i index = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(linear, scale), half));
+        __m256i encoded = _mm256_and_si256(_mm256_i32gather_epi32((const int*)tables.toSrgb, index, 1), byteMask);
+
+        // One output pixel per 128 bit lane, packed to bytes in its low 32 bits.
+        __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(encoded, encoded), _mm256_setzero_si256());
+        uint32_t pixels[2] = { (uint32_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(packed)),
+                               (uint32_t)_mm_cvtsi128_si32(_mm256_extracti128_si256(packed, 1)) };
+        std::memcpy(dst + x * 4, pixels, sizeof(pixels));
+
+        for (int i = 0; i < 2; i++) {
+            const unsigned char* p = r0 + (x + i) * 8;
+            const unsigned char* q = r1 + (x + i) * 8;
+            dst[(x + i) * 4 + 3] = (unsigned char)((p[3] + p[7] + q[3] + q[7] + 2) >> 2);
+        }
+    }
+
+    return x;
+}
+
+static bool cpu_has_avx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+#ifdef IMAGE_SIMD_NEON
+// Four output pixels per iteration.
+static int box_row_neon(const unsigned char* r0, const unsigned char* r1, unsigned char* dst, int dstWidth) {
+    int x = 0;
+
+    for (; x + 4 <= dstWidth; x += 4) {
+        uint8x16_t a0 = vld1q_u8(r0 + x * 8), a1 = vld1q_u8(r0 + x * 8 + 16);
+        uint8x16_t b0 = vld1q_u8(r1 + x * 8), b1 = vld1q_u8(r1 + x * 8 + 16);
+
+        uint16x8_t s0 = vaddl_u8(vget_low_u8(a0), vget_low_u8(b0));     // source pixels 0, 1
+        uint16x8_t s1 = vaddl_u8(vget_high_u8(a0), vget_high_u8(b0));   // 2, 3
+        uint16x8_t s2 = vaddl_u8(vget_low_u8(a1), vget_low_u8(b1));     // 4, 5
+        uint16x8_t s3 = vaddl_u8(vget_high_u8(a1), vget_high_u8(b1));   // 6, 7
+
+        uint16x8_t lo = vcombine_u16(vadd_u16(vget_low_u16(s0), vget_high_u16(s0)), vadd_u16(vget_low_u16(s1), vget_high_u16(s1)));
+        uint16x8_t hi = vcombine_u16(vadd_u16(vget_low_u16(s2), vget_high_u16(s2)), vadd_u16(vget_low_u16(s3), vget_high_u16(s3)));
+
+        vst1q_u8(dst + x * 4, vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2)));
+    }
+
+    return x;
+}
+
+static float32x4_t decode_pixel_neon(const float* toLinear, const unsigned char* p) {
+    float linear[4] = { toLinear[p[0]], toLinear[p[1]], toLinear[p[2]], 0.0f };
+    return vld1q_f32(linear);
+}
+
+// As the SSE2 sRGB kernel: scalar lookups, vector sums and encoding index.
+static int box_row_srgb_neon(const unsigned char* r0, const unsigned char* r1, unsigned char* dst, int dstWidth) {
+    const SrgbTables& tables = srgb_tables();
+    const float32x4_t scale = vdupq_n_f32((float)LINEAR_TO_SRGB_SIZE);
+    int x = 0;
+
+    for (; x < dstWidth; x++) {
+        const unsigned char* a = r0 + x * 8;
+        const unsigned char* b = r1 + x * 8;
+        float32x4_t sum = vaddq_f32(decode_pixel_neon(tables.toLinear, a), decode_pixel_neon(tables.toLinear, a + 4));
+        sum = vaddq_f32(sum, decode_pixel_neon(tables.toLinear, b));
+        sum = vaddq_f32(sum, decode_pixel_neon(tables.toLinear, b + 4));
+        float32x4_t linear = vminq_f32(vmaxq_f32(vmulq_n_f32(sum, 0.25f), vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+        int32x4_t index = vcvtq_s32_f32(vaddq_f32(vmulq_f32(linear, scale), vdupq_n_f32(0.5f)));
+
+        dst[x * 4] = tables.toSrgb[vgetq_lane_s32(index, 0)];
+        dst[x * 4 + 1] = tables.toSrgb[vgetq_lane_s32(index, 1)];
+        dst[x * 4 + 2] = tables.toSrgb[vgetq_lane_s32(index, 2)];
+        dst[x * 4 + 3] = (unsigned char)((a[3] + a[7] + b[3] + b[7] + 2) >> 2);
+    }
+
+    return x;
+}
+#endif
+
+
+/**
+ * @brief Average 2x2 blocks of two source rows into one destination row.
+ *
+ * @param row0 First source row, at least 2 * dstWidth pixels.
+ * @param row1 Second source row, may equal row0.
+ * @param dst Destination row.
+ * @param dstWidth Destination width in pixels.
+ * @param srgb Average the color channels in linear light.
+ */
+void downsample_row(const unsigned char* row0, const unsigned char* row1, unsigned char* dst, int dstWidth, bool srgb) {
+    int done = 0;
+#if defined(IMAGE_SIMD_X86)
+    static const bool avx2 = cpu_has_avx2();
+    if (srgb) {
+        done = avx2 ? box_row_srgb_avx2(row0, row1, dst, dstWidth) : box_row_srgb_sse2(row0, row1, dst, dstWidth);
+    }
+    else {
+        done = avx2 ? box_row_avx2(row0, row1, dst, dstWidth) : box_row_sse2(row0, row1, dst, dstWidth);
+    }
+#elif defined(IMAGE_SIMD_NEON)
+    done = srgb ? box_row_srgb_neon(row0, row1, dst, dstWidth) : box_row_neon(row0, row1, dst, dstWidth);
+#endif
+    if (srgb) {
+        box_row_srgb(row0, row1, dst, done, dstWidth);
+    }
+    else {
+        box_row_scalar(row0, row1, dst, done, dstWidth);
+    }
+}
+
+/**
+ * @brief Halve an RGBA8 image with a 2x2 box filter. Odd sizes drop the last row/column, and
+ * a dimension of 1 stays 1.
+ *
+ * @param src Source pixels.
+ * @param width Source width.
+ * @param height Source height.
+ * @param srgb Average the color channels in linear light.
+ * @return std::vector<unsigned char> Pixels of size max(1, width / 2) x max(1, height / 2).
+ */
+std::vector<unsigned char> downsample_image(const unsigned char* src, int width, int height, bool srgb) {
+    int newWidth = std::max(1, width / 2);
+    int newHeight = std::max(1, height / 2);
+    std::vector<unsigned char> dst((size_t)newWidth * newHeight * 4);
+
+    // A single column is widened to two identical ones so the row kernels apply.
+    std::vector<unsigned char> widened;
+    if (width == 1) {
+        widened.resize((size_t)height * 8);
+        for (int y = 0; y < height; y++) {
+            std::copy(src + y * 4, src + y * 4 + 4, &widened[y * 8]);
+            std::copy(src + y * 4, src + y * 4 + 4, &widened[y * 8 + 4]);
+        }
+        src = widened.data();
+        width = 2;
+    }
+
+    for (int y = 0; y < newHeight; y++) {
+        const unsigned char* row0 = src + (size_t)std::min(y * 2, height - 1) * width * 4;
+        const unsigned char* row1 = src + (size_t)std::min(y * 2 + 1, height - 1) * width * 4;
+        downsample_row(row0, row1, &dst[(size_t)y * newWidth * 4], newWidth, srgb);
+    }
+
+    return dst;
+}
+
+
+// Kaiser filter
+//---------------
+
+static double bessel_i0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// Weights of a Kaiser windowed sinc for 2:1 reduction. Six taps, at source texel offsets
+// -2.5 ... 2.5 from the destination texel center.
+struct KaiserWeights {
+    float weights[6];
+
+    KaiserWeights() {
+        const double alpha = 4.0, radius = 1.5;
+        const double pi = 3.14159265358979323846;
+        double total = 0.0;
+        for (int i = 0; i < 6; i++) {
+            double x = (i - 2.5) / 2.0;     // destination texel units
+            double sinc = std::sin(pi * x) / (pi * x);
+            double r = x / radius;
+            double window = bessel_i0(alpha * std::sqrt(std::max(0.0, 1.0 - r * r))) / bessel_i0(alpha);
+            weights[i] = (float)(sinc * window);
+            total += weights[i];
+        }
+        for (float& w : weights) {
+            w = (float)(w / total);
+        }
+    }
+};
+
+static const float* kaiser_weights() {
+    static const KaiserWeights kaiser;
+    return kaiser.weights;
+}
+
+static std::vector<unsigned char> kaiser_downsample(const unsigned char* src, int width, int height, bool srgb) {
+    int newWidth = std::max(1, width / 2);
+    int newHeight = std::max(1, height / 2);
+    const float* w = kaiser_weights();
+    const float* toLinear = srgb_tables().toLinear;
+
+    auto decode = [&](unsigned char v, int c) {
+        return (srgb && c < 3) ? toLinear[v] : v / 255.0f;
+    };
+
+    // Horizontal pass into linear floats, then vertical pass. Edges clamp.
+    std::vector<glm::vec4> horizontal((size_t)newWidth * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < newWidth; x++) {
+            glm::vec4 sum(0.0f);
+            for (int t = 0; t < 6; t++) {
+                int sx = std::clamp(2 * x - 2 + t, 0, width - 1);
+                const unsigned char* p = src + ((size_t)y * width + sx) * 4;
+                sum += w[t] * glm::vec4(decode(p[0], 0), decode(p[1], 1), decode(p[2], 2), decode(p[3], 3));
+            }
+            horizontal[(size_t)y * newWidth + x] = sum;
+        }
+    }
+
+    std::vector<unsigned char> dst((size_t)newWidth * newHeight * 4);
+    for (int y = 0; y < newHeight; y++) {
+        for (int x = 0; x < newWidth; x++) {
+            glm::vec4 sum(0.0f);
+            for (int t = 0; t < 6; t++) {
+                int sy = std::clamp(2 * y - 2 + t, 0, height - 1);
+                sum += w[t] * horizontal[(size_t)sy * newWidth + x];
+            }
+
+            unsigned char* p = &dst[((size_t)y * newWidth + x) * 4];
+            for (int c = 0; c < 4; c++) {
+                p[c] = (srgb && c < 3) ? encode_srgb(sum[c])
+                    : (unsigned char)std::lround(std::clamp(sum[c], 0.0f, 1.0f) * 255.0f);
+            }
+        }
+    }
+
+    return dst;
+}
+
+
+/**
+ * @brief Build the complete mip chain of an RGBA8 image on the CPU.
+ *
+ * @param src Level 0 pixels.
+ * @param width Level 0 width.
+ * @param height Level 0 height.
+ * @param srgb The color channels are sRGB encoded and are filtered in linear light.
+ * @param filter MipFilter::BOX (fast, SIMD) or MipFilter::KAISER (sharper).
+ * @return std::vector<std::vector<unsigned char>> Every level down to 1x1, level 0 included.
+ */
+std::vector<std::vector<unsigned char>> generate_mipmaps(const unsigned char* src, int width, int height, bool srgb, MipFilter filter) {
+    std::vector<std::vector<unsigned char>> mips;
+    mips.emplace_back(src, src + (size_t)width * height * 4);
+
+    while (width > 1 || height > 1) {
+        // The kernel needs a few texels to work with, the last levels are boxed.
+        bool kaiser = filter == MipFilter::KAISER && width >= 4 && height >= 4;
+        mips.push_back(kaiser ? kaiser_downsample(mips.back().data(), width, height, srgb)
+            : downsample_image(mips.back().data(), width, height, srgb));
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+
+    return mips;
+}
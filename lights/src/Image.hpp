@@ -0,0 +1,24 @@
+/**
+ * @file Image.hpp
+ * @author Rohan Siddhu
+ * @brief CPU side image operations on RGBA8 pixel data.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+enum class MipFilter {
+    BOX,
+    KAISER
+};
+
+const float* srgb_to_linear_table();
+std::vector<unsigned char> resample_image(const unsigned char* src, int width, int height, int newWidth, int newHeight);
+std::vector<unsigned char> downsample_image(const unsigned char* src, int width, int height, bool srgb = false);
+void downsample_row(const unsigned char* row0, const unsigned char* row1, unsigned char* dst, int dstWidth, bool srgb);
+std::vector<std::vector<unsigned char>> generate_mipmaps(const unsigned char* src, int width, int height,
+    bool srgb, MipFilter filter = MipFilter::BOX);
@@ -0,0 +1,100 @@
+/**
+ * @file MappedFile.cpp
+ * @author Rohan Siddhu
+ * @brief MappedFile class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+/**
+ * @brief Map the whole file into memory. Pages are faulted in from disk on first access.
+ *
+ * @param path Path to the file.
+ * @return bool true on success.
+ */
+bool MappedFile::open(const char* path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(f, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(f);
+        return false;
+    }
+
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = m ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (m) {
+            CloseHandle(m);
+        }
+        CloseHandle(f);
+        return false;
+    }
+
+    file = f;
+    mapping = m;
+    address = (const unsigned char*)view;
+    length = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);    // The mapping keeps its own reference to the file.
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    address = (const unsigned char*)view;
+    length = (size_t)st.st_size;
+#endif
+
+    return true;
+}
+
+void MappedFile::close() {
+    if (!address) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(address);
+    CloseHandle((HANDLE)mapping);
+    CloseHandle((HANDLE)file);
+    file = nullptr;
+    mapping = nullptr;
+#else
+    munmap((void*)address, length);
+#endif
+
+    address = nullptr;
+    length = 0;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file MappedFile.hpp
+ * @author Rohan Siddhu
+ * @brief Read only memory mapped file.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <cstddef>
+
+class MappedFile {
+private:
+    const unsigned char* address = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const char* path);
+    void close();
+
+    bool isOpen() const { return address != nullptr; }
+    const unsigned char* data() const { return address; }
+    size_t size() const { return length; }
+};
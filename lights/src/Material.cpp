@@ -0,0 +1,140 @@
+/**
+ * @file Material.cpp
+ * @author Rohan Siddhu
+ * @brief MaterialLibrary class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Material.hpp"
+#include "Image.hpp"
+#include "stb_image.h"
+
+
+/**
+ * @brief Add a texture as a layer of the texture array. Textures are shared between materials,
+ * so adding the same path twice returns the same layer. Decoding is deferred to build().
+ *
+ * @param path Path to the texture, or nullptr for a black layer.
+ * @param srgb true for color textures, false for data such as specular maps.
+ * @return GLint Layer index.
+ */
+GLint MaterialLibrary::addTexture(const char* path, bool srgb) {
+    std::string key = path ? path : "";
+    for (size_t i = 0; i < layers.size(); i++) {
+        if (layers[i].path == key) {
+            return (GLint)i;
+        }
+    }
+
+    layers.push_back({ key, srgb });
+    return (GLint)layers.size() - 1;
+}
+
+/**
+ * @brief Register a material. Must be called before build().
+ *
+ * @param name Name of the material.
+ * @param diffusePath Path to the diffuse map.
+ * @param specularPath Path to the specular map, or nullptr for no specular highlights.
+ * @param shininess Specular exponent.
+ * @return GLint Material index to be stored per object, or -1 if the table is full.
+ */
+GLint MaterialLibrary::addMaterial(const char* name, const char* diffusePath, const char* specularPath, float shininess) {
+    if (materials.size() >= MAX_MATERIALS) {
+        std::cerr << "Too many materials, " << name << " ignored" << std::endl;
+        return -1;
+    }
+
+    GLint diffuse = addTexture(diffusePath, true);
+    GLint specular = addTexture(specularPath, false);
+
+    materials.push_back({ name, diffuse, specular, shininess });
+    return (GLint)materials.size() - 1;
+}
+
+/**
+ * @brief Decode one layer, scale it to MATERIAL_TEXTURE_SIZE and build its mip chain. Runs on
+ * the texture manager's workers.
+ */
+static std::vector<std::vector<unsigned char>> decode_layer(const std::string& path, bool srgb) {
+    std::vector<unsigned char> pixels;
+
+    int width, height, nrComponents;
+    unsigned char* img = path.empty() ? nullptr : stbi_load(path.c_str(), &width, &height, &nrComponents, 4);
+    if (img) {
+        if (width == MATERIAL_TEXTURE_SIZE && height == MATERIAL_TEXTURE_SIZE) {
+            pixels.assign(img, img + (size_t)width * height * 4);
+        }
+        else {
+            pixels = resample_image(img, width, height, MATERIAL_TEXTURE_SIZE, MATERIAL_TEXTURE_SIZE);
+        }
+        stbi_image_free(img);
+    }
+    else {
+        if (!path.empty()) {
+            std::cerr << "Failed to load texture: " << path << std::endl;
+        }
+        pixels.assign((size_t)MATERIAL_TEXTURE_SIZE * MATERIAL_TEXTURE_SIZE * 4, 0);
+    }
+
+    return generate_mipmaps(pixels.data(), MATERIAL_TEXTURE_SIZE, MATERIAL_TEXTURE_SIZE, srgb);
+}
+
+/**
+ * @brief Decode all layers in parallel and hand them to the texture manager as one streamable
+ * texture array, then upload the material table into a uniform buffer.
+ *
+ * @param manager Texture manager that owns the texture array.
+ */
+void MaterialLibrary::build(TextureManager& manager) {
+    std::vector<std::vector<std::vector<unsigned char>>> layerMips(layers.size());
+    manager.getPool().parallelFor((int)layers.size(), [&](int i) {
+        layerMips[i] = decode_layer(layers[i].path, layers[i].srgb);
+    });
+
+    // Each level holds all layers one after another, as glTexSubImage3D expects.
+    std::vector<std::vector<unsigned char>> mips(layerMips.empty() ? 0 : layerMips[0].size());
+    for (size_t m = 0; m < mips.size(); m++) {
+        for (auto& layer : layerMips) {
+            mips[m].insert(mips[m].end(), layer[m].begin(), layer[m].end());
+            std::vector<unsigned char>().swap(layer[m]);
+        }
+    }
+
+    textures = &manager;
+    textureArray = manager.create("materials", GL_TEXTURE_2D_ARRAY, MATERIAL_TEXTURE_SIZE, MATERIAL_TEXTURE_SIZE,
+        (int)layers.size(), std::move(mips));
+
+    glsl::Materials data {};
+    for (int i = 0; i < MAX_MATERIALS; i++) {
+        data.materials[i].shininess = 1.0f;
+    }
+    for (size_t i = 0; i < materials.size(); i++) {
+        data.materials[i].diffuseLayer = materials[i].diffuseLayer;
+        data.materials[i].specularLayer = materials[i].specularLayer;
+        data.materials[i].shininess = materials[i].shininess;
+    }
+
+    glGenBuffers(1, &materialBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, materialBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(data), &data, GL_STATIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+/**
+ * @brief Bind the texture array to a texture unit and the material table to MATERIAL_BLOCK_BINDING.
+ *
+ * @param unit Texture unit for the sampler2DArray.
+ */
+void MaterialLibrary::bind(GLuint unit) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textures->id(textureArray));
+    glBindBufferBase(GL_UNIFORM_BUFFER, MATERIAL_BLOCK_BINDING, materialBuffer);
+}
+
+// The texture array belongs to the texture manager and is deleted by it.
+void MaterialLibrary::clean() {
+    glDeleteBuffers(1, &materialBuffer);
+    materialBuffer = 0;
+}
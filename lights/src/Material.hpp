@@ -0,0 +1,61 @@
+/**
+ * @file Material.hpp
+ * @author Rohan Siddhu
+ * @brief Material library backed by texture arrays.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "ShaderBlocks.hpp"
+#include "TextureManager.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Every material texture is resampled to this size so that all of them fit in one
+// GL_TEXTURE_2D_ARRAY and objects with different materials can share a draw call.
+constexpr int MATERIAL_TEXTURE_SIZE = 512;
+
+// Must match the array size of the Materials uniform block in the shaders.
+constexpr int MAX_MATERIALS = 64;
+static_assert(sizeof(glsl::Materials::materials) / sizeof(glsl::Material) == MAX_MATERIALS,
+              "MAX_MATERIALS must match the array size of the Materials block");
+
+// Uniform block binding point of the material table.
+constexpr GLuint MATERIAL_BLOCK_BINDING = glsl::Materials::binding;
+
+struct Material {
+    std::string name;
+    GLint diffuseLayer;
+    GLint specularLayer;
+    float shininess;
+};
+
+class MaterialLibrary {
+private:
+    struct Layer {
+        std::string path;   /** Empty for a black layer. */
+        bool srgb;          /** Color data, filtered in linear light when building mipmaps. */
+    };
+
+    std::vector<Layer> layers;
+    std::vector<Material> materials;
+
+    TextureManager* textures = nullptr;
+    int textureArray = -1;      /** TextureManager handle of the GL_TEXTURE_2D_ARRAY. */
+    GLuint materialBuffer = 0;
+public:
+    GLint addTexture(const char* path, bool srgb);
+    GLint addMaterial(const char* name, const char* diffusePath, const char* specularPath, float shininess);
+    void build(TextureManager& manager);
+    void bind(GLuint unit);
+    void clean();
+
+    const std::vector<Material>& getMaterials() const { return materials; }
+    int textureHandle() const { return textureArray; }
+    GLsizei layerCount() const { return (GLsizei)layers.size(); }
+};
@@ -0,0 +1,205 @@
+/**
+ * @file Mesh.cpp
+ * @author Rohan Siddhu
+ * @brief Mesh class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Mesh.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <chrono>
+
+
+/**
+ * @brief Map a mesh file and upload it. There is no parsing, the streams after the header go to
+ * the GPU with a single glBufferData, so the cost is the page faults of the copy. The buffer is
+ * bound both as vertex and element buffer, the index stream is addressed by its offset.
+ * Attribute locations match the cube VAO: 0 position, 1 normal, 2 texture coordinates.
+ * Quantized formats are fetched as normalized integers and half floats. Meshes with meshlets
+ * also get a command buffer with one indirect draw per meshlet.
+ *
+ * @param path Path to a *.mesh file written by meshimport.
+ * @return bool true on success.
+ */
+bool Mesh::load(const char* path) {
+    auto start = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Failed to open mesh: " << path << std::endl;
+        return false;
+    }
+
+    MeshHeader fileHeader;
+    if (!read_mesh_header(file.data(), file.size(), fileHeader)) {
+        std::cerr << "Failed to load mesh, invalid file: " << path << std::endl;
+        return false;
+    }
+
+    clean();
+    header = fileHeader;
+    lods = read_mesh_lods(file.data(), header);
+    firstMeshlets.clear();
+    uint32_t firstMeshlet = 0;
+    for (const MeshLod& lod : lods) {
+        firstMeshlets.push_back(firstMeshlet);
+        firstMeshlet += lod.meshletCount;
+    }
+
+    size_t streamEnd = header.indexOffset + (size_t)header.indexCount * header.indexSize;
+    if (header.meshletCount > 0) {
+        streamEnd = header.meshletOffset + (size_t)header.meshletCount * sizeof(MeshMeshlet);
+    }
+    size_t streamBytes = streamEnd - header.vertexOffset;
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &buffer);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, streamBytes, file.data() + header.vertexOffset, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+
+    GLsizei stride = header.vertexStride;
+    switch (header.vertexFormat) {
+    case MESH_VERTEX_FLOAT:
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (const void*)offsetof(MeshVertex, position));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (const void*)offsetof(MeshVertex, normal));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (const void*)offsetof(MeshVertex, uv));
+        break;
+    case MESH_VERTEX_OCTAHEDRAL:
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (const void*)offsetof(MeshVertexQuantized, position));
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride, (const void*)offsetof(MeshVertexQuantized, normal));
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (const void*)offsetof(MeshVertexQuantized, uv));
+        break;
+    case MESH_VERTEX_PACKED:
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (const void*)offsetof(MeshVertexQuantized, position));
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (const void*)offsetof(MeshVertexQuantized, normal));
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (const void*)offsetof(MeshVertexQuantized, uv));
+        break;
+    }
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (header.meshletCount > 0) {
+        glGenBuffers(1, &commands);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, header.meshletCount * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    loadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+/**
+ * @brief Draw the mesh. Per instance attributes have to be set up on getVAO() beforehand.
+ * The vertex decode uniforms are set for the draw and reset afterwards, since the cubes share
+ * the program and use plain float vertices.
+ *
+ * @param shader Program in use, built from vertexShader.glsl.
+ * @param instanceCount Number of instances.
+ * @param lod Level of detail, 0 is full detail.
+ */
+void Mesh::draw(Shader& shader, GLsizei instanceCount, int lod) const {
+    setDecodeUniforms(shader, true);
+
+    glBindVertexArray(vao);
+    size_t offset = header.indexOffset - header.vertexOffset + (size_t)lods[lod].firstIndex * header.indexSize;
+    glDrawElementsInstanced(GL_TRIANGLES, lods[lod].indexCount, indexType(), (const void*)offset, instanceCount);
+
+    setDecodeUniforms(shader, false);
+}
+
+/**
+ * @brief Draw the meshlets of a level with a single glMultiDrawElementsIndirect. The commands
+ * are written by MeshletCuller::cull(), culled meshlets have an instance count of 0 and cost a
+ * command fetch but no vertex work. The caller issues the command barrier.
+ *
+ * @param shader Program in use, built from vertexShader.glsl.
+ * @param lod Level of detail, 0 is full detail.
+ */
+void Mesh::drawMeshlets(Shader& shader, int lod) const {
+    if (!commands || lods[lod].meshletCount == 0) {
+        draw(shader, 1, lod);
+        return;
+    }
+
+    setDecodeUniforms(shader, true);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, indexType(),
+        (const void*)(firstMeshlets[lod] * sizeof(DrawElementsIndirectCommand)), lods[lod].meshletCount, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    setDecodeUniforms(shader, false);
+}
+
+/**
+ * @brief Pick the coarsest level of detail whose error stays below a pixel threshold on screen.
+ * Coarser levels are only taken with a margin, finer ones as soon as the current level exceeds
+ * the threshold, so objects near a switching distance do not flicker between two levels.
+ *
+ * @param pixelsPerUnit Screen pixels per model unit at the object's distance.
+ * @param current Level drawn last frame.
+ * @param threshold Largest acceptable error in pixels.
+ * @param hysteresis Relative margin required to switch to a coarser level.
+ * @return int Level to draw.
+ */
+int Mesh::selectLod(float pixelsPerUnit, int current, float threshold, float hysteresis) const {
+    current = std::min(std::max(current, 0), (int)lods.size() - 1);
+
+    int lod = current;
+    for (int l = current + 1; l < (int)lods.size(); l++) {
+        if (lods[l].error * pixelsPerUnit * (1.0f + hysteresis) <= threshold) {
+            lod = l;
+        }
+    }
+    while (lod > 0 && lods[lod].error * pixelsPerUnit > threshold) {
+        lod--;
+    }
+    return lod;
+}
+
+void Mesh::clean() {
+    glDeleteBuffers(1, &commands);
+    glDeleteBuffers(1, &buffer);
+    glDeleteVertexArrays(1, &vao);
+    commands = 0;
+    buffer = 0;
+    vao = 0;
+}
+
+
+/*
+* Private Methods
+*/
+
+// Quantized positions are rescaled by the vertex shader. The uniforms are reset after the draw
+// since other geometry shares the program, float vertices rely on the defaults.
+void Mesh::setDecodeUniforms(Shader& shader, bool enable) const {
+    if (header.vertexFormat == MESH_VERTEX_FLOAT) {
+        return;
+    }
+
+    if (enable) {
+        glm::vec3 lo = boundsMin();
+        glm::vec3 extent = glm::max(boundsMax() - lo, glm::vec3(0.0f));
+        shader.setVec3("positionScale", glm::vec3(extent.x > 0.0f ? extent.x : 1.0f,
+            extent.y > 0.0f ? extent.y : 1.0f, extent.z > 0.0f ? extent.z : 1.0f));
+        shader.setVec3("positionOffset", lo);
+        shader.setInt("octahedralNormals", header.vertexFormat == MESH_VERTEX_OCTAHEDRAL);
+    }
+    else {
+        shader.setVec3("positionScale", glm::vec3(1.0f));
+        shader.setVec3("positionOffset", glm::vec3(0.0f));
+        shader.setInt("octahedralNormals", 0);
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file Mesh.hpp
+ * @author Rohan Siddhu
+ * @brief Indexed mesh loaded from a binary mesh file.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "MeshFile.hpp"
+#include "Shader.hpp"
+#include <iostream>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Layout of a single command in GL_DRAW_INDIRECT_BUFFER for glMultiDrawElementsIndirect.
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+class Mesh {
+private:
+    MeshHeader header {};
+    std::vector<MeshLod> lods;  /** Finest level first. */
+    std::vector<uint32_t> firstMeshlets;    /** Per level. */
+    GLuint vao = 0;
+    GLuint buffer = 0;      /** Vertex, index and meshlet streams, as laid out in the file. */
+    GLuint commands = 0;    /** One DrawElementsIndirectCommand per meshlet, written by MeshletCuller. */
+    double loadTime = 0.0;  /** Milliseconds from open to upload. */
+public:
+    bool load(const char* path);
+    void draw(Shader& shader, GLsizei instanceCount = 1, int lod = 0) const;
+    void drawMeshlets(Shader& shader, int lod = 0) const;
+    int selectLod(float pixelsPerUnit, int current, float threshold, float hysteresis) const;
+    void clean();
+
+    GLuint getVAO() const { return vao; }
+    GLuint getBuffer() const { return buffer; }
+    GLuint getCommandBuffer() const { return commands; }
+    uint32_t vertexCount() const { return header.vertexCount; }
+    uint32_t triangleCount(int lod = 0) const { return lods[lod].indexCount / 3; }
+    const std::vector<MeshLod>& getLods() const { return lods; }
+    bool hasMeshlets() const { return header.meshletCount > 0; }
+    uint32_t meshletCount(int lod = 0) const { return lods[lod].meshletCount; }
+    uint32_t firstMeshlet(int lod = 0) const { return firstMeshlets[lod]; }
+    size_t meshletOffset() const { return header.meshletOffset - header.vertexOffset; }
+    size_t meshletBytes() const { return (size_t)header.meshletCount * sizeof(MeshMeshlet); }
+    uint32_t indexBase() const { return (uint32_t)((header.indexOffset - header.vertexOffset) / header.indexSize); }
+    GLenum indexType() const { return header.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT; }
+    uint32_t vertexStride() const { return header.vertexStride; }
+    uint32_t vertexFormat() const { return header.vertexFormat; }
+    glm::vec3 boundsMin() const { return glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]); }
+    glm::vec3 boundsMax() const { return glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]); }
+    double getLoadTime() const { return loadTime; }
+private:
+    void setDecodeUniforms(Shader& shader, bool enable) const;
+};
@@ -0,0 +1,278 @@
+/**
+ * @file MeshFile.cpp
+ * @author Rohan Siddhu
+ * @brief Mesh file writer and validation.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "MeshFile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <glm/gtc/packing.hpp>
+
+static_assert(sizeof(MeshHeader) == 88, "MeshHeader is read straight from the file");
+static_assert(sizeof(MeshVertex) == 32, "MeshVertex is uploaded straight from the file");
+static_assert(sizeof(MeshVertexQuantized) == 16, "MeshVertexQuantized is uploaded straight from the file");
+static_assert(sizeof(MeshMeshlet) == 48, "MeshMeshlet is read by the culling shader straight from the file");
+
+static uint64_t align_stream(uint64_t offset) {
+    return (offset + MESH_STREAM_ALIGNMENT - 1) / MESH_STREAM_ALIGNMENT * MESH_STREAM_ALIGNMENT;
+}
+
+// Octahedral mapping: project onto the octahedron |x| + |y| + |z| = 1 and fold the lower half
+// over the diagonals, so a unit vector fits into the [-1, 1] square.
+static glm::vec2 octahedral_encode(glm::vec3 n) {
+    n /= std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    glm::vec2 e(n.x, n.y);
+    if (n.z < 0.0f) {
+        e = glm::vec2((1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                      (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+    }
+    return e;
+}
+
+static glm::vec3 octahedral_decode(glm::vec2 e) {
+    glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+
+// Scale of the unorm16 positions, degenerate axes get 1 so they decode to boundsMin.
+static glm::vec3 position_extent(const MeshHeader& header) {
+    glm::vec3 extent;
+    for (int i = 0; i < 3; i++) {
+        extent[i] = header.boundsMax[i] > header.boundsMin[i] ? header.boundsMax[i] - header.boundsMin[i] : 1.0f;
+    }
+    return extent;
+}
+
+static MeshVertexQuantized quantize_vertex(const MeshVertex& v, const MeshHeader& header) {
+    glm::vec3 lo(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    glm::vec3 p = glm::clamp((v.position - lo) / position_extent(header), 0.0f, 1.0f);
+
+    MeshVertexQuantized q;
+    q.position[0] = (uint16_t)std::lround(p.x * 65535.0f);
+    q.position[1] = (uint16_t)std::lround(p.y * 65535.0f);
+    q.position[2] = (uint16_t)std::lround(p.z * 65535.0f);
+    q.position[3] = 0;
+
+    glm::vec3 n = glm::dot(v.normal, v.normal) > 0.0f ? glm::normalize(v.normal) : glm::vec3(0.0f, 0.0f, 1.0f);
+    if (header.vertexFormat == MESH_VERTEX_OCTAHEDRAL) {
+        q.normal = glm::packSnorm2x16(octahedral_encode(n));
+    }
+    else {
+        q.normal = glm::packSnorm3x10_1x2(glm::vec4(n, 0.0f));
+    }
+    q.uv = glm::packHalf2x16(v.uv);
+    return q;
+}
+
+/**
+ * @brief Bytes per vertex of a vertex format.
+ */
+uint32_t mesh_vertex_stride(MeshVertexFormat format) {
+    return format == MESH_VERTEX_FLOAT ? sizeof(MeshVertex) : sizeof(MeshVertexQuantized);
+}
+
+/**
+ * @brief Write an indexed mesh. Indices are narrowed to 16 bits when every vertex fits.
+ *
+ * @param path Output file.
+ * @param mesh Vertices and triangle list.
+ * @param format Vertex layout to store, the quantized ones halve the vertex stream.
+ * @return bool true on success.
+ */
+bool write_mesh_file(const char* path, const MeshData& mesh, MeshVertexFormat format) {
+    MeshHeader header {};
+    std::memcpy(header.magic, "MESH", 4);
+    header.version = MESH_VERSION;
+    header.vertexFormat = format;
+    header.vertexStride = mesh_vertex_stride(format);
+    header.vertexCount = (uint32_t)mesh.vertices.size();
+    header.indexCount = (uint32_t)mesh.indices.size();
+    header.indexSize = mesh.vertices.size() <= 0xFFFF ? 2 : 4;
+
+    std::vector<MeshLod> lods = mesh.lods;
+    if (lods.empty()) {
+        lods.push_back({ 0, header.indexCount, 0.0f, (uint32_t)mesh.meshlets.size() });
+    }
+    header.lodCount = (uint32_t)std::min<size_t>(lods.size(), MESH_MAX_LODS);
+    lods.resize(header.lodCount);
+    header.meshletCount = 0;
+    for (const MeshLod& lod : lods) {
+        header.meshletCount += lod.meshletCount;
+    }
+    if (header.meshletCount > mesh.meshlets.size()) {
+        std::cerr << "Failed to write mesh file, the LOD table refers to missing meshlets: " << path << std::endl;
+        return false;
+    }
+
+    header.vertexOffset = align_stream(sizeof(MeshHeader) + lods.size() * sizeof(MeshLod));
+    header.indexOffset = align_stream(header.vertexOffset + (uint64_t)header.vertexCount * header.vertexStride);
+    header.meshletOffset = align_stream(header.indexOffset + (uint64_t)header.indexCount * header.indexSize);
+
+    glm::vec3 lo(mesh.vertices.empty() ? 0.0f : INFINITY);
+    glm::vec3 hi(mesh.vertices.empty() ? 0.0f : -INFINITY);
+    for (const MeshVertex& v : mesh.vertices) {
+        lo = glm::min(lo, v.position);
+        hi = glm::max(hi, v.position);
+    }
+    std::memcpy(header.boundsMin, &lo, sizeof(header.boundsMin));
+    std::memcpy(header.boundsMax, &hi, sizeof(header.boundsMax));
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to create mesh file: " << path << std::endl;
+        return false;
+    }
+
+    static const char zeros[MESH_STREAM_ALIGNMENT] = {};
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)lods.data(), lods.size() * sizeof(MeshLod));
+    out.write(zeros, header.vertexOffset - sizeof(header) - lods.size() * sizeof(MeshLod));
+    if (format == MESH_VERTEX_FLOAT) {
+        out.write((const char*)mesh.vertices.data(), (std::streamsize)mesh.vertices.size() * sizeof(MeshVertex));
+    }
+    else {
+        std::vector<MeshVertexQuantized> quantized(mesh.vertices.size());
+        for (size_t i = 0; i < mesh.vertices.size(); i++) {
+            quantized[i] = quantize_vertex(mesh.vertices[i], header);
+        }
+        out.write((const char*)quantized.data(), (std::streamsize)quantized.size() * sizeof(MeshVertexQuantized));
+    }
+    out.write(zeros, header.indexOffset - (header.vertexOffset + (uint64_t)header.vertexCount * header.vertexStride));
+
+    if (header.indexSize == 2) {
+        std::vector<uint16_t> narrow(mesh.indices.begin(), mesh.indices.end());
+        out.write((const char*)narrow.data(), (std::streamsize)narrow.size() * sizeof(uint16_t));
+    }
+    else {
+        out.write((const char*)mesh.indices.data(), (std::streamsize)mesh.indices.size() * sizeof(uint32_t));
+    }
+    out.write(zeros, header.meshletOffset - (header.indexOffset + (uint64_t)header.indexCount * header.indexSize));
+    out.write((const char*)mesh.meshlets.data(), (std::streamsize)header.meshletCount * sizeof(MeshMeshlet));
+
+    if (!out) {
+        std::cerr << "Failed to write mesh file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Size of the header of a file version. Version 3 appended the meshlet stream fields.
+ */
+size_t mesh_header_size(uint32_t version) {
+    return version >= 3 ? sizeof(MeshHeader) : offsetof(MeshHeader, meshletOffset);
+}
+
+/**
+ * @brief Check that a mapped file is a complete mesh file of a known version and read its
+ * header. Fields a version does not have are zero.
+ *
+ * @param data File contents.
+ * @param size File size in bytes.
+ * @param header Receives the header.
+ * @return bool false if the file is invalid.
+ */
+bool read_mesh_header(const unsigned char* data, size_t size, MeshHeader& header) {
+    header = MeshHeader {};
+    if (!data || size < offsetof(MeshHeader, meshletOffset)) {
+        return false;
+    }
+
+    std::memcpy(&header, data, offsetof(MeshHeader, meshletOffset));
+    if (std::memcmp(header.magic, "MESH", 4) != 0 || header.version < 1 || header.version > MESH_VERSION) {
+        return false;
+    }
+    size_t headerSize = mesh_header_size(header.version);
+    if (size < headerSize) {
+        return false;
+    }
+    std::memcpy(&header, data, headerSize);
+
+    if (header.lodCount > MESH_MAX_LODS || header.vertexOffset < headerSize + header.lodCount * sizeof(MeshLod)) {
+        return false;
+    }
+    if (header.vertexFormat > MESH_VERTEX_PACKED ||
+        header.vertexStride != mesh_vertex_stride((MeshVertexFormat)header.vertexFormat)) {
+        return false;
+    }
+    if (header.indexSize != 2 && header.indexSize != 4) {
+        return false;
+    }
+
+    uint64_t vertexEnd = header.vertexOffset + (uint64_t)header.vertexCount * header.vertexStride;
+    uint64_t indexEnd = header.indexOffset + (uint64_t)header.indexCount * header.indexSize;
+    uint64_t meshletEnd = header.meshletOffset + (uint64_t)header.meshletCount * sizeof(MeshMeshlet);
+    if (vertexEnd > header.indexOffset || indexEnd > size) {
+        return false;
+    }
+    if (header.meshletCount > 0 && (header.meshletOffset < indexEnd || meshletEnd > size)) {
+        return false;
+    }
+
+    uint64_t meshlets = 0;
+    for (const MeshLod& lod : read_mesh_lods(data, header)) {
+        if ((uint64_t)lod.firstIndex + lod.indexCount > header.indexCount) {
+            return false;
+        }
+        meshlets += lod.meshletCount;
+    }
+    return meshlets == header.meshletCount;
+}
+
+/**
+ * @brief LOD table of a validated mesh file, finest level first. Files without a table have a
+ * single level covering all indices, files before version 3 have no meshlets.
+ */
+std::vector<MeshLod> read_mesh_lods(const unsigned char* data, const MeshHeader& header) {
+    if (header.lodCount == 0) {
+        return { { 0, header.indexCount, 0.0f, 0 } };
+    }
+
+    std::vector<MeshLod> lods(header.lodCount);
+    std::memcpy(lods.data(), data + mesh_header_size(header.version), lods.size() * sizeof(MeshLod));
+    if (header.version < 3) {
+        for (MeshLod& lod : lods) {
+            lod.meshletCount = 0;
+        }
+    }
+    return lods;
+}
+
+/**
+ * @brief Read a vertex back as floats, decoding quantized formats the way the vertex shader does.
+ *
+ * @param header Header of the file.
+ * @param vertices Start of the vertex stream.
+ * @param index Vertex index.
+ * @return MeshVertex The decoded vertex.
+ */
+MeshVertex decode_mesh_vertex(const MeshHeader& header, const unsigned char* vertices, uint32_t index) {
+    MeshVertex v;
+    if (header.vertexFormat == MESH_VERTEX_FLOAT) {
+        std::memcpy(&v, vertices + (size_t)index * header.vertexStride, sizeof(v));
+        return v;
+    }
+
+    MeshVertexQuantized q;
+    std::memcpy(&q, vertices + (size_t)index * header.vertexStride, sizeof(q));
+
+    glm::vec3 lo(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    v.position = lo + glm::vec3(q.position[0], q.position[1], q.position[2]) / 65535.0f * position_extent(header);
+    if (header.vertexFormat == MESH_VERTEX_OCTAHEDRAL) {
+        v.normal = octahedral_decode(glm::unpackSnorm2x16(q.normal));
+    }
+    else {
+        v.normal = glm::normalize(glm::vec3(glm::unpackSnorm3x10_1x2(q.normal)));
+    }
+    v.uv = glm::unpackHalf2x16(q.uv);
+    return v;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file MeshFile.hpp
+ * @author Rohan Siddhu
+ * @brief Binary mesh format written by the import tool and memory mapped by the runtime.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// File layout: MeshHeader, the LOD table, then the vertex, index and meshlet streams. Streams
+// start at a multiple of MESH_STREAM_ALIGNMENT and are laid out exactly as the GPU consumes them,
+// so the runtime uploads all of them with a single glBufferData. The alignment also satisfies
+// GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, the meshlet stream is bound as a range of that buffer.
+constexpr uint32_t MESH_VERSION = 3;
+constexpr uint32_t MESH_STREAM_ALIGNMENT = 256;
+
+// Levels of detail share the vertex stream, each one is a range of the index stream.
+constexpr uint32_t MESH_MAX_LODS = 8;
+
+// Meshlets are small clusters of a level's triangles, culled one by one on the GPU. The limits
+// keep a meshlet's vertices and triangles within what a mesh shader workgroup could hold.
+constexpr uint32_t MESHLET_MAX_VERTICES = 64;
+constexpr uint32_t MESHLET_MAX_TRIANGLES = 124;
+
+// Vertex layouts stored in the vertex stream.
+enum MeshVertexFormat : uint32_t {
+    MESH_VERTEX_FLOAT = 0,          /** MeshVertex, 32 bytes. */
+    MESH_VERTEX_OCTAHEDRAL = 1,     /** MeshVertexQuantized, octahedral snorm16 normal, 16 bytes. */
+    MESH_VERTEX_PACKED = 2          /** MeshVertexQuantized, GL_INT_2_10_10_10_REV normal, 16 bytes. */
+};
+
+struct MeshHeader {
+    char magic[4];              /** "MESH" */
+    uint32_t version;
+    uint32_t vertexFormat;      /** MeshVertexFormat */
+    uint32_t vertexStride;      /** Bytes per vertex. */
+    uint32_t vertexCount;
+    uint32_t indexCount;        /** Triangle lists of all levels of detail. */
+    uint32_t indexSize;         /** 2 or 4 bytes. */
+    uint32_t lodCount;          /** Entries in the LOD table, 0 in version 1 files. */
+    uint64_t vertexOffset;      /** From the start of the file. */
+    uint64_t indexOffset;       /** From the start of the file. */
+    float boundsMin[3];         /** Quantized positions are relative to the bounds. */
+    float boundsMax[3];
+    uint64_t meshletOffset;     /** From the start of the file, version 3 and later. */
+    uint32_t meshletCount;      /** Meshlets of all levels of detail. */
+    uint32_t reserved;
+};
+
+struct MeshLod {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float error;                /** Deviation from the full detail surface, in model units. */
+    uint32_t meshletCount;      /** Meshlets of this level, they follow those of the finer levels. */
+};
+
+// A meshlet's triangles are a contiguous range of its level's index range. The layout matches a
+// std430 array of { vec4 sphere; vec4 cone; uvec4 range; } in the culling shader.
+struct MeshMeshlet {
+    float center[3];            /** Bounding sphere, model space. */
+    float radius;
+    float coneAxis[3];          /** Average facing of the triangles. */
+    float coneCutoff;           /** Sine of the normal cone angle, 1 if the cone can not be culled. */
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    uint32_t vertexCount;       /** Unique vertices referenced. */
+    uint32_t reserved;
+};
+
+// Same layout as the hard coded cube vertices: position, normal, texture coordinates.
+struct MeshVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 uv;
+};
+
+// Compact vertex, half the size of MeshVertex. The vertex shader decodes it.
+struct MeshVertexQuantized {
+    uint16_t position[4];   /** unorm16 between boundsMin and boundsMax, w unused. */
+    uint32_t normal;        /** Octahedral snorm16 x 2 or snorm 2_10_10_10, by format. */
+    uint32_t uv;            /** half x 2. */
+};
+
+// Indexed triangle list as produced by the importers. Without lods, indices is a single level.
+struct MeshData {
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<MeshLod> lods;
+    std::vector<MeshMeshlet> meshlets;
+};
+
+uint32_t mesh_vertex_stride(MeshVertexFormat format);
+bool write_mesh_file(const char* path, const MeshData& mesh, MeshVertexFormat format = MESH_VERTEX_FLOAT);
+size_t mesh_header_size(uint32_t version);
+bool read_mesh_header(const unsigned char* data, size_t size, MeshHeader& header);
+std::vector<MeshLod> read_mesh_lods(const unsigned char* data, const MeshHeader& header);
+MeshVertex decode_mesh_vertex(const MeshHeader& header, const unsigned char* vertices, uint32_t index);
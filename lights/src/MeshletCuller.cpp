@@ -0,0 +1,184 @@
+/**
+ * @file MeshletCuller.cpp
+ * @author Rohan Siddhu
+ * @brief MeshletCuller class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "MeshletCuller.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Build the culling and depth pyramid programs and the statistics buffers.
+ *
+ * @return bool false if the GL context has no compute shaders (before 4.3).
+ */
+bool MeshletCuller::init() {
+    if (!GLAD_GL_VERSION_4_3) {
+        std::cerr << "Failed to initialize meshlet culling, OpenGL 4.3 is required" << std::endl;
+        return false;
+    }
+
+    cullProgram.addShader(GL_COMPUTE_SHADER, "res/shaders/csMeshletCull.glsl");
+    cullProgram.createProgram();
+    pyramidProgram.addShader(GL_COMPUTE_SHADER, "res/shaders/csDepthPyramid.glsl");
+    pyramidProgram.createProgram();
+
+    GLuint zero[2] = { 0, 0 };
+    glGenBuffers(2, stats);
+    for (GLuint buffer : stats) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(zero), zero, GL_DYNAMIC_READ);
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    return true;
+}
+
+/**
+ * @brief Cull the meshlets of one level and write the mesh's indirect commands for
+ * Mesh::drawMeshlets(). The occlusion test uses the depth pyramid of the previous frame and is
+ * skipped until endFrame() has built one.
+ *
+ * @param mesh Mesh with meshlets.
+ * @param lod Level of detail to cull.
+ * @param model Model matrix of the single instance, uniformly scaled.
+ * @param frustum Camera frustum planes, CameraMatrices::frustum.
+ * @param cameraPosition Camera position, world space.
+ * @param countStats Add the visible meshlets and triangles to the statistics. Off for a second
+ * level culled in the same frame, the counters describe one level.
+ */
+void MeshletCuller::cull(const Mesh& mesh, int lod, const glm::mat4& model, const glm::vec4 frustum[6],
+    glm::vec3 cameraPosition, bool countStats) {
+    if (!mesh.hasMeshlets() || mesh.meshletCount(lod) == 0) {
+        return;
+    }
+
+    float scale = std::max(std::max(glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1]))),
+        glm::length(glm::vec3(model[2])));
+
+    cullProgram.use();
+    cullProgram.setInt("firstMeshlet", (GLint)mesh.firstMeshlet(lod));
+    cullProgram.setInt("meshletCount", (GLint)mesh.meshletCount(lod));
+    cullProgram.setInt("indexBase", (GLint)mesh.indexBase());
+    cullProgram.setMat4("model", glm::value_ptr(model));
+    cullProgram.setFloat("modelScale", scale);
+    cullProgram.setVec3("cameraPosition", cameraPosition);
+    cullProgram.setVec4Array("frustum", frustum, 6);
+    cullProgram.setInt("cullFrustum", cullFrustum);
+    cullProgram.setInt("cullCone", cullCone);
+    cullProgram.setInt("cullOcclusion", cullOcclusion && pyramidValid);
+    cullProgram.setInt("countStats", countStats);
+    cullProgram.setInt("depthPyramid", 0);
+    cullProgram.setVec2("pyramidSize", glm::vec2(std::max(depthWidth / 2, 1), std::max(depthHeight / 2, 1)));
+    cullProgram.setMat4("depthViewProjection", glm::value_ptr(pyramidViewProjection));
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, pyramid);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, mesh.getBuffer(), mesh.meshletOffset(), mesh.meshletBytes());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mesh.getCommandBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, stats[statsIndex]);
+
+    glDispatchCompute((mesh.meshletCount(lod) + 63) / 64, 1, 1);
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+}
+
+/**
+ * @brief Build the depth pyramid the next frame's occlusion test reads, from the depth buffer of
+ * the bound read framebuffer, and read back the statistics. Call after the opaque geometry.
+ *
+ * @param width Framebuffer width.
+ * @param height Framebuffer height.
+ * @param viewProjection Matrices the depth buffer was rendered with.
+ */
+void MeshletCuller::endFrame(int width, int height, const glm::mat4& viewProjection) {
+    // The counters were written a frame ago, so reading them rarely waits for the GPU.
+    int previous = 1 - statsIndex;
+    GLuint counts[2] = { 0, 0 };
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, stats[previous]);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(counts), counts);
+    visibleMeshlets = counts[0];
+    visibleTriangles = counts[1];
+    GLuint zero[2] = { 0, 0 };
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(zero), zero);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    statsIndex = previous;
+
+    if (width <= 0 || height <= 0) {
+        pyramidValid = false;
+        return;
+    }
+    if (width != depthWidth || height != depthHeight) {
+        resize(width, height);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, depthCopy);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height);
+
+    pyramidProgram.use();
+    pyramidProgram.setInt("source", 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    int sourceWidth = width, sourceHeight = height;
+    for (int level = 0; level < pyramidLevels; level++) {
+        int levelWidth = std::max(sourceWidth / 2, 1);
+        int levelHeight = std::max(sourceHeight / 2, 1);
+
+        glBindTexture(GL_TEXTURE_2D, level == 0 ? depthCopy : pyramid);
+        pyramidProgram.setInt("sourceLevel", level == 0 ? 0 : level - 1);
+        glBindImageTexture(0, pyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((levelWidth + 7) / 8, (levelHeight + 7) / 8, 1);
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+        sourceWidth = levelWidth;
+        sourceHeight = levelHeight;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    pyramidViewProjection = viewProjection;
+    pyramidValid = true;
+}
+
+void MeshletCuller::clean() {
+    cullProgram.clean();
+    pyramidProgram.clean();
+    glDeleteTextures(1, &depthCopy);
+    glDeleteTextures(1, &pyramid);
+    glDeleteBuffers(2, stats);
+    depthCopy = pyramid = 0;
+    stats[0] = stats[1] = 0;
+}
+
+
+/*
+* Private Methods
+*/
+
+void MeshletCuller::resize(int width, int height) {
+    glDeleteTextures(1, &depthCopy);
+    glDeleteTextures(1, &pyramid);
+
+    depthWidth = width;
+    depthHeight = height;
+    int pyramidWidth = std::max(width / 2, 1);
+    int pyramidHeight = std::max(height / 2, 1);
+    pyramidLevels = (int)std::floor(std::log2((float)std::max(pyramidWidth, pyramidHeight))) + 1;
+
+    glGenTextures(1, &depthCopy);
+    glBindTexture(GL_TEXTURE_2D, depthCopy);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glGenTextures(1, &pyramid);
+    glBindTexture(GL_TEXTURE_2D, pyramid);
+    glTexStorage2D(GL_TEXTURE_2D, pyramidLevels, GL_R32F, pyramidWidth, pyramidHeight);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    pyramidValid = false;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file MeshletCuller.hpp
+ * @author Rohan Siddhu
+ * @brief GPU meshlet culling against the frustum, normal cones and a depth pyramid.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "Mesh.hpp"
+#include "Shader.hpp"
+#include <iostream>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+class MeshletCuller {
+private:
+    Shader cullProgram;
+    Shader pyramidProgram;
+
+    // Depth pyramid of the previous frame, used by the occlusion test.
+    GLuint depthCopy = 0;       /** Depth buffer copy, GL_DEPTH_COMPONENT32F. */
+    GLuint pyramid = 0;         /** R32F, half resolution, farthest depth per texel. */
+    int depthWidth = 0, depthHeight = 0;
+    int pyramidLevels = 0;
+    bool pyramidValid = false;
+    glm::mat4 pyramidViewProjection = glm::mat4(1.0f);
+
+    // Visible meshlet and triangle counters, two so the one read back is a frame old.
+    GLuint stats[2] = { 0, 0 };
+    int statsIndex = 0;
+    GLuint visibleMeshlets = 0;
+    GLuint visibleTriangles = 0;
+public:
+    bool cullFrustum = true;
+    bool cullCone = true;
+    bool cullOcclusion = true;
+
+    bool init();
+    void cull(const Mesh& mesh, int lod, const glm::mat4& model, const glm::vec4 frustum[6], glm::vec3 cameraPosition,
+        bool countStats = true);
+    void endFrame(int width, int height, const glm::mat4& viewProjection);
+    void clean();
+
+    GLuint getVisibleMeshlets() const { return visibleMeshlets; }
+    GLuint getVisibleTriangles() const { return visibleTriangles; }
+private:
+    void resize(int width, int height);
+};
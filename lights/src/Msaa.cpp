@@ -0,0 +1,62 @@
+/**
+ * @file Msaa.cpp
+ * @author Rohan Siddhu
+ * @brief Msaa class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Msaa.hpp"
+
+bool Msaa::init() {
+    program.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    program.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsMsaaResolve.glsl");
+    program.createProgram();
+    glGenVertexArrays(1, &emptyVao);
+    return true;
+}
+
+/**
+ * @brief Declare the resolve of the multisampled scene targets into single sampled ones, in one
+ * fullscreen pass. Depth is resolved too, so SSAO and the depth pyramid work as without MSAA.
+ *
+ * @param graph Graph of the frame.
+ * @param color Multisampled scene color.
+ * @param ambient Multisampled ambient light, or -1.
+ * @param depth Multisampled depth.
+ * @param resolvedColor Single sampled targets, the same size.
+ * @param resolvedAmbient
+ * @param resolvedDepth
+ */
+void Msaa::addPass(RenderGraph& graph, int color, int ambient, int depth, int resolvedColor, int resolvedAmbient,
+    int resolvedDepth) {
+    int pass = graph.addPass("MSAA resolve", [this, &graph, color, ambient, depth]() {
+        glDepthFunc(GL_ALWAYS);
+        program.use();
+        program.setInt("samples", graph.desc(color).samples);
+        program.setInt("resolveAmbient", ambient >= 0);
+        GLuint textures[3] = { graph.texture(color), ambient >= 0 ? graph.texture(ambient) : 0, graph.texture(depth) };
+        for (int i = 0; i < 3; i++) {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, textures[i]);
+        }
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glDepthFunc(GL_LESS);
+    });
+    graph.read(pass, color, ACCESS_SAMPLED);
+    graph.read(pass, depth, ACCESS_SAMPLED);
+    graph.write(pass, resolvedColor, ACCESS_TARGET, 0);
+    graph.write(pass, resolvedDepth, ACCESS_TARGET);
+    if (ambient >= 0) {
+        graph.read(pass, ambient, ACCESS_SAMPLED);
+        graph.write(pass, resolvedAmbient, ACCESS_TARGET, 1);
+    }
+}
+
+void Msaa::clean() {
+    program.clean();
+    glDeleteVertexArrays(1, &emptyVao);
+    emptyVao = 0;
+}
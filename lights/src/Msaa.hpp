@@ -0,0 +1,25 @@
+/**
+ * @file Msaa.hpp
+ * @author Rohan Siddhu
+ * @brief Resolve of a multisampled scene for the passes after it, as a render graph pass.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "RenderGraph.hpp"
+#include "Shader.hpp"
+#include <glad/glad.h>
+
+constexpr int MSAA_SAMPLES = 4;
+
+class Msaa {
+private:
+    Shader program;
+    GLuint emptyVao = 0;
+public:
+    bool init();
+    void addPass(RenderGraph& graph, int color, int ambient, int depth, int resolvedColor, int resolvedAmbient, int resolvedDepth);
+    void clean();
+};
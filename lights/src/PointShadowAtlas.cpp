@@ -0,0 +1,198 @@
+/**
+ * @file PointShadowAtlas.cpp
+ * @author Rohan Siddhu
+ * @brief PointShadowAtlas class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "PointShadowAtlas.hpp"
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+
+/**
+ * @brief Allocate the whole budget up front: one cube map array with a cube per slot. Every slot
+ * gets a cube map view of its layers, so rendering and clearing one slot leaves the cached
+ * contents of the others alone.
+ *
+ * @param resolution Texels per side of a cube face.
+ * @param slotCount Number of lights that can be shadowed at once.
+ * @return bool false if the GL context has no texture views (before 4.3).
+ */
+bool PointShadowAtlas::init(int resolution, int slotCount) {
+    if (!GLAD_GL_VERSION_4_3) {
+        std::cerr << "Failed to initialize point light shadows, OpenGL 4.3 is required" << std::endl;
+        return false;
+    }
+    this->resolution = resolution;
+    slots.resize(std::max(slotCount, 1));
+
+    glGenTextures(1, &cubeArray);
+    glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, cubeArray);
+    glTexStorage3D(GL_TEXTURE_CUBE_MAP_ARRAY, 1, GL_DEPTH_COMPONENT32F, resolution, resolution, (GLsizei)slots.size() * 6);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, 0);
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    GLint previous = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous);
+    GLenum status = GL_FRAMEBUFFER_COMPLETE;
+    for (int i = 0; i < (int)slots.size(); i++) {
+        glGenTextures(1, &slots[i].view);
+        glTextureView(slots[i].view, GL_TEXTURE_CUBE_MAP, cubeArray, GL_DEPTH_COMPONENT32F, 0, 1, i * 6, 6);
+
+        glGenFramebuffers(1, &slots[i].fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, slots[i].fbo);
+        glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, slots[i].view, 0);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        if (status == GL_FRAMEBUFFER_COMPLETE) {
+            status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        }
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, previous);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Failed to create point shadow framebuffer" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void PointShadowAtlas::beginFrame() {
+    frame++;
+    requested = 0;
+    rendered = 0;
+}
+
+/**
+ * @brief Find the slot of a light for this frame. Lights are requested in order of importance:
+ * a light keeps its slot (and its cached map) while it is requested every frame, a new one takes
+ * a free slot or the one least recently used, and once every slot is taken this frame the rest
+ * go without shadows.
+ *
+ * @param light Caller's id of the light.
+ * @param position Light position, world space.
+ * @param range Distance beyond which the light has no effect, the far plane of its cube.
+ * @return int Slot, or -1 if the budget is used up.
+ */
+int PointShadowAtlas::request(int light, glm::vec3 position, float range) {
+    int found = -1;
+    for (int i = 0; i < (int)slots.size() && found < 0; i++) {
+        if (slots[i].light == light) {
+            found = i;
+        }
+    }
+
+    if (found < 0) {
+        for (int i = 0; i < (int)slots.size(); i++) {
+            if (slots[i].lastUsed == frame) {
+                continue;
+            }
+            if (found < 0 || slots[i].light < 0 ||
+                (slots[found].light >= 0 && slots[i].lastUsed < slots[found].lastUsed)) {
+                found = i;
+            }
+        }
+        if (found < 0) {
+            return -1;
+        }
+        slots[found].light = light;
+        slots[found].valid = false;
+    }
+
+    Slot& slot = slots[found];
+    if (slot.position != position || slot.range != range) {
+        slot.position = position;
+        slot.range = range;
+        slot.valid = false;
+    }
+    slot.lastUsed = frame;
+    requested++;
+    return found;
+}
+
+bool PointShadowAtlas::needsRender(int slot) const {
+    return !slots[slot].valid || slots[slot].revision != casterRevision;
+}
+
+/**
+ * @brief Start rendering a slot. Sets the uniforms of the point shadow program: one matrix per
+ * cube face for the geometry shader, which sends every triangle to the faces it touches, and the
+ * light position and range for the stored distance.
+ *
+ * @param slot Slot returned by request().
+ * @param shader Program made of vsPointShadow, gsPointShadow and fsPointShadow.
+ */
+void PointShadowAtlas::begin(int slot, Shader& shader) {
+    glGetIntegerv(GL_VIEWPORT, savedViewport);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &savedFramebuffer);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, slots[slot].fbo);
+    glViewport(0, 0, resolution, resolution);
+    glClear(GL_DEPTH_BUFFER_BIT);
+
+    // Face order and orientation of GL cube maps.
+    static const glm::vec3 targets[6] = { { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+                                          { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+    static const glm::vec3 ups[6] = { { 0.0f, -1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+                                      { 0.0f, 0.0f, -1.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f } };
+
+    const Slot& s = slots[slot];
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.05f, s.range);
+    glm::mat4 faces[6];
+    for (int f = 0; f < 6; f++) {
+        faces[f] = projection * glm::lookAt(s.position, s.position + targets[f], ups[f]);
+    }
+    shader.setMat4Array("faceMatrices", faces, 6);
+    shader.setVec3("lightPosition", s.position);
+    shader.setFloat("lightRange", s.range);
+}
+
+void PointShadowAtlas::end(int slot) {
+    slots[slot].valid = true;
+    slots[slot].revision = casterRevision;
+    rendered++;
+    glBindFramebuffer(GL_FRAMEBUFFER, savedFramebuffer);
+    glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+}
+
+/**
+ * @brief Every caster changed, re-render all slots.
+ */
+void PointShadowAtlas::invalidate() {
+    casterRevision++;
+}
+
+/**
+ * @brief A caster moved, re-render the slots whose light reaches it. Call with the bounds at both
+ * the old and the new place.
+ *
+ * @param center Bounding sphere centre, world space.
+ * @param radius Bounding sphere radius.
+ */
+void PointShadowAtlas::invalidate(glm::vec3 center, float radius) {
+    for (Slot& slot : slots) {
+        if (slot.light >= 0 && glm::length(center - slot.position) < slot.range + radius) {
+            slot.valid = false;
+        }
+    }
+}
+
+void PointShadowAtlas::bind() const {
+    glActiveTexture(GL_TEXTURE0 + POINT_SHADOW_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, cubeArray);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void PointShadowAtlas::clean() {
+    for (Slot& slot : slots) {
+        glDeleteFramebuffers(1, &slot.fbo);
+        glDeleteTextures(1, &slot.view);
+    }
+    slots.clear();
+    glDeleteTextures(1, &cubeArray);
+    cubeArray = 0;
+}
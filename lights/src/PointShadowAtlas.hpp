@@ -0,0 +1,60 @@
+/**
+ * @file PointShadowAtlas.hpp
+ * @author Rohan Siddhu
+ * @brief Cached cube shadow maps for point lights, in a fixed budget of slots.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "Shader.hpp"
+#include <iostream>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Texture unit of the cube map array, must match the pointShadowMaps sampler in the shaders.
+constexpr GLuint POINT_SHADOW_TEXTURE_UNIT = 4;
+
+class PointShadowAtlas {
+private:
+    // A cube of the array and the light it belongs to.
+    struct Slot {
+        int light = -1;                 /** Owner, -1 while free. */
+        glm::vec3 position = glm::vec3(0.0f);
+        float range = 0.0f;
+        bool valid = false;             /** Holds the shadow of its light as last rendered. */
+        unsigned revision = 0;          /** Caster revision it was rendered at. */
+        unsigned lastUsed = 0;          /** Frame it was last requested in. */
+        GLuint view = 0;                /** GL_TEXTURE_CUBE_MAP view of the slot's 6 layers. */
+        GLuint fbo = 0;                 /** Layered framebuffer on the view. */
+    };
+
+    GLuint cubeArray = 0;       /** GL_TEXTURE_CUBE_MAP_ARRAY, distance to the light over its range. */
+    std::vector<Slot> slots;
+    int resolution = 0;
+    unsigned frame = 0;
+    unsigned casterRevision = 1;
+    int requested = 0;
+    int rendered = 0;
+    GLint savedViewport[4];
+    GLint savedFramebuffer = 0;
+public:
+    bool init(int resolution = 512, int slotCount = 8);
+    void beginFrame();
+    int request(int light, glm::vec3 position, float range);
+    bool needsRender(int slot) const;
+    void begin(int slot, Shader& shader);
+    void end(int slot);
+    void invalidate();
+    void invalidate(glm::vec3 center, float radius);
+    void bind() const;
+    void clean();
+
+    int slotCount() const { return (int)slots.size(); }
+    GLuint getTexture() const { return cubeArray; }
+    int requestedSlots() const { return requested; }
+    int renderedSlots() const { return rendered; }
+    size_t videoMemory() const { return (size_t)resolution * resolution * 6 * slots.size() * 4; }
+};
@@ -0,0 +1,531 @@
+/**
+ * @file RenderGraph.cpp
+ * @author Rohan Siddhu
+ * @brief RenderGraph class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "RenderGraph.hpp"
+#include <algorithm>
+#include <queue>
+
+/**
+ * @brief Bytes per texel of the formats render targets use.
+ */
+size_t texture_format_size(GLenum format) {
+    switch (format) {
+        case GL_R8:
+            return 1;
+        case GL_R16F:
+        case GL_RG8:
+        case GL_DEPTH_COMPONENT16:
+            return 2;
+        case GL_RGBA16F:
+        case GL_RG32F:
+        case GL_DEPTH32F_STENCIL8:
+            return 8;
+        case GL_RGBA32F:
+            return 16;
+        default:
+            return 4;
+    }
+}
+
+static bool is_depth_format(GLenum format) {
+    return format == GL_DEPTH_COMPONENT16 || format == GL_DEPTH_COMPONENT24 || format == GL_DEPTH_COMPONENT32F ||
+           format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+}
+
+// Barrier that makes incoherent writes visible to a later access of the given kind.
+static GLbitfield barrier_bit(RenderAccess access) {
+    switch (access) {
+        case ACCESS_SAMPLED:
+            return GL_TEXTURE_FETCH_BARRIER_BIT;
+        case ACCESS_IMAGE:
+            return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+        case ACCESS_STORAGE:
+            return GL_SHADER_STORAGE_BARRIER_BIT;
+        case ACCESS_TARGET:
+            return GL_FRAMEBUFFER_BARRIER_BIT;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Forget the passes and resources of the previous frame. Graph textures and framebuffers
+ * stay allocated for the next compile to reuse.
+ */
+void RenderGraph::reset() {
+    resources.clear();
+    passes.clear();
+    order.clear();
+}
+
+/**
+ * @brief Make a texture created outside the graph available to passes. Texture 0 is the default
+ * framebuffer, which passes can only write as ACCESS_TARGET.
+ */
+int RenderGraph::importTexture(const char* name, GLuint texture, const RenderTextureDesc& desc) {
+    Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    resource.imported = true;
+    resource.object = texture;
+    resources.push_back(resource);
+    return (int)resources.size() - 1;
+}
+
+int RenderGraph::importBuffer(const char* name, GLuint buffer) {
+    Resource resource;
+    resource.name = name;
+    resource.imported = true;
+    resource.buffer = true;
+    resource.object = buffer;
+    resources.push_back(resource);
+    return (int)resources.size() - 1;
+}
+
+/**
+ * @brief Declare a texture that only lives within the frame. It gets storage when the graph is
+ * compiled, possibly shared with other transients of the same size and format.
+ */
+int RenderGraph::createTexture(const char* name, const RenderTextureDesc& desc) {
+    Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    resources.push_back(resource);
+    return (int)resources.size() - 1;
+}
+
+/**
+ * @brief Declare a pass. Passes run in an order that satisfies their reads and writes, not in the
+ * order they are added, and only if something that is kept uses their output.
+ *
+ * @param name Name, also used for the GPU timing of the pass.
+ * @param execute Records the pass's GL commands. Framebuffer targets are bound already.
+ * @param sideEffect Keep the pass even if nothing reads what it writes (read backs, for instance).
+ * @return int Pass handle for read() and write().
+ */
+int RenderGraph::addPass(const char* name, std::function<void()> execute, bool sideEffect) {
+    Pass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    pass.sideEffect = sideEffect;
+    passes.push_back(std::move(pass));
+    return (int)passes.size() - 1;
+}
+
+void RenderGraph::read(int pass, int resource, RenderAccess access) {
+    passes[pass].accesses.push_back({ resource, access, false, -1 });
+}
+
+/**
+ * @brief Declare a write. Color targets are attached in the order they are written unless
+ * 'attachment' places one, which keeps fragment output locations fixed when a target in between
+ * is left out.
+ */
+void RenderGraph::write(int pass, int resource, RenderAccess access, int attachment) {
+    passes[pass].accesses.push_back({ resource, access, true, attachment });
+}
+
+/**
+ * @brief Mark a resource as a result of the frame. Passes that contribute to it are kept.
+ */
+void RenderGraph::output(int resource) {
+    resources[resource].output = true;
+}
+
+/**
+ * @brief Order and cull the passes, give transients storage and work out the barriers.
+ *
+ * A read sees the last write added before it, and a write waits for the reads of the previous
+ * version, so a pass may blend into a texture that earlier passes read. A read added before any
+ * write of the resource runs after its last writer. Passes are culled backwards from the outputs
+ * and side effects. Transients live from their first to their last use, and a transient reuses the
+ * texture of another with the same size and format whose lifetime is over. A barrier is only
+ * issued before the first access of each kind that follows an image or storage write.
+ *
+ * @return bool false if the passes depend on each other in a cycle.
+ */
+bool RenderGraph::compile() {
+    int passCount = (int)passes.size();
+
+    // Dependencies, from the versions each pass reads and writes
+    std::vector<std::vector<int>> dependents(passCount);
+    std::vector<int> dependencies(passCount, 0);
+    auto depend = [&](int before, int after) {
+        if (before >= 0 && before != after &&
+            std::find(dependents[before].begin(), dependents[before].end(), after) == dependents[before].end()) {
+            dependents[before].push_back(after);
+            dependencies[after]++;
+        }
+    };
+    std::vector<int> lastWriter(resources.size(), -1);
+    std::vector<std::vector<int>> readers(resources.size());
+    std::vector<std::vector<int>> earlyReaders(resources.size());
+    for (int p = 0; p < passCount; p++) {
+        std::map<int, bool> touched;    // resource -> written
+        for (const Access& access : passes[p].accesses) {
+            touched[access.resource] = touched[access.resource] || access.write;
+        }
+        for (const auto& entry : touched) {
+            int r = entry.first;
+            if (entry.second) {
+                depend(lastWriter[r], p);
+                for (int reader : readers[r]) {
+                    depend(reader, p);
+                }
+                readers[r].clear();
+                lastWriter[r] = p;
+            }
+            else if (lastWriter[r] >= 0) {
+                depend(lastWriter[r], p);
+                readers[r].push_back(p);
+            }
+            else {
+                earlyReaders[r].push_back(p);
+            }
+        }
+    }
+    for (size_t r = 0; r < resources.size(); r++) {
+        for (int reader : earlyReaders[r]) {
+            depend(lastWriter[r], reader);
+        }
+    }
+
+    // Topological order, ties broken by the order passes were added
+    std::priority_queue<int, std::vector<int>, std::greater<int>> ready;
+    for (int p = 0; p < passCount; p++) {
+        if (dependencies[p] == 0) {
+            ready.push(p);
+        }
+    }
+    std::vector<int> sorted;
+    while (!ready.empty()) {
+        int p = ready.top();
+        ready.pop();
+        sorted.push_back(p);
+        for (int next : dependents[p]) {
+            if (--dependencies[next] == 0) {
+                ready.push(next);
+            }
+        }
+    }
+    if ((int)sorted.size() != passCount) {
+        std::cerr << "Failed to compile render graph, its passes depend on each other in a cycle" << std::endl;
+        order.clear();
+        return false;
+    }
+
+    // Culling, from the last pass backwards
+    std::vector<bool> needed(resources.size(), false);
+    for (size_t r = 0; r < resources.size(); r++) {
+        needed[r] = resources[r].output;
+    }
+    for (auto it = sorted.rbegin(); it != sorted.rend(); ++it) {
+        Pass& pass = passes[*it];
+        bool keep = pass.sideEffect;
+        for (const Access& access : pass.accesses) {
+            keep = keep || (access.write && needed[access.resource]);
+        }
+        pass.culled = !keep;
+        if (keep) {
+            for (const Access& access : pass.accesses) {
+                if (!access.write || access.access == ACCESS_TARGET) {
+                    needed[access.resource] = true;
+                }
+            }
+        }
+    }
+
+    order.clear();
+    for (int p : sorted) {
+        if (!passes[p].culled) {
+            order.push_back(p);
+        }
+    }
+    for (int i = 0; i < (int)order.size(); i++) {
+        for (const Access& access : passes[order[i]].accesses) {
+            Resource& resource = resources[access.resource];
+            if (resource.firstUse < 0) {
+                resource.firstUse = i;
+            }
+            resource.lastUse = i;
+        }
+    }
+
+    allocate();
+    computeBarriers();
+    createFramebuffers();
+    return true;
+}
+
+/**
+ * @brief Run the compiled passes, each timed under its name.
+ */
+void RenderGraph::execute(GpuProfiler& profiler) {
+    for (int p : order) {
+        Pass& pass = passes[p];
+        int scope = profiler.begin(pass.name.c_str());
+        if (pass.barrier) {
+            glMemoryBarrier(pass.barrier);
+        }
+        if (pass.bindTarget) {
+            glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer);
+            glViewport(0, 0, pass.width, pass.height);
+        }
+        pass.execute();
+        profiler.end(scope);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+ * @brief Delete the cached framebuffers attached to a texture. Owners of imported textures call it
+ * before deleting one, as a new texture may get the same name.
+ */
+void RenderGraph::releaseTexture(GLuint texture) {
+    for (auto it = framebuffers.begin(); it != framebuffers.end();) {
+        if (std::find(it->first.begin(), it->first.end(), texture) != it->first.end()) {
+            glDeleteFramebuffers(1, &it->second);
+            it = framebuffers.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+size_t RenderGraph::videoMemory() const {
+    size_t bytes = 0;
+    for (const Physical& physical : pool) {
+        bytes += (size_t)physical.desc.width * physical.desc.height * physical.desc.samples * texture_format_size(physical.desc.format);
+    }
+    return bytes;
+}
+
+void RenderGraph::clean() {
+    for (auto& entry : framebuffers) {
+        glDeleteFramebuffers(1, &entry.second);
+    }
+    framebuffers.clear();
+    for (Physical& physical : pool) {
+        glDeleteTextures(1, &physical.texture);
+    }
+    pool.clear();
+    reset();
+}
+
+
+/*
+* Private Methods
+*/
+
+// Give every transient a texture from the pool, first come first served in order of first use.
+void RenderGraph::allocate() {
+    std::vector<int> transients;
+    transientBytes = 0;
+    for (int r = 0; r < (int)resources.size(); r++) {
+        if (!resources[r].imported && resources[r].firstUse >= 0) {
+            transients.push_back(r);
+            const RenderTextureDesc& desc = resources[r].desc;
+            transientBytes += (size_t)desc.width * desc.height * desc.samples * texture_format_size(desc.format);
+        }
+    }
+    std::sort(transients.begin(), transients.end(), [&](int a, int b) {
+        return resources[a].firstUse < resources[b].firstUse;
+    });
+
+    for (Physical& physical : pool) {
+        physical.used = false;
+        physical.lastUse = -1;
+    }
+    for (int r : transients) {
+        Resource& resource = resources[r];
+        Physical* match = nullptr;
+        for (Physical& physical : pool) {
+            if (physical.desc == resource.desc && physical.lastUse < resource.firstUse) {
+                match = &physical;
+                break;
+            }
+        }
+        if (!match) {
+            Physical physical;
+            physical.desc = resource.desc;
+            const RenderTextureDesc& desc = resource.desc;
+            bool depth = is_depth_format(desc.format);
+            glGenTextures(1, &physical.texture);
+            if (desc.samples > 1) {
+                glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, physical.texture);
+                glTexStorage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, desc.samples, desc.format, desc.width, desc.height, GL_TRUE);
+                glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+            }
+            else {
+                glBindTexture(GL_TEXTURE_2D, physical.texture);
+                glTexStorage2D(GL_TEXTURE_2D, 1, desc.format, desc.width, desc.height);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, depth ? GL_NEAREST : GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, depth ? GL_NEAREST : GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glBindTexture(GL_TEXTURE_2D, 0);
+            }
+            pool.push_back(physical);
+            match = &pool.back();
+        }
+        match->used = true;
+        match->lastUse = resource.lastUse;
+        resource.object = match->texture;
+    }
+
+    // Textures no transient wanted this frame, and the framebuffers built on them, are released.
+    for (size_t i = 0; i < pool.size();) {
+        if (pool[i].used) {
+            i++;
+            continue;
+        }
+        GLuint texture = pool[i].texture;
+        releaseTexture(texture);
+        glDeleteTextures(1, &texture);
+        pool.erase(pool.begin() + i);
+    }
+}
+
+// glMemoryBarrier is global: one bit covers every earlier incoherent write for that kind of access.
+// So a pass only needs the bits for its accesses to resources written incoherently since the last
+// barrier with that bit. State is kept per texture or buffer object, which also covers transients
+// sharing a texture.
+void RenderGraph::computeBarriers() {
+    struct State {
+        bool incoherent = false;    /** Written by image or storage access. */
+        GLbitfield issued = 0;      /** Barrier bits issued since. */
+    };
+    std::map<std::pair<bool, GLuint>, State> states;
+    for (const Resource& resource : resources) {
+        auto pending = pendingImports.find(resource.name);
+        if (resource.imported && pending != pendingImports.end()) {
+            State& state = states[{ resource.buffer, resource.object }];
+            state.incoherent = true;
+            state.issued = pending->second;
+        }
+    }
+
+    barriers = 0;
+    for (int p : order) {
+        Pass& pass = passes[p];
+        pass.barrier = 0;
+        for (const Access& access : pass.accesses) {
+            const Resource& resource = resources[access.resource];
+            State& state = states[{ resource.buffer, resource.object }];
+            GLbitfield bit = barrier_bit(access.access);
+            if (state.incoherent && (state.issued & bit) != bit) {
+                pass.barrier |= bit;
+            }
+        }
+        if (pass.barrier) {
+            barriers++;
+            for (auto& entry : states) {
+                entry.second.issued |= pass.barrier;
+            }
+        }
+        for (const Access& access : pass.accesses) {
+            if (access.write && access.access != ACCESS_CUSTOM) {
+                const Resource& resource = resources[access.resource];
+                State& state = states[{ resource.buffer, resource.object }];
+                state.incoherent = access.access == ACCESS_IMAGE || access.access == ACCESS_STORAGE;
+                state.issued = 0;
+            }
+        }
+    }
+
+    // Persistent resources may be read incoherently at the start of the next frame.
+    for (const Resource& resource : resources) {
+        if (!resource.imported) {
+            continue;
+        }
+        const State& state = states[{ resource.buffer, resource.object }];
+        if (state.incoherent) {
+            pendingImports[resource.name] = state.issued;
+        }
+        else {
+            pendingImports.erase(resource.name);
+        }
+    }
+}
+
+// Framebuffers for the passes that write ACCESS_TARGET, cached by their attachments.
+void RenderGraph::createFramebuffers() {
+    for (int p : order) {
+        Pass& pass = passes[p];
+        std::vector<GLuint> colors;
+        GLuint depth = 0;
+        GLenum depthFormat = 0;
+        bool backbuffer = false;
+        pass.bindTarget = false;
+
+        for (const Access& access : pass.accesses) {
+            if (access.access != ACCESS_TARGET) {
+                continue;
+            }
+            const Resource& resource = resources[access.resource];
+            if (!pass.bindTarget) {
+                pass.width = resource.desc.width;
+                pass.height = resource.desc.height;
+                pass.bindTarget = true;
+            }
+            if (resource.imported && resource.object == 0) {
+                backbuffer = true;
+            }
+            else if (is_depth_format(resource.desc.format)) {
+                depth = resource.object;
+                depthFormat = resource.desc.format;
+            }
+            else if (std::find(colors.begin(), colors.end(), resource.object) == colors.end()) {
+                size_t slot = access.attachment >= 0 ? (size_t)access.attachment : colors.size();
+                colors.resize(std::max(colors.size(), slot + 1), 0);
+                colors[slot] = resource.object;
+            }
+        }
+        if (!pass.bindTarget || backbuffer) {
+            pass.framebuffer = 0;
+            continue;
+        }
+
+        std::vector<GLuint> key = colors;
+        key.push_back(depth);
+        auto found = framebuffers.find(key);
+        if (found != framebuffers.end()) {
+            pass.framebuffer = found->second;
+            continue;
+        }
+
+        GLuint fbo;
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        std::vector<GLenum> drawBuffers;
+        for (size_t i = 0; i < colors.size(); i++) {
+            if (colors[i]) {
+                glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + (GLenum)i, colors[i], 0);
+            }
+            drawBuffers.push_back(colors[i] ? GL_COLOR_ATTACHMENT0 + (GLenum)i : GL_NONE);
+        }
+        if (depth) {
+            bool stencil = depthFormat == GL_DEPTH24_STENCIL8 || depthFormat == GL_DEPTH32F_STENCIL8;
+            glFramebufferTexture(GL_FRAMEBUFFER, stencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT, depth, 0);
+        }
+        if (drawBuffers.empty()) {
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        }
+        else {
+            glDrawBuffers((GLsizei)drawBuffers.size(), drawBuffers.data());
+        }
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Failed to create framebuffer for pass " << pass.name << std::endl;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        framebuffers[key] = fbo;
+        pass.framebuffer = fbo;
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * @file RenderGraph.hpp
+ * @author Rohan Siddhu
+ * @brief Render passes declared with their reads and writes, ordered, culled and given aliased
+ * transient textures.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "GpuProfiler.hpp"
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+// How a pass touches a resource. Image and storage writes are incoherent and need a barrier before
+// a later pass uses the resource, the other accesses are ordered by GL.
+enum RenderAccess : int {
+    ACCESS_SAMPLED = 0,     /** Texture fetches. */
+    ACCESS_IMAGE = 1,       /** Image load / store. */
+    ACCESS_STORAGE = 2,     /** Shader storage buffer. */
+    ACCESS_TARGET = 3,      /** Framebuffer attachment, bound by the graph. */
+    ACCESS_CUSTOM = 4       /** Ordering only, the pass binds the resource itself. */
+};
+
+struct RenderTextureDesc {
+    int width = 0;
+    int height = 0;
+    GLenum format = GL_RGBA8;
+    int samples = 1;        /** More than 1 for a GL_TEXTURE_2D_MULTISAMPLE. */
+
+    bool operator==(const RenderTextureDesc& other) const {
+        return width == other.width && height == other.height && format == other.format && samples == other.samples;
+    }
+};
+
+class RenderGraph {
+private:
+    struct Resource {
+        std::string name;
+        RenderTextureDesc desc;
+        bool imported = false;
+        bool buffer = false;
+        bool output = false;
+        GLuint object = 0;          /** Texture or buffer, for transients once compiled. */
+        int firstUse = -1, lastUse = -1;
+    };
+
+    struct Access {
+        int resource;
+        RenderAccess access;
+        bool write;
+        int attachment;             /** Color attachment of a target, -1 for the next free one. */
+    };
+
+    struct Pass {
+        std::string name;
+        std::function<void()> execute;
+        std::vector<Access> accesses;
+        bool sideEffect = false;    /** Kept even if nothing reads what it writes. */
+        bool culled = false;
+        GLbitfield barrier = 0;     /** Issued before the pass runs. */
+        GLuint framebuffer = 0;
+        int width = 0, height = 0;
+        bool bindTarget = false;
+    };
+
+    // Texture owned by the graph, shared by transients whose lifetimes do not overlap.
+    struct Physical {
+        RenderTextureDesc desc;
+        GLuint texture = 0;
+        int lastUse = -1;
+        bool used = false;
+    };
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<int> order;         /** Passes that survived culling, in execution order. */
+    std::vector<Physical> pool;
+    std::map<std::vector<GLuint>, GLuint> framebuffers;
+    std::map<std::string, GLbitfield> pendingImports;  /** Imported resources written incoherently, and the barriers issued since. */
+    int barriers = 0;
+    size_t transientBytes = 0;
+public:
+    void reset();
+    int importTexture(const char* name, GLuint texture, const RenderTextureDesc& desc);
+    int importBuffer(const char* name, GLuint buffer);
+    int createTexture(const char* name, const RenderTextureDesc& desc);
+    int addPass(const char* name, std::function<void()> execute, bool sideEffect = false);
+    void read(int pass, int resource, RenderAccess access);
+    void write(int pass, int resource, RenderAccess access, int attachment = -1);
+    void output(int resource);
+    bool compile();
+    void execute(GpuProfiler& profiler);
+    void releaseTexture(GLuint texture);
+    void clean();
+
+    GLuint texture(int resource) const { return resources[resource].object; }
+    GLuint buffer(int resource) const { return resources[resource].object; }
+    const RenderTextureDesc& desc(int resource) const { return resources[resource].desc; }
+
+    // Statistics of the last compile.
+    int passCount() const { return (int)passes.size(); }
+    const std::string& passName(int pass) const { return passes[pass].name; }
+    bool isCulled(int pass) const { return passes[pass].culled; }
+    const std::vector<int>& executionOrder() const { return order; }
+    int barrierCount() const { return barriers; }
+    int physicalTextures() const { return (int)pool.size(); }
+    size_t transientMemory() const { return transientBytes; }
+    size_t videoMemory() const;
+private:
+    void allocate();
+    void computeBarriers();
+    void createFramebuffers();
+};
+
+size_t texture_format_size(GLenum format);
@@ -0,0 +1,93 @@
+/**
+ * @file SceneData.hpp
+ * @author Rohan Siddhu
+ * @brief Geometry of the demo scene, shared by the application and the software rasterizer.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+inline float cubeData[] = {
+    // Coords               // Normals              // Texture Coords
+    -0.5f, -0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    0.0f, 0.0f,
+     0.5f, -0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    1.0f, 0.0f,
+     0.5f,  0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    1.0f, 1.0f,
+     0.5f,  0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    1.0f, 1.0f,
+    -0.5f,  0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    0.0f, 1.0f,
+    -0.5f, -0.5f, -0.5f,     0.0f,  0.0f, -1.0f,    0.0f, 0.0f,
+
+    -0.5f, -0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     0.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     1.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     1.0f, 1.0f,
+     0.5f,  0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     1.0f, 1.0f,
+    -0.5f,  0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     0.0f, 1.0f,
+    -0.5f, -0.5f,  0.5f,     0.0f,  0.0f, 1.0f,     0.0f, 0.0f,
+
+    -0.5f,  0.5f,  0.5f,    -1.0f,  0.0f,  0.0f,    1.0f, 0.0f,
+    -0.5f,  0.5f, -0.5f,    -1.0f,  0.0f,  0.0f,    1.0f, 1.0f,
+    -0.5f, -0.5f, -0.5f,    -1.0f,  0.0f,  0.0f,    0.0f, 1.0f,
+    -0.5f, -0.5f, -0.5f,    -1.0f,  0.0f,  0.0f,    0.0f, 1.0f,
+    -0.5f, -0.5f,  0.5f,    -1.0f,  0.0f,  0.0f,    0.0f, 0.0f,
+    -0.5f,  0.5f,  0.5f,    -1.0f,  0.0f,  0.0f,    1.0f, 0.0f,
+
+     0.5f,  0.5f,  0.5f,     1.0f,  0.0f,  0.0f,    1.0f, 0.0f,
+     0.5f,  0.5f, -0.5f,     1.0f,  0.0f,  0.0f,    1.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,     1.0f,  0.0f,  0.0f,    0.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,     1.0f,  0.0f,  0.0f,    0.0f, 1.0f,
+     0.5f, -0.5f,  0.5f,     1.0f,  0.0f,  0.0f,    0.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,     1.0f,  0.0f,  0.0f,    1.0f, 0.0f,
+
+    -0.5f, -0.5f, -0.5f,     0.0f, -1.0f,  0.0f,    0.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,     0.0f, -1.0f,  0.0f,    1.0f, 1.0f,
+     0.5f, -0.5f,  0.5f,     0.0f, -1.0f,  0.0f,    1.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,     0.0f, -1.0f,  0.0f,    1.0f, 0.0f,
+    -0.5f, -0.5f,  0.5f,     0.0f, -1.0f,  0.0f,    0.0f, 0.0f,
+    -0.5f, -0.5f, -0.5f,     0.0f, -1.0f,  0.0f,    0.0f, 1.0f,
+
+    -0.5f,  0.5f, -0.5f,     0.0f,  1.0f,  0.0f,    0.0f, 1.0f,
+     0.5f,  0.5f, -0.5f,     0.0f,  1.0f,  0.0f,    1.0f, 1.0f,
+     0.5f,  0.5f,  0.5f,     0.0f,  1.0f,  0.0f,    1.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,     0.0f,  1.0f,  0.0f,    1.0f, 0.0f,
+    -0.5f,  0.5f,  0.5f,     0.0f,  1.0f,  0.0f,    0.0f, 0.0f,
+    -0.5f,  0.5f, -0.5f,     0.0f,  1.0f,  0.0f,    0.0f, 1.0f
+};
+
+
+inline float floorData[] = {
+    // Coords               // Normals              // Texture Coords
+    -40.0f, -4.0f, -80.0f,   0.0f,  1.0f,  0.0f,     0.0f, 12.0f,
+     40.0f, -4.0f, -80.0f,   0.0f,  1.0f,  0.0f,    12.0f, 12.0f,
+     40.0f, -4.0f,  10.0f,   0.0f,  1.0f,  0.0f,    12.0f,  0.0f,
+     40.0f, -4.0f,  10.0f,   0.0f,  1.0f,  0.0f,    12.0f,  0.0f,
+    -40.0f, -4.0f,  10.0f,   0.0f,  1.0f,  0.0f,     0.0f,  0.0f,
+    -40.0f, -4.0f, -80.0f,   0.0f,  1.0f,  0.0f,     0.0f, 12.0f
+};
+
+// A decal lying on the floor, one unit wide. Drawn with a polygon offset so it wins against the
+// floor it rests on.
+inline float decalData[] = {
+    // Coords               // Normals              // Texture Coords
+    -0.5f, -4.0f, -0.5f,     0.0f,  1.0f,  0.0f,     0.0f, 1.0f,
+     0.5f, -4.0f, -0.5f,     0.0f,  1.0f,  0.0f,     1.0f, 1.0f,
+     0.5f, -4.0f,  0.5f,     0.0f,  1.0f,  0.0f,     1.0f, 0.0f,
+     0.5f, -4.0f,  0.5f,     0.0f,  1.0f,  0.0f,     1.0f, 0.0f,
+    -0.5f, -4.0f,  0.5f,     0.0f,  1.0f,  0.0f,     0.0f, 0.0f,
+    -0.5f, -4.0f, -0.5f,     0.0f,  1.0f,  0.0f,     0.0f, 1.0f
+};
+
+// Cube positions
+inline glm::vec3 cubePositions[] = {
+    glm::vec3(0.0f,  0.0f,  0.0f),
+    glm::vec3(2.0f,  5.0f, -15.0f),
+    glm::vec3(-1.5f, -2.2f, -2.5f),
+    glm::vec3(-3.8f, -2.0f, -12.3f),
+    glm::vec3(2.4f, -0.4f, -3.5f),
+    glm::vec3(-1.7f,  3.0f, -7.5f),
+    glm::vec3(1.3f, -2.0f, -2.5f),
+    glm::vec3(1.5f,  2.0f, -2.5f),
+    glm::vec3(1.5f,  0.2f, -1.5f),
+    glm::vec3(-1.3f,  1.0f, -1.5f)
+};
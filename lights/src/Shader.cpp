@@ -7,82 +7,422 @@
  */
 
 #include "Shader.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 
 
-void Shader::addShader(GLenum type, const char* path) {
-    const char* src;
-    std::string line, source;
-    std::ifstream file(path);
+std::vector<Shader*> Shader::programs;
+const ShaderBlockLayout* Shader::blockLayouts = nullptr;
+size_t Shader::blockLayoutCount = 0;
 
-    while (std::getline(file, line)) {
-        source += line + '\n';
+// Stage files of a program, for messages.
+static std::string describe_stages(const std::vector<std::string>& paths) {
+    std::string text;
+    for (const std::string& path : paths) {
+        text += (text.empty() ? "" : " + ") + path;
     }
+    return text;
+}
 
-    src = source.c_str();
-    file.close();
+/**
+ * @brief Compile a stage from a GLSL file and attach it. The file goes through the preprocessor
+ * first, so it may #include other files and test the permutation keys with #ifdef.
+ *
+ * @param type GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, ...
+ * @param path GLSL file.
+ * @param defines Permutation keys, as "NAME" or "NAME=VALUE".
+ * @return bool false if the file is missing or does not compile.
+ */
+bool Shader::addShader(GLenum type, const char* path, const std::vector<std::string>& defines) {
+    stages.push_back({ type, path, defines });
+    ShaderSource source;
+    if (!preprocess_shader(path, defines, source)) {
+        return false;
+    }
+    files.insert(files.end(), source.files.begin(), source.files.end());
+    addDeclarations(source.text);
+    const char* src = source.text.c_str();
 
     GLuint id = glCreateShader(type);
     glShaderSource(id, 1, &src, nullptr);
     glCompileShader(id);
 
-    GLint status;
-    glGetShaderiv(id, GL_COMPILE_STATUS, &status);
-    if (status != GL_TRUE) {
-        GLsizei log_length = 0;
-        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &log_length);
-        GLchar* message = new GLchar[log_length];
-        glGetShaderInfoLog(id, log_length, &log_length, message);
+    bool compiled = checkStage(id, stages.back(), source);
+    if (compiled) {
+        glAttachShader(program, id);
+    }
+    glDeleteShader(id);
+    return compiled;
+}
 
-        std::cout << "Failed to compile " << ((type == GL_VERTEX_SHADER) ? "Vertex Shader" : "Fragment Shader") << std::endl;
-        std::cout << message << std::endl;
+bool Shader::createProgram() {
+    glLinkProgram(program);
+    if (std::find(programs.begin(), programs.end(), this) == programs.end()) {
+        programs.push_back(this);
+    }
+    return checkLink(program) && checkBlocks(program);
+}
+
+/**
+ * @brief Uniform block layouts every program is checked against once linked, see checkBlocks().
+ * Blocks a program does not use are skipped.
+ *
+ * @param layouts Usually glsl::BLOCKS, generated by shaderreflect.
+ * @param count Number of layouts.
+ */
+void Shader::expectBlocks(const ShaderBlockLayout* layouts, size_t count) {
+    blockLayouts = layouts;
+    blockLayoutCount = count;
+}
 
-        delete[] message;
-        return;
+/**
+ * @brief Location of a uniform, looked up once and cached. A name the program does not have is
+ * reported once: glGetUniformLocation returns -1 alike for a typo, a member of a uniform block and
+ * a uniform the compiler removed because it is unused, only the last one is not an error.
+ *
+ * @param name Uniform name, "light.ambient" for a struct member.
+ * @return GLint Location, -1 if the program has no such uniform.
+ */
+GLint Shader::location(const char* name) {
+    auto found = locations.find(name);
+    if (found != locations.end()) {
+        return found->second;
     }
 
-    glAttachShader(program, id);
-    glDeleteShader(id);
+    GLint location = glGetUniformLocation(program, name);
+    if (location < 0) {
+        std::vector<std::string> paths;
+        for (const Stage& stage : stages) {
+            paths.push_back(stage.path);
+        }
+        if (glGetProgramResourceIndex(program, GL_UNIFORM, name) != GL_INVALID_INDEX) {
+            std::cerr << "Uniform " << name << " of " << describe_stages(paths) << " is in a uniform block, set it through its buffer" << std::endl;
+        }
+        else if (!declared(name)) {
+            std::cerr << "Uniform " << name << " is not declared in " << describe_stages(paths) << std::endl;
+        }
+    }
+    locations[name] = location;
+    return location;
 }
 
-void Shader::createProgram() {
-    glLinkProgram(program);
+/**
+ * @brief Whether 'path' is one of the files, includes too, the program was built from.
+ */
+bool Shader::usesFile(const std::string& path) const {
+    return std::find(files.begin(), files.end(), path) != files.end();
+}
 
+/**
+ * @brief Read the stage files again and start building a new program from them. Nothing waits on
+ * the driver here; with parallel shader compilation it builds in the background while the old
+ * program keeps drawing. A rebuild already in flight is dropped.
+ *
+ * @return bool false if a file could not be read, the old program is kept.
+ */
+bool Shader::beginReload() {
+    cancelReload();
+    pendingProgram = glCreateProgram();
+    for (const Stage& stage : stages) {
+        ShaderSource source;
+        if (!preprocess_shader(stage.path.c_str(), stage.defines, source)) {
+            cancelReload();
+            return false;
+        }
+        const char* src = source.text.c_str();
+        GLuint id = glCreateShader(stage.type);
+        glShaderSource(id, 1, &src, nullptr);
+        glCompileShader(id);
+        glAttachShader(pendingProgram, id);
+        pendingStages.push_back(id);
+        pendingSources.push_back(std::move(source));
+    }
+    glLinkProgram(pendingProgram);
+    return true;
+}
 
-    GLint status;
-    glGetProgramiv(program, GL_LINK_STATUS, &status);
-    if (status != GL_TRUE) {
-        GLsizei log_length = 0;
-        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_length);
-        GLchar* message = new GLchar[log_length];
-        glGetProgramInfoLog(program, log_length, &log_length, message);
+/**
+ * @brief Swap in the program started by beginReload() once it is built. Call between frames, so
+ * a frame is drawn entirely with the old or the new program.
+ *
+ * @param wait Block until the driver is done, needed without GL_ARB_parallel_shader_compile.
+ * @return ShaderReloadStatus RELOAD_PENDING while compiling, then whether it was swapped in.
+ */
+ShaderReloadStatus Shader::finishReload(bool wait) {
+    if (!pendingProgram) {
+        return RELOAD_NONE;
+    }
+    if (!wait) {
+        GLint done = GL_TRUE;
+        glGetProgramiv(pendingProgram, SHADER_COMPLETION_STATUS, &done);
+        if (!done) {
+            return RELOAD_PENDING;
+        }
+    }
 
-        std::cout << "Failed to link program" << std::endl;
-        std::cout << message << std::endl;
+    bool built = true;
+    for (size_t i = 0; i < pendingStages.size(); i++) {
+        built = checkStage(pendingStages[i], stages[i], pendingSources[i]) && built;
+    }
+    built = built && checkLink(pendingProgram) && checkBlocks(pendingProgram);
+    if (!built) {
+        cancelReload();
+        return RELOAD_FAILED;
+    }
 
-        delete[] message;
+    glDeleteProgram(program);
+    program = pendingProgram;
+    pendingProgram = 0;
+    files.clear();
+    declarations.clear();
+    locations.clear();
+    for (const ShaderSource& source : pendingSources) {
+        files.insert(files.end(), source.files.begin(), source.files.end());
+        addDeclarations(source.text);
     }
+    cancelReload();
+    return RELOAD_SWAPPED;
 }
 
 void Shader::setMat4(const char* name, const GLfloat* value) {
-    glUniformMatrix4fv(glGetUniformLocation(program, name), 1, GL_FALSE, value);
+    glUniformMatrix4fv(location(name), 1, GL_FALSE, value);
+}
+
+void Shader::setMat4Array(const char* name, const glm::mat4* values, GLsizei count) {
+    glUniformMatrix4fv(location(name), count, GL_FALSE, glm::value_ptr(values[0]));
+}
+
+void Shader::setVec2(const char* name, glm::vec2 value) {
+    glUniform2fv(location(name), 1, glm::value_ptr(value));
 }
 
 void Shader::setVec3(const char* name, const GLfloat v0, const GLfloat v1, const GLfloat v2) {
-    glUniform3f(glGetUniformLocation(program, name), v0, v1, v2);
+    glUniform3f(location(name), v0, v1, v2);
 }
 
 void Shader::setVec3(const char* name, glm::vec3 value) {
-    glUniform3fv(glGetUniformLocation(program, name), 1, glm::value_ptr(value));
+    glUniform3fv(location(name), 1, glm::value_ptr(value));
+}
+
+void Shader::setVec4Array(const char* name, const glm::vec4* values, GLsizei count) {
+    glUniform4fv(location(name), count, glm::value_ptr(values[0]));
 }
 
 void Shader::setFloat(const char* name, const GLfloat value) {
-    glUniform1f(glGetUniformLocation(program, name), value);
+    glUniform1f(location(name), value);
 }
 
 void Shader::setInt(const char* name, const GLint value) {
-    glUniform1i(glGetUniformLocation(program, name), value);
+    glUniform1i(location(name), value);
 }
 
 void Shader::clean() {
+    cancelReload();
     glDeleteProgram(program);
+    programs.erase(std::remove(programs.begin(), programs.end(), this), programs.end());
+}
+
+
+/*
+* Private Methods
+*/
+
+// Drop the rebuild in flight, if any.
+void Shader::cancelReload() {
+    for (GLuint id : pendingStages) {
+        glDeleteShader(id);
+    }
+    if (pendingProgram) {
+        glDeleteProgram(pendingProgram);
+    }
+    pendingProgram = 0;
+    pendingStages.clear();
+    pendingSources.clear();
+}
+
+bool Shader::checkStage(GLuint id, const Stage& stage, const ShaderSource& source) const {
+    GLint status;
+    glGetShaderiv(id, GL_COMPILE_STATUS, &status);
+    if (status == GL_TRUE) {
+        return true;
+    }
+
+    GLsizei log_length = 0;
+    glGetShaderiv(id, GL_INFO_LOG_LENGTH, &log_length);
+    GLchar* message = new GLchar[log_length];
+    glGetShaderInfoLog(id, log_length, &log_length, message);
+
+    GLenum type = stage.type;
+    const char* name = (type == GL_VERTEX_SHADER) ? "Vertex Shader" : (type == GL_COMPUTE_SHADER) ? "Compute Shader" :
+        (type == GL_GEOMETRY_SHADER) ? "Geometry Shader" : "Fragment Shader";
+    std::cout << "Failed to compile " << name << " " << stage.path;
+    if (!stage.defines.empty()) {
+        std::cout << " (" << shader_variant_key(stage.defines) << ")";
+    }
+    std::cout << std::endl;
+    // Lines are reported as source:line, the sources being the file and its includes.
+    for (size_t i = 1; i < source.files.size(); i++) {
+        std::cout << "  source " << i << ": " << source.files[i] << std::endl;
+    }
+    std::cout << message << std::endl;
+
+    delete[] message;
+    return false;
+}
+
+bool Shader::checkLink(GLuint program) {
+    GLint status;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status == GL_TRUE) {
+        return true;
+    }
+
+    GLsizei log_length = 0;
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_length);
+    GLchar* message = new GLchar[log_length];
+    glGetProgramInfoLog(program, log_length, &log_length, message);
+
+    std::cout << "Failed to link program" << std::endl;
+    std::cout << message << std::endl;
+
+    delete[] message;
+    return false;
+}
+
+/**
+ * @brief Compare the uniform blocks of a linked program with the layouts their C++ structs were
+ * generated with: binding, size and the offset of every active member.
+ *
+ * @return bool false, with the differences printed, if a block does not match.
+ */
+bool Shader::checkBlocks(GLuint program) const {
+    bool matching = true;
+    for (size_t b = 0; b < blockLayoutCount; b++) {
+        const ShaderBlockLayout& layout = blockLayouts[b];
+        GLuint index = glGetProgramResourceIndex(program, GL_UNIFORM_BLOCK, layout.name);
+        if (index == GL_INVALID_INDEX) {
+            continue;
+        }
+
+        std::vector<std::string> paths;
+        for (const Stage& stage : stages) {
+            paths.push_back(stage.path);
+        }
+        const GLenum blockProperties[] = { GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE };
+        GLint values[2];
+        glGetProgramResourceiv(program, GL_UNIFORM_BLOCK, index, 2, blockProperties, 2, nullptr, values);
+        if (values[0] != (GLint)layout.binding || values[1] != layout.size) {
+            std::cerr << "Failed to match uniform block " << layout.name << " of " << describe_stages(paths) << ": binding "
+                      << values[0] << " and " << values[1] << " bytes, generated for binding " << layout.binding
+                      << " and " << layout.size << " bytes" << std::endl;
+            matching = false;
+            continue;
+        }
+        for (size_t m = 0; m < layout.memberCount; m++) {
+            const ShaderBlockMember& member = layout.members[m];
+            GLuint uniform = glGetProgramResourceIndex(program, GL_UNIFORM, member.name);
+            if (uniform == GL_INVALID_INDEX) {
+                continue;
+            }
+            const GLenum offsetProperty = GL_OFFSET;
+            GLint offset = -1;
+            glGetProgramResourceiv(program, GL_UNIFORM, uniform, 1, &offsetProperty, 1, nullptr, &offset);
+            if (offset != member.offset) {
+                std::cerr << "Failed to match uniform block " << layout.name << " of " << describe_stages(paths) << ": "
+                          << member.name << " at offset " << offset << ", generated for " << member.offset << std::endl;
+                matching = false;
+            }
+        }
+    }
+    return matching;
+}
+
+// Loose uniforms and struct members of a source, see declared().
+void Shader::addDeclarations(const std::string& text) {
+    std::vector<std::string> tokens;
+    for (size_t i = 0; i < text.size(); ) {
+        if (text.compare(i, 2, "//") == 0) {
+            i = std::min(text.find('\n', i), text.size());
+        }
+        else if (text.compare(i, 2, "/*") == 0) {
+            i = std::min(text.find("*/", i + 2), text.size());
+        }
+        else if (std::isalnum((unsigned char)text[i]) || text[i] == '_') {
+            size_t start = i;
+            while (i < text.size() && (std::isalnum((unsigned char)text[i]) || text[i] == '_')) {
+                i++;
+            }
+            tokens.push_back(text.substr(start, i - start));
+        }
+        else {
+            if (std::strchr("{};,[", text[i])) {
+                tokens.push_back(std::string(1, text[i]));
+            }
+            i++;
+        }
+    }
+
+    // "struct S { T a, b[4]; ... }" and "uniform T a;", blocks are found by the driver instead.
+    for (size_t i = 0; i + 2 < tokens.size(); i++) {
+        std::string prefix;
+        size_t end = i;
+        if (tokens[i] == "struct" && tokens[i + 2] == "{") {
+            prefix = tokens[i + 1] + ".";
+            end = i + 3;
+        }
+        else if (tokens[i] == "uniform" && tokens[i + 2] != "{") {
+            end = i + 1;
+        }
+        else {
+            continue;
+        }
+        while (end + 1 < tokens.size() && tokens[end] != "}") {
+            std::string type = tokens[end++];
+            while (end < tokens.size() && tokens[end] != ";") {
+                if (tokens[end] == "[") {
+                    while (end < tokens.size() && tokens[end] != "," && tokens[end] != ";") {
+                        end++;
+                    }
+                    continue;
+                }
+                if (tokens[end] != ",") {
+                    declarations[prefix + tokens[end]] = type;
+                }
+                end++;
+            }
+            end++;
+            if (prefix.empty()) {
+                break;
+            }
+        }
+        i = end - 1;
+    }
+}
+
+// Whether the sources declare "a[2].b": a loose uniform a whose struct has a member b.
+bool Shader::declared(const char* name) const {
+    std::string type;
+    std::string component;
+    for (const char* c = name; ; c++) {
+        if (*c == '[') {
+            while (*c && *c != ']') {
+                c++;
+            }
+            continue;
+        }
+        if (*c && *c != '.') {
+            component += *c;
+            continue;
+        }
+        auto found = declarations.find(type.empty() ? component : type + "." + component);
+        if (found == declarations.end()) {
+            return false;
+        }
+        type = found->second;
+        component.clear();
+        if (!*c) {
+            return true;
+        }
+    }
 }
@@ -8,32 +8,83 @@
 
 #pragma once
 
+#include "ShaderPreprocessor.hpp"
+#include "ShaderReflection.hpp"
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 
+// GL_COMPLETION_STATUS_ARB of GL_ARB_parallel_shader_compile, which the generated loader lacks.
+constexpr GLenum SHADER_COMPLETION_STATUS = 0x91B1;
+
+// Outcome of Shader::finishReload().
+enum ShaderReloadStatus : int {
+    RELOAD_NONE = 0,        /** No rebuild in flight. */
+    RELOAD_PENDING = 1,     /** The driver is still compiling. */
+    RELOAD_SWAPPED = 2,     /** The new program replaced the old one. */
+    RELOAD_FAILED = 3       /** The new sources do not build, the old program is kept. */
+};
+
 class Shader {
 private:
+    struct Stage {
+        GLenum type;
+        std::string path;
+        std::vector<std::string> defines;
+    };
+
     GLuint program;
+    std::vector<Stage> stages;
+    std::vector<std::string> files;         /** Every file the stages were built from, includes too. */
+    std::unordered_map<std::string, std::string> declarations;  /** Uniform and struct member ("Light.ambient") types, to tell typos from inactive uniforms. */
+    std::unordered_map<std::string, GLint> locations;   /** Looked up on first use, -1 once reported. */
+
+    // Rebuild in flight, see beginReload().
+    GLuint pendingProgram = 0;
+    std::vector<GLuint> pendingStages;
+    std::vector<ShaderSource> pendingSources;
+
+    static std::vector<Shader*> programs;   /** Linked and not cleaned yet, for the hot reload. */
+    static const ShaderBlockLayout* blockLayouts;
+    static size_t blockLayoutCount;
 public:
     Shader() {
         program = glCreateProgram();
     }
 
-    void addShader(GLenum type, const char* path);
-    void createProgram();
+    bool addShader(GLenum type, const char* path, const std::vector<std::string>& defines = {});
+    bool createProgram();
     void use() { glUseProgram(program); }
-    GLuint id() { return program; }
+    GLuint id() const { return program; }
+
+    bool usesFile(const std::string& path) const;
+    bool beginReload();
+    ShaderReloadStatus finishReload(bool wait);
+    static const std::vector<Shader*>& all() { return programs; }
+    static void expectBlocks(const ShaderBlockLayout* layouts, size_t count);
+    GLint location(const char* name);
 
     void setMat4(const char* name, const GLfloat* value);
+    void setMat4Array(const char* name, const glm::mat4* values, GLsizei count);
+    void setVec2(const char* name, glm::vec2 value);
     void setVec3(const char* name, const GLfloat x, const GLfloat y, const GLfloat z);
     void setVec3(const char* name, glm::vec3 value);
+    void setVec4Array(const char* name, const glm::vec4* values, GLsizei count);
     void setFloat(const char* name, const GLfloat value);
     void setInt(const char* name, const GLint value);
 
     void clean();
+private:
+    void cancelReload();
+    bool checkStage(GLuint id, const Stage& stage, const ShaderSource& source) const;
+    static bool checkLink(GLuint program);
+    bool checkBlocks(GLuint program) const;
+    void addDeclarations(const std::string& text);
+    bool declared(const char* name) const;
 };
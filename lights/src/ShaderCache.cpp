@@ -0,0 +1,118 @@
+/**
+ * @file ShaderCache.cpp
+ * @author Rohan Siddhu
+ * @brief ShaderCache class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "ShaderCache.hpp"
+#include <chrono>
+#include <sstream>
+
+/**
+ * @brief Program built from two files with a set of permutation keys. The first request compiles
+ * it, which stalls the frame; variants listed in the manifest are compiled up front instead.
+ *
+ * @param vertexPath Vertex shader file.
+ * @param fragmentPath Fragment shader file.
+ * @param defines Permutation keys, in any order.
+ * @return Shader& The program, valid until clean(). A variant that failed to build stays cached
+ * and draws nothing rather than being recompiled every frame, until a hot reload fixes it.
+ */
+Shader& ShaderCache::get(const std::string& vertexPath, const std::string& fragmentPath, const std::vector<std::string>& defines) {
+    std::string key = vertexPath + "|" + fragmentPath + "|" + shader_variant_key(defines);
+    auto found = variants.find(key);
+    if (found != variants.end()) {
+        return found->second.shader;
+    }
+    lazyCompiles++;
+    return compile(key, vertexPath, fragmentPath, defines).shader;
+}
+
+/**
+ * @brief Compile the variants listed in a manifest, one per line: the vertex and fragment shader
+ * files relative to the manifest, then the keys. Lines starting with '#' are comments.
+ *
+ * @param manifestPath Manifest file.
+ * @return int Variants compiled, -1 if the manifest could not be read.
+ */
+int ShaderCache::prewarm(const char* manifestPath) {
+    std::ifstream file(manifestPath);
+    if (!file) {
+        std::cerr << "Failed to open shader manifest: " << manifestPath << std::endl;
+        return -1;
+    }
+    std::string directory = manifestPath;
+    size_t slash = directory.find_last_of("/\\");
+    directory = slash == std::string::npos ? std::string() : directory.substr(0, slash + 1);
+
+    int compiled = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream words(line);
+        std::string vertexName, fragmentName;
+        if (!(words >> vertexName >> fragmentName) || vertexName[0] == '#') {
+            continue;
+        }
+        std::vector<std::string> defines;
+        std::string define;
+        while (words >> define) {
+            defines.push_back(define);
+        }
+
+        std::string vertexPath = directory + vertexName;
+        std::string fragmentPath = directory + fragmentName;
+        std::string key = vertexPath + "|" + fragmentPath + "|" + shader_variant_key(defines);
+        if (variants.find(key) == variants.end()) {
+            compile(key, vertexPath, fragmentPath, defines);
+            compiled++;
+        }
+    }
+    return compiled;
+}
+
+void ShaderCache::clean() {
+    for (auto& entry : variants) {
+        entry.second.shader.clean();
+    }
+    variants.clear();
+}
+
+/**
+ * @brief Names of the cached variants, "fragment shader [keys]", for the settings window.
+ */
+std::vector<std::string> ShaderCache::variantNames() const {
+    std::vector<std::string> names;
+    for (const auto& entry : variants) {
+        const Variant& variant = entry.second;
+        // Asked from the program, which a hot reload may have replaced since it was compiled here.
+        GLint linked = GL_FALSE;
+        glGetProgramiv(variant.shader.id(), GL_LINK_STATUS, &linked);
+        std::string name = variant.fragmentPath.substr(variant.fragmentPath.find_last_of("/\\") + 1);
+        names.push_back(name + " [" + shader_variant_key(variant.defines) + "]" + (linked ? "" : " (failed)"));
+    }
+    return names;
+}
+
+
+/*
+* Private Methods
+*/
+
+ShaderCache::Variant& ShaderCache::compile(const std::string& key, const std::string& vertexPath,
+    const std::string& fragmentPath, const std::vector<std::string>& defines) {
+    auto start = std::chrono::steady_clock::now();
+    Variant& variant = variants[key];
+    variant.vertexPath = vertexPath;
+    variant.fragmentPath = fragmentPath;
+    variant.defines = defines;
+    variant.shader.addShader(GL_VERTEX_SHADER, vertexPath.c_str(), defines);
+    variant.shader.addShader(GL_FRAGMENT_SHADER, fragmentPath.c_str(), defines);
+    variant.shader.createProgram();
+
+    // Waiting for the link status made the driver finish the job, so this is the real cost.
+    variant.compileMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    compileMilliseconds += variant.compileMilliseconds;
+    return variant;
+}
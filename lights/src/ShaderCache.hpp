@@ -0,0 +1,41 @@
+/**
+ * @file ShaderCache.hpp
+ * @author Rohan Siddhu
+ * @brief Programs compiled per permutation of #define keys, on first use or from a manifest.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "Shader.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+class ShaderCache {
+private:
+    struct Variant {
+        Shader shader;
+        std::string vertexPath;
+        std::string fragmentPath;
+        std::vector<std::string> defines;
+        float compileMilliseconds = 0.0f;
+    };
+
+    std::map<std::string, Variant> variants;
+    float compileMilliseconds = 0.0f;
+    int lazyCompiles = 0;       /** Variants compiled on first use rather than prewarmed. */
+public:
+    Shader& get(const std::string& vertexPath, const std::string& fragmentPath, const std::vector<std::string>& defines = {});
+    int prewarm(const char* manifestPath);
+    void clean();
+
+    int variantCount() const { return (int)variants.size(); }
+    int lazyCompileCount() const { return lazyCompiles; }
+    float compileTime() const { return compileMilliseconds; }
+    std::vector<std::string> variantNames() const;
+private:
+    Variant& compile(const std::string& key, const std::string& vertexPath, const std::string& fragmentPath,
+        const std::vector<std::string>& defines);
+};
@@ -0,0 +1,120 @@
+/**
+ * @file ShaderPreprocessor.cpp
+ * @author Rohan Siddhu
+ * @brief Shader preprocessor definitions.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "ShaderPreprocessor.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+// Directory of 'path' with its trailing slash, empty for a bare file name.
+static std::string directory_of(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+// File name of an '#include "name"' line, empty if the line is something else.
+static std::string include_name(const std::string& line) {
+    size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line.compare(start, 8, "#include") != 0) {
+        return std::string();
+    }
+    size_t open = line.find('"', start + 8);
+    size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+    if (close == std::string::npos) {
+        return std::string();
+    }
+    return line.substr(open + 1, close - open - 1);
+}
+
+static bool append_file(const std::string& path, ShaderSource& source, std::vector<std::string>& stack, bool root,
+    const std::string& defines) {
+    if (std::find(stack.begin(), stack.end(), path) != stack.end()) {
+        std::cerr << "Failed to preprocess shader, " << path << " includes itself" << std::endl;
+        return false;
+    }
+    // Every file is pasted once, like #pragma once, so headers can include what they use.
+    if (std::find(source.files.begin(), source.files.end(), path) != source.files.end()) {
+        return true;
+    }
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open shader: " << path << std::endl;
+        return false;
+    }
+
+    int index = (int)source.files.size();
+    source.files.push_back(path);
+    stack.push_back(path);
+    if (!root) {
+        source.text += "#line 1 " + std::to_string(index) + "\n";
+    }
+
+    std::string line;
+    int number = 0;
+    while (std::getline(file, line)) {
+        number++;
+        std::string name = include_name(line);
+        if (!name.empty()) {
+            if (!append_file(directory_of(path) + name, source, stack, false, defines)) {
+                return false;
+            }
+            source.text += "#line " + std::to_string(number + 1) + " " + std::to_string(index) + "\n";
+            continue;
+        }
+        source.text += line + '\n';
+
+        // Permutation keys go right after #version, which has to stay the first statement.
+        if (root && line.compare(0, 8, "#version") == 0) {
+            source.text += defines;
+            source.text += "#line " + std::to_string(number + 1) + " 0\n";
+        }
+    }
+    stack.pop_back();
+    return true;
+}
+
+/**
+ * @brief Read a GLSL file, paste its '#include "file"' lines (relative to the including file)
+ * and define the permutation keys after its #version line.
+ *
+ * @param path Shader file.
+ * @param defines Keys, as "NAME" or "NAME=VALUE".
+ * @param source Receives the assembled source and the list of files in it.
+ * @return bool false if a file is missing or includes itself.
+ */
+bool preprocess_shader(const char* path, const std::vector<std::string>& defines, ShaderSource& source) {
+    std::string block;
+    for (const std::string& define : defines) {
+        size_t equals = define.find('=');
+        if (equals == std::string::npos) {
+            block += "#define " + define + " 1\n";
+        }
+        else {
+            block += "#define " + define.substr(0, equals) + " " + define.substr(equals + 1) + "\n";
+        }
+    }
+
+    source.text.clear();
+    source.files.clear();
+    std::vector<std::string> stack;
+    return append_file(path, source, stack, true, block);
+}
+
+/**
+ * @brief Canonical name of a set of permutation keys, the same whatever their order.
+ */
+std::string shader_variant_key(const std::vector<std::string>& defines) {
+    std::vector<std::string> sorted = defines;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    std::string key;
+    for (const std::string& define : sorted) {
+        key += (key.empty() ? "" : " ") + define;
+    }
+    return key;
+}
@@ -0,0 +1,22 @@
+/**
+ * @file ShaderPreprocessor.hpp
+ * @author Rohan Siddhu
+ * @brief #include resolution and #define injection for GLSL sources.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Shader source after preprocessing, with the files it was assembled from. The GLSL compiler
+// reports errors as "source:line", where source indexes files.
+struct ShaderSource {
+    std::string text;
+    std::vector<std::string> files;
+};
+
+bool preprocess_shader(const char* path, const std::vector<std::string>& defines, ShaderSource& source);
+std::string shader_variant_key(const std::vector<std::string>& defines);
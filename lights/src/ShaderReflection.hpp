@@ -0,0 +1,29 @@
+/**
+ * @file ShaderReflection.hpp
+ * @author Rohan Siddhu
+ * @brief std140 layouts of the uniform blocks, as computed offline by shaderreflect.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <glad/glad.h>
+
+// A leaf member of a block under its GL resource name, "light.ambient" or "pointLights[0].color".
+struct ShaderBlockMember {
+    const char* name;
+    GLint offset;
+};
+
+// Layout the C++ struct of a block was generated with. Shader checks every linked program
+// against it, so a driver that disagrees, or a stale header, is reported instead of read as
+// garbage.
+struct ShaderBlockLayout {
+    const char* name;
+    GLuint binding;
+    GLint size;
+    const ShaderBlockMember* members;
+    size_t memberCount;
+};
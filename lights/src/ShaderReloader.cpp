@@ -0,0 +1,208 @@
+/**
+ * @file ShaderReloader.cpp
+ * @author Rohan Siddhu
+ * @brief ShaderReloader class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "ShaderReloader.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// glMaxShaderCompilerThreadsARB, loaded by hand like SHADER_COMPLETION_STATUS.
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSARBPROC)(GLuint count);
+
+// Editors save in several writes, a change is acted on once the files have been quiet this long.
+constexpr std::chrono::milliseconds SHADER_SETTLE_TIME(50);
+
+/**
+ * @brief Start watching a directory and its subdirectories. On Linux the kernel reports changes
+ * through inotify; elsewhere the modification times are polled a few times a second.
+ *
+ * @param directory Shader directory, as the programs name their files ("res/shaders").
+ * @param loader GL function loader, for the parallel compile extension.
+ * @return bool false if the directory does not exist.
+ */
+bool ShaderReloader::init(const char* directory, GLADloadproc loader) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        std::cerr << "Failed to watch shaders, no directory " << directory << std::endl;
+        return false;
+    }
+    this->directory = directory;
+
+    // Let the driver compile on its own threads, so a rebuild does not stall the frames.
+    GLint extensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensions);
+    for (GLint i = 0; i < extensions; i++) {
+        const char* name = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0 || std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0) {
+            parallel = true;
+        }
+    }
+    if (parallel) {
+        auto maxThreads = (PFNGLMAXSHADERCOMPILERTHREADSARBPROC)loader("glMaxShaderCompilerThreadsARB");
+        if (!maxThreads) {
+            maxThreads = (PFNGLMAXSHADERCOMPILERTHREADSARBPROC)loader("glMaxShaderCompilerThreadsKHR");
+        }
+        if (maxThreads) {
+            maxThreads(0xFFFFFFFF);
+        }
+    }
+
+    std::vector<std::string> directories = { this->directory };
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+        if (entry.is_directory()) {
+            directories.push_back(entry.path().generic_string());
+        }
+        else {
+            stamps[entry.path().generic_string()] = entry.last_write_time();
+        }
+    }
+#ifdef __linux__
+    inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    for (const std::string& path : directories) {
+        int watch = inotify >= 0 ? inotify_add_watch(inotify, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) : -1;
+        if (watch >= 0) {
+            watches[watch] = path;
+        }
+    }
+#endif
+    lastPoll = std::chrono::steady_clock::now();
+    return true;
+}
+
+/**
+ * @brief Swap in the programs that finished building, then start rebuilding those whose files
+ * changed. Call once per frame before drawing, so a frame never mixes old and new programs.
+ */
+void ShaderReloader::update() {
+    if (inotify >= 0) {
+        readEvents();
+    }
+    else if (!directory.empty()) {
+        pollFiles();
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (!building.empty()) {
+        std::vector<Shader*> pending;
+        for (Shader* shader : building) {
+            ShaderReloadStatus status = shader->finishReload(!parallel);
+            if (status == RELOAD_PENDING) {
+                pending.push_back(shader);
+            }
+            else if (status == RELOAD_FAILED) {
+                failures++;
+            }
+            else if (status == RELOAD_SWAPPED) {
+                reloads++;
+            }
+        }
+        building = pending;
+        if (building.empty()) {
+            lastMilliseconds = std::chrono::duration<float, std::milli>(now - buildStart).count();
+        }
+    }
+
+    if (changed.empty() || now - lastChange < SHADER_SETTLE_TIME) {
+        return;
+    }
+    // A program already building is started again with the newer files.
+    buildStart = now;
+    for (Shader* shader : Shader::all()) {
+        bool affected = false;
+        for (const std::string& path : changed) {
+            affected = affected || shader->usesFile(path);
+        }
+        if (!affected) {
+            continue;
+        }
+        if (!shader->beginReload()) {
+            failures++;
+        }
+        else if (std::find(building.begin(), building.end(), shader) == building.end()) {
+            building.push_back(shader);
+        }
+    }
+    changed.clear();
+}
+
+void ShaderReloader::clean() {
+#ifdef __linux__
+    if (inotify >= 0) {
+        close(inotify);
+    }
+#endif
+    inotify = -1;
+    watches.clear();
+    stamps.clear();
+    building.clear();
+    changed.clear();
+    directory.clear();
+}
+
+
+/*
+* Private Methods
+*/
+
+void ShaderReloader::readEvents() {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(inotify, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + length; p += sizeof(inotify_event) + ((inotify_event*)p)->len) {
+            const inotify_event* event = (const inotify_event*)p;
+            auto watch = watches.find(event->wd);
+            if (watch == watches.end() || event->len == 0) {
+                continue;
+            }
+            std::string path = watch->second + "/" + event->name;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & IN_CREATE) {
+                    int added = inotify_add_watch(inotify, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+                    if (added >= 0) {
+                        watches[added] = path;
+                    }
+                }
+                continue;
+            }
+            // A new empty file is only interesting once written, which IN_CLOSE_WRITE reports.
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                changed.insert(path);
+                lastChange = std::chrono::steady_clock::now();
+            }
+        }
+    }
+#endif
+}
+
+void ShaderReloader::pollFiles() {
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastPoll < std::chrono::milliseconds(250)) {
+        return;
+    }
+    lastPoll = now;
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        std::string path = entry.path().generic_string();
+        auto time = entry.last_write_time(error);
+        auto found = stamps.find(path);
+        if (found == stamps.end() || found->second != time) {
+            stamps[path] = time;
+            changed.insert(path);
+            lastChange = now;
+        }
+    }
+}
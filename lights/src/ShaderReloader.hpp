@@ -0,0 +1,48 @@
+/**
+ * @file ShaderReloader.hpp
+ * @author Rohan Siddhu
+ * @brief Watches the shader directory and rebuilds the programs whose files changed.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "Shader.hpp"
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+class ShaderReloader {
+private:
+    std::string directory;
+    int inotify = -1;                               /** inotify descriptor, -1 when polling. */
+    std::map<int, std::string> watches;             /** Watch descriptor to watched directory. */
+    std::map<std::string, std::filesystem::file_time_type> stamps;  /** Modification times, when polling. */
+    std::chrono::steady_clock::time_point lastPoll;
+    std::set<std::string> changed;                  /** Files changed since the last rebuild started. */
+    std::chrono::steady_clock::time_point lastChange;
+    std::vector<Shader*> building;
+    std::chrono::steady_clock::time_point buildStart;
+    bool parallel = false;                          /** GL_ARB_parallel_shader_compile is available. */
+    int reloads = 0, failures = 0;
+    float lastMilliseconds = 0.0f;
+public:
+    bool init(const char* directory, GLADloadproc loader);
+    void update();
+    void clean();
+
+    bool parallelCompile() const { return parallel; }
+    bool watching() const { return inotify >= 0; }
+    bool busy() const { return !building.empty() || !changed.empty(); }
+    int reloadCount() const { return reloads; }
+    int failureCount() const { return failures; }
+    float lastReloadTime() const { return lastMilliseconds; }
+private:
+    void readEvents();
+    void pollFiles();
+};
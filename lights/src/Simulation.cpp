@@ -0,0 +1,194 @@
+/**
+ * @file Simulation.cpp
+ * @author Rohan Siddhu
+ * @brief Fixed timestep simulation of the camera and animations on its own thread.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Simulation.hpp"
+#include <algorithm>
+#include <cmath>
+
+static double seconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+Simulation::~Simulation() {
+    stop();
+}
+
+/**
+ * @brief Start stepping from a camera on the simulation thread.
+ *
+ * @param camera Initial camera.
+ * @param lightsAngle Initial angle of the animated point lights.
+ */
+void Simulation::start(const Camera& camera, float lightsAngle) {
+    stop();
+    this->camera = camera;
+    lastInput = pendingInput;
+    inputs.write(pendingInput);
+
+    SimulationState state;
+    state.position = camera.position;
+    state.yaw = camera.yaw;
+    state.pitch = camera.pitch;
+    state.fov = camera.fov;
+    state.lightsAngle = lightsAngle;
+    StatePair initial { state, state };
+    states.write(initial);
+
+    // The thread starts from its own copy, states is only read by the window thread.
+    startTime = Clock::now();
+    stopping = false;
+    thread = std::thread(&Simulation::run, this, initial);
+}
+
+/**
+ * @brief Stop the simulation thread. The last state stays readable.
+ */
+void Simulation::stop() {
+    if (!thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+}
+
+void Simulation::setKeys(uint32_t keys) {
+    if (keys != pendingInput.keys) {
+        pendingInput.keys = keys;
+        inputs.write(pendingInput);
+    }
+}
+
+void Simulation::cursorMoved(float xOffset, float yOffset) {
+    pendingInput.cursorX += xOffset;
+    pendingInput.cursorY += yOffset;
+    inputs.write(pendingInput);
+}
+
+void Simulation::scrolled(float yOffset) {
+    pendingInput.scroll += yOffset;
+    inputs.write(pendingInput);
+}
+
+void Simulation::setAnimateLights(bool animate) {
+    if (animate != pendingInput.animateLights) {
+        pendingInput.animateLights = animate;
+        inputs.write(pendingInput);
+    }
+}
+
+/**
+ * @brief State to draw now: the blend of the last two steps one step in the past. Called by the
+ * window thread once per frame.
+ *
+ * @return SimulationState Interpolated state, with the step number of the newer one.
+ */
+SimulationState Simulation::interpolate() {
+    states.update();
+    const StatePair& pair = states.read();
+    double now = seconds(Clock::now() - startTime);
+    alpha = (float)std::clamp((now - pair.current.time) / step(), 0.0, 1.0);
+
+    SimulationState state = pair.current;
+    state.position = glm::mix(pair.previous.position, pair.current.position, alpha);
+    state.yaw = glm::mix(pair.previous.yaw, pair.current.yaw, alpha);
+    state.pitch = glm::mix(pair.previous.pitch, pair.current.pitch, alpha);
+    state.fov = glm::mix(pair.previous.fov, pair.current.fov, alpha);
+    state.lightsAngle = glm::mix(pair.previous.lightsAngle, pair.current.lightsAngle, alpha);
+    return state;
+}
+
+
+/*
+* Private Methods
+*/
+
+// Accumulate the elapsed time and run one step per SIMULATION_RATE-th of a second of it. After a
+// stall, at most SIMULATION_MAX_CATCH_UP steps run and the rest of the backlog is dropped, so a
+// long hitch cannot leave the simulation permanently behind.
+void Simulation::run(StatePair pair) {
+    const double dt = step();
+    double accumulator = 0.0;
+    Clock::time_point last = startTime;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        auto due = last + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dt - accumulator));
+        if (wake.wait_until(lock, due, [this] { return stopping; })) {
+            break;
+        }
+        lock.unlock();
+
+        Clock::time_point now = Clock::now();
+        accumulator += seconds(now - last);
+        last = now;
+
+        int steps = 0;
+        while (accumulator >= dt && steps < SIMULATION_MAX_CATCH_UP) {
+            pair.previous = pair.current;
+            inputs.update();
+            bool reset = inputs.read().keys & 1u << (int)Command::RESET;
+            advance(pair.current, dt);
+            if (reset) {
+                pair.previous = pair.current;       // jump, do not sweep across the scene
+            }
+            accumulator -= dt;
+            steps++;
+        }
+        if (accumulator >= dt) {
+            double dropped = std::floor(accumulator / dt);
+            droppedSteps.fetch_add((uint64_t)dropped, std::memory_order_relaxed);
+            accumulator -= dropped * dt;
+        }
+
+        if (steps > 0) {
+            // The newest step was due when the accumulator last crossed a step.
+            pair.current.time = seconds(now - startTime) - accumulator;
+            pair.previous.time = pair.current.time - dt;
+            states.write(pair);
+        }
+        lock.lock();
+    }
+}
+
+// One fixed step of the camera and the lights, from the last input.
+void Simulation::advance(SimulationState& state, double time) {
+    const SimulationInput& input = inputs.read();
+
+    float xOffset = (float)(input.cursorX - lastInput.cursorX);
+    float yOffset = (float)(input.cursorY - lastInput.cursorY);
+    if (xOffset != 0.0f || yOffset != 0.0f) {
+        camera.mouseInput(xOffset, yOffset);
+    }
+    if (input.scroll != lastInput.scroll) {
+        camera.zoom((float)(input.scroll - lastInput.scroll));
+    }
+
+    const Command moves[] = { Command::FORWARD, Command::BACKWARD, Command::RIGHT, Command::LEFT, Command::UP, Command::DOWN };
+    for (Command command : moves) {
+        if (input.keys & 1u << (int)command) {
+            camera.keyInput(command, (float)time);
+        }
+    }
+    if (input.keys & 1u << (int)Command::RESET) {
+        camera.keyInput(Command::RESET);
+    }
+    if (input.animateLights) {
+        state.lightsAngle += (float)time * 0.5f;
+    }
+    lastInput = input;
+
+    state.step++;
+    state.position = camera.position;
+    state.yaw = camera.yaw;
+    state.pitch = camera.pitch;
+    state.fov = camera.fov;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file Simulation.hpp
+ * @author Rohan Siddhu
+ * @brief Fixed timestep simulation of the camera and animations on its own thread.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "Camera.hpp"
+#include "TripleBuffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <glm/glm.hpp>
+
+// Simulated steps per second.
+constexpr int SIMULATION_RATE = 120;
+
+// Steps run back to back to catch up after a stall; older ones are dropped.
+constexpr int SIMULATION_MAX_CATCH_UP = 8;
+
+// Inputs as the window thread last saw them. Cursor and scroll offsets are running totals,
+// the simulation applies the change since its previous step.
+struct SimulationInput {
+    uint32_t keys = 0;              /** Bit (1 << Command) per key held down. */
+    double cursorX = 0.0;
+    double cursorY = 0.0;
+    double scroll = 0.0;
+    bool animateLights = false;
+};
+
+struct SimulationState {
+    uint64_t step = 0;
+    double time = 0.0;              /** Seconds since start() at which the step was due. */
+    glm::vec3 position { 0.0f };
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    float fov = 0.0f;
+    float lightsAngle = 0.0f;
+};
+
+// The camera and the light animation advance in fixed steps on a thread of their own, so a
+// slow frame neither changes how far the camera moves nor drops input. The window thread sends
+// its inputs and reads the last two states through lock-free triple buffers, and draws a blend
+// of them one step in the past, which keeps motion smooth at any frame rate.
+class Simulation {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // The last two steps, handed over together so they always belong to each other.
+    struct StatePair {
+        SimulationState previous;
+        SimulationState current;
+    };
+
+    TripleBuffer<SimulationInput> inputs;
+    TripleBuffer<StatePair> states;
+    SimulationInput pendingInput;       /** Window thread only. */
+    Clock::time_point startTime;
+
+    // Simulation thread only.
+    Camera camera;
+    SimulationInput lastInput;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    std::atomic<uint64_t> droppedSteps { 0 };
+    float alpha = 0.0f;
+public:
+    Simulation() = default;
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+    ~Simulation();
+
+    void start(const Camera& camera, float lightsAngle);
+    void stop();
+
+    // Window thread input.
+    void setKeys(uint32_t keys);
+    void cursorMoved(float xOffset, float yOffset);
+    void scrolled(float yOffset);
+    void setAnimateLights(bool animate);
+
+    SimulationState interpolate();
+
+    uint64_t dropped() const { return droppedSteps.load(std::memory_order_relaxed); }
+    float blend() const { return alpha; }
+    static double step() { return 1.0 / SIMULATION_RATE; }
+private:
+    void run(StatePair pair);
+    void advance(SimulationState& state, double time);
+};
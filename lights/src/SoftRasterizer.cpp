@@ -0,0 +1,835 @@
+/**
+ * @file SoftRasterizer.cpp
+ * @author Rohan Siddhu
+ * @brief Tile based software rasterizer for the lit scene, for hosts without a GPU.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "SoftRasterizer.hpp"
+#include "Image.hpp"
+#include "stb_image.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOFT_SSE2 1
+#endif
+
+// Vertices are clipped to this many pixels around the viewport, which keeps the sub-pixel
+// positions within 18 bits and the edge functions within 64.
+constexpr float SOFT_GUARD_BAND = 8192.0f;
+
+// Edge function values beyond this decide a whole tile alike, they are clamped to fit 32 bit lanes.
+constexpr int64_t SOFT_EDGE_CLAMP = 1 << 30;
+
+// Vertices transformed per task.
+constexpr size_t SOFT_VERTEX_CHUNK = 4096;
+
+// Pixel offsets of the four lanes of a 2 x 2 quad.
+static const float QUAD_X[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+static const float QUAD_Y[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+static uint32_t pack_color(glm::vec3 c) {
+    glm::vec3 v = glm::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f;
+    return (uint32_t)v.r | (uint32_t)v.g << 8 | (uint32_t)v.b << 16 | 0xFF000000u;
+}
+
+// Filtered colors fall between the 8 bit values, so the table of the mipmap filter is interpolated.
+static glm::vec3 decode_srgb(glm::vec3 c) {
+    static const float* toLinear = srgb_to_linear_table();
+    glm::vec3 linear;
+    for (int i = 0; i < 3; i++) {
+        float f = std::clamp(c[i], 0.0f, 1.0f) * 255.0f;
+        int index = std::min((int)f, 254);
+        linear[i] = toLinear[index] + (toLinear[index + 1] - toLinear[index]) * (f - (float)index);
+    }
+    return linear;
+}
+
+// Lanes of a quad inside all three edges, as a 4 bit mask.
+static int quad_coverage(const int32_t* edges, const int32_t* stepX, const int32_t* stepY) {
+#ifdef SOFT_SSE2
+    __m128i outside = _mm_setzero_si128();
+    for (int i = 0; i < 3; i++) {
+        __m128i steps = _mm_set_epi32(stepX[i] + stepY[i], stepY[i], stepX[i], 0);
+        outside = _mm_or_si128(outside, _mm_add_epi32(_mm_set1_epi32(edges[i]), steps));
+    }
+    return ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+#else
+    int mask = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        int32_t outside = 0;
+        for (int i = 0; i < 3; i++) {
+            outside |= edges[i] + (lane & 1 ? stepX[i] : 0) + (lane & 2 ? stepY[i] : 0);
+        }
+        mask |= outside >= 0 ? 1 << lane : 0;
+    }
+    return mask;
+#endif
+}
+
+// Plane value at the four lanes of a quad. Both paths round the same way, so the image does not
+// depend on which one was compiled.
+static void evaluate_plane(const float* plane, const float* dx, const float* dy, float* values) {
+#ifdef SOFT_SSE2
+    __m128 v = _mm_add_ps(_mm_set1_ps(plane[0]), _mm_mul_ps(_mm_set1_ps(plane[1]), _mm_loadu_ps(dx)));
+    _mm_storeu_ps(values, _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(plane[2]), _mm_loadu_ps(dy))));
+#else
+    for (int lane = 0; lane < 4; lane++) {
+        values[lane] = (plane[0] + plane[1] * dx[lane]) + plane[2] * dy[lane];
+    }
+#endif
+}
+
+// Depth test of the covered lanes of a quad against its two rows of the depth buffer, which
+// keeps the nearer depths. Returns the lanes that passed.
+static int depth_test(const float* depth, int mask, float* row0, float* row1, bool fullQuad) {
+#ifdef SOFT_SSE2
+    if (fullQuad) {
+        __m128 stored = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)row0), (const __m64*)row1);
+        __m128 values = _mm_loadu_ps(depth);
+        int passed = _mm_movemask_ps(_mm_cmplt_ps(values, stored)) & mask;
+        const __m128i laneBits = _mm_set_epi32(8, 4, 2, 1);
+        __m128 select = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(passed), laneBits), laneBits));
+        __m128 result = _mm_or_ps(_mm_and_ps(select, values), _mm_andnot_ps(select, stored));
+        _mm_storel_pi((__m64*)row0, result);
+        _mm_storeh_pi((__m64*)row1, result);
+        return passed;
+    }
+#else
+    (void)fullQuad;
+#endif
+    for (int lane = 0; lane < 4; lane++) {
+        float& stored = (lane >> 1 ? row1 : row0)[lane & 1];
+        if (mask & 1 << lane) {
+            if (depth[lane] < stored) {
+                stored = depth[lane];
+            }
+            else {
+                mask &= ~(1 << lane);
+            }
+        }
+    }
+    return mask;
+}
+
+// Perspective correct attributes at the four lanes of a quad: each plane divided by the
+// interpolated 1 / w.
+static void interpolate_attributes(const float (*planes)[3], int count, const float* dx, const float* dy, float (*attributes)[4]) {
+#ifdef SOFT_SSE2
+    __m128 x = _mm_loadu_ps(dx);
+    __m128 y = _mm_loadu_ps(dy);
+    auto evaluate = [&](const float* plane) {
+        __m128 v = _mm_add_ps(_mm_set1_ps(plane[0]), _mm_mul_ps(_mm_set1_ps(plane[1]), x));
+        return _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(plane[2]), y));
+    };
+    __m128 w = _mm_div_ps(_mm_set1_ps(1.0f), evaluate(planes[0]));
+    for (int k = 0; k < count; k++) {
+        _mm_storeu_ps(attributes[k], _mm_mul_ps(evaluate(planes[1 + k]), w));
+    }
+#else
+    float w[4];
+    evaluate_plane(planes[0], dx, dy, w);
+    for (int lane = 0; lane < 4; lane++) {
+        w[lane] = 1.0f / w[lane];
+    }
+    for (int k = 0; k < count; k++) {
+        evaluate_plane(planes[1 + k], dx, dy, attributes[k]);
+        for (int lane = 0; lane < 4; lane++) {
+            attributes[k][lane] *= w[lane];
+        }
+    }
+#endif
+}
+
+#ifdef SOFT_SSE2
+// Shading of a quad in structure of arrays form: one vector per component, one lane per pixel.
+struct QuadVec3 {
+    __m128 x, y, z;
+};
+
+static QuadVec3 quad_splat(glm::vec3 v) {
+    return { _mm_set1_ps(v.x), _mm_set1_ps(v.y), _mm_set1_ps(v.z) };
+}
+
+static QuadVec3 quad_load(const float* x, const float* y, const float* z) {
+    return { _mm_loadu_ps(x), _mm_loadu_ps(y), _mm_loadu_ps(z) };
+}
+
+static QuadVec3 quad_add(const QuadVec3& a, const QuadVec3& b) {
+    return { _mm_add_ps(a.x, b.x), _mm_add_ps(a.y, b.y), _mm_add_ps(a.z, b.z) };
+}
+
+static QuadVec3 quad_sub(const QuadVec3& a, const QuadVec3& b) {
+    return { _mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y), _mm_sub_ps(a.z, b.z) };
+}
+
+static QuadVec3 quad_mul(const QuadVec3& a, const QuadVec3& b) {
+    return { _mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y), _mm_mul_ps(a.z, b.z) };
+}
+
+static QuadVec3 quad_scale(const QuadVec3& a, __m128 s) {
+    return { _mm_mul_ps(a.x, s), _mm_mul_ps(a.y, s), _mm_mul_ps(a.z, s) };
+}
+
+static __m128 quad_dot(const QuadVec3& a, const QuadVec3& b) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+}
+
+// As glm::normalize, a multiply with the inverse length.
+static QuadVec3 quad_normalize(const QuadVec3& a) {
+    return quad_scale(a, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(quad_dot(a, a))));
+}
+
+// glm::reflect(-l, n) = 2 * dot(n, l) * n - l.
+static QuadVec3 quad_reflect_negated(const QuadVec3& l, const QuadVec3& n) {
+    __m128 d = _mm_mul_ps(_mm_set1_ps(2.0f), quad_dot(n, l));
+    return quad_sub(quad_scale(n, d), l);
+}
+
+// log2 of positive values, the polynomial of the Cephes logf on the mantissa in
+// [sqrt(0.5), sqrt(2)).
+static __m128 quad_log2(__m128 x) {
+    __m128i bits = _mm_castps_si128(x);
+    __m128i exponent = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+    __m128 high = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356f));
+    m = _mm_or_ps(_mm_and_ps(high, _mm_mul_ps(m, _mm_set1_ps(0.5f))), _mm_andnot_ps(high, m));
+    exponent = _mm_sub_epi32(exponent, _mm_castps_si128(high));
+
+    __m128 f = _mm_sub_ps(m, _mm_set1_ps(1.0f));
+    static const float coefficients[] = { 7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f, -1.2420140846e-1f,
+        1.4249322787e-1f, -1.6668057665e-1f, 2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f };
+    __m128 p = _mm_set1_ps(coefficients[0]);
+    for (int i = 1; i < 9; i++) {
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(coefficients[i]));
+    }
+    __m128 f2 = _mm_mul_ps(f, f);
+    __m128 ln = _mm_add_ps(f, _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(f, f2), p), _mm_mul_ps(_mm_set1_ps(0.5f), f2)));
+    return _mm_add_ps(_mm_mul_ps(ln, _mm_set1_ps(1.44269504f)), _mm_cvtepi32_ps(exponent));
+}
+
+// 2^x, the polynomial of the Cephes exp2f on the fraction in [-0.5, 0.5].
+static __m128 quad_exp2(__m128 x) {
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-126.0f)), _mm_set1_ps(126.0f));
+    __m128i n = _mm_cvtps_epi32(x);
+    __m128 f = _mm_sub_ps(x, _mm_cvtepi32_ps(n));
+    static const float coefficients[] = { 1.535336188319500e-4f, 1.339887440266574e-3f, 9.618437357674640e-3f,
+        5.550332471162809e-2f, 2.402264791363012e-1f, 6.931472028550421e-1f };
+    __m128 p = _mm_set1_ps(coefficients[0]);
+    for (int i = 1; i < 6; i++) {
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(coefficients[i]));
+    }
+    __m128 r = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(f, p));
+    return _mm_mul_ps(r, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23)));
+}
+
+// Specular term pow(max(x, 0), shininess), 0 where x is not positive.
+static __m128 quad_specular(__m128 x, float shininess) {
+    __m128 positive = _mm_cmpgt_ps(x, _mm_setzero_ps());
+    __m128 safe = _mm_or_ps(_mm_and_ps(positive, x), _mm_andnot_ps(positive, _mm_set1_ps(1.0f)));
+    return _mm_and_ps(positive, quad_exp2(_mm_mul_ps(quad_log2(safe), _mm_set1_ps(shininess))));
+}
+
+static __m128 quad_max0(__m128 x) {
+    return _mm_max_ps(x, _mm_setzero_ps());
+}
+
+// pack_color of each lane.
+static void quad_pack(const QuadVec3& c, uint32_t* colors) {
+    auto channel = [](__m128 v) {
+        v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+    };
+    __m128i packed = _mm_or_si128(channel(c.x), _mm_slli_epi32(channel(c.y), 8));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(channel(c.z), 16));
+    _mm_storeu_si128((__m128i*)colors, _mm_or_si128(packed, _mm_set1_epi32((int)0xFF000000u)));
+}
+#endif
+
+/**
+ * @brief Load an image and build its mipmaps as the material textures get them.
+ *
+ * @param path Image file.
+ * @param srgb Color data, filtered in linear light when building the mipmaps.
+ * @param flipVertically Put the last row first, for images loaded with stbi_set_flip_vertically_on_load.
+ * @return bool false if the image could not be read.
+ */
+bool SoftTexture::load(const char* path, bool srgb, bool flipVertically) {
+    int width, height, channels;
+    unsigned char* img = stbi_load(path, &width, &height, &channels, 4);
+    if (!img) {
+        std::cerr << "Failed to load texture " << path << std::endl;
+        return false;
+    }
+    if (flipVertically) {
+        for (int y = 0; y < height / 2; y++) {
+            std::swap_ranges(img + (size_t)y * width * 4, img + (size_t)(y + 1) * width * 4, img + (size_t)(height - 1 - y) * width * 4);
+        }
+    }
+    std::vector<std::vector<unsigned char>> mips = generate_mipmaps(img, width, height, srgb);
+    stbi_image_free(img);
+
+    levels.clear();
+    for (const std::vector<unsigned char>& mip : mips) {
+        Level level { width, height, std::vector<uint32_t>((size_t)width * height) };
+        std::memcpy(level.texels.data(), mip.data(), level.texels.size() * sizeof(uint32_t));
+        levels.push_back(std::move(level));
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return true;
+}
+
+/**
+ * @brief Trilinear lookup. The level comes from the texture coordinate derivatives over a pixel,
+ * as GPUs take them across a 2 x 2 quad.
+ *
+ * @param uv Texture coordinates.
+ * @param uvDx Change of uv to the next pixel in x.
+ * @param uvDy Change of uv to the next pixel in y.
+ * @return glm::vec3 Filtered color.
+ */
+glm::vec3 SoftTexture::sample(glm::vec2 uv, glm::vec2 uvDx, glm::vec2 uvDy) const {
+    glm::vec2 size((float)levels[0].width, (float)levels[0].height);
+    float rho = std::max(glm::dot(uvDx * size, uvDx * size), glm::dot(uvDy * size, uvDy * size));
+    float lod = 0.5f * std::log2(std::max(rho, 1.0f));
+    int last = (int)levels.size() - 1;
+    if (lod >= (float)last) {
+        return sampleLevel(last, uv);
+    }
+    int level = (int)lod;
+    float blend = lod - (float)level;
+    glm::vec3 color = sampleLevel(level, uv);
+    if (blend > 0.0f) {
+        color = glm::mix(color, sampleLevel(level + 1, uv), blend);
+    }
+    return color;
+}
+
+glm::vec3 SoftTexture::sampleLevel(int level, glm::vec2 uv) const {
+    // Repeat wrapping without divisions: x lands in [-0.5, width - 0.5).
+    const Level& l = levels[level];
+    float x = (uv.x - std::floor(uv.x)) * l.width - 0.5f;
+    float y = (uv.y - std::floor(uv.y)) * l.height - 0.5f;
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    int x0 = fx < 0.0f ? l.width - 1 : std::min((int)fx, l.width - 1);
+    int y0 = fy < 0.0f ? l.height - 1 : std::min((int)fy, l.height - 1);
+    int x1 = x0 + 1 < l.width ? x0 + 1 : 0;
+    int y1 = y0 + 1 < l.height ? y0 + 1 : 0;
+
+    auto texel = [&](int tx, int ty) {
+        uint32_t t = l.texels[(size_t)ty * l.width + tx];
+        return glm::vec3((float)(t & 0xFF), (float)(t >> 8 & 0xFF), (float)(t >> 16 & 0xFF));
+    };
+    glm::vec3 top = glm::mix(texel(x0, y0), texel(x1, y0), x - fx);
+    glm::vec3 bottom = glm::mix(texel(x0, y1), texel(x1, y1), x - fx);
+    return glm::mix(top, bottom, y - fy) * (1.0f / 255.0f);
+}
+
+/**
+ * @brief Allocate the color and depth buffers.
+ *
+ * @param width Width in pixels, up to the guard band.
+ * @param height Height in pixels.
+ * @param pool Threads rasterizing the tiles, or nullptr to draw on the calling thread.
+ * @return bool false if the size is not supported.
+ */
+bool SoftRasterizer::init(int width, int height, ThreadPool* pool) {
+    if (width <= 0 || height <= 0 || width > (int)SOFT_GUARD_BAND || height > (int)SOFT_GUARD_BAND) {
+        std::cerr << "Failed to create a " << width << "x" << height << " software render target" << std::endl;
+        return false;
+    }
+    this->width = width;
+    this->height = height;
+    this->pool = pool;
+    tilesX = (width + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    tilesY = (height + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    colorBuffer.assign((size_t)width * height, 0);
+    depthBuffer.assign((size_t)width * height, 1.0f);
+    bins.assign(tilesX * tilesY, {});
+    tilePixels.assign(tilesX * tilesY, 0);
+    return true;
+}
+
+void SoftRasterizer::clear(glm::vec3 color) {
+    std::fill(colorBuffer.begin(), colorBuffer.end(), pack_color(color));
+    std::fill(depthBuffer.begin(), depthBuffer.end(), 1.0f);
+    submittedTriangles = 0;
+    binnedTriangles = 0;
+    shadedPixels = 0;
+}
+
+/**
+ * @brief Camera and lights of the following draws, as the lit shaders get them.
+ *
+ * @param frame Camera, main light and sun.
+ * @param pointLights Additional point lights.
+ * @param sun Whether to light with the sun, the SUN_LIGHT key of the shaders.
+ */
+void SoftRasterizer::setFrame(const glsl::Frame& frame, const glsl::PointLights& pointLights, bool sun) {
+    this->frame = frame;
+    this->pointLights = pointLights;
+    sunEnabled = sun;
+    lightPosition = glm::vec3(frame.view * glm::vec4(frame.lightPos, 1.0f));
+}
+
+/**
+ * @brief Transform, clip and bin a triangle list. Nothing is drawn before flush().
+ *
+ * @param vertices Three vertices per triangle.
+ * @param count Number of vertices.
+ * @param model Model matrix.
+ * @param material Textures, which must outlive the next flush().
+ */
+void SoftRasterizer::draw(const SoftVertex* vertices, size_t count, const glm::mat4& model, const SoftMaterial& material) {
+    int materialIndex = (int)materials.size();
+    materials.push_back(material);
+
+    glm::mat4 modelView = frame.view * model;
+    glm::mat4 modelViewProjection = frame.projection * modelView;
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(modelView)));
+
+    std::vector<ClipVertex> transformed(count);
+    auto transform = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const SoftVertex& v = vertices[i];
+            ClipVertex& out = transformed[i];
+            out.clip = modelViewProjection * glm::vec4(v.position, 1.0f);
+            glm::vec3 viewPosition = glm::vec3(modelView * glm::vec4(v.position, 1.0f));
+            glm::vec3 normal = normalMatrix * v.normal;
+            float* a = out.attributes;
+            a[0] = viewPosition.x; a[1] = viewPosition.y; a[2] = viewPosition.z;
+            a[3] = normal.x; a[4] = normal.y; a[5] = normal.z;
+            a[6] = v.texCoords.x; a[7] = v.texCoords.y;
+        }
+    };
+    if (count > SOFT_VERTEX_CHUNK) {
+        int chunks = (int)((count + SOFT_VERTEX_CHUNK - 1) / SOFT_VERTEX_CHUNK);
+        parallelFor(chunks, [&](int chunk) {
+            transform(chunk * SOFT_VERTEX_CHUNK, std::min(count, (chunk + 1) * SOFT_VERTEX_CHUNK));
+        });
+    }
+    else {
+        transform(0, count);
+    }
+
+    for (size_t i = 0; i + 2 < count; i += 3) {
+        clipTriangle(&transformed[i], materialIndex);
+    }
+    submittedTriangles += count / 3;
+}
+
+/**
+ * @brief Rasterize the binned triangles, one task per tile.
+ */
+void SoftRasterizer::flush() {
+    parallelFor(tilesX * tilesY, [this](int tile) {
+        rasterizeTile(tile);
+    });
+    for (size_t tile = 0; tile < bins.size(); tile++) {
+        shadedPixels += tilePixels[tile];
+        tilePixels[tile] = 0;
+        bins[tile].clear();
+    }
+    triangles.clear();
+    materials.clear();
+}
+
+
+/*
+* Private Methods
+*/
+
+void SoftRasterizer::parallelFor(int count, const std::function<void(int)>& body) {
+    if (pool) {
+        pool->parallelFor(count, body);
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        body(i);
+    }
+}
+
+// Clip against the near and far planes and the guard band, then set up the pieces as a fan.
+// Triangles inside all planes, nearly all of them, skip the polygon clipper.
+void SoftRasterizer::clipTriangle(const ClipVertex* vertices, int material) {
+    float guardX = 1.0f + 2.0f * SOFT_GUARD_BAND / width;
+    float guardY = 1.0f + 2.0f * SOFT_GUARD_BAND / height;
+    auto distance = [&](const glm::vec4& c, int plane) {
+        switch (plane) {
+        case 0: return c.w + c.z;
+        case 1: return c.w - c.z;
+        case 2: return guardX * c.w + c.x;
+        case 3: return guardX * c.w - c.x;
+        case 4: return guardY * c.w + c.y;
+        default: return guardY * c.w - c.y;
+        }
+    };
+
+    int outside = 0;
+    for (int plane = 0; plane < 6; plane++) {
+        int count = 0;
+        for (int v = 0; v < 3; v++) {
+            count += distance(vertices[v].clip, plane) < 0.0f;
+        }
+        if (count == 3) {
+            return;
+        }
+        outside |= count ? 1 << plane : 0;
+    }
+    if (!outside) {
+        setupTriangle(vertices[0], vertices[1], vertices[2], material);
+        return;
+    }
+
+    // Sutherland-Hodgman, each plane adds at most one vertex.
+    ClipVertex polygon[9], clipped[9];
+    int count = 3;
+    std::copy(vertices, vertices + 3, polygon);
+    for (int plane = 0; plane < 6 && count >= 3; plane++) {
+        if (!(outside & 1 << plane)) {
+            continue;
+        }
+        int clippedCount = 0;
+        for (int i = 0; i < count; i++) {
+            const ClipVertex& a = polygon[i];
+            const ClipVertex& b = polygon[(i + 1) % count];
+            float da = distance(a.clip, plane);
+            float db = distance(b.clip, plane);
+            if (da >= 0.0f) {
+                clipped[clippedCount++] = a;
+            }
+            if ((da >= 0.0f) != (db >= 0.0f)) {
+                float t = da / (da - db);
+                ClipVertex& v = clipped[clippedCount++];
+                v.clip = glm::mix(a.clip, b.clip, t);
+                for (int k = 0; k < PLANE_COUNT - PLANE_ATTRIBUTES; k++) {
+                    v.attributes[k] = a.attributes[k] + (b.attributes[k] - a.attributes[k]) * t;
+                }
+            }
+        }
+        std::copy(clipped, clipped + clippedCount, polygon);
+        count = clippedCount;
+    }
+    for (int i = 1; i + 1 < count; i++) {
+        setupTriangle(polygon[0], polygon[i], polygon[i + 1], material);
+    }
+}
+
+void SoftRasterizer::setupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, int material) {
+    const ClipVertex* v[3] = { &v0, &v1, &v2 };
+
+    // Window coordinates, y up with row 0 at the bottom as in GL, snapped to sub-pixels.
+    float inverseW[3], depth[3];
+    int64_t fx[3], fy[3];
+    for (int i = 0; i < 3; i++) {
+        const glm::vec4& c = v[i]->clip;
+        inverseW[i] = 1.0f / c.w;
+        float x = (c.x * inverseW[i] * 0.5f + 0.5f) * width;
+        float y = (c.y * inverseW[i] * 0.5f + 0.5f) * height;
+        fx[i] = std::llround(x * (1 << SOFT_SUBPIXEL_BITS));
+        fy[i] = std::llround(y * (1 << SOFT_SUBPIXEL_BITS));
+        depth[i] = c.z * inverseW[i] * 0.5f + 0.5f;
+    }
+
+    // Counter-clockwise from here on, both faces are drawn.
+    int64_t area = (fx[1] - fx[0]) * (fy[2] - fy[0]) - (fy[1] - fy[0]) * (fx[2] - fx[0]);
+    if (area == 0) {
+        return;
+    }
+    if (area < 0) {
+        std::swap(v[1], v[2]);
+        std::swap(inverseW[1], inverseW[2]);
+        std::swap(depth[1], depth[2]);
+        std::swap(fx[1], fx[2]);
+        std::swap(fy[1], fy[2]);
+    }
+
+    Triangle t;
+    t.minX = (int)std::max<int64_t>(0, std::min({ fx[0], fx[1], fx[2] }) >> SOFT_SUBPIXEL_BITS);
+    t.minY = (int)std::max<int64_t>(0, std::min({ fy[0], fy[1], fy[2] }) >> SOFT_SUBPIXEL_BITS);
+    t.maxX = (int)std::min<int64_t>(width - 1, std::max({ fx[0], fx[1], fx[2] }) >> SOFT_SUBPIXEL_BITS);
+    t.maxY = (int)std::min<int64_t>(height - 1, std::max({ fy[0], fy[1], fy[2] }) >> SOFT_SUBPIXEL_BITS);
+    if (t.minX > t.maxX || t.minY > t.maxY) {
+        return;
+    }
+
+    // Edge i runs from vertex i to the next one, positive inside. Pixels exactly on an edge
+    // belong to a top or left edge only, so triangles sharing it do not both draw them.
+    for (int i = 0; i < 3; i++) {
+        int j = (i + 1) % 3;
+        t.edgeA[i] = fy[i] - fy[j];
+        t.edgeB[i] = fx[j] - fx[i];
+        t.edgeC[i] = -(t.edgeA[i] * fx[i] + t.edgeB[i] * fy[i]);
+        bool topLeft = fy[j] < fy[i] || (fy[j] == fy[i] && fx[j] < fx[i]);
+        t.edgeC[i] -= topLeft ? 0 : 1;
+    }
+
+    // Planes through the snapped positions.
+    float scale = 1.0f / (1 << SOFT_SUBPIXEL_BITS);
+    float x[3], y[3];
+    for (int i = 0; i < 3; i++) {
+        x[i] = fx[i] * scale;
+        y[i] = fy[i] * scale;
+    }
+    t.x0 = x[0];
+    t.y0 = y[0];
+    float x10 = x[1] - x[0], y10 = y[1] - y[0], x20 = x[2] - x[0], y20 = y[2] - y[0];
+    float inverseArea = 1.0f / (x10 * y20 - x20 * y10);
+    auto set_plane = [&](int plane, float a0, float a1, float a2) {
+        t.planes[plane][0] = a0;
+        t.planes[plane][1] = ((a1 - a0) * y20 - (a2 - a0) * y10) * inverseArea;
+        t.planes[plane][2] = ((a2 - a0) * x10 - (a1 - a0) * x20) * inverseArea;
+    };
+    set_plane(PLANE_DEPTH, depth[0], depth[1], depth[2]);
+    set_plane(PLANE_INVERSE_W, inverseW[0], inverseW[1], inverseW[2]);
+    for (int k = 0; k < PLANE_COUNT - PLANE_ATTRIBUTES; k++) {
+        set_plane(PLANE_ATTRIBUTES + k, v[0]->attributes[k] * inverseW[0], v[1]->attributes[k] * inverseW[1],
+            v[2]->attributes[k] * inverseW[2]);
+    }
+    t.material = material;
+
+    uint32_t index = (uint32_t)triangles.size();
+    triangles.push_back(t);
+    for (int ty = t.minY / SOFT_TILE_SIZE; ty <= t.maxY / SOFT_TILE_SIZE; ty++) {
+        for (int tx = t.minX / SOFT_TILE_SIZE; tx <= t.maxX / SOFT_TILE_SIZE; tx++) {
+            bins[ty * tilesX + tx].push_back(index);
+        }
+    }
+    binnedTriangles++;
+}
+
+// Walk the triangles of a tile in 2 x 2 quads: coverage from the edge functions, depth test, then
+// perspective correct attributes and shading of the pixels left.
+void SoftRasterizer::rasterizeTile(int tile) {
+    int tileX0 = tile % tilesX * SOFT_TILE_SIZE;
+    int tileY0 = tile / tilesX * SOFT_TILE_SIZE;
+    int tileX1 = std::min(tileX0 + SOFT_TILE_SIZE, width) - 1;
+    int tileY1 = std::min(tileY0 + SOFT_TILE_SIZE, height) - 1;
+    const int64_t pixel = 1 << SOFT_SUBPIXEL_BITS;
+    uint64_t shaded = 0;
+
+    for (uint32_t index : bins[tile]) {
+        const Triangle& t = triangles[index];
+        const SoftMaterial& material = materials[t.material];
+        int32_t stepX[3], stepY[3];
+        for (int i = 0; i < 3; i++) {
+            stepX[i] = (int32_t)(t.edgeA[i] * pixel);
+            stepY[i] = (int32_t)(t.edgeB[i] * pixel);
+        }
+        int startX = std::max(t.minX, tileX0) & ~1;
+        int startY = std::max(t.minY, tileY0) & ~1;
+        int endX = std::min(t.maxX, tileX1);
+        int endY = std::min(t.maxY, tileY1);
+
+        for (int y = startY; y <= endY; y += 2) {
+            for (int x = startX; x <= endX; x += 2) {
+                // Edge values at the center of the first pixel of the quad
+                int64_t sampleX = x * pixel + pixel / 2;
+                int64_t sampleY = y * pixel + pixel / 2;
+                int32_t edges[3];
+                for (int i = 0; i < 3; i++) {
+                    int64_t e = t.edgeA[i] * sampleX + t.edgeB[i] * sampleY + t.edgeC[i];
+                    edges[i] = (int32_t)std::clamp<int64_t>(e, -SOFT_EDGE_CLAMP, SOFT_EDGE_CLAMP);
+                }
+                int mask = quad_coverage(edges, stepX, stepY);
+                mask &= x + 1 <= tileX1 ? 0xF : 0x5;
+                mask &= y + 1 <= tileY1 ? 0xF : 0x3;
+                if (!mask) {
+                    continue;
+                }
+
+                float dx[4], dy[4];
+                for (int lane = 0; lane < 4; lane++) {
+                    dx[lane] = ((float)x + 0.5f + QUAD_X[lane]) - t.x0;
+                    dy[lane] = ((float)y + 0.5f + QUAD_Y[lane]) - t.y0;
+                }
+                // The second row and column only exist inside the tile, the quads of its last
+                // row or column are tested by lane.
+                bool fullQuad = x + 1 <= tileX1 && y + 1 <= tileY1;
+                size_t row0 = (size_t)y * width + x;
+                size_t row1 = y + 1 <= tileY1 ? row0 + width : row0;
+                float depth[4];
+                evaluate_plane(t.planes[PLANE_DEPTH], dx, dy, depth);
+                mask = depth_test(depth, mask, &depthBuffer[row0], &depthBuffer[row1], fullQuad);
+                if (!mask) {
+                    continue;
+                }
+
+                float attributes[PLANE_COUNT - PLANE_ATTRIBUTES][4];
+                interpolate_attributes(&t.planes[PLANE_INVERSE_W], PLANE_COUNT - PLANE_ATTRIBUTES, dx, dy, attributes);
+
+                uint32_t colors[4];
+                shadeQuad(material, attributes, mask, colors);
+                for (int lane = 0; lane < 4; lane++) {
+                    if (mask & 1 << lane) {
+                        colorBuffer[(lane >> 1 ? row1 : row0) + (lane & 1)] = colors[lane];
+                        shaded++;
+                    }
+                }
+            }
+        }
+    }
+    tilePixels[tile] = shaded;
+}
+
+// The lanes of a quad in mask, shaded with their texture coordinate derivatives. With SSE2 the
+// lighting runs on all four lanes at once, only the texture lookups are per lane.
+void SoftRasterizer::shadeQuad(const SoftMaterial& material, const float (*attributes)[4], int mask, uint32_t* colors) const {
+    // Texture coordinate derivatives, shared by the quad. Lanes outside the triangle still have
+    // their attributes, as helper pixels on a GPU.
+    glm::vec2 texCoordsDx(attributes[6][1] - attributes[6][0], attributes[7][1] - attributes[7][0]);
+    glm::vec2 texCoordsDy(attributes[6][2] - attributes[6][0], attributes[7][2] - attributes[7][0]);
+#ifdef SOFT_SSE2
+    if (material.unlit) {
+        std::fill(colors, colors + 4, pack_color(material.color));
+        return;
+    }
+    float diffuseColors[3][4] = {}, specularColors[3][4] = {};
+    for (int lane = 0; lane < 4; lane++) {
+        if (!(mask & 1 << lane)) {
+            continue;
+        }
+        glm::vec2 texCoords(attributes[6][lane], attributes[7][lane]);
+        if (material.diffuse) {
+            glm::vec3 c = material.diffuse->sample(texCoords, texCoordsDx, texCoordsDy);
+            c = frame.decodeSrgb ? decode_srgb(c) : c;
+            diffuseColors[0][lane] = c.r; diffuseColors[1][lane] = c.g; diffuseColors[2][lane] = c.b;
+        }
+        if (material.specular) {
+            glm::vec3 c = material.specular->sample(texCoords, texCoordsDx, texCoordsDy);
+            specularColors[0][lane] = c.r; specularColors[1][lane] = c.g; specularColors[2][lane] = c.b;
+        }
+    }
+    QuadVec3 diffuseColor = quad_load(diffuseColors[0], diffuseColors[1], diffuseColors[2]);
+    QuadVec3 specularColor = quad_load(specularColors[0], specularColors[1], specularColors[2]);
+    QuadVec3 fragPos = quad_load(attributes[0], attributes[1], attributes[2]);
+    const glsl::Light& light = frame.light;
+
+    // ambient
+    QuadVec3 ambient = quad_mul(quad_splat(light.ambient), diffuseColor);
+
+    // diffuse
+    QuadVec3 norm = quad_normalize(quad_load(attributes[3], attributes[4], attributes[5]));
+    QuadVec3 toLight = quad_sub(quad_splat(lightPosition), fragPos);
+    QuadVec3 lightDir = quad_normalize(toLight);
+    __m128 diff = quad_max0(quad_dot(norm, lightDir));
+    QuadVec3 diffuse = quad_mul(quad_scale(quad_splat(light.diffuse), diff), diffuseColor);
+
+    // specular
+    QuadVec3 viewDir = quad_normalize(quad_sub(quad_splat(glm::vec3(0.0f)), fragPos));
+    __m128 spec = quad_specular(quad_dot(viewDir, quad_reflect_negated(lightDir, norm)), material.shininess);
+    QuadVec3 specular = quad_mul(quad_scale(quad_splat(light.specular), spec), specularColor);
+
+    __m128 distance = _mm_sqrt_ps(quad_dot(toLight, toLight));
+    __m128 denominator = _mm_add_ps(_mm_add_ps(_mm_set1_ps(light.constant), _mm_mul_ps(_mm_set1_ps(light.linear), distance)),
+        _mm_mul_ps(_mm_set1_ps(light.quadratic), _mm_mul_ps(distance, distance)));
+    __m128 attenuation = _mm_div_ps(_mm_set1_ps(1.0f), denominator);
+    QuadVec3 result = quad_scale(quad_add(quad_add(ambient, diffuse), specular), attenuation);
+
+    // additional point lights, skipped when out of range of every lane
+    for (int i = 0; i < pointLights.pointLightCount; i++) {
+        const glsl::PointLight& point = pointLights.pointLights[i];
+        QuadVec3 toPoint = quad_sub(quad_splat(glm::vec3(point.viewPosition)), fragPos);
+        __m128 d = _mm_sqrt_ps(quad_dot(toPoint, toPoint));
+        __m128 inRange = _mm_cmplt_ps(d, _mm_set1_ps(point.viewPosition.w));
+        if (!(_mm_movemask_ps(inRange) & mask)) {
+            continue;
+        }
+        QuadVec3 dir = quad_scale(toPoint, _mm_div_ps(_mm_set1_ps(1.0f), d));
+        __m128 pointDiff = quad_max0(quad_dot(norm, dir));
+        __m128 pointSpec = quad_specular(quad_dot(viewDir, quad_reflect_negated(dir, norm)), material.shininess);
+        __m128 pointDenominator = _mm_add_ps(_mm_add_ps(_mm_set1_ps(light.constant), _mm_mul_ps(_mm_set1_ps(light.linear), d)),
+            _mm_mul_ps(_mm_set1_ps(light.quadratic), _mm_mul_ps(d, d)));
+        __m128 pointAttenuation = _mm_and_ps(inRange, _mm_div_ps(_mm_set1_ps(1.0f), pointDenominator));
+        QuadVec3 lit = quad_add(quad_scale(diffuseColor, pointDiff), quad_scale(specularColor, pointSpec));
+        result = quad_add(result, quad_mul(quad_scale(quad_splat(point.color), pointAttenuation), lit));
+    }
+
+    // directional light
+    if (sunEnabled) {
+        const glsl::DirectionalLight& sun = frame.sun;
+        QuadVec3 sunDir = quad_splat(glm::normalize(-sun.direction));
+        __m128 sunDiff = quad_max0(quad_dot(norm, sunDir));
+        __m128 sunSpec = quad_specular(quad_dot(viewDir, quad_reflect_negated(sunDir, norm)), material.shininess);
+        QuadVec3 sunLight = quad_add(quad_mul(quad_splat(sun.ambient), diffuseColor),
+            quad_mul(quad_scale(quad_splat(sun.diffuse), sunDiff), diffuseColor));
+        sunLight = quad_add(sunLight, quad_mul(quad_scale(quad_splat(sun.specular), sunSpec), specularColor));
+        result = quad_add(result, sunLight);
+    }
+    quad_pack(result, colors);
+#else
+    for (int lane = 0; lane < 4; lane++) {
+        if (mask & 1 << lane) {
+            glm::vec3 fragPos(attributes[0][lane], attributes[1][lane], attributes[2][lane]);
+            glm::vec3 normal(attributes[3][lane], attributes[4][lane], attributes[5][lane]);
+            glm::vec2 texCoords(attributes[6][lane], attributes[7][lane]);
+            colors[lane] = pack_color(shade(material, fragPos, normal, texCoords, texCoordsDx, texCoordsDy));
+        }
+    }
+#endif
+}
+
+// fragmentShader.glsl with every light unshadowed, or fsLight.glsl for unlit materials.
+glm::vec3 SoftRasterizer::shade(const SoftMaterial& material, glm::vec3 fragPos, glm::vec3 normal, glm::vec2 texCoords,
+    glm::vec2 texCoordsDx, glm::vec2 texCoordsDy) const {
+    if (material.unlit) {
+        return material.color;
+    }
+    glm::vec3 diffuseColor = material.diffuse ? material.diffuse->sample(texCoords, texCoordsDx, texCoordsDy) : glm::vec3(0.0f);
+    if (frame.decodeSrgb) {
+        diffuseColor = decode_srgb(diffuseColor);
+    }
+    glm::vec3 specularColor = material.specular ? material.specular->sample(texCoords, texCoordsDx, texCoordsDy) : glm::vec3(0.0f);
+    const glsl::Light& light = frame.light;
+
+    // ambient
+    glm::vec3 ambient = light.ambient * diffuseColor;
+
+    // diffuse
+    glm::vec3 norm = glm::normalize(normal);
+    glm::vec3 lightDir = glm::normalize(lightPosition - fragPos);
+    float diff = std::max(glm::dot(norm, lightDir), 0.0f);
+    glm::vec3 diffuse = light.diffuse * diff * diffuseColor;
+
+    // specular
+    glm::vec3 viewDir = glm::normalize(-fragPos);
+    glm::vec3 reflectDir = glm::reflect(-lightDir, norm);
+    float spec = std::pow(std::max(glm::dot(viewDir, reflectDir), 0.0f), material.shininess);
+    glm::vec3 specular = light.specular * spec * specularColor;
+
+    float distance = glm::length(lightPosition - fragPos);
+    float attenuation = 1.0f / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    glm::vec3 result = (ambient + diffuse + specular) * attenuation;
+
+    // additional point lights
+    for (int i = 0; i < pointLights.pointLightCount; i++) {
+        const glsl::PointLight& point = pointLights.pointLights[i];
+        glm::vec3 toLight = glm::vec3(point.viewPosition) - fragPos;
+        float d = glm::length(toLight);
+        if (d >= point.viewPosition.w) {
+            continue;
+        }
+        glm::vec3 dir = toLight / d;
+        float pointDiff = std::max(glm::dot(norm, dir), 0.0f);
+        float pointSpec = std::pow(std::max(glm::dot(viewDir, glm::reflect(-dir, norm)), 0.0f), material.shininess);
+        float pointAttenuation = 1.0f / (light.constant + light.linear * d + light.quadratic * (d * d));
+        result += point.color * pointAttenuation * (pointDiff * diffuseColor + pointSpec * specularColor);
+    }
+
+    // directional light
+    if (sunEnabled) {
+        const glsl::DirectionalLight& sun = frame.sun;
+        glm::vec3 sunDir = glm::normalize(-sun.direction);
+        float sunDiff = std::max(glm::dot(norm, sunDir), 0.0f);
+        float sunSpec = std::pow(std::max(glm::dot(viewDir, glm::reflect(-sunDir, norm)), 0.0f), material.shininess);
+        result += sun.ambient * diffuseColor + sun.diffuse * sunDiff * diffuseColor + sun.specular * sunSpec * specularColor;
+    }
+    return result;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file SoftRasterizer.hpp
+ * @author Rohan Siddhu
+ * @brief Tile based software rasterizer for the lit scene, for hosts without a GPU.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "ShaderBlocks.hpp"
+#include "ThreadPool.hpp"
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Screen tiles are rasterized independently, one task each.
+constexpr int SOFT_TILE_SIZE = 64;
+
+// Vertex positions are snapped to 1/16 of a pixel, as GPUs do.
+constexpr int SOFT_SUBPIXEL_BITS = 4;
+
+// Same layout as cubeData: position, normal, texture coordinates.
+struct SoftVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoords;
+};
+static_assert(sizeof(SoftVertex) == 8 * sizeof(float), "SoftVertex must match the interleaved vertex arrays");
+
+// RGBA8 image with its mipmaps, sampled with trilinear filtering and repeat wrapping like the
+// material textures.
+struct SoftTexture {
+    struct Level {
+        int width;
+        int height;
+        std::vector<uint32_t> texels;
+    };
+    std::vector<Level> levels;
+
+    bool load(const char* path, bool srgb = false, bool flipVertically = false);
+    glm::vec3 sample(glm::vec2 uv, glm::vec2 uvDx, glm::vec2 uvDy) const;
+private:
+    glm::vec3 sampleLevel(int level, glm::vec2 uv) const;
+};
+
+struct SoftMaterial {
+    const SoftTexture* diffuse = nullptr;
+    const SoftTexture* specular = nullptr;      /** Black without one, as an empty material layer. */
+    float shininess = 32.0f;
+    bool unlit = false;                         /** Flat color, as fsLight.glsl draws the lights. */
+    glm::vec3 color { 1.0f };
+};
+
+// Draws triangles with the shading of fragmentShader.glsl (point lights and the sun, without
+// shadows) into an RGBA8 color buffer with a depth buffer. draw() transforms, clips and bins the
+// triangles to screen tiles; flush() rasterizes the tiles on the thread pool. Every tile draws its
+// triangles in submission order and no pixel depends on the tiling, so the image is the same bit
+// for bit whatever the number of threads.
+class SoftRasterizer {
+private:
+    // Interpolated over the screen, divided by w except for depth.
+    enum Plane : int {
+        PLANE_DEPTH = 0,
+        PLANE_INVERSE_W = 1,
+        PLANE_ATTRIBUTES = 2,       /** View space position, view space normal, texture coordinates. */
+        PLANE_COUNT = 10
+    };
+
+    // Triangle after clipping and setup. Coverage uses exact integer edge functions
+    // A * x + B * y + C on sub-pixel positions, the attributes are planes
+    // value + dx * (x - x0) + dy * (y - y0) in pixels.
+    struct Triangle {
+        int64_t edgeA[3], edgeB[3], edgeC[3];
+        int minX, minY, maxX, maxY;         /** Pixel bounds, inclusive. */
+        float x0, y0;
+        float planes[PLANE_COUNT][3];
+        int material;
+    };
+
+    int width = 0;
+    int height = 0;
+    int tilesX = 0;
+    int tilesY = 0;
+    ThreadPool* pool = nullptr;
+
+    std::vector<uint32_t> colorBuffer;      /** RGBA8, bottom row first like glReadPixels. */
+    std::vector<float> depthBuffer;
+    std::vector<Triangle> triangles;
+    std::vector<SoftMaterial> materials;
+    std::vector<std::vector<uint32_t>> bins;    /** Triangles touching each tile, in submission order. */
+    std::vector<uint64_t> tilePixels;
+
+    glsl::Frame frame {};
+    glsl::PointLights pointLights {};
+    glm::vec3 lightPosition { 0.0f };       /** View space. */
+    bool sunEnabled = false;
+
+    // Statistics since clear().
+    uint64_t submittedTriangles = 0;
+    uint64_t binnedTriangles = 0;
+    uint64_t shadedPixels = 0;
+public:
+    bool init(int width, int height, ThreadPool* pool);
+    void clear(glm::vec3 color);
+    void setFrame(const glsl::Frame& frame, const glsl::PointLights& pointLights, bool sun);
+    void draw(const SoftVertex* vertices, size_t count, const glm::mat4& model, const SoftMaterial& material);
+    void flush();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const std::vector<uint32_t>& pixels() const { return colorBuffer; }
+    const std::vector<float>& depth() const { return depthBuffer; }
+    uint64_t triangleCount() const { return submittedTriangles; }
+    uint64_t binnedCount() const { return binnedTriangles; }
+    uint64_t pixelCount() const { return shadedPixels; }
+private:
+    struct ClipVertex {
+        glm::vec4 clip;
+        float attributes[PLANE_COUNT - PLANE_ATTRIBUTES];
+    };
+
+    void parallelFor(int count, const std::function<void(int)>& body);
+    void clipTriangle(const ClipVertex* vertices, int material);
+    void setupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, int material);
+    void rasterizeTile(int tile);
+    void shadeQuad(const SoftMaterial& material, const float (*attributes)[4], int mask, uint32_t* colors) const;
+    glm::vec3 shade(const SoftMaterial& material, glm::vec3 fragPos, glm::vec3 normal, glm::vec2 texCoords,
+        glm::vec2 texCoordsDx, glm::vec2 texCoordsDy) const;
+};
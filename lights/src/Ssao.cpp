@@ -0,0 +1,136 @@
+/**
+ * @file Ssao.cpp
+ * @author Rohan Siddhu
+ * @brief Ssao class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Ssao.hpp"
+#include <algorithm>
+
+bool Ssao::init() {
+    depthProgram.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    depthProgram.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsAoDepth.glsl");
+    depthProgram.createProgram();
+    aoProgram.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    aoProgram.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsHbao.glsl");
+    aoProgram.createProgram();
+    blurProgram.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    blurProgram.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsAoBlur.glsl");
+    blurProgram.createProgram();
+    upsampleProgram.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    upsampleProgram.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsAoUpsample.glsl");
+    upsampleProgram.createProgram();
+    glGenVertexArrays(1, &emptyVao);
+    return true;
+}
+
+/**
+ * @brief Declare the passes that darken the ambient light of the scene. Depth is reduced to half
+ * resolution, occlusion is computed there with a 4x4 interleaved pattern of directions, blurred
+ * horizontally and vertically without crossing depth edges, and brought back to full resolution
+ * with a bilateral filter that subtracts the occluded ambient light from the scene. All targets are
+ * half resolution transients except the scene's own, so the cost is about a quarter of a full
+ * resolution effect.
+ *
+ * @param graph Graph of the frame.
+ * @param depth Scene depth buffer.
+ * @param ambient Ambient light of the scene, written as its second color target.
+ * @param scene Scene color the occluded ambient light is taken from.
+ * @param projection Camera projection.
+ */
+void Ssao::addPasses(RenderGraph& graph, int depth, int ambient, int scene, const glm::mat4& projection) {
+    const RenderTextureDesc& full = graph.desc(scene);
+    RenderTextureDesc half { std::max((full.width + 1) / 2, 1), std::max((full.height + 1) / 2, 1), GL_R32F };
+    int viewDepth = graph.createTexture("AO depth", half);
+    half.format = GL_R8;
+    int raw = graph.createTexture("AO", half);
+    int blurX = graph.createTexture("AO blur X", half);
+    int blurY = graph.createTexture("AO blur Y", half);
+
+    glm::vec2 depthParams(projection[2][2], projection[3][2]);
+    auto draw = [this]() {
+        glBindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    };
+
+    int pass = graph.addPass("AO depth", [this, &graph, depth, depthParams, draw]() {
+        glDisable(GL_DEPTH_TEST);
+        depthProgram.use();
+        depthProgram.setVec2("depthParams", depthParams);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, graph.texture(depth));
+        draw();
+    });
+    graph.read(pass, depth, ACCESS_SAMPLED);
+    graph.write(pass, viewDepth, ACCESS_TARGET);
+
+    glm::vec2 projScale(1.0f / projection[0][0], 1.0f / projection[1][1]);
+    float radiusScale = 0.5f * half.height * projection[1][1];
+    pass = graph.addPass("HBAO", [this, &graph, viewDepth, projScale, radiusScale, draw]() {
+        aoProgram.use();
+        aoProgram.setVec2("projScale", projScale);
+        aoProgram.setFloat("radiusScale", radiusScale);
+        aoProgram.setFloat("radius", radius);
+        aoProgram.setFloat("bias", bias);
+        aoProgram.setFloat("intensity", intensity);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, graph.texture(viewDepth));
+        draw();
+    });
+    graph.read(pass, viewDepth, ACCESS_SAMPLED);
+    graph.write(pass, raw, ACCESS_TARGET);
+
+    int source = raw;
+    for (int target : { blurX, blurY }) {
+        glm::vec2 direction = target == blurX ? glm::vec2(1.0f, 0.0f) : glm::vec2(0.0f, 1.0f);
+        pass = graph.addPass(target == blurX ? "AO blur X" : "AO blur Y", [this, &graph, source, viewDepth, direction, draw]() {
+            blurProgram.use();
+            blurProgram.setVec2("direction", direction);
+            blurProgram.setFloat("sharpness", sharpness);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, graph.texture(source));
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, graph.texture(viewDepth));
+            draw();
+        });
+        graph.read(pass, source, ACCESS_SAMPLED);
+        graph.read(pass, viewDepth, ACCESS_SAMPLED);
+        graph.write(pass, target, ACCESS_TARGET);
+        source = target;
+    }
+
+    pass = graph.addPass("AO upsample", [this, &graph, blurY, viewDepth, depth, ambient, depthParams, draw]() {
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_REVERSE_SUBTRACT);
+        glBlendFunc(GL_ONE, GL_ONE);
+        upsampleProgram.use();
+        upsampleProgram.setVec2("depthParams", depthParams);
+        GLuint textures[4] = { graph.texture(blurY), graph.texture(viewDepth), graph.texture(depth), graph.texture(ambient) };
+        for (int i = 0; i < 4; i++) {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D, textures[i]);
+        }
+        glActiveTexture(GL_TEXTURE0);
+        draw();
+        glBlendEquation(GL_FUNC_ADD);
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+    });
+    graph.read(pass, blurY, ACCESS_SAMPLED);
+    graph.read(pass, viewDepth, ACCESS_SAMPLED);
+    graph.read(pass, depth, ACCESS_SAMPLED);
+    graph.read(pass, ambient, ACCESS_SAMPLED);
+    graph.read(pass, scene, ACCESS_TARGET);
+    graph.write(pass, scene, ACCESS_TARGET);
+}
+
+void Ssao::clean() {
+    depthProgram.clean();
+    aoProgram.clean();
+    blurProgram.clean();
+    upsampleProgram.clean();
+    glDeleteVertexArrays(1, &emptyVao);
+    emptyVao = 0;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file Ssao.hpp
+ * @author Rohan Siddhu
+ * @brief Horizon based ambient occlusion at half resolution, as render graph passes.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "RenderGraph.hpp"
+#include "Shader.hpp"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+class Ssao {
+private:
+    Shader depthProgram;
+    Shader aoProgram;
+    Shader blurProgram;
+    Shader upsampleProgram;
+    GLuint emptyVao = 0;
+public:
+    float radius = 1.0f;        /** World units searched for occluders. */
+    float intensity = 2.0f;     /** Exponent applied to the visibility. */
+    float bias = 0.1f;          /** Ignores occluders this close to the tangent plane, in cosine. */
+    float sharpness = 400.0f;   /** How strongly the blur stops at depth edges. */
+
+    bool init();
+    void addPasses(RenderGraph& graph, int depth, int ambient, int scene, const glm::mat4& projection);
+    void clean();
+};
@@ -0,0 +1,140 @@
+/**
+ * @file Taa.cpp
+ * @author Rohan Siddhu
+ * @brief Taa class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Taa.hpp"
+
+/**
+ * @brief Element 'index' of the Halton sequence in 'base', in [0, 1).
+ */
+float halton(int index, int base) {
+    float result = 0.0f;
+    float fraction = 1.0f;
+    while (index > 0) {
+        fraction /= base;
+        result += fraction * (index % base);
+        index /= base;
+    }
+    return result;
+}
+
+bool Taa::init() {
+    program.addShader(GL_VERTEX_SHADER, "res/shaders/vsFullscreen.glsl");
+    program.addShader(GL_FRAGMENT_SHADER, "res/shaders/fsTaa.glsl");
+    program.createProgram();
+    glGenVertexArrays(1, &emptyVao);
+    return true;
+}
+
+/**
+ * @brief Sub-pixel offset of this frame, in pixels within [-0.5, 0.5). Halton (2, 3) points
+ * cover the pixel evenly in few frames.
+ */
+glm::vec2 Taa::jitter() const {
+    int index = (int)(frame % TAA_SEQUENCE_LENGTH) + 1;
+    return glm::vec2(halton(index, 2), halton(index, 3)) - 0.5f;
+}
+
+/**
+ * @brief Shift 'projection' by this frame's jitter. Only the scene is drawn with it, culling and
+ * motion vectors use the unjittered projection.
+ */
+glm::mat4 Taa::jitterProjection(const glm::mat4& projection, int width, int height) const {
+    glm::vec2 offset = jitter();
+    glm::mat4 jittered = projection;
+    jittered[2][0] += offset.x * 2.0f / width;
+    jittered[2][1] += offset.y * 2.0f / height;
+    return jittered;
+}
+
+/**
+ * @brief Declare the resolve of the jittered scene with the history.
+ *
+ * @param graph Graph of the frame.
+ * @param scene Scene color, drawn with jitterProjection().
+ * @param velocity GL_RG16F motion since the last frame, in texture coordinates.
+ * @param depth Scene depth buffer.
+ * @return int The anti-aliased scene, also next frame's history.
+ */
+int Taa::addPass(RenderGraph& graph, int scene, int velocity, int depth) {
+    const RenderTextureDesc& desc = graph.desc(scene);
+    if (desc.width != width || desc.height != height) {
+        graph.releaseTexture(history[0]);
+        graph.releaseTexture(history[1]);
+        resize(desc.width, desc.height);
+    }
+    RenderTextureDesc historyDesc { width, height, GL_RGBA16F };
+    int previous = graph.importTexture("TAA history", history[1 - current], historyDesc);
+    int output = graph.importTexture("TAA output", history[current], historyDesc);
+
+    int pass = graph.addPass("TAA", [this, &graph, scene, velocity, depth, previous]() {
+        glDisable(GL_DEPTH_TEST);
+        program.use();
+        program.setFloat("feedback", feedback);
+        program.setInt("historyValid", historyValid);
+        GLuint textures[4] = { graph.texture(scene), graph.texture(previous), graph.texture(velocity), graph.texture(depth) };
+        for (int i = 0; i < 4; i++) {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D, textures[i]);
+        }
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glEnable(GL_DEPTH_TEST);
+        resolved = true;
+    });
+    graph.read(pass, scene, ACCESS_SAMPLED);
+    graph.read(pass, previous, ACCESS_SAMPLED);
+    graph.read(pass, velocity, ACCESS_SAMPLED);
+    graph.read(pass, depth, ACCESS_SAMPLED);
+    graph.write(pass, output, ACCESS_TARGET);
+    return output;
+}
+
+/**
+ * @brief Move on to the next jitter position. The history is only kept if the resolve ran, so
+ * turning TAA back on does not blend in a stale frame.
+ */
+void Taa::endFrame() {
+    frame++;
+    historyValid = resolved;
+    if (resolved) {
+        current = 1 - current;
+    }
+    resolved = false;
+}
+
+void Taa::clean() {
+    program.clean();
+    glDeleteTextures(2, history);
+    glDeleteVertexArrays(1, &emptyVao);
+    history[0] = history[1] = emptyVao = 0;
+    width = height = 0;
+}
+
+
+/*
+* Private Methods
+*/
+
+void Taa::resize(int width, int height) {
+    glDeleteTextures(2, history);
+    this->width = width;
+    this->height = height;
+    historyValid = false;
+
+    glGenTextures(2, history);
+    for (GLuint texture : history) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA16F, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
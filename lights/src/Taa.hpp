@@ -0,0 +1,45 @@
+/**
+ * @file Taa.hpp
+ * @author Rohan Siddhu
+ * @brief Temporal anti-aliasing: Halton jittered projections and a history resolve, as a render
+ * graph pass.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "RenderGraph.hpp"
+#include "Shader.hpp"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Jitter positions before the sequence repeats.
+constexpr int TAA_SEQUENCE_LENGTH = 8;
+
+class Taa {
+private:
+    Shader program;
+    GLuint history[2] = { 0, 0 };   /** GL_RGBA16F, resolved last frame and this frame. */
+    GLuint emptyVao = 0;
+    int width = 0, height = 0;
+    int current = 0;                /** History written this frame. */
+    unsigned frame = 0;
+    bool historyValid = false;
+    bool resolved = false;          /** The resolve ran this frame. */
+public:
+    float feedback = 0.9f;          /** Share of the history in each frame. */
+
+    bool init();
+    glm::vec2 jitter() const;
+    glm::mat4 jitterProjection(const glm::mat4& projection, int width, int height) const;
+    int addPass(RenderGraph& graph, int scene, int velocity, int depth);
+    void endFrame();
+    void clean();
+
+    size_t videoMemory() const { return (size_t)width * height * 8 * 2; }
+private:
+    void resize(int width, int height);
+};
+
+float halton(int index, int base);
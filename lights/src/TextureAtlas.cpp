@@ -0,0 +1,419 @@
+/**
+ * @file TextureAtlas.cpp
+ * @author Rohan Siddhu
+ * @brief TextureAtlas class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "TextureAtlas.hpp"
+#include "Image.hpp"
+#include "stb_image.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// stb_rect_pack ships with Dear ImGui. imgui_draw.cpp compiles it with STBRP_STATIC, so this
+// translation unit gets its own private copy of the implementation.
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+
+/**
+ * @brief Create an empty atlas. Pages are allocated on demand.
+ *
+ * @param pageSize Width and height of a page in texels.
+ * @param padding Border added around each image. Edge texels are extruded into it. Images are
+ * packed at multiples of the coarsest level's footprint, so every texel of levels 1 to
+ * log2(padding) averages texels of a single image and neighbours do not bleed into each other.
+ * @param maxPages Maximum number of pages.
+ */
+TextureAtlas::TextureAtlas(int pageSize, int padding, int maxPages) :
+    pageSize(pageSize),
+    padding(padding),
+    maxPages(maxPages),
+    levels(1)
+{
+    while ((1 << levels) <= padding) {
+        levels++;
+    }
+    alignment = 1 << (levels - 1);
+}
+
+// Defined here, where stbrp_context is a complete type. GL objects are released by clean().
+TextureAtlas::~TextureAtlas() = default;
+
+/**
+ * @brief Insert an RGBA8 image. The image is uploaded on the next update().
+ *
+ * @param rgba Pixels, 'width' x 'height', four bytes per texel.
+ * @param width Image width.
+ * @param height Image height.
+ * @return int Handle of the image, or -1 if the atlas is full.
+ */
+int TextureAtlas::insert(const unsigned char* rgba, int width, int height) {
+    if (paddedSize(width) > pageSize || paddedSize(height) > pageSize) {
+        std::cerr << "Image " << width << "x" << height << " does not fit in an atlas page" << std::endl;
+        return -1;
+    }
+
+    int handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    else {
+        handle = (int)entries.size();
+        entries.push_back({});
+    }
+    entries[handle] = { false, -1, 0, 0, width, height };
+
+    bool packed = false;
+    for (int i = 0; i < (int)pages.size() && !packed; i++) {
+        packed = pack(i, handle);
+    }
+
+    if (!packed && (int)pages.size() < maxPages) {
+        packed = pack(addPage(), handle);
+    }
+
+    // Out of space, reclaim the holes left by evicted images. Start with the page that has the
+    // most dead space since it is the most likely to fit.
+    if (!packed) {
+        std::vector<int> order;
+        for (int i = 0; i < (int)pages.size(); i++) {
+            if (pages[i].deadArea >= (long)paddedSize(width) * paddedSize(height)) {
+                order.push_back(i);
+            }
+        }
+        std::sort(order.begin(), order.end(), [this](int a, int b) {
+            return pages[a].deadArea > pages[b].deadArea;
+        });
+
+        for (size_t i = 0; i < order.size() && !packed; i++) {
+            packed = repack(order[i], handle);
+        }
+    }
+
+    if (!packed) {
+        freeHandles.push_back(handle);
+        return -1;
+    }
+
+    Entry& entry = entries[handle];
+    entry.alive = true;
+    blit(pages[entry.page], entry, rgba, width * 4);
+
+    return handle;
+}
+
+/**
+ * @brief Load an image from disk and insert it.
+ *
+ * @param path Path to the image.
+ * @return int Handle of the image, or -1 on failure.
+ */
+int TextureAtlas::insert(const char* path) {
+    int width, height, nrComponents;
+    unsigned char* img = stbi_load(path, &width, &height, &nrComponents, 4);
+    if (!img) {
+        std::cerr << "Failed to load texture: " << path << std::endl;
+        return -1;
+    }
+
+    int handle = insert(img, width, height);
+    stbi_image_free(img);
+
+    return handle;
+}
+
+/**
+ * @brief Evict an image. Its space is reused once the page is repacked or empties out.
+ *
+ * @param handle Handle returned by insert().
+ */
+void TextureAtlas::remove(int handle) {
+    if (handle < 0 || handle >= (int)entries.size() || !entries[handle].alive) {
+        return;
+    }
+
+    Entry& entry = entries[handle];
+    Page& page = pages[entry.page];
+    long area = (long)paddedSize(entry.width) * paddedSize(entry.height);
+    page.usedArea -= area;
+    page.deadArea += area;
+    entry.alive = false;
+    freeHandles.push_back(handle);
+
+    // An empty page can simply start over.
+    if (page.usedArea == 0) {
+        stbrp_init_target(page.packer.get(), pageSize / alignment, pageSize / alignment, page.nodes.data(), (int)page.nodes.size());
+        page.deadArea = 0;
+    }
+}
+
+/**
+ * @brief Upload the modified parts of every page. Mipmaps of the modified parts are rebuilt on
+ * the CPU in linear light, instead of running glGenerateMipmap over the whole page.
+ */
+void TextureAtlas::update() {
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, pageSize);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    for (Page& page : pages) {
+        glm::ivec4 d = page.dirty;
+        if (d.x >= d.z || d.y >= d.w) {
+            continue;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, page.texture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, d.x, d.y, d.z - d.x, d.w - d.y, GL_RGBA, GL_UNSIGNED_BYTE,
+            page.pixels.data() + ((size_t)d.y * pageSize + d.x) * 4);
+        uploadMips(page, d);
+
+        page.dirty = glm::ivec4(pageSize, pageSize, 0, 0);
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ * @brief Location of an image in the atlas. Repacking moves images, so the region should be
+ * queried again for the handles takeMoved() reports.
+ */
+AtlasRegion TextureAtlas::region(int handle) const {
+    const Entry& entry = entries[handle];
+    return {
+        entry.page,
+        glm::vec2(entry.x + padding, entry.y + padding) / (float)pageSize,
+        glm::vec2(entry.width, entry.height) / (float)pageSize
+    };
+}
+
+/**
+ * @brief Map a texture coordinate of the original image into the atlas page. Coordinates
+ * outside [0, 1] do not wrap, atlas images cannot use GL_REPEAT.
+ */
+glm::vec2 TextureAtlas::transformUV(int handle, glm::vec2 uv) const {
+    AtlasRegion r = region(handle);
+    return r.offset + glm::clamp(uv, 0.0f, 1.0f) * r.scale;
+}
+
+/**
+ * @brief Rewrite the texture coordinates of an interleaved vertex array in place. The
+ * coordinates must be the original ones, remapping twice maps into the wrong place.
+ *
+ * @param handle Image the vertices are textured with.
+ * @param vertices Interleaved float vertex data.
+ * @param vertexCount Number of vertices.
+ * @param stride Floats per vertex.
+ * @param uvOffset Offset of the texture coordinates within a vertex, in floats.
+ */
+void TextureAtlas::remapUVs(int handle, float* vertices, size_t vertexCount, size_t stride, size_t uvOffset) const {
+    for (size_t i = 0; i < vertexCount; i++) {
+        float* uv = vertices + i * stride + uvOffset;
+        glm::vec2 t = transformUV(handle, glm::vec2(uv[0], uv[1]));
+        uv[0] = t.x;
+        uv[1] = t.y;
+    }
+}
+
+/**
+ * @brief Handles of the live images a repack moved since the last call. Anything built from
+ * their regions, like remapped texture coordinates, has to be rebuilt.
+ */
+std::vector<int> TextureAtlas::takeMoved() {
+    std::vector<int> handles;
+    handles.swap(moved);
+    return handles;
+}
+
+/**
+ * @brief GPU memory used by all pages and their mipmaps, in bytes.
+ */
+size_t TextureAtlas::videoMemory() const {
+    size_t bytes = 0;
+    for (int size = pageSize, level = 0; size >= 1 && (1 << level) <= std::max(padding, 1); size /= 2, level++) {
+        bytes += (size_t)size * size * 4;
+    }
+    return bytes * pages.size();
+}
+
+void TextureAtlas::clean() {
+    for (Page& page : pages) {
+        glDeleteTextures(1, &page.texture);
+    }
+    pages.clear();
+    entries.clear();
+    freeHandles.clear();
+    moved.clear();
+}
+
+
+/*
+* Private Methods
+*/
+
+int TextureAtlas::addPage() {
+    Page page;
+    page.pixels.assign((size_t)pageSize * pageSize * 4, 0);
+    page.packer = std::make_unique<stbrp_context>();
+    page.nodes.resize(pageSize / alignment);
+    stbrp_init_target(page.packer.get(), pageSize / alignment, pageSize / alignment, page.nodes.data(), (int)page.nodes.size());
+    page.usedArea = 0;
+    page.deadArea = 0;
+    page.dirty = glm::ivec4(pageSize, pageSize, 0, 0);
+    for (int m = 1; m < levels; m++) {
+        int size = std::max(1, pageSize >> m);
+        page.mips.emplace_back((size_t)size * size * 4, 0);
+    }
+
+    glGenTextures(1, &page.texture);
+    glBindTexture(GL_TEXTURE_2D, page.texture);
+    glTexStorage2D(GL_TEXTURE_2D, levels, GL_RGBA8, pageSize, pageSize);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    pages.push_back(std::move(page));
+    return (int)pages.size() - 1;
+}
+
+bool TextureAtlas::pack(int pageIndex, int handle) {
+    Page& page = pages[pageIndex];
+    Entry& entry = entries[handle];
+
+    // The packer works in cells of 'alignment' texels.
+    stbrp_rect rect {};
+    rect.id = handle;
+    rect.w = paddedSize(entry.width) / alignment;
+    rect.h = paddedSize(entry.height) / alignment;
+
+    if (!stbrp_pack_rects(page.packer.get(), &rect, 1)) {
+        return false;
+    }
+
+    entry.page = pageIndex;
+    entry.x = rect.x * alignment;
+    entry.y = rect.y * alignment;
+    page.usedArea += (long)paddedSize(entry.width) * paddedSize(entry.height);
+
+    return true;
+}
+
+bool TextureAtlas::repack(int pageIndex, int handle) {
+    Page& page = pages[pageIndex];
+
+    std::vector<stbrp_rect> rects;
+    for (int i = 0; i < (int)entries.size(); i++) {
+        const Entry& entry = entries[i];
+        if ((entry.alive && entry.page == pageIndex) || i == handle) {
+            stbrp_rect rect {};
+            rect.id = i;
+            rect.w = paddedSize(entry.width) / alignment;
+            rect.h = paddedSize(entry.height) / alignment;
+            rects.push_back(rect);
+        }
+    }
+
+    // Pack into a scratch context first so the page is untouched if it still does not fit.
+    auto packer = std::make_unique<stbrp_context>();
+    std::vector<stbrp_node> nodes(pageSize / alignment);
+    stbrp_init_target(packer.get(), pageSize / alignment, pageSize / alignment, nodes.data(), (int)nodes.size());
+    if (!stbrp_pack_rects(packer.get(), rects.data(), (int)rects.size())) {
+        return false;
+    }
+
+    // Move the surviving images to their new places. The padded rectangles are copied whole,
+    // so the extruded borders come along.
+    std::vector<unsigned char> pixels((size_t)pageSize * pageSize * 4, 0);
+    page.usedArea = 0;
+    for (const stbrp_rect& rect : rects) {
+        Entry& entry = entries[rect.id];
+        int x = rect.x * alignment;
+        int y = rect.y * alignment;
+        int w = paddedSize(entry.width);
+        int h = paddedSize(entry.height);
+        if (rect.id != handle) {
+            for (int row = 0; row < h; row++) {
+                std::memcpy(&pixels[((size_t)(y + row) * pageSize + x) * 4],
+                    &page.pixels[((size_t)(entry.y + row) * pageSize + entry.x) * 4], (size_t)w * 4);
+            }
+            if (x != entry.x || y != entry.y) {
+                moved.push_back(rect.id);
+            }
+        }
+
+        entry.page = pageIndex;
+        entry.x = x;
+        entry.y = y;
+        page.usedArea += (long)w * h;
+    }
+
+    page.pixels.swap(pixels);
+    page.packer = std::move(packer);
+    page.nodes.swap(nodes);
+    page.deadArea = 0;
+    markDirty(page, 0, 0, pageSize, pageSize);
+
+    return true;
+}
+
+// The whole padded rectangle is filled, including the texels it was rounded up by.
+void TextureAtlas::blit(Page& page, const Entry& entry, const unsigned char* rgba, int stride) {
+    int w = paddedSize(entry.width);
+    int h = paddedSize(entry.height);
+
+    for (int row = 0; row < h; row++) {
+        int srcRow = std::clamp(row - padding, 0, entry.height - 1);
+        unsigned char* dst = &page.pixels[((size_t)(entry.y + row) * pageSize + entry.x) * 4];
+        const unsigned char* src = rgba + (size_t)srcRow * stride;
+
+        for (int col = 0; col < w; col++) {
+            int srcCol = std::clamp(col - padding, 0, entry.width - 1);
+            std::memcpy(dst + col * 4, src + srcCol * 4, 4);
+        }
+    }
+
+    markDirty(page, entry.x, entry.y, entry.x + w, entry.y + h);
+}
+
+void TextureAtlas::markDirty(Page& page, int x0, int y0, int x1, int y1) {
+    page.dirty.x = std::min(page.dirty.x, x0);
+    page.dirty.y = std::min(page.dirty.y, y0);
+    page.dirty.z = std::max(page.dirty.z, x1);
+    page.dirty.w = std::max(page.dirty.w, y1);
+}
+
+// Rebuild each level below the dirty rectangle from the level above it and upload it. The
+// rectangle grows to even texel boundaries so every destination texel sees its full footprint.
+void TextureAtlas::uploadMips(Page& page, glm::ivec4 rect) {
+    const unsigned char* src = page.pixels.data();
+    int srcSize = pageSize;
+
+    for (int m = 1; m < levels; m++) {
+        int dstSize = std::max(1, srcSize / 2);
+        glm::ivec4 r(rect.x / 2, rect.y / 2, std::min((rect.z + 1) / 2, dstSize), std::min((rect.w + 1) / 2, dstSize));
+        unsigned char* dst = page.mips[m - 1].data();
+
+        for (int y = r.y; y < r.w; y++) {
+            const unsigned char* row0 = src + ((size_t)(2 * y) * srcSize + 2 * r.x) * 4;
+            const unsigned char* row1 = row0 + (size_t)srcSize * 4;
+            downsample_row(row0, row1, dst + ((size_t)y * dstSize + r.x) * 4, r.z - r.x, true);
+        }
+
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, dstSize);
+        glTexSubImage2D(GL_TEXTURE_2D, m, r.x, r.y, r.z - r.x, r.w - r.y, GL_RGBA, GL_UNSIGNED_BYTE,
+            dst + ((size_t)r.y * dstSize + r.x) * 4);
+
+        src = dst;
+        srcSize = dstSize;
+        rect = r;
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, pageSize);
+}
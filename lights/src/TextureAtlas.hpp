@@ -0,0 +1,86 @@
+/**
+ * @file TextureAtlas.hpp
+ * @author Rohan Siddhu
+ * @brief Runtime texture atlas for small textures (decals, icons).
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+struct stbrp_context;
+struct stbrp_node;
+
+// Location of an image inside the atlas.
+struct AtlasRegion {
+    int page;           /** Page (texture) index. */
+    glm::vec2 offset;   /** UV of the image's bottom left corner, padding excluded. */
+    glm::vec2 scale;    /** UV size of the image. */
+};
+
+class TextureAtlas {
+private:
+    struct Entry {
+        bool alive;
+        int page;
+        int x, y;           /** Position of the padded rectangle in texels. */
+        int width, height;  /** Image size without padding. */
+    };
+
+    struct Page {
+        GLuint texture;
+        std::vector<unsigned char> pixels;  /** CPU copy, RGBA8. */
+        std::vector<std::vector<unsigned char>> mips;   /** CPU copy of levels 1 and up. */
+        std::unique_ptr<stbrp_context> packer;
+        std::vector<stbrp_node> nodes;
+        long usedArea;      /** Texels covered by live entries. */
+        long deadArea;      /** Texels covered by evicted entries that are still in the skyline. */
+        glm::ivec4 dirty;   /** Texel rectangle to upload (x0, y0, x1, y1), empty if x0 >= x1. */
+    };
+
+    int pageSize;
+    int padding;
+    int maxPages;
+    int levels;         /** Mip levels per page, as many as the padding keeps free of bleeding. */
+    int alignment;      /** Texels per packing cell, the footprint of a texel of the last level. */
+
+    std::vector<Entry> entries;
+    std::vector<int> freeHandles;
+    std::vector<Page> pages;
+    std::vector<int> moved;     /** Handles moved by repacking, see takeMoved(). */
+public:
+    TextureAtlas(int pageSize = 1024, int padding = 4, int maxPages = 4);
+    ~TextureAtlas();
+
+    int insert(const unsigned char* rgba, int width, int height);
+    int insert(const char* path);
+    void remove(int handle);
+    void update();
+
+    AtlasRegion region(int handle) const;
+    glm::vec2 transformUV(int handle, glm::vec2 uv) const;
+    void remapUVs(int handle, float* vertices, size_t vertexCount, size_t stride, size_t uvOffset) const;
+    std::vector<int> takeMoved();
+
+    int pageCount() const { return (int)pages.size(); }
+    GLuint pageTexture(int page) const { return pages[page].texture; }
+    float occupancy(int page) const { return (float)pages[page].usedArea / ((float)pageSize * pageSize); }
+    int entryCount() const { return (int)(entries.size() - freeHandles.size()); }
+    size_t videoMemory() const;
+
+    void clean();
+private:
+    int paddedSize(int size) const { return (size + 2 * padding + alignment - 1) / alignment * alignment; }
+    int addPage();
+    bool pack(int page, int handle);
+    bool repack(int page, int handle);
+    void blit(Page& page, const Entry& entry, const unsigned char* rgba, int stride);
+    void markDirty(Page& page, int x0, int y0, int x1, int y1);
+    void uploadMips(Page& page, glm::ivec4 rect);
+};
@@ -0,0 +1,331 @@
+/**
+ * @file TextureManager.cpp
+ * @author Rohan Siddhu
+ * @brief TextureManager class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "TextureManager.hpp"
+#include "Image.hpp"
+#include "stb_image.h"
+#include <algorithm>
+#include <cmath>
+
+
+// Decode workers leave one core to the render thread.
+static unsigned worker_count() {
+    unsigned cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 1;
+}
+
+TextureManager::TextureManager(size_t budget) :
+    budget(budget),
+    pool(worker_count())
+{
+}
+
+/**
+ * @brief Load an image as a streamable GL_TEXTURE_2D. Decoding and mip generation run on the
+ * worker threads, the complete chain is uploaded by update() once ready. Until then the
+ * texture is a 1x1 grey placeholder. The chain stays on the CPU so levels can be dropped from
+ * and restored to VRAM at any time.
+ *
+ * @param path Path to the texture.
+ * @param srgb true for color textures, false for data such as specular maps.
+ * @return int Texture handle.
+ */
+int TextureManager::load(const char* path, bool srgb) {
+    std::vector<std::vector<unsigned char>> placeholder { { 128, 128, 128, 255 } };
+    int handle = create(path, GL_TEXTURE_2D, 1, 1, 1, std::move(placeholder));
+    textures[handle].loading = true;
+
+    std::string file = path;
+    pool.submit([this, handle, file, srgb]() {
+        Decoded result { handle, 0, 0, {} };
+
+        int nrComponents;
+        unsigned char* img = stbi_load(file.c_str(), &result.width, &result.height, &nrComponents, 4);
+        if (img) {
+            result.mips = generate_mipmaps(img, result.width, result.height, srgb);
+            stbi_image_free(img);
+        }
+        else {
+            std::cerr << "Failed to load texture: " << file << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        decoded.push_back(std::move(result));
+    });
+
+    return handle;
+}
+
+/**
+ * @brief Take ownership of a texture given as a complete CPU mip chain.
+ *
+ * @param name Name shown in the statistics.
+ * @param target GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY.
+ * @param width Level 0 width.
+ * @param height Level 0 height.
+ * @param layers Number of array layers, 1 for GL_TEXTURE_2D.
+ * @param mips RGBA8 pixels of each level down to 1x1, layers stored one after another.
+ * @return int Texture handle.
+ */
+int TextureManager::create(const char* name, GLenum target, int width, int height, int layers,
+    std::vector<std::vector<unsigned char>> mips) {
+    TextureInfo texture {};
+    texture.name = name;
+    texture.target = target;
+    texture.width = width;
+    texture.height = height;
+    texture.layers = layers;
+    texture.levels = (int)mips.size();
+    texture.residentLevel = texture.levels;
+    texture.desiredLevel = 0;
+    texture.screenSize = -1.0f;
+    texture.streamed = false;
+    texture.mips = std::move(mips);
+
+    allocate(texture, 0);
+
+    textures.push_back(std::move(texture));
+    return (int)textures.size() - 1;
+}
+
+/**
+ * @brief Account for a texture owned elsewhere (atlas pages, virtual texture caches), so that
+ * it counts against the budget and shows up in the statistics.
+ *
+ * @param name Name shown in the statistics.
+ * @param bytes VRAM used by the texture.
+ * @return int Texture handle.
+ */
+int TextureManager::track(const char* name, size_t bytes) {
+    TextureInfo texture {};
+    texture.name = name;
+    texture.bytes = bytes;
+    texture.screenSize = -1.0f;
+
+    textures.push_back(std::move(texture));
+    return (int)textures.size() - 1;
+}
+
+void TextureManager::setTrackedBytes(int handle, size_t bytes) {
+    textures[handle].bytes = bytes;
+}
+
+/**
+ * @brief Report how large a texture appears on screen this frame. Call it for every use of the
+ * texture, the largest size wins. Textures that are never reported stay at full resolution.
+ *
+ * @param handle Texture handle.
+ * @param pixels On screen size of the whole texture, in pixels.
+ */
+void TextureManager::requestSize(int handle, float pixels) {
+    TextureInfo& texture = textures[handle];
+    texture.screenSize = std::max(texture.screenSize, pixels);
+    texture.streamed = true;
+}
+
+/**
+ * @brief Pick the resident mip level of every texture from its screen size, enforce the budget
+ * and apply the changes. Levels the screen size no longer needs are dropped with hysteresis,
+ * levels the budget takes away at once. Streaming in is limited to one level per texture and
+ * MAX_MIP_UPLOADS_PER_FRAME textures per frame.
+ */
+void TextureManager::update() {
+    frame++;
+    uploadedBytes = 0;
+
+    std::vector<Decoded> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.swap(decoded);
+    }
+
+    for (Decoded& result : ready) {
+        if (result.handle >= (int)textures.size()) {
+            continue;
+        }
+
+        TextureInfo& texture = textures[result.handle];
+        if (!result.mips.empty()) {
+            texture.width = result.width;
+            texture.height = result.height;
+            texture.levels = (int)result.mips.size();
+            texture.mips = std::move(result.mips);
+            // The placeholder has nothing to copy from, the whole chain is uploaded.
+            texture.residentLevel = texture.levels;
+            allocate(texture, 0);
+        }
+        texture.loading = false;
+    }
+
+    size_t total = 0;
+    std::vector<TextureInfo*> managed;
+
+    for (TextureInfo& texture : textures) {
+        if (!texture.target || texture.loading) {
+            total += texture.bytes;
+            continue;
+        }
+
+        // A texel per pixel is enough, finer levels would only be minified away. A size hovering
+        // around a level boundary keeps the resident level instead of dropping and streaming it
+        // back in every few frames.
+        int desired = 0;
+        if (texture.streamed) {
+            float size = std::max(texture.screenSize, 1.0f);
+            float lod = std::log2(std::max(texture.width, texture.height) / size);
+            desired = (int)std::floor(lod);
+            if (desired <= texture.residentLevel || lod < texture.residentLevel + 1 + MIP_DROP_HYSTERESIS) {
+                texture.neededFrame = frame;
+            }
+            if (frame - texture.neededFrame < MIN_MIP_RESIDENCY_FRAMES) {
+                desired = std::min(desired, texture.residentLevel);
+            }
+        }
+        texture.desiredLevel = std::clamp(desired, 0, texture.levels - 1);
+
+        total += levelBytes(texture, texture.desiredLevel);
+        managed.push_back(&texture);
+    }
+
+    // Over budget: coarsen the textures that are smallest on screen first.
+    std::sort(managed.begin(), managed.end(), [](const TextureInfo* a, const TextureInfo* b) {
+        return a->screenSize < b->screenSize;
+    });
+
+    bool changed = true;
+    while (total > budget && changed) {
+        changed = false;
+        for (TextureInfo* texture : managed) {
+            if (total <= budget) {
+                break;
+            }
+            if (texture->desiredLevel < texture->levels - 1) {
+                total -= levelBytes(*texture, texture->desiredLevel);
+                texture->desiredLevel++;
+                total += levelBytes(*texture, texture->desiredLevel);
+                changed = true;
+            }
+        }
+    }
+
+    int uploads = 0;
+    for (TextureInfo* texture : managed) {
+        if (texture->desiredLevel > texture->residentLevel) {
+            allocate(*texture, texture->desiredLevel);
+        }
+        else if (texture->desiredLevel < texture->residentLevel && uploads < MAX_MIP_UPLOADS_PER_FRAME) {
+            allocate(*texture, texture->residentLevel - 1);
+            uploads++;
+        }
+        texture->screenSize = -1.0f;
+    }
+}
+
+/**
+ * @brief Delete every owned texture. Tracked textures are left to their owners.
+ */
+void TextureManager::clean() {
+    for (TextureInfo& texture : textures) {
+        if (texture.target) {
+            glDeleteTextures(1, &texture.id);
+        }
+    }
+    textures.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    decoded.clear();
+}
+
+size_t TextureManager::residentBytes() const {
+    size_t total = 0;
+    for (const TextureInfo& texture : textures) {
+        total += texture.bytes;
+    }
+    return total;
+}
+
+/**
+ * @brief On screen size in pixels of an object under a perspective projection.
+ *
+ * @param worldSize Size of the object in world units.
+ * @param distance Distance from the camera.
+ * @param fovY Vertical field of view in degrees.
+ * @param viewportHeight Viewport height in pixels.
+ * @return float Size in pixels.
+ */
+float TextureManager::screenSize(float worldSize, float distance, float fovY, int viewportHeight) {
+    float extent = 2.0f * std::max(distance, 1e-3f) * std::tan(glm::radians(fovY) * 0.5f);
+    return worldSize / extent * viewportHeight;
+}
+
+
+/*
+* Private Methods
+*/
+
+size_t TextureManager::levelBytes(const TextureInfo& texture, int level) const {
+    size_t bytes = 0;
+    for (int m = level; m < texture.levels; m++) {
+        bytes += texture.mips[m].size();
+    }
+    return bytes;
+}
+
+// Immutable storage cannot change its levels, so changing the resident level recreates the
+// texture with the new level as its base. Levels that were resident before are copied over on the
+// GPU, only the newly resident ones are uploaded from the CPU copy. Without GL 4.3 every level is
+// uploaded.
+void TextureManager::allocate(TextureInfo& texture, int level) {
+    int width = std::max(1, texture.width >> level);
+    int height = std::max(1, texture.height >> level);
+    GLsizei levels = texture.levels - level;
+    bool array = texture.target == GL_TEXTURE_2D_ARRAY;
+
+    GLuint id;
+    glGenTextures(1, &id);
+    glBindTexture(texture.target, id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if (array) {
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, GL_RGBA8, width, height, texture.layers);
+    }
+    else {
+        glTexStorage2D(GL_TEXTURE_2D, levels, GL_RGBA8, width, height);
+    }
+
+    for (GLsizei m = 0; m < levels; m++) {
+        int source = level + (int)m;
+        int w = std::max(1, width >> m);
+        int h = std::max(1, height >> m);
+        if (GLAD_GL_VERSION_4_3 && texture.id && source >= texture.residentLevel) {
+            glCopyImageSubData(texture.id, texture.target, source - texture.residentLevel, 0, 0, 0,
+                id, texture.target, m, 0, 0, 0, w, h, texture.layers);
+        }
+        else if (array) {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, m, 0, 0, 0, w, h, texture.layers, GL_RGBA, GL_UNSIGNED_BYTE,
+                texture.mips[source].data());
+            uploadedBytes += texture.mips[source].size();
+        }
+        else {
+            glTexSubImage2D(GL_TEXTURE_2D, m, 0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, texture.mips[source].data());
+            uploadedBytes += texture.mips[source].size();
+        }
+    }
+
+    glTexParameteri(texture.target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(texture.target, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(texture.target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(texture.target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(texture.target, 0);
+
+    glDeleteTextures(1, &texture.id);
+    texture.id = id;
+    texture.residentLevel = level;
+    texture.neededFrame = frame;
+    texture.bytes = levelBytes(texture, level);
+}
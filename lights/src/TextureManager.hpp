@@ -0,0 +1,87 @@
+/**
+ * @file TextureManager.hpp
+ * @author Rohan Siddhu
+ * @brief Texture ownership, VRAM accounting and mip streaming under a memory budget.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "ThreadPool.hpp"
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+constexpr size_t DEFAULT_TEXTURE_BUDGET = 64 * 1024 * 1024;
+
+// Upper bound of textures streaming in a finer mip per frame.
+constexpr int MAX_MIP_UPLOADS_PER_FRAME = 2;
+
+// A level is only dropped once the screen size has asked for a level at least this far past it
+// for MIN_MIP_RESIDENCY_FRAMES frames in a row. The budget can still drop levels at once.
+constexpr float MIP_DROP_HYSTERESIS = 0.25f;
+constexpr uint64_t MIN_MIP_RESIDENCY_FRAMES = 60;
+
+struct TextureInfo {
+    std::string name;
+    GLenum target;          /** GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, or 0 for tracked textures. */
+    GLuint id;
+    int width, height, layers;
+    int levels;             /** Levels of the full mip chain. */
+    int residentLevel;      /** Finest level currently in VRAM. */
+    int desiredLevel;       /** Finest level wanted, after the budget is applied. */
+    uint64_t neededFrame;   /** Last frame the resident level was needed or streamed in. */
+    size_t bytes;           /** VRAM currently used. */
+    float screenSize;       /** Largest on screen size in pixels requested this frame, -1 if none. */
+    bool streamed;          /** Whether screen size requests have ever been made. */
+    bool loading;           /** Still decoding, a 1x1 placeholder is resident meanwhile. */
+    std::vector<std::vector<unsigned char>> mips;   /** CPU copy of every level, RGBA8, all layers. */
+};
+
+class TextureManager {
+private:
+    struct Decoded {
+        int handle;
+        int width, height;
+        std::vector<std::vector<unsigned char>> mips;
+    };
+
+    std::vector<TextureInfo> textures;
+    size_t budget;
+    uint64_t frame = 0;
+    size_t uploadedBytes = 0;       /** Uploaded from the CPU copies by the last update(). */
+
+    std::mutex mutex;
+    std::vector<Decoded> decoded;   /** Finished by the workers, waiting for upload. */
+    ThreadPool pool;                /** Declared last so it is joined before the rest goes away. */
+public:
+    TextureManager(size_t budget = DEFAULT_TEXTURE_BUDGET);
+
+    int load(const char* path, bool srgb = true);
+    int create(const char* name, GLenum target, int width, int height, int layers,
+        std::vector<std::vector<unsigned char>> mips);
+    int track(const char* name, size_t bytes);
+    void setTrackedBytes(int handle, size_t bytes);
+
+    void requestSize(int handle, float pixels);
+    void update();
+    void clean();
+
+    GLuint id(int handle) const { return textures[handle].id; }
+    ThreadPool& getPool() { return pool; }
+    const std::vector<TextureInfo>& getTextures() const { return textures; }
+    size_t getBudget() const { return budget; }
+    void setBudget(size_t bytes) { budget = bytes; }
+    size_t residentBytes() const;
+    size_t lastUploadBytes() const { return uploadedBytes; }
+
+    static float screenSize(float worldSize, float distance, float fovY, int viewportHeight);
+private:
+    size_t levelBytes(const TextureInfo& texture, int level) const;
+    void allocate(TextureInfo& texture, int level);
+};
@@ -0,0 +1,122 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Rohan Siddhu
+ * @brief ThreadPool class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+
+/**
+ * @brief Start the worker threads.
+ *
+ * @param threadCount Number of workers, at least one.
+ */
+ThreadPool::ThreadPool(unsigned threadCount) {
+    threadCount = std::max(threadCount, 1u);
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+/**
+ * @brief Finish the queued tasks and join the workers.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Queue a task.
+ *
+ * @param task Function to run on a worker.
+ * @return std::future<void> Becomes ready when the task has run.
+ */
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> result = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(packaged));
+    }
+    wake.notify_one();
+
+    return result;
+}
+
+/**
+ * @brief Run body(0) ... body(count - 1) on the workers and the calling thread, and return once
+ * all of them have finished. The caller takes part, so nested calls from inside a task cannot
+ * deadlock even when every worker is busy.
+ *
+ * @param count Number of iterations.
+ * @param body Loop body, called with the iteration index.
+ */
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& body) {
+    struct State {
+        std::atomic<int> next { 0 };
+        std::atomic<int> done { 0 };
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    auto state = std::make_shared<State>();
+    int total = count;
+
+    // Workers that get to their helper task late find no work left and return without
+    // touching 'body', which may be gone by then.
+    auto run = [state, total, &body]() {
+        int i;
+        while ((i = state->next.fetch_add(1)) < total) {
+            body(i);
+            if (state->done.fetch_add(1) + 1 == total) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    int helpers = std::min(count - 1, (int)workers.size());
+    for (int i = 0; i < helpers; i++) {
+        submit(run);
+    }
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->done.load() == total; });
+}
+
+
+/*
+* Private Methods
+*/
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file ThreadPool.hpp
+ * @author Rohan Siddhu
+ * @brief Fixed size pool of worker threads.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::packaged_task<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+public:
+    ThreadPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    std::future<void> submit(std::function<void()> task);
+    void parallelFor(int count, const std::function<void(int)>& body);
+
+    unsigned size() const { return (unsigned)workers.size(); }
+private:
+    void workerLoop();
+};
@@ -0,0 +1,55 @@
+/**
+ * @file TripleBuffer.hpp
+ * @author Rohan Siddhu
+ * @brief Lock-free handoff of the latest value from one writer thread to one reader thread.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// The writer fills its back slot and publishes it by swapping it with the shared middle slot; the
+// reader takes the middle slot the same way. Neither side waits, copies under a lock or sees a
+// half written value, and the reader always gets the newest published value. Values published
+// while the reader is busy replace each other. With only two slots, the writer would have to
+// wait for the reader to let go of the front one.
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr uint8_t INDEX_MASK = 3;
+    static constexpr uint8_t FRESH = 4;     /** The middle slot holds a value the reader has not taken. */
+
+    T slots[3];
+    std::atomic<uint8_t> middle { 1 };
+    uint8_t back = 0;       /** Writer thread only. */
+    uint8_t front = 2;      /** Reader thread only. */
+public:
+    TripleBuffer(const T& value = T()) {
+        slots[0] = slots[1] = slots[2] = value;
+    }
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer: the slot to fill, then publish() it.
+    T& writeSlot() { return slots[back]; }
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+    void write(const T& value) {
+        slots[back] = value;
+        publish();
+    }
+
+    // Reader: take the newest published value, if any, and read it until the next update().
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& read() const { return slots[front]; }
+};
@@ -0,0 +1,535 @@
+/**
+ * @file VirtualTexture.cpp
+ * @author Rohan Siddhu
+ * @brief VirtualTexture class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "VirtualTexture.hpp"
+#include "Image.hpp"
+#include "stb_image.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+
+// Tile keys pack the mip level and the tile coordinates into 32 bits.
+static uint32_t tile_key(uint32_t level, uint32_t x, uint32_t y) {
+    return (level << 28) | (y << 14) | x;
+}
+
+static uint32_t key_level(uint32_t key) { return key >> 28; }
+static uint32_t key_y(uint32_t key) { return (key >> 14) & 0x3FFF; }
+static uint32_t key_x(uint32_t key) { return key & 0x3FFF; }
+
+// Feedback texels no tile was asked for, level 15 is beyond any tile file.
+constexpr GLuint FEEDBACK_NONE = 0xFFFFFFFFu;
+
+static uint32_t next_pow2(uint32_t v) {
+    uint32_t p = 1;
+    while (p < v) {
+        p <<= 1;
+    }
+    return p;
+}
+
+
+/**
+ * @brief Convert an image into a tile file. The image is scaled up to power of two dimensions,
+ * its mip chain is built on the CPU and every level is cut into bordered tiles. Borders wrap
+ * around, so the virtual texture can be repeated.
+ *
+ * @param imagePath Source image.
+ * @param tilePath Output tile file.
+ * @param tileSize Texels per tile side.
+ * @param border Border texels on each side of a tile, for bilinear filtering.
+ * @return bool true on success.
+ */
+bool VirtualTexture::buildTileFile(const char* imagePath, const char* tilePath, int tileSize, int border) {
+    int width, height, nrComponents;
+    unsigned char* img = stbi_load(imagePath, &width, &height, &nrComponents, 4);
+    if (!img) {
+        std::cerr << "Failed to load texture: " << imagePath << std::endl;
+        return false;
+    }
+
+    int w = (int)next_pow2(std::max(width, tileSize));
+    int h = (int)next_pow2(std::max(height, tileSize));
+    std::vector<unsigned char> level = (w == width && h == height)
+        ? std::vector<unsigned char>(img, img + (size_t)w * h * 4)
+        : resample_image(img, width, height, w, h);
+    stbi_image_free(img);
+
+    std::ofstream out(tilePath, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to create tile file: " << tilePath << std::endl;
+        return false;
+    }
+
+    VirtualTextureHeader hdr {};
+    std::memcpy(hdr.magic, "VTEX", 4);
+    hdr.version = 1;
+    hdr.width = w;
+    hdr.height = h;
+    hdr.tileSize = tileSize;
+    hdr.border = border;
+    hdr.levels = 1;
+    while (std::max(w / tileSize, h / tileSize) >> (hdr.levels - 1) > 1) {
+        hdr.levels++;
+    }
+    out.write((const char*)&hdr, sizeof(hdr));
+
+    int padded = tileSize + 2 * border;
+    std::vector<unsigned char> tile((size_t)padded * padded * 4);
+    int levelWidth = w, levelHeight = h;
+
+    for (uint32_t m = 0; m < hdr.levels; m++) {
+        int tilesX = std::max(1, (w / tileSize) >> m);
+        int tilesY = std::max(1, (h / tileSize) >> m);
+
+        for (int ty = 0; ty < tilesY; ty++) {
+            for (int tx = 0; tx < tilesX; tx++) {
+                for (int py = 0; py < padded; py++) {
+                    int sy = ((ty * tileSize + py - border) % levelHeight + levelHeight) % levelHeight;
+                    for (int px = 0; px < padded; px++) {
+                        int sx = ((tx * tileSize + px - border) % levelWidth + levelWidth) % levelWidth;
+                        std::memcpy(&tile[((size_t)py * padded + px) * 4], &level[((size_t)sy * levelWidth + sx) * 4], 4);
+                    }
+                }
+                out.write((const char*)tile.data(), tile.size());
+            }
+        }
+
+        level = downsample_image(level.data(), levelWidth, levelHeight, true);
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+
+    return (bool)out;
+}
+
+/**
+ * @brief Map a tile file and create the GPU resources. The coarsest tile is loaded right away
+ * and pinned, so every texel of the virtual texture always has something to sample.
+ *
+ * @param tilePath Tile file created by buildTileFile().
+ * @param cacheSlotsPerSide The physical cache holds cacheSlotsPerSide^2 tiles.
+ * @param workerCount Number of streaming threads.
+ * @return bool true on success.
+ */
+bool VirtualTexture::open(const char* tilePath, int cacheSlotsPerSide, int workerCount) {
+    if (!file.open(tilePath) || file.size() < sizeof(VirtualTextureHeader)) {
+        return false;
+    }
+
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, "VTEX", 4) != 0 || header.version != 1 || header.levels > 15) {
+        std::cerr << "Invalid tile file: " << tilePath << std::endl;
+        file.close();
+        return false;
+    }
+
+    int padded = header.tileSize + 2 * header.border;
+    tileBytes = (size_t)padded * padded * 4;
+
+    levelOffsets.assign(1, 0);
+    for (uint32_t m = 0; m < header.levels; m++) {
+        glm::ivec2 tiles = levelTiles(m);
+        levelOffsets.push_back(levelOffsets.back() + (size_t)tiles.x * tiles.y);
+    }
+
+    if (file.size() < sizeof(VirtualTextureHeader) + levelOffsets.back() * tileBytes) {
+        std::cerr << "Truncated tile file: " << tilePath << std::endl;
+        file.close();
+        return false;
+    }
+
+    // Physical cache
+    slotsPerSide = std::min(cacheSlotsPerSide, 255);
+    slots.assign((size_t)slotsPerSide * slotsPerSide, Slot{ UINT32_MAX, 0, false });
+
+    glGenTextures(1, &cacheTexture);
+    glBindTexture(GL_TEXTURE_2D, cacheTexture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, slotsPerSide * padded, slotsPerSide * padded);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Page table
+    glm::ivec2 tiles = levelTiles(0);
+    glGenTextures(1, &pageTable);
+    glBindTexture(GL_TEXTURE_2D, pageTable);
+    glTexStorage2D(GL_TEXTURE_2D, header.levels, GL_RGBA8UI, tiles.x, tiles.y);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    pageEntries.resize(header.levels);
+    for (uint32_t m = 0; m < header.levels; m++) {
+        glm::ivec2 t = levelTiles(m);
+        pageEntries[m].assign((size_t)t.x * t.y, glm::u8vec4(0));
+    }
+
+    // The coarsest level is a single tile that never leaves the cache.
+    LoadedTile root { tile_key(header.levels - 1, 0, 0), {} };
+    root.pixels.assign(tileData(root.key), tileData(root.key) + tileBytes);
+    upload(root);
+    slots[resident[root.key]].pinned = true;
+    rebuildPageTable();
+
+    stopping = false;
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&VirtualTexture::workerLoop, this);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Bind the low resolution feedback framebuffer. Draw everything that samples the
+ * virtual texture with bind(..., true) between beginFeedback() and endFeedback().
+ *
+ * @param width Window width.
+ * @param height Window height.
+ */
+void VirtualTexture::beginFeedback(int width, int height) {
+    int w = std::max(1, width / VT_FEEDBACK_SCALE);
+    int h = std::max(1, height / VT_FEEDBACK_SCALE);
+
+    if (w != feedbackWidth || h != feedbackHeight) {
+        glDeleteFramebuffers(1, &feedbackFbo);
+        glDeleteTextures(1, &feedbackColor);
+        glDeleteRenderbuffers(1, &feedbackDepth);
+        glDeleteBuffers(2, feedbackPbo);
+        for (GLsync& fence : feedbackFence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        glGenTextures(1, &feedbackColor);
+        glBindTexture(GL_TEXTURE_2D, feedbackColor);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32UI, w, h);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glGenRenderbuffers(1, &feedbackDepth);
+        glBindRenderbuffer(GL_RENDERBUFFER, feedbackDepth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glGenFramebuffers(1, &feedbackFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, feedbackFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, feedbackColor, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, feedbackDepth);
+
+        glGenBuffers(2, feedbackPbo);
+        for (GLuint pbo : feedbackPbo) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+            glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)w * h * 4, nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        feedbackWidth = w;
+        feedbackHeight = h;
+    }
+
+    glGetIntegerv(GL_VIEWPORT, savedViewport);
+    glBindFramebuffer(GL_FRAMEBUFFER, feedbackFbo);
+    glViewport(0, 0, w, h);
+    const GLuint none[4] = { FEEDBACK_NONE, 0, 0, 0 };
+    glClearBufferuiv(GL_COLOR, 0, none);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+/**
+ * @brief Start an asynchronous read back of the feedback buffer and restore the default
+ * framebuffer. The result is consumed by update() once the GPU is done with it.
+ */
+void VirtualTexture::endFeedback() {
+    GLsync& fence = feedbackFence[feedbackIndex];
+    if (!fence) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, feedbackPbo[feedbackIndex]);
+        glReadPixels(0, 0, feedbackWidth, feedbackHeight, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        feedbackIndex = (feedbackIndex + 1) % 2;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+}
+
+/**
+ * @brief Per frame housekeeping. Consumes finished feedback read backs, queues the missing
+ * tiles for the streaming threads and uploads the tiles they have finished.
+ */
+void VirtualTexture::update() {
+    frame++;
+
+    for (GLsync& fence : feedbackFence) {
+        if (!fence || glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+            continue;
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+
+        GLuint pbo = feedbackPbo[&fence - feedbackFence];
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        auto keys = (const uint32_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+            (GLsizeiptr)feedbackWidth * feedbackHeight * 4, GL_MAP_READ_BIT);
+        if (keys) {
+            processFeedback(keys, (size_t)feedbackWidth * feedbackHeight);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    std::vector<LoadedTile> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = std::min(loaded.size(), (size_t)VT_MAX_UPLOADS_PER_FRAME);
+        std::move(loaded.begin(), loaded.begin() + count, std::back_inserter(ready));
+        loaded.erase(loaded.begin(), loaded.begin() + count);
+    }
+
+    uploadsLastFrame = 0;
+    for (const LoadedTile& tile : ready) {
+        upload(tile);
+        pending.erase(tile.key);
+    }
+
+    if (pageTableDirty) {
+        rebuildPageTable();
+    }
+}
+
+/**
+ * @brief Bind the page table and the physical cache, and set the uniforms used by
+ * fsVirtual.glsl and fsFeedback.glsl.
+ *
+ * @param shader Target shader, must be in use.
+ * @param pageTableUnit Texture unit for the page table.
+ * @param cacheUnit Texture unit for the physical cache.
+ * @param feedback true when drawing the feedback pass, to compensate for its lower resolution.
+ */
+void VirtualTexture::bind(Shader& shader, GLuint pageTableUnit, GLuint cacheUnit, bool feedback) {
+    glActiveTexture(GL_TEXTURE0 + pageTableUnit);
+    glBindTexture(GL_TEXTURE_2D, pageTable);
+    glActiveTexture(GL_TEXTURE0 + cacheUnit);
+    glBindTexture(GL_TEXTURE_2D, cacheTexture);
+
+    float padded = (float)(header.tileSize + 2 * header.border);
+    shader.setInt("vt.pageTable", pageTableUnit);
+    shader.setInt("vt.cache", cacheUnit);
+    shader.setVec2("vt.size", glm::vec2(header.width, header.height));
+    shader.setFloat("vt.tileSize", (float)header.tileSize);
+    shader.setFloat("vt.border", (float)header.border);
+    shader.setFloat("vt.cacheSize", padded * slotsPerSide);
+    shader.setFloat("vt.maxLevel", (float)(header.levels - 1));
+    shader.setFloat("vt.mipBias", feedback ? -std::log2((float)VT_FEEDBACK_SCALE) : 0.0f);
+}
+
+void VirtualTexture::clean() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        requests.clear();
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    loaded.clear();
+    pending.clear();
+
+    for (GLsync& fence : feedbackFence) {
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+    glDeleteBuffers(2, feedbackPbo);
+    glDeleteFramebuffers(1, &feedbackFbo);
+    glDeleteTextures(1, &feedbackColor);
+    glDeleteRenderbuffers(1, &feedbackDepth);
+    glDeleteTextures(1, &cacheTexture);
+    glDeleteTextures(1, &pageTable);
+    feedbackWidth = feedbackHeight = 0;
+    cacheTexture = pageTable = 0;
+
+    resident.clear();
+    slots.clear();
+    file.close();
+}
+
+/**
+ * @brief GPU memory used by the physical cache and the page table, in bytes. Independent of
+ * the size of the virtual texture apart from the page table.
+ */
+size_t VirtualTexture::videoMemory() const {
+    size_t padded = header.tileSize + 2 * header.border;
+    size_t bytes = slots.size() * padded * padded * 4;
+    for (const auto& level : pageEntries) {
+        bytes += level.size() * sizeof(glm::u8vec4);
+    }
+    return bytes;
+}
+
+
+/*
+* Private Methods
+*/
+
+glm::ivec2 VirtualTexture::levelTiles(uint32_t level) const {
+    return glm::ivec2(std::max(1u, (header.width / header.tileSize) >> level),
+        std::max(1u, (header.height / header.tileSize) >> level));
+}
+
+const unsigned char* VirtualTexture::tileData(uint32_t key) const {
+    uint32_t level = key_level(key);
+    size_t index = levelOffsets[level] + (size_t)key_y(key) * levelTiles(level).x + key_x(key);
+    return file.data() + sizeof(VirtualTextureHeader) + index * tileBytes;
+}
+
+void VirtualTexture::workerLoop() {
+    while (true) {
+        uint32_t key;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !requests.empty(); });
+            if (stopping) {
+                return;
+            }
+            key = requests.front();
+            requests.pop_front();
+        }
+
+        // Copying out of the mapping is where the page faults, and so the disk reads, happen.
+        LoadedTile tile { key, {} };
+        const unsigned char* src = tileData(key);
+        tile.pixels.assign(src, src + tileBytes);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        loaded.push_back(std::move(tile));
+    }
+}
+
+void VirtualTexture::processFeedback(const uint32_t* keys, size_t count) {
+    std::unordered_set<uint32_t> wanted;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t level = key_level(keys[i]);
+        if (level >= header.levels) {
+            continue;
+        }
+
+        // Ancestors are wanted as well, they are the fallback while the tile streams in.
+        uint32_t x = key_x(keys[i]), y = key_y(keys[i]);
+        for (uint32_t m = level; m < header.levels; m++, x /= 2, y /= 2) {
+            if (!wanted.insert(tile_key(m, x, y)).second) {
+                break;
+            }
+        }
+    }
+
+    std::vector<uint32_t> missing;
+    for (uint32_t key : wanted) {
+        auto it = resident.find(key);
+        if (it != resident.end()) {
+            slots[it->second].lastUsed = frame;
+        }
+        else if (!pending.count(key)) {
+            missing.push_back(key);
+        }
+    }
+
+    // Coarse tiles first, they cover more of the screen per byte.
+    std::sort(missing.begin(), missing.end(), [](uint32_t a, uint32_t b) {
+        return key_level(a) > key_level(b);
+    });
+
+    // Never ask for more than the cache can hold at once.
+    missing.resize(std::min(missing.size(), slots.size() / 2));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (uint32_t key : missing) {
+            requests.push_back(key);
+            pending.insert(key);
+        }
+    }
+    wake.notify_all();
+}
+
+void VirtualTexture::upload(const LoadedTile& tile) {
+    int slot = allocateSlot();
+    if (slot < 0) {
+        return;
+    }
+
+    int padded = header.tileSize + 2 * header.border;
+    glBindTexture(GL_TEXTURE_2D, cacheTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, (slot % slotsPerSide) * padded, (slot / slotsPerSide) * padded,
+        padded, padded, GL_RGBA, GL_UNSIGNED_BYTE, tile.pixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    slots[slot] = { tile.key, frame, false };
+    resident[tile.key] = slot;
+    pageTableDirty = true;
+    uploadsLastFrame++;
+}
+
+int VirtualTexture::allocateSlot() {
+    int victim = -1;
+    for (int i = 0; i < (int)slots.size(); i++) {
+        const Slot& slot = slots[i];
+        if (slot.key == UINT32_MAX) {
+            return i;
+        }
+        // Tiles seen in the current frame's feedback stay.
+        if (!slot.pinned && slot.lastUsed < frame && (victim < 0 || slot.lastUsed < slots[victim].lastUsed)) {
+            victim = i;
+        }
+    }
+
+    if (victim >= 0) {
+        resident.erase(slots[victim].key);
+        slots[victim].key = UINT32_MAX;
+    }
+
+    return victim;
+}
+
+void VirtualTexture::rebuildPageTable() {
+    // Walk from the coarsest level down. A missing tile inherits its parent's entry, so the
+    // shader falls back to the closest resident ancestor.
+    for (int m = (int)header.levels - 1; m >= 0; m--) {
+        glm::ivec2 tiles = levelTiles(m);
+        glm::ivec2 parentTiles = levelTiles(std::min(m + 1, (int)header.levels - 1));
+
+        for (int y = 0; y < tiles.y; y++) {
+            for (int x = 0; x < tiles.x; x++) {
+                glm::u8vec4& entry = pageEntries[m][(size_t)y * tiles.x + x];
+                auto it = resident.find(tile_key(m, x, y));
+
+                if (it != resident.end()) {
+                    entry = glm::u8vec4(it->second % slotsPerSide, it->second / slotsPerSide, m, 1);
+                }
+                else if (m + 1 < (int)header.levels) {
+                    int px = std::min(x / 2, parentTiles.x - 1), py = std::min(y / 2, parentTiles.y - 1);
+                    entry = pageEntries[m + 1][(size_t)py * parentTiles.x + px];
+                }
+            }
+        }
+
+        glBindTexture(GL_TEXTURE_2D, pageTable);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, m, 0, 0, tiles.x, tiles.y, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, pageEntries[m].data());
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    pageTableDirty = false;
+}
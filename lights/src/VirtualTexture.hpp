@@ -0,0 +1,118 @@
+/**
+ * @file VirtualTexture.hpp
+ * @author Rohan Siddhu
+ * @brief Sparse virtual texture streamed from a memory mapped tile file.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "MappedFile.hpp"
+#include "Shader.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// The feedback pass renders at 1 / VT_FEEDBACK_SCALE of the window resolution.
+constexpr int VT_FEEDBACK_SCALE = 8;
+
+// Upper bound of tiles uploaded per frame, keeps the upload cost of a camera cut bounded.
+constexpr int VT_MAX_UPLOADS_PER_FRAME = 8;
+
+// Header of a tile file (*.vt). It is followed by the tiles of every mip level, finest level
+// first, each level in row major order. A tile is (tileSize + 2 * border)^2 RGBA8 texels.
+struct VirtualTextureHeader {
+    char magic[4];          /** "VTEX" */
+    uint32_t version;
+    uint32_t width;         /** Level 0 width in texels, power of two. */
+    uint32_t height;        /** Level 0 height in texels, power of two. */
+    uint32_t tileSize;      /** Texels per tile side, border excluded. */
+    uint32_t border;        /** Texels copied from the neighbouring tiles on each side. */
+    uint32_t levels;        /** Mip levels, the last one is a single tile. */
+    uint32_t reserved;
+};
+
+class VirtualTexture {
+private:
+    struct Slot {
+        uint32_t key;       /** Tile in this slot, UINT32_MAX if free. */
+        uint64_t lastUsed;  /** Last frame the feedback pass asked for the tile. */
+        bool pinned;
+    };
+
+    struct LoadedTile {
+        uint32_t key;
+        std::vector<unsigned char> pixels;
+    };
+
+    MappedFile file;
+    VirtualTextureHeader header {};
+    size_t tileBytes = 0;
+    std::vector<size_t> levelOffsets;   /** First tile of each level, in tiles. */
+
+    // Physical cache
+    GLuint cacheTexture = 0;
+    int slotsPerSide = 0;
+    std::vector<Slot> slots;
+    std::unordered_map<uint32_t, int> resident;     /** Tile key to slot. */
+
+    // Page table, one texel per tile and one mip level per tile level.
+    GLuint pageTable = 0;
+    std::vector<std::vector<glm::u8vec4>> pageEntries;
+    bool pageTableDirty = false;
+
+    // Feedback
+    GLuint feedbackFbo = 0;
+    GLuint feedbackColor = 0;
+    GLuint feedbackDepth = 0;
+    GLuint feedbackPbo[2] = { 0, 0 };
+    GLsync feedbackFence[2] = { nullptr, nullptr };
+    int feedbackWidth = 0, feedbackHeight = 0;
+    int feedbackIndex = 0;
+    GLint savedViewport[4];
+
+    // Streaming
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<uint32_t> requests;
+    std::vector<LoadedTile> loaded;
+    std::unordered_set<uint32_t> pending;
+    bool stopping = false;
+
+    uint64_t frame = 0;
+    int uploadsLastFrame = 0;
+public:
+    static bool buildTileFile(const char* imagePath, const char* tilePath, int tileSize = 128, int border = 4);
+
+    bool open(const char* tilePath, int cacheSlotsPerSide = 8, int workerCount = 2);
+    void beginFeedback(int width, int height);
+    void endFeedback();
+    void update();
+    void bind(Shader& shader, GLuint pageTableUnit, GLuint cacheUnit, bool feedback);
+    void clean();
+
+    int residentTiles() const { return (int)resident.size(); }
+    int cacheSlots() const { return (int)slots.size(); }
+    int pendingTiles() const { return (int)pending.size(); }
+    int uploads() const { return uploadsLastFrame; }
+    size_t totalTiles() const { return levelOffsets.empty() ? 0 : levelOffsets.back(); }
+    size_t videoMemory() const;
+private:
+    glm::ivec2 levelTiles(uint32_t level) const;
+    const unsigned char* tileData(uint32_t key) const;
+    void workerLoop();
+    void processFeedback(const uint32_t* keys, size_t count);
+    void upload(const LoadedTile& tile);
+    int allocateSlot();
+    void rebuildPageTable();
+};
@@ -0,0 +1,144 @@
+/**
+ * @file ImageCompare.cpp
+ * @author Rohan Siddhu
+ * @brief Perceptual comparison of rendered images against goldens (SSIM).
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "ImageCompare.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Gaussian window of Wang et al., 11 taps with a standard deviation of 1.5 pixels.
+constexpr int SSIM_RADIUS = 5;
+constexpr double SSIM_SIGMA = 1.5;
+
+// Stabilizing constants for 8 bit values, (0.01 * 255)^2 and (0.03 * 255)^2.
+constexpr double SSIM_C1 = 6.5025;
+constexpr double SSIM_C2 = 58.5225;
+
+constexpr int SSIM_BLOCK = 16;
+
+static std::vector<double> luminance(const uint8_t* pixels, int width, int height) {
+    std::vector<double> y((size_t)width * height);
+    for (size_t i = 0; i < y.size(); i++) {
+        y[i] = 0.299 * pixels[i * 4] + 0.587 * pixels[i * 4 + 1] + 0.114 * pixels[i * 4 + 2];
+    }
+    return y;
+}
+
+// Separable Gaussian blur, clamping at the borders.
+static std::vector<double> blur(const std::vector<double>& src, int width, int height, const double* weights) {
+    std::vector<double> rows(src.size());
+    std::vector<double> dst(src.size());
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double sum = 0.0;
+            for (int k = -SSIM_RADIUS; k <= SSIM_RADIUS; k++) {
+                int sx = std::clamp(x + k, 0, width - 1);
+                sum += weights[k + SSIM_RADIUS] * src[(size_t)y * width + sx];
+            }
+            rows[(size_t)y * width + x] = sum;
+        }
+    }
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double sum = 0.0;
+            for (int k = -SSIM_RADIUS; k <= SSIM_RADIUS; k++) {
+                int sy = std::clamp(y + k, 0, height - 1);
+                sum += weights[k + SSIM_RADIUS] * rows[(size_t)sy * width + x];
+            }
+            dst[(size_t)y * width + x] = sum;
+        }
+    }
+    return dst;
+}
+
+/**
+ * @brief Structural similarity (SSIM) of the luminance of two images, with per channel statistics.
+ * SSIM compares local means, contrasts and structure rather than raw values, so it tolerates the
+ * last bit differences of another compiler or math library but not a missing object or light.
+ *
+ * @param a First RGBA8 image.
+ * @param b Second RGBA8 image.
+ * @param width Width of both images.
+ * @param height Height of both images.
+ * @param ssimMap Optional output, the dissimilarity map as an RGBA8 image.
+ * @return ImageDifference Similarity and difference statistics.
+ */
+ImageDifference compare_images(const uint8_t* a, const uint8_t* b, int width, int height, std::vector<uint8_t>* ssimMap) {
+    ImageDifference result;
+    size_t count = (size_t)width * height;
+    for (size_t i = 0; i < count; i++) {
+        int delta = 0;
+        for (int c = 0; c < 3; c++) {
+            delta = std::max(delta, std::abs((int)a[i * 4 + c] - (int)b[i * 4 + c]));
+        }
+        result.maxDelta = std::max(result.maxDelta, delta);
+        result.differingPixels += delta > 2;
+    }
+
+    double weights[2 * SSIM_RADIUS + 1];
+    double total = 0.0;
+    for (int k = -SSIM_RADIUS; k <= SSIM_RADIUS; k++) {
+        weights[k + SSIM_RADIUS] = std::exp(-(k * k) / (2.0 * SSIM_SIGMA * SSIM_SIGMA));
+        total += weights[k + SSIM_RADIUS];
+    }
+    for (double& w : weights) {
+        w /= total;
+    }
+
+    std::vector<double> x = luminance(a, width, height);
+    std::vector<double> y = luminance(b, width, height);
+    std::vector<double> xx(count), yy(count), xy(count);
+    for (size_t i = 0; i < count; i++) {
+        xx[i] = x[i] * x[i];
+        yy[i] = y[i] * y[i];
+        xy[i] = x[i] * y[i];
+    }
+    std::vector<double> muX = blur(x, width, height, weights);
+    std::vector<double> muY = blur(y, width, height, weights);
+    std::vector<double> sigmaXX = blur(xx, width, height, weights);
+    std::vector<double> sigmaYY = blur(yy, width, height, weights);
+    std::vector<double> sigmaXY = blur(xy, width, height, weights);
+
+    std::vector<double> ssim(count);
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double mx = muX[i], my = muY[i];
+        double vx = sigmaXX[i] - mx * mx;
+        double vy = sigmaYY[i] - my * my;
+        double cxy = sigmaXY[i] - mx * my;
+        ssim[i] = ((2.0 * mx * my + SSIM_C1) * (2.0 * cxy + SSIM_C2)) /
+                  ((mx * mx + my * my + SSIM_C1) * (vx + vy + SSIM_C2));
+        sum += ssim[i];
+    }
+    result.meanSsim = count ? sum / count : 1.0;
+
+    for (int by = 0; by < height; by += SSIM_BLOCK) {
+        for (int bx = 0; bx < width; bx += SSIM_BLOCK) {
+            double blockSum = 0.0;
+            int blockCount = 0;
+            for (int py = by; py < std::min(by + SSIM_BLOCK, height); py++) {
+                for (int px = bx; px < std::min(bx + SSIM_BLOCK, width); px++) {
+                    blockSum += ssim[(size_t)py * width + px];
+                    blockCount++;
+                }
+            }
+            result.minBlockSsim = std::min(result.minBlockSsim, blockSum / blockCount);
+        }
+    }
+
+    if (ssimMap) {
+        ssimMap->resize(count * 4);
+        for (size_t i = 0; i < count; i++) {
+            // Dissimilarity, stretched so small differences show.
+            uint8_t v = (uint8_t)std::clamp((1.0 - ssim[i]) * 4.0 * 255.0, 0.0, 255.0);
+            (*ssimMap)[i * 4] = (*ssimMap)[i * 4 + 1] = (*ssimMap)[i * 4 + 2] = v;
+            (*ssimMap)[i * 4 + 3] = 255;
+        }
+    }
+    return result;
+}
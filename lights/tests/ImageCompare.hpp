@@ -0,0 +1,25 @@
+/**
+ * @file ImageCompare.hpp
+ * @author Rohan Siddhu
+ * @brief Perceptual comparison of rendered images against goldens (SSIM).
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct ImageDifference {
+    double meanSsim = 1.0;          /** Mean structural similarity of the luminance, 1 for equal images. */
+    double minBlockSsim = 1.0;      /** Lowest mean SSIM of the 16 x 16 pixel blocks, catches local errors. */
+    int maxDelta = 0;               /** Largest difference of a color channel. */
+    size_t differingPixels = 0;     /** Pixels with a channel off by more than 2. */
+};
+
+// Compare two RGBA8 images of the same size. 'ssimMap', if given, receives the per pixel
+// dissimilarity as a gray RGBA8 image, white where the images differ most.
+ImageDifference compare_images(const uint8_t* a, const uint8_t* b, int width, int height,
+    std::vector<uint8_t>* ssimMap = nullptr);
@@ -0,0 +1,236 @@
+/**
+ * @file RenderTest.cpp
+ * @author Rohan Siddhu
+ * @brief Headless golden image test: renders a scene from its fixed poses on the software
+ * rasterizer and compares the images and render times against the stored ones.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+#include "ImageCompare.hpp"
+#include "TestScenes.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+struct TestOptions {
+    std::string scene;
+    std::string root = ".";
+    std::string golden = "lights/tests/golden";
+    std::string output = ".";
+    bool update = false;
+    int runs = 5;
+    int threads = 1;
+    double minSsim = 0.99;
+    double minBlockSsim = 0.9;
+    double timeTolerance = 0.0;    /** Off: stored times come from one host and build type. */
+};
+
+static void usage() {
+    std::cerr << "Usage: rendertest --scene lights|camera|glLight [options]\n"
+              << "  --root DIR             repository root (default .)\n"
+              << "  --golden DIR           golden images and timings (default lights/tests/golden)\n"
+              << "  --output DIR           where failing images and timings are written (default .)\n"
+              << "  --update               rewrite the goldens and timings instead of comparing\n"
+              << "  --runs N               renders per pose, the median time counts (default 5)\n"
+              << "  --threads N            rasterizer threads (default 1, the most stable timings)\n"
+              << "  --ssim X               lowest mean SSIM that passes (default 0.99)\n"
+              << "  --block-ssim X         lowest SSIM of a 16x16 block that passes (default 0.9)\n"
+              << "  --time-tolerance X     fail above X times the stored time (default 0, off)" << std::endl;
+}
+
+static bool parse_options(int argc, char* argv[], TestOptions& options) {
+    for (int arg = 1; arg < argc; arg++) {
+        std::string option = argv[arg];
+        if (option == "--update") {
+            options.update = true;
+            continue;
+        }
+        if (arg + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++arg];
+        if (option == "--scene") {
+            options.scene = value;
+        }
+        else if (option == "--root") {
+            options.root = value;
+        }
+        else if (option == "--golden") {
+            options.golden = value;
+        }
+        else if (option == "--output") {
+            options.output = value;
+        }
+        else if (option == "--runs" && std::atoi(value) >= 1) {
+            options.runs = std::atoi(value);
+        }
+        else if (option == "--threads" && std::atoi(value) >= 1) {
+            options.threads = std::atoi(value);
+        }
+        else if (option == "--ssim") {
+            options.minSsim = std::atof(value);
+        }
+        else if (option == "--block-ssim") {
+            options.minBlockSsim = std::atof(value);
+        }
+        else if (option == "--time-tolerance") {
+            options.timeTolerance = std::atof(value);
+        }
+        else {
+            return false;
+        }
+    }
+    return !options.scene.empty();
+}
+
+// Color buffer of the rasterizer, bottom row first, as RGBA8 rows from the top.
+static std::vector<uint8_t> top_down(const SoftRasterizer& raster) {
+    int width = raster.getWidth();
+    int height = raster.getHeight();
+    std::vector<uint8_t> image((size_t)width * height * 4);
+    for (int y = 0; y < height; y++) {
+        std::memcpy(&image[(size_t)y * width * 4], &raster.pixels()[(size_t)(height - 1 - y) * width], (size_t)width * 4);
+    }
+    return image;
+}
+
+static bool write_png(const std::string& path, const std::vector<uint8_t>& image, int width, int height) {
+    if (!stbi_write_png(path.c_str(), width, height, 4, image.data(), width * 4)) {
+        std::cerr << "Failed to write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Milliseconds per pose, one "pose ms" line each.
+static std::map<std::string, double> read_timings(const std::string& path) {
+    std::map<std::string, double> timings;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream words(line);
+        std::string pose;
+        double ms;
+        if (words >> pose >> ms) {
+            timings[pose] = ms;
+        }
+    }
+    return timings;
+}
+
+static bool write_timings(const std::string& path, const std::map<std::string, double>& timings) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to write " << path << std::endl;
+        return false;
+    }
+    for (const auto& [pose, ms] : timings) {
+        file << pose << " " << ms << "\n";
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    TestOptions options;
+    if (!parse_options(argc, argv, options)) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    TestScene scene;
+    if (!load_test_scene(options.scene, options.root, scene)) {
+        return EXIT_FAILURE;
+    }
+
+    // The calling thread rasterizes too.
+    std::unique_ptr<ThreadPool> pool;
+    if (options.threads > 1) {
+        pool = std::make_unique<ThreadPool>(options.threads - 1);
+    }
+    SoftRasterizer raster;
+    if (!raster.init(scene.width, scene.height, pool.get())) {
+        return EXIT_FAILURE;
+    }
+
+    std::string timingsName = "/" + scene.name + ".timings";
+    std::map<std::string, double> baseline = read_timings(options.golden + timingsName);
+    std::map<std::string, double> timings;
+    bool passed = true;
+
+    for (const TestPose& pose : scene.poses) {
+        std::string name = scene.name + "_" + pose.name;
+
+        std::vector<double> times;
+        for (int run = 0; run < options.runs; run++) {
+            auto start = Clock::now();
+            render_test_scene(scene, pose, raster);
+            times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        double ms = times[times.size() / 2];
+        timings[pose.name] = ms;
+        std::vector<uint8_t> image = top_down(raster);
+
+        if (options.update) {
+            if (!write_png(options.golden + "/" + name + ".png", image, scene.width, scene.height)) {
+                return EXIT_FAILURE;
+            }
+            std::cout << name << ": updated, " << ms << " ms" << std::endl;
+            continue;
+        }
+
+        int width, height, channels;
+        unsigned char* golden = stbi_load((options.golden + "/" + name + ".png").c_str(), &width, &height, &channels, 4);
+        if (!golden || width != scene.width || height != scene.height) {
+            std::cerr << name << ": FAILED, no golden image of " << scene.width << "x" << scene.height << std::endl;
+            stbi_image_free(golden);
+            write_png(options.output + "/" + name + "_actual.png", image, scene.width, scene.height);
+            passed = false;
+            continue;
+        }
+        std::vector<uint8_t> ssimMap;
+        ImageDifference difference = compare_images(golden, image.data(), width, height, &ssimMap);
+        stbi_image_free(golden);
+
+        bool imageMatches = difference.meanSsim >= options.minSsim && difference.minBlockSsim >= options.minBlockSsim;
+        auto expected = baseline.find(pose.name);
+        bool timeMatches = options.timeTolerance <= 0.0 || expected == baseline.end() ||
+                           ms <= expected->second * options.timeTolerance;
+
+        std::cout << name << ": " << (imageMatches && timeMatches ? "passed" : "FAILED")
+                  << ", SSIM " << difference.meanSsim << " (worst block " << difference.minBlockSsim << ")"
+                  << ", max delta " << difference.maxDelta << ", " << difference.differingPixels << " pixels differ"
+                  << ", " << ms << " ms";
+        if (expected != baseline.end()) {
+            std::cout << " (stored " << expected->second << " ms)";
+        }
+        std::cout << std::endl;
+
+        if (!imageMatches) {
+            write_png(options.output + "/" + name + "_actual.png", image, width, height);
+            write_png(options.output + "/" + name + "_ssim.png", ssimMap, width, height);
+        }
+        passed = passed && imageMatches && timeMatches;
+    }
+
+    // Timings of this run next to the images, in the format of the stored ones.
+    if (!write_timings((options.update ? options.golden : options.output) + timingsName, timings)) {
+        return EXIT_FAILURE;
+    }
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
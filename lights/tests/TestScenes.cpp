@@ -0,0 +1,209 @@
+/**
+ * @file TestScenes.cpp
+ * @author Rohan Siddhu
+ * @brief The scenes of lights, camera and glLight, rebuilt for the software rasterizer.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "TestScenes.hpp"
+#include "Camera.hpp"
+#include "SceneData.hpp"
+#include <iostream>
+#include <glm/gtc/constants.hpp>
+
+static const SoftVertex* cube_vertices() {
+    return reinterpret_cast<const SoftVertex*>(cubeData);
+}
+
+static const size_t CUBE_VERTEX_COUNT = std::size(cubeData) * sizeof(float) / sizeof(SoftVertex);
+
+static const SoftTexture* load_texture(TestScene& scene, const std::string& path, bool srgb, bool flipVertically = false) {
+    scene.textures.emplace_back();
+    if (!scene.textures.back().load(path.c_str(), srgb, flipVertically)) {
+        return nullptr;
+    }
+    return &scene.textures.back();
+}
+
+static int add_unlit(TestScene& scene, glm::vec3 color) {
+    SoftMaterial material;
+    material.unlit = true;
+    material.color = color;
+    scene.materials.push_back(material);
+    return (int)scene.materials.size() - 1;
+}
+
+static glm::mat4 light_model(glm::vec3 position, float scale) {
+    return glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(scale));
+}
+
+// lights/src/Application.cpp: the ten containers, the floor, the main light and the sun, at the
+// default window size. The floor samples the image its virtual texture is built from. Four of
+// the extra point lights are on, so their loop is covered too.
+static bool load_lights(const std::string& root, TestScene& scene) {
+    const SoftTexture* container1 = load_texture(scene, root + "/lights/res/textures/container1.png", true);
+    const SoftTexture* container1Specular = load_texture(scene, root + "/lights/res/textures/container1_specular.png", false);
+    const SoftTexture* container = load_texture(scene, root + "/lights/res/textures/container.jpg", true);
+    if (!container1 || !container1Specular || !container) {
+        return false;
+    }
+    scene.materials.push_back({ container1, container1Specular, 32.0f });
+    scene.materials.push_back({ container, nullptr, 8.0f });
+    int white = add_unlit(scene, glm::vec3(1.0f));
+
+    scene.width = 324;
+    scene.height = 192;
+    for (int i = 0; i < 10; i++) {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), cubePositions[i]);
+        model = glm::rotate(model, glm::radians(20.0f * i), glm::vec3(1.0f, 0.3, 0.5));
+        scene.objects.push_back({ cube_vertices(), CUBE_VERTEX_COUNT, model, 0 });
+    }
+    scene.objects.push_back({ reinterpret_cast<const SoftVertex*>(floorData), 6, glm::mat4(1.0f), 1 });
+
+    glm::vec3 lightPos(1.0f, 0.5f, 2.0f);
+    scene.frame.lightPos = lightPos;
+    scene.frame.light.position = lightPos;
+    scene.frame.light.ambient = glm::vec3(0.2f);
+    scene.frame.light.diffuse = glm::vec3(0.5f);
+    scene.frame.light.specular = glm::vec3(1.0f);
+    scene.frame.light.constant = 1.0f;
+    scene.frame.light.linear = 0.09f;
+    scene.frame.light.quadratic = 0.032f;
+    scene.objects.push_back({ cube_vertices(), CUBE_VERTEX_COUNT, light_model(lightPos, 0.2f), white });
+
+    scene.sun = true;
+    scene.sunDirection = glm::vec3(-0.2f, -1.0f, -0.3f);
+    scene.frame.sun.ambient = glm::vec3(0.06f);
+    scene.frame.sun.diffuse = glm::vec3(0.6f);
+    scene.frame.sun.specular = glm::vec3(0.6f);
+
+    // light_range(1, 0.09, 0.032, 1 / 64) of Application.cpp, and colors spread over MAX_POINT_LIGHTS.
+    const int lightCount = 4;
+    const float range = 42.98f;
+    const float colorSlots = (float)std::size(scene.pointLights.pointLights);
+    scene.pointLights.pointLightCount = lightCount;
+    for (int i = 0; i < lightCount; i++) {
+        float angle = glm::two_pi<float>() * i / lightCount;
+        glm::vec3 position = glm::vec3(0.0f, -2.5f, -6.0f) + 6.0f * glm::vec3(std::cos(angle), 0.0f, std::sin(angle));
+        glsl::PointLight& light = scene.pointLights.pointLights[i];
+        light.viewPosition = glm::vec4(position, range);
+        light.worldPosition = glm::vec4(position, 1.0f);
+        light.color = 0.5f + 0.5f * glm::cos(glm::two_pi<float>() * ((float)i / colorSlots + glm::vec3(0.0f, 0.33f, 0.67f)));
+        light.shadowSlot = -1;
+        scene.objects.push_back({ cube_vertices(), CUBE_VERTEX_COUNT, light_model(position, 0.1f), add_unlit(scene, light.color) });
+    }
+
+    scene.poses.push_back({ "start", glm::vec3(-0.7f, 0.7f, 3.9f), -63.5f, -6.5f });
+    scene.poses.push_back({ "overview", glm::vec3(0.0f, 6.0f, 9.0f), -90.0f, -30.0f });
+    scene.poses.push_back({ "lights", glm::vec3(-9.0f, -1.0f, 4.0f), -40.0f, -12.0f });
+    return true;
+}
+
+// camera/src/Application.cpp: one container lit without attenuation, and the light cube.
+static bool load_camera(const std::string& root, TestScene& scene) {
+    const SoftTexture* diffuse = load_texture(scene, root + "/camera/res/textures/container1.png", false);
+    const SoftTexture* specular = load_texture(scene, root + "/camera/res/textures/container1_specular.png", false);
+    if (!diffuse || !specular) {
+        return false;
+    }
+    scene.materials.push_back({ diffuse, specular, 64.0f });
+    int white = add_unlit(scene, glm::vec3(1.0f));
+
+    scene.width = 320;
+    scene.height = 240;
+    glm::vec3 lightPos(1.0f, 0.5f, 2.0f);
+    scene.frame.lightPos = lightPos;
+    scene.frame.light.ambient = glm::vec3(0.2f);
+    scene.frame.light.diffuse = glm::vec3(0.5f);
+    scene.frame.light.specular = glm::vec3(1.0f);
+    scene.frame.light.constant = 1.0f;
+    scene.objects.push_back({ cube_vertices(), CUBE_VERTEX_COUNT, glm::mat4(1.0f), 0 });
+    scene.objects.push_back({ cube_vertices(), CUBE_VERTEX_COUNT, light_model(lightPos, 0.2f), white });
+
+    scene.poses.push_back({ "start", glm::vec3(0.0f, 1.0f, 3.0f), DEFAULT_YAW, DEFAULT_PITCH });
+    scene.poses.push_back({ "corner", glm::vec3(2.2f, 1.6f, 1.8f), -145.0f, -30.0f });
+    return true;
+}
+
+// glLight/src/Application.cpp: the textured cube in the first frame, with the orbiting light at
+// angle 0. Its shader lights in world space, (ambient + diffuse + 0.5 specular) times the texture
+// without attenuation, which is the same sum in view space with the texture as specular map.
+static bool load_gl_light(const std::string& root, TestScene& scene) {
+    const SoftTexture* box = load_texture(scene, root + "/glLight/res/textures/box.jpg", false, true);
+    if (!box) {
+        return false;
+    }
+    scene.materials.push_back({ box, box, 32.0f });
+    int white = add_unlit(scene, glm::vec3(1.0f));
+
+    scene.width = 320;
+    scene.height = 240;
+    scene.farPlane = 100.0f;
+    glm::vec3 lightPos(2.5f, 1.0f, 0.0f);
+    scene.frame.lightPos = lightPos;
+    scene.frame.light.ambient = glm::vec3(0.2f);
+    scene.frame.light.diffuse = glm::vec3(1.0f);
+    scene.frame.light.specular = glm::vec3(0.5f);
+    scene.frame.light.constant = 1.0f;
+    scene.objects.push_back({ cube_vertices(), CUBE_VERTEX_COUNT, glm::mat4(1.0f), 0 });
+    scene.objects.push_back({ cube_vertices(), CUBE_VERTEX_COUNT, light_model(lightPos, 0.2f), white });
+
+    scene.poses.push_back({ "start", glm::vec3(0.0f, 1.0f, 3.0f), DEFAULT_YAW, DEFAULT_PITCH });
+    scene.poses.push_back({ "light", glm::vec3(1.5f, 1.2f, 4.0f), -94.0f, -8.5f });
+    return true;
+}
+
+/**
+ * @brief Build the scene of an application.
+ *
+ * @param name "lights", "camera" or "glLight".
+ * @param root Repository root, holding the directories of the three applications.
+ * @param scene Output scene.
+ * @return bool false for an unknown name or a missing texture.
+ */
+bool load_test_scene(const std::string& name, const std::string& root, TestScene& scene) {
+    scene = {};
+    scene.name = name;
+    if (name == "lights") {
+        return load_lights(root, scene);
+    }
+    if (name == "camera") {
+        return load_camera(root, scene);
+    }
+    if (name == "glLight") {
+        return load_gl_light(root, scene);
+    }
+    std::cerr << "Failed to load test scene " << name << ", expected lights, camera or glLight" << std::endl;
+    return false;
+}
+
+/**
+ * @brief Draw a scene from one of its poses. The rasterizer must have the size of the scene.
+ *
+ * @param scene Scene to draw.
+ * @param pose Camera.
+ * @param raster Target.
+ */
+void render_test_scene(const TestScene& scene, const TestPose& pose, SoftRasterizer& raster) {
+    Camera cam(pose.position, glm::vec3(0.0f, 1.0f, 0.0f), pose.yaw, pose.pitch);
+    glsl::Frame frame = scene.frame;
+    frame.view = cam.getViewMatrix();
+    frame.projection = glm::perspective(glm::radians(cam.fov), (float)scene.width / scene.height, 0.1f, scene.farPlane);
+    frame.currentViewProjection = frame.projection * frame.view;
+    frame.previousViewProjection = frame.currentViewProjection;
+    frame.sun.direction = glm::mat3(frame.view) * glm::normalize(scene.sunDirection);
+
+    glsl::PointLights pointLights = scene.pointLights;
+    for (int i = 0; i < pointLights.pointLightCount; i++) {
+        glsl::PointLight& light = pointLights.pointLights[i];
+        light.viewPosition = glm::vec4(glm::vec3(frame.view * light.worldPosition), light.viewPosition.w);
+    }
+
+    raster.clear(glm::vec3(0.0f));
+    raster.setFrame(frame, pointLights, scene.sun);
+    for (const TestObject& object : scene.objects) {
+        raster.draw(object.vertices, object.count, object.model, scene.materials[object.material]);
+    }
+    raster.flush();
+}
@@ -0,0 +1,51 @@
+/**
+ * @file TestScenes.hpp
+ * @author Rohan Siddhu
+ * @brief The scenes of lights, camera and glLight, rebuilt for the software rasterizer.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "SoftRasterizer.hpp"
+#include <deque>
+#include <string>
+#include <vector>
+
+// Fixed camera, as Camera(position, up, yaw, pitch).
+struct TestPose {
+    std::string name;
+    glm::vec3 position;
+    float yaw;
+    float pitch;
+};
+
+struct TestObject {
+    const SoftVertex* vertices;
+    size_t count;
+    glm::mat4 model;
+    int material;
+};
+
+// Everything an application draws in its first frame, with the same textures, lights and
+// projection. Only the camera changes from pose to pose.
+struct TestScene {
+    std::string name;
+    int width = 0;
+    int height = 0;
+    float farPlane = 1000.0f;
+
+    std::deque<SoftTexture> textures;       /** Stable addresses for the materials. */
+    std::vector<SoftMaterial> materials;
+    std::vector<TestObject> objects;
+    std::vector<TestPose> poses;
+
+    glsl::Frame frame {};                   /** Main light and sun, the camera is set per pose. */
+    glsl::PointLights pointLights {};       /** World positions, moved to view space per pose. */
+    bool sun = false;
+    glm::vec3 sunDirection { 0.0f, -1.0f, 0.0f };
+};
+
+bool load_test_scene(const std::string& name, const std::string& root, TestScene& scene);
+void render_test_scene(const TestScene& scene, const TestPose& pose, SoftRasterizer& raster);
@@ -0,0 +1,174 @@
+/**
+ * @file CameraBench.cpp
+ * @author Rohan Siddhu
+ * @brief Microbenchmark of the camera matrices: the cached SSE path against the per call
+ * CUSTOM_LOOK_AT_MATRIX and glm::lookAt paths.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Camera.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Poses cycled through, so no call sees the inputs of the previous one.
+constexpr int POSE_COUNT = 1024;
+
+struct Pose {
+    glm::vec3 position;
+    float yaw;
+    float pitch;
+    float fov;
+};
+
+static void usage() {
+    std::cerr << "Usage: camerabench [--iterations N]\n"
+              << "  --iterations N  calls per path (default 2000000)" << std::endl;
+}
+
+// What a frame needs besides the view: projection, view projection, its inverse and the frustum,
+// built the way Application.cpp built them before the camera cached its matrices.
+static void scalar_matrices(const glm::mat4& view, const Pose& pose, CameraMatrices& result) {
+    result.view = view;
+    result.projection = glm::perspective(glm::radians(pose.fov), DEFAULT_ASPECT, DEFAULT_NEAR_PLANE, DEFAULT_FAR_PLANE);
+    result.viewProjection = result.projection * view;
+    result.inverseViewProjection = glm::inverse(result.viewProjection);
+    glm::mat4 m = glm::transpose(result.viewProjection);
+    for (int i = 0; i < 6; i++) {
+        glm::vec4 plane = m[3] + (i % 2 == 0 ? 1.0f : -1.0f) * m[i / 2];
+        result.frustum[i] = plane / glm::length(glm::vec3(plane));
+    }
+}
+
+static float max_difference(const glm::mat4& a, const glm::mat4& b) {
+    float difference = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            difference = std::max(difference, std::abs(a[i][j] - b[i][j]));
+        }
+    }
+    return difference;
+}
+
+// Times a path over the poses and prints nanoseconds per call. The checksum keeps the compiler
+// from dropping the work.
+template <typename Function>
+static double run(const char* name, int iterations, Function function, float& checksum) {
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        checksum += function(i % POSE_COUNT);
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    std::printf("  %-40s %8.2f ns\n", name, ns);
+    return ns;
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = 2000000;
+    int arg = 1;
+    while (arg + 1 < argc && std::strncmp(argv[arg], "--", 2) == 0) {
+        std::string option = argv[arg];
+        const char* value = argv[arg + 1];
+        if (option == "--iterations" && std::atoi(value) >= 1) {
+            iterations = std::atoi(value);
+        }
+        else {
+            usage();
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    if (arg != argc) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<Pose> poses(POSE_COUNT);
+    for (Pose& pose : poses) {
+        pose.position = glm::vec3(unit(random), unit(random), unit(random)) * 20.0f;
+        pose.yaw = unit(random) * 180.0f;
+        pose.pitch = unit(random) * 89.0f;
+        pose.fov = 30.0f + (unit(random) + 1.0f) * 7.5f;
+    }
+    std::vector<Camera> cameras(POSE_COUNT);
+    for (int i = 0; i < POSE_COUNT; i++) {
+        cameras[i].setPose(poses[i].position, poses[i].yaw, poses[i].pitch);
+        cameras[i].fov = poses[i].fov;
+    }
+
+    // The SSE path must agree with the scalar one. glm::lookAt takes the camera's up vector rather
+    // than the world's, which rounds differently close to straight up or down.
+    float viewError = 0.0f, projectionError = 0.0f, inverseError = 0.0f;
+    for (int i = 0; i < POSE_COUNT; i++) {
+        const Camera& cam = cameras[i];
+        CameraMatrices reference;
+        scalar_matrices(Camera::lookAtMatrix(cam.position, cam.front, cam.worldUp), poses[i], reference);
+        const CameraMatrices& matrices = cam.getMatrices();
+        viewError = std::max(viewError, max_difference(matrices.view, reference.view));
+        projectionError = std::max(projectionError, max_difference(matrices.projection, reference.projection));
+        inverseError = std::max(inverseError, max_difference(matrices.inverseViewProjection * matrices.viewProjection, glm::mat4(1.0f)));
+    }
+    std::printf("Largest difference to the scalar path: view %.2e, projection %.2e, inverse %.2e\n", viewError, projectionError,
+        inverseError);
+    bool agree = viewError < 1e-4f && projectionError < 1e-4f && inverseError < 1e-3f;
+
+    float checksum = 0.0f;
+    Camera moving;
+    std::printf("%d calls per path\nView matrix:\n", iterations);
+    run("CUSTOM_LOOK_AT_MATRIX", iterations, [&](int i) {
+        const Camera& cam = cameras[i];
+        return Camera::lookAtMatrix(cam.position, cam.front, cam.worldUp)[3][0];
+    }, checksum);
+    run("glm::lookAt", iterations, [&](int i) {
+        const Camera& cam = cameras[i];
+        return glm::lookAt(cam.position, cam.position + cam.front, cam.up)[3][0];
+    }, checksum);
+    run("Camera, moved every call (all of them)", iterations, [&](int i) {
+        moving.position = poses[i].position;
+        moving.front = cameras[i].front;
+        return moving.getViewMatrix()[3][0];
+    }, checksum);
+
+    std::printf("View, projection, inverse and frustum:\n");
+    CameraMatrices scalar;
+    double custom = run("CUSTOM_LOOK_AT_MATRIX + glm", iterations, [&](int i) {
+        const Camera& cam = cameras[i];
+        scalar_matrices(Camera::lookAtMatrix(cam.position, cam.front, cam.worldUp), poses[i], scalar);
+        return scalar.inverseViewProjection[3][0] + scalar.frustum[5].w;
+    }, checksum);
+    run("glm::lookAt + glm", iterations, [&](int i) {
+        const Camera& cam = cameras[i];
+        scalar_matrices(glm::lookAt(cam.position, cam.position + cam.front, cam.up), poses[i], scalar);
+        return scalar.inverseViewProjection[3][0] + scalar.frustum[5].w;
+    }, checksum);
+    double rebuilt = run("Camera, moved and zoomed every call", iterations, [&](int i) {
+        moving.position = poses[i].position;
+        moving.front = cameras[i].front;
+        moving.fov = poses[i].fov;
+        const CameraMatrices& matrices = moving.getMatrices();
+        return matrices.inverseViewProjection[3][0] + matrices.frustum[5].w;
+    }, checksum);
+    double cached = run("Camera, unchanged", iterations, [&](int i) {
+        const CameraMatrices& matrices = cameras[0].getMatrices();
+        return matrices.inverseViewProjection[3][i & 3] + matrices.frustum[5].w;
+    }, checksum);
+    std::printf("Speedup over CUSTOM_LOOK_AT_MATRIX: %.1fx rebuilt, %.1fx cached (checksum %g)\n", custom / rebuilt,
+        custom / cached, checksum);
+
+    if (!agree) {
+        std::cerr << "Failed: the camera matrices differ from the scalar path" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,450 @@
+/**
+ * @file GltfImporter.cpp
+ * @author Rohan Siddhu
+ * @brief glTF 2.0 (*.gltf and *.glb) mesh import.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Importers.hpp"
+#include "Json.hpp"
+#include "MappedFile.hpp"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+
+constexpr uint32_t GLB_MAGIC = 0x46546C67;         // "glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+constexpr int GLTF_UNSIGNED_BYTE = 5121;
+constexpr int GLTF_UNSIGNED_SHORT = 5123;
+constexpr int GLTF_UNSIGNED_INT = 5125;
+constexpr int GLTF_FLOAT = 5126;
+constexpr int GLTF_TRIANGLES = 4;
+
+struct BufferView {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+};
+
+struct Gltf {
+    JsonValue json;
+    std::vector<BufferView> buffers;
+    std::vector<std::unique_ptr<MappedFile>> files;         /** External buffers. */
+    std::vector<std::vector<unsigned char>> decoded;        /** Base64 data URIs. */
+};
+
+struct Primitive {
+    const JsonValue* primitive;
+    glm::mat4 transform;
+};
+
+std::vector<unsigned char> decode_base64(const std::string& text, size_t start) {
+    auto value = [](char c) -> int {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+') return 62;
+        if (c == '/') return 63;
+        return -1;
+    };
+
+    std::vector<unsigned char> out;
+    out.reserve((text.size() - start) * 3 / 4);
+    unsigned bits = 0;
+    int count = 0;
+    for (size_t i = start; i < text.size(); i++) {
+        int v = value(text[i]);
+        if (v < 0) {
+            continue;
+        }
+        bits = (bits << 6) | v;
+        count += 6;
+        if (count >= 8) {
+            count -= 8;
+            out.push_back((unsigned char)(bits >> count));
+        }
+    }
+    return out;
+}
+
+std::string decode_uri(const std::string& uri) {
+    std::string out;
+    for (size_t i = 0; i < uri.size(); i++) {
+        if (uri[i] == '%' && i + 2 < uri.size()) {
+            out += (char)std::stoi(uri.substr(i + 1, 2), nullptr, 16);
+            i += 2;
+        }
+        else {
+            out += uri[i];
+        }
+    }
+    return out;
+}
+
+bool load_buffers(Gltf& gltf, const std::string& directory, BufferView binChunk) {
+    const JsonValue& buffers = gltf.json["buffers"];
+    for (size_t i = 0; i < buffers.size(); i++) {
+        const JsonValue& buffer = buffers[i];
+        const JsonValue& uri = buffer["uri"];
+        BufferView view;
+
+        if (uri.isNull()) {
+            view = binChunk;
+        }
+        else if (uri.asString().compare(0, 5, "data:") == 0) {
+            size_t comma = uri.asString().find(',');
+            if (comma == std::string::npos) {
+                std::cerr << "Failed to decode glTF data URI" << std::endl;
+                return false;
+            }
+            gltf.decoded.push_back(decode_base64(uri.asString(), comma + 1));
+            view = { gltf.decoded.back().data(), gltf.decoded.back().size() };
+        }
+        else {
+            std::string file = directory + decode_uri(uri.asString());
+            auto mapped = std::make_unique<MappedFile>();
+            if (!mapped->open(file.c_str())) {
+                std::cerr << "Failed to open glTF buffer: " << file << std::endl;
+                return false;
+            }
+            view = { mapped->data(), mapped->size() };
+            gltf.files.push_back(std::move(mapped));
+        }
+
+        if (view.size < (size_t)buffer["byteLength"].asNumber()) {
+            std::cerr << "Failed to load glTF buffer " << i << ", it is truncated" << std::endl;
+            return false;
+        }
+        gltf.buffers.push_back(view);
+    }
+    return true;
+}
+
+int component_count(const std::string& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    return 0;
+}
+
+int component_size(int componentType) {
+    switch (componentType) {
+    case GLTF_UNSIGNED_BYTE: return 1;
+    case GLTF_UNSIGNED_SHORT: return 2;
+    case GLTF_UNSIGNED_INT:
+    case GLTF_FLOAT: return 4;
+    default: return 0;
+    }
+}
+
+// Locates the elements of an accessor. Returns the first element, or nullptr if the accessor
+// does not fit its buffer.
+const unsigned char* accessor_data(const Gltf& gltf, const JsonValue& accessor, size_t& count, size_t& stride) {
+    const JsonValue& view = gltf.json["bufferViews"][(size_t)accessor["bufferView"].asInt(-1)];
+    int componentSize = component_size(accessor["componentType"].asInt());
+    int components = component_count(accessor["type"].asString());
+    size_t buffer = (size_t)view["buffer"].asInt(-1);
+    if (view.isNull() || componentSize == 0 || components == 0 || buffer >= gltf.buffers.size()) {
+        return nullptr;
+    }
+
+    count = (size_t)accessor["count"].asNumber();
+    size_t elementSize = (size_t)componentSize * components;
+    stride = view["byteStride"].isNull() ? elementSize : (size_t)view["byteStride"].asNumber();
+    size_t offset = (size_t)view["byteOffset"].asNumber() + (size_t)accessor["byteOffset"].asNumber();
+    size_t length = (size_t)view["byteLength"].asNumber();
+
+    if (count == 0 || (size_t)accessor["byteOffset"].asNumber() + (count - 1) * stride + elementSize > length ||
+        offset + (count - 1) * stride + elementSize > gltf.buffers[buffer].size) {
+        return nullptr;
+    }
+    return gltf.buffers[buffer].data + offset;
+}
+
+float read_component(const unsigned char* p, int componentType, bool normalized) {
+    switch (componentType) {
+    case GLTF_FLOAT: {
+        float f;
+        std::memcpy(&f, p, sizeof(f));
+        return f;
+    }
+    case GLTF_UNSIGNED_BYTE:
+        return normalized ? *p / 255.0f : *p;
+    case GLTF_UNSIGNED_SHORT: {
+        uint16_t s;
+        std::memcpy(&s, p, sizeof(s));
+        return normalized ? s / 65535.0f : s;
+    }
+    default:
+        return 0.0f;
+    }
+}
+
+// Reads up to four float components of every element.
+bool read_attribute(const Gltf& gltf, int index, int components, std::vector<glm::vec4>& out) {
+    const JsonValue& accessor = gltf.json["accessors"][(size_t)index];
+    if (!accessor["sparse"].isNull()) {
+        std::cerr << "Failed to read glTF accessor " << index << ", sparse accessors are not supported" << std::endl;
+        return false;
+    }
+
+    size_t count, stride;
+    const unsigned char* data = accessor_data(gltf, accessor, count, stride);
+    int componentType = accessor["componentType"].asInt();
+    if (!data || component_count(accessor["type"].asString()) < components || componentType == GLTF_UNSIGNED_INT) {
+        std::cerr << "Failed to read glTF accessor " << index << std::endl;
+        return false;
+    }
+
+    int componentSize = component_size(componentType);
+    bool normalized = accessor["normalized"].boolean;
+    out.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        glm::vec4 v(0.0f);
+        for (int c = 0; c < components; c++) {
+            v[c] = read_component(data + i * stride + c * componentSize, componentType, normalized);
+        }
+        out[i] = v;
+    }
+    return true;
+}
+
+bool read_indices(const Gltf& gltf, int index, std::vector<uint32_t>& out) {
+    const JsonValue& accessor = gltf.json["accessors"][(size_t)index];
+    size_t count, stride;
+    const unsigned char* data = accessor_data(gltf, accessor, count, stride);
+    if (!data) {
+        std::cerr << "Failed to read glTF index accessor " << index << std::endl;
+        return false;
+    }
+
+    int componentType = accessor["componentType"].asInt();
+    out.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        const unsigned char* p = data + i * stride;
+        if (componentType == GLTF_UNSIGNED_BYTE) {
+            out[i] = *p;
+        }
+        else if (componentType == GLTF_UNSIGNED_SHORT) {
+            uint16_t s;
+            std::memcpy(&s, p, sizeof(s));
+            out[i] = s;
+        }
+        else {
+            std::memcpy(&out[i], p, sizeof(uint32_t));
+        }
+    }
+    return true;
+}
+
+glm::mat4 node_transform(const JsonValue& node) {
+    const JsonValue& matrix = node["matrix"];
+    if (matrix.size() == 16) {
+        glm::mat4 m;
+        for (int i = 0; i < 16; i++) {
+            glm::value_ptr(m)[i] = (float)matrix[i].asNumber();
+        }
+        return m;
+    }
+
+    const JsonValue& t = node["translation"];
+    const JsonValue& r = node["rotation"];
+    const JsonValue& s = node["scale"];
+    glm::vec3 translation(t[0].asNumber(), t[1].asNumber(), t[2].asNumber());
+    glm::quat rotation((float)r[3].asNumber(1.0), (float)r[0].asNumber(), (float)r[1].asNumber(), (float)r[2].asNumber());
+    glm::vec3 scale(s[0].asNumber(1.0), s[1].asNumber(1.0), s[2].asNumber(1.0));
+
+    glm::mat4 m = glm::mat4_cast(rotation);
+    m[0] *= scale.x;
+    m[1] *= scale.y;
+    m[2] *= scale.z;
+    m[3] = glm::vec4(translation, 1.0f);
+    return m;
+}
+
+void collect_node(const Gltf& gltf, size_t index, const glm::mat4& parent, int depth, std::vector<Primitive>& out) {
+    const JsonValue& node = gltf.json["nodes"][index];
+    if (node.isNull() || depth > 64) {
+        return;
+    }
+
+    glm::mat4 world = parent * node_transform(node);
+    const JsonValue& mesh = gltf.json["meshes"][(size_t)node["mesh"].asInt(-1)];
+    const JsonValue& primitives = mesh["primitives"];
+    for (size_t i = 0; i < primitives.size(); i++) {
+        out.push_back({ &primitives[i], world });
+    }
+
+    const JsonValue& children = node["children"];
+    for (size_t i = 0; i < children.size(); i++) {
+        collect_node(gltf, (size_t)children[i].asInt(-1), world, depth + 1, out);
+    }
+}
+
+bool import_primitive(const Gltf& gltf, const Primitive& job, MeshData& mesh) {
+    const JsonValue& primitive = *job.primitive;
+    if (primitive["mode"].asInt(GLTF_TRIANGLES) != GLTF_TRIANGLES) {
+        std::cerr << "Skipping glTF primitive, only triangle lists are supported" << std::endl;
+        return true;
+    }
+
+    const JsonValue& attributes = primitive["attributes"];
+    std::vector<glm::vec4> positions, normals, uvs;
+    if (!read_attribute(gltf, attributes["POSITION"].asInt(-1), 3, positions)) {
+        return false;
+    }
+    if (!attributes["NORMAL"].isNull() && !read_attribute(gltf, attributes["NORMAL"].asInt(), 3, normals)) {
+        return false;
+    }
+    if (!attributes["TEXCOORD_0"].isNull() && !read_attribute(gltf, attributes["TEXCOORD_0"].asInt(), 2, uvs)) {
+        return false;
+    }
+
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(job.transform)));
+    mesh.vertices.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        MeshVertex& v = mesh.vertices[i];
+        v.position = glm::vec3(job.transform * glm::vec4(glm::vec3(positions[i]), 1.0f));
+        v.normal = i < normals.size() ? glm::normalize(normalMatrix * glm::vec3(normals[i])) : glm::vec3(0.0f);
+        v.uv = i < uvs.size() ? glm::vec2(uvs[i]) : glm::vec2(0.0f);
+    }
+
+    if (primitive["indices"].isNull()) {
+        mesh.indices.resize(positions.size() / 3 * 3);
+        for (size_t i = 0; i < mesh.indices.size(); i++) {
+            mesh.indices[i] = (uint32_t)i;
+        }
+    }
+    else if (!read_indices(gltf, primitive["indices"].asInt(), mesh.indices)) {
+        return false;
+    }
+
+    mesh.indices.resize(mesh.indices.size() / 3 * 3);
+    for (uint32_t index : mesh.indices) {
+        if (index >= mesh.vertices.size()) {
+            std::cerr << "Failed to import glTF primitive, index out of range" << std::endl;
+            return false;
+        }
+    }
+
+    // Mirroring transforms flip the winding.
+    if (glm::determinant(glm::mat3(job.transform)) < 0.0f) {
+        for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+            std::swap(mesh.indices[i + 1], mesh.indices[i + 2]);
+        }
+    }
+    return true;
+}
+
+}
+
+
+/**
+ * @brief Import the default scene of a glTF 2.0 file, text or binary. Every triangle primitive
+ * is flattened into one mesh with its node transforms applied. Primitives are read in parallel.
+ * Positions, normals and the first texture coordinate set are used, materials are ignored.
+ *
+ * @param path Path to a *.gltf or *.glb file.
+ * @param mesh Receives the mesh.
+ * @param pool Threads to read primitives on.
+ * @return bool true on success.
+ */
+bool import_gltf(const char* path, MeshData& mesh, ThreadPool& pool) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Failed to open glTF file: " << path << std::endl;
+        return false;
+    }
+
+    const char* json = (const char*)file.data();
+    size_t jsonLength = file.size();
+    BufferView binChunk;
+
+    uint32_t magic = 0;
+    if (file.size() >= 12) {
+        std::memcpy(&magic, file.data(), sizeof(magic));
+    }
+    if (magic == GLB_MAGIC) {
+        json = nullptr;
+        size_t offset = 12;
+        while (offset + 8 <= file.size()) {
+            uint32_t chunk[2];
+            std::memcpy(chunk, file.data() + offset, sizeof(chunk));
+            const unsigned char* data = file.data() + offset + 8;
+            if (offset + 8 + chunk[0] > file.size()) {
+                break;
+            }
+            if (chunk[1] == GLB_CHUNK_JSON && !json) {
+                json = (const char*)data;
+                jsonLength = chunk[0];
+            }
+            else if (chunk[1] == GLB_CHUNK_BIN && !binChunk.data) {
+                binChunk = { data, chunk[0] };
+            }
+            offset += 8 + ((chunk[0] + 3) & ~3u);
+        }
+        if (!json) {
+            std::cerr << "Failed to find the JSON chunk of " << path << std::endl;
+            return false;
+        }
+    }
+
+    Gltf gltf;
+    if (!parse_json(json, jsonLength, gltf.json)) {
+        std::cerr << "Failed to parse glTF file: " << path << std::endl;
+        return false;
+    }
+
+    std::string directory = path;
+    size_t slash = directory.find_last_of("/\\");
+    directory = slash == std::string::npos ? "" : directory.substr(0, slash + 1);
+    if (!load_buffers(gltf, directory, binChunk)) {
+        return false;
+    }
+
+    std::vector<Primitive> jobs;
+    const JsonValue& scene = gltf.json["scenes"][(size_t)gltf.json["scene"].asInt(0)];
+    if (!scene.isNull()) {
+        const JsonValue& roots = scene["nodes"];
+        for (size_t i = 0; i < roots.size(); i++) {
+            collect_node(gltf, (size_t)roots[i].asInt(-1), glm::mat4(1.0f), 0, jobs);
+        }
+    }
+    else {
+        const JsonValue& meshes = gltf.json["meshes"];
+        for (size_t m = 0; m < meshes.size(); m++) {
+            const JsonValue& primitives = meshes[m]["primitives"];
+            for (size_t i = 0; i < primitives.size(); i++) {
+                jobs.push_back({ &primitives[i], glm::mat4(1.0f) });
+            }
+        }
+    }
+
+    std::vector<MeshData> parts(jobs.size());
+    std::vector<char> ok(jobs.size(), 0);
+    pool.parallelFor((int)jobs.size(), [&](int i) {
+        ok[i] = import_primitive(gltf, jobs[i], parts[i]);
+    });
+
+    mesh.vertices.clear();
+    mesh.indices.clear();
+    for (size_t i = 0; i < parts.size(); i++) {
+        if (!ok[i]) {
+            return false;
+        }
+        uint32_t base = (uint32_t)mesh.vertices.size();
+        mesh.vertices.insert(mesh.vertices.end(), parts[i].vertices.begin(), parts[i].vertices.end());
+        for (uint32_t index : parts[i].indices) {
+            mesh.indices.push_back(base + index);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,17 @@
+/**
+ * @file Importers.hpp
+ * @author Rohan Siddhu
+ * @brief Source formats understood by meshimport.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "MeshFile.hpp"
+#include "ThreadPool.hpp"
+
+bool import_obj(const char* path, MeshData& mesh, ThreadPool& pool);
+bool import_gltf(const char* path, MeshData& mesh, ThreadPool& pool);
+
+void generate_missing_normals(MeshData& mesh);
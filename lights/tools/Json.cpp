@@ -0,0 +1,266 @@
+/**
+ * @file Json.cpp
+ * @author Rohan Siddhu
+ * @brief Recursive descent JSON parser.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Json.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+static const JsonValue null_value;
+
+const JsonValue& JsonValue::operator[](const char* key) const {
+    if (type == OBJECT) {
+        for (const auto& member : object) {
+            if (member.first == key) {
+                return member.second;
+            }
+        }
+    }
+    return null_value;
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const {
+    if (type == ARRAY && index < array.size()) {
+        return array[index];
+    }
+    return null_value;
+}
+
+
+namespace {
+
+struct JsonParser {
+    const char* p;
+    const char* end;
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+            p++;
+        }
+    }
+
+    bool expect(const char* word) {
+        size_t n = std::strlen(word);
+        if ((size_t)(end - p) < n || std::memcmp(p, word, n) != 0) {
+            return false;
+        }
+        p += n;
+        return true;
+    }
+
+    // Appends a code point as UTF-8.
+    static void appendUtf8(std::string& out, unsigned code) {
+        if (code < 0x80) {
+            out += (char)code;
+        }
+        else if (code < 0x800) {
+            out += (char)(0xC0 | (code >> 6));
+            out += (char)(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000) {
+            out += (char)(0xE0 | (code >> 12));
+            out += (char)(0x80 | ((code >> 6) & 0x3F));
+            out += (char)(0x80 | (code & 0x3F));
+        }
+        else {
+            out += (char)(0xF0 | (code >> 18));
+            out += (char)(0x80 | ((code >> 12) & 0x3F));
+            out += (char)(0x80 | ((code >> 6) & 0x3F));
+            out += (char)(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parseHex4(unsigned& code) {
+        if (end - p < 4) {
+            return false;
+        }
+        code = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = *p++;
+            code <<= 4;
+            if (c >= '0' && c <= '9') code |= c - '0';
+            else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        p++;    // opening quote
+        while (p < end && *p != '"') {
+            char c = *p++;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (p >= end) {
+                return false;
+            }
+            char e = *p++;
+            switch (e) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                unsigned code;
+                if (!parseHex4(code)) {
+                    return false;
+                }
+                // Surrogate pair
+                if (code >= 0xD800 && code < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                    p += 2;
+                    unsigned low;
+                    if (!parseHex4(low)) {
+                        return false;
+                    }
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, code);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        if (p >= end) {
+            return false;
+        }
+        p++;    // closing quote
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, int depth) {
+        if (depth > 64) {
+            return false;
+        }
+
+        skipSpace();
+        if (p >= end) {
+            return false;
+        }
+
+        switch (*p) {
+        case '{': {
+            value.type = JsonValue::OBJECT;
+            p++;
+            skipSpace();
+            if (p < end && *p == '}') {
+                p++;
+                return true;
+            }
+            while (true) {
+                skipSpace();
+                if (p >= end || *p != '"') {
+                    return false;
+                }
+                value.object.emplace_back();
+                if (!parseString(value.object.back().first)) {
+                    return false;
+                }
+                skipSpace();
+                if (p >= end || *p++ != ':') {
+                    return false;
+                }
+                if (!parseValue(value.object.back().second, depth + 1)) {
+                    return false;
+                }
+                skipSpace();
+                if (p < end && *p == ',') {
+                    p++;
+                    continue;
+                }
+                if (p < end && *p == '}') {
+                    p++;
+                    return true;
+                }
+                return false;
+            }
+        }
+        case '[': {
+            value.type = JsonValue::ARRAY;
+            p++;
+            skipSpace();
+            if (p < end && *p == ']') {
+                p++;
+                return true;
+            }
+            while (true) {
+                value.array.emplace_back();
+                if (!parseValue(value.array.back(), depth + 1)) {
+                    return false;
+                }
+                skipSpace();
+                if (p < end && *p == ',') {
+                    p++;
+                    continue;
+                }
+                if (p < end && *p == ']') {
+                    p++;
+                    return true;
+                }
+                return false;
+            }
+        }
+        case '"':
+            value.type = JsonValue::STRING;
+            return parseString(value.string);
+        case 't':
+            value.type = JsonValue::BOOLEAN;
+            value.boolean = true;
+            return expect("true");
+        case 'f':
+            value.type = JsonValue::BOOLEAN;
+            return expect("false");
+        case 'n':
+            return expect("null");
+        default: {
+            // strtod needs a terminated string, numbers are short so copy them out.
+            char buffer[64];
+            size_t n = 0;
+            while (p + n < end && n < sizeof(buffer) - 1 && p[n] != '\0' && std::strchr("+-0123456789.eE", p[n])) {
+                n++;
+            }
+            if (n == 0) {
+                return false;
+            }
+            std::memcpy(buffer, p, n);
+            buffer[n] = '\0';
+            value.type = JsonValue::NUMBER;
+            value.number = std::strtod(buffer, nullptr);
+            p += n;
+            return true;
+        }
+        }
+    }
+};
+
+}
+
+
+/**
+ * @brief Parse a JSON document.
+ *
+ * @param text Document text, does not need to be null terminated.
+ * @param length Length of the text in bytes.
+ * @param root Receives the document.
+ * @return bool true on success.
+ */
+bool parse_json(const char* text, size_t length, JsonValue& root) {
+    JsonParser parser { text, text + length };
+    if (!parser.parseValue(root, 0)) {
+        std::cerr << "Failed to parse JSON at offset " << (parser.p - text) << std::endl;
+        return false;
+    }
+    return true;
+}
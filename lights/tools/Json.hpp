@@ -0,0 +1,39 @@
+/**
+ * @file Json.hpp
+ * @author Rohan Siddhu
+ * @brief Minimal JSON reader, enough for glTF.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+class JsonValue {
+public:
+    enum Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+    Type type = NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    // Missing members and out of range elements return a null value, so lookups can be chained.
+    const JsonValue& operator[](const char* key) const;
+    const JsonValue& operator[](size_t index) const;
+    const JsonValue& operator[](int index) const { return (*this)[(size_t)index]; }
+
+    bool isNull() const { return type == NUL; }
+    size_t size() const { return type == ARRAY ? array.size() : object.size(); }
+    int asInt(int fallback = 0) const { return type == NUMBER ? (int)number : fallback; }
+    double asNumber(double fallback = 0.0) const { return type == NUMBER ? number : fallback; }
+    const std::string& asString() const { return string; }
+};
+
+bool parse_json(const char* text, size_t length, JsonValue& root);
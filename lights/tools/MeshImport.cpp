@@ -0,0 +1,248 @@
+/**
+ * @file MeshImport.cpp
+ * @author Rohan Siddhu
+ * @brief Offline converter from OBJ / glTF to the binary mesh format.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Importers.hpp"
+#include "MappedFile.hpp"
+#include "Meshlets.hpp"
+#include "Simplifier.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+using Clock = std::chrono::steady_clock;
+
+static double milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool has_extension(const std::string& path, const char* extension) {
+    size_t n = std::strlen(extension);
+    if (path.size() < n) {
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (std::tolower((unsigned char)path[path.size() - n + i]) != extension[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Give vertices without a normal the area weighted average of the faces around their
+ * position. Vertices are matched by position, so seams in the texture coordinates stay smooth.
+ *
+ * @param mesh Mesh with zero normals where the source had none.
+ */
+void generate_missing_normals(MeshData& mesh) {
+    bool missing = false;
+    for (const MeshVertex& v : mesh.vertices) {
+        missing |= v.normal == glm::vec3(0.0f);
+    }
+    if (!missing) {
+        return;
+    }
+
+    struct PositionHash {
+        size_t operator()(const glm::vec3& p) const {
+            uint32_t bits[3];
+            std::memcpy(bits, &p, sizeof(bits));
+            return bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u;
+        }
+    };
+    std::unordered_map<glm::vec3, glm::vec3, PositionHash> sums;
+    sums.reserve(mesh.vertices.size());
+
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        glm::vec3 a = mesh.vertices[mesh.indices[i]].position;
+        glm::vec3 b = mesh.vertices[mesh.indices[i + 1]].position;
+        glm::vec3 c = mesh.vertices[mesh.indices[i + 2]].position;
+        glm::vec3 n = glm::cross(b - a, c - a);
+        sums[a] += n;
+        sums[b] += n;
+        sums[c] += n;
+    }
+
+    for (MeshVertex& v : mesh.vertices) {
+        if (v.normal == glm::vec3(0.0f)) {
+            glm::vec3 sum = sums[v.position];
+            v.normal = glm::dot(sum, sum) > 0.0f ? glm::normalize(sum) : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    }
+}
+
+// Largest position error and normal deviation (degrees) the stored format introduces.
+static void report_precision(const MeshData& mesh, const char* path) {
+    MappedFile file;
+    MeshHeader header;
+    if (!file.open(path) || !read_mesh_header(file.data(), file.size(), header)) {
+        return;
+    }
+
+    float positionError = 0.0f;
+    float normalError = 0.0f;
+    for (uint32_t i = 0; i < header.vertexCount; i++) {
+        MeshVertex v = decode_mesh_vertex(header, file.data() + header.vertexOffset, i);
+        positionError = std::max(positionError, glm::length(v.position - mesh.vertices[i].position));
+        float c = glm::dot(v.normal, glm::normalize(mesh.vertices[i].normal));
+        normalError = std::max(normalError, glm::degrees(std::acos(std::min(c, 1.0f))));
+    }
+    std::cout << "  max error: position " << positionError << ", normal " << normalError << " deg" << std::endl;
+}
+
+/**
+ * @brief Append simplified levels of detail to the index stream, each with about half the
+ * triangles of the previous one. The chain ends early when the simplifier gets stuck.
+ *
+ * @param mesh Mesh whose indices are the full detail level.
+ * @param count Number of levels including the full detail one.
+ */
+static void build_lods(MeshData& mesh, int count) {
+    uint32_t fullCount = (uint32_t)mesh.indices.size();
+    mesh.lods = { { 0, fullCount, 0.0f, 0 } };
+
+    Simplifier simplifier(mesh);
+    std::vector<uint32_t> chain;
+    for (int level = 1; level < count; level++) {
+        size_t previous = mesh.lods.back().indexCount;
+        size_t target = previous / 2 / 3 * 3;
+        if (target < 3 * 32) {
+            break;
+        }
+
+        const std::vector<uint32_t>& indices = simplifier.simplify(target);
+        if (indices.size() > previous * 9 / 10) {
+            break;
+        }
+        mesh.lods.push_back({ fullCount + (uint32_t)chain.size(), (uint32_t)indices.size(), simplifier.error(), 0 });
+        chain.insert(chain.end(), indices.begin(), indices.end());
+    }
+    mesh.indices.insert(mesh.indices.end(), chain.begin(), chain.end());
+}
+
+static void usage() {
+    std::cerr << "Usage: meshimport [--vertex float|octahedral|packed] [--lods N] <input.obj|input.gltf|input.glb> <output.mesh>\n"
+              << "  --vertex float       32 bytes per vertex (default)\n"
+              << "  --vertex octahedral  16 bytes: unorm16 position, octahedral snorm16 normal, half uv\n"
+              << "  --vertex packed      16 bytes: unorm16 position, 2_10_10_10 normal, half uv\n"
+              << "  --lods N             levels of detail including full detail, 1 to " << MESH_MAX_LODS << " (default 4)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    MeshVertexFormat format = MESH_VERTEX_FLOAT;
+    int lodCount = 4;
+    int arg = 1;
+    while (arg + 1 < argc && std::strncmp(argv[arg], "--", 2) == 0) {
+        std::string option = argv[arg];
+        std::string value = argv[arg + 1];
+        if (option == "--vertex" && value == "float") {
+            format = MESH_VERTEX_FLOAT;
+        }
+        else if (option == "--vertex" && value == "octahedral") {
+            format = MESH_VERTEX_OCTAHEDRAL;
+        }
+        else if (option == "--vertex" && value == "packed") {
+            format = MESH_VERTEX_PACKED;
+        }
+        else if (option == "--lods" && std::atoi(value.c_str()) >= 1 && std::atoi(value.c_str()) <= (int)MESH_MAX_LODS) {
+            lodCount = std::atoi(value.c_str());
+        }
+        else {
+            usage();
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    if (argc - arg != 2) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    std::string input = argv[arg];
+    const char* output = argv[arg + 1];
+    ThreadPool pool;
+    MeshData mesh;
+
+    auto start = Clock::now();
+    bool imported = false;
+    if (has_extension(input, ".obj")) {
+        imported = import_obj(input.c_str(), mesh, pool);
+    }
+    else if (has_extension(input, ".gltf") || has_extension(input, ".glb")) {
+        imported = import_gltf(input.c_str(), mesh, pool);
+    }
+    else {
+        std::cerr << "Failed to import " << input << ", unknown file type" << std::endl;
+    }
+    if (!imported) {
+        return EXIT_FAILURE;
+    }
+    generate_missing_normals(mesh);
+    double importTime = milliseconds(start);
+
+    if (mesh.indices.empty()) {
+        std::cerr << "Failed to import " << input << ", it has no triangles" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    size_t triangleCount = mesh.indices.size() / 3;
+    start = Clock::now();
+    build_lods(mesh, lodCount);
+    double simplifyTime = milliseconds(start);
+
+    start = Clock::now();
+    build_meshlets(mesh, pool);
+    double meshletTime = milliseconds(start);
+
+    if (!write_mesh_file(output, mesh, format)) {
+        return EXIT_FAILURE;
+    }
+
+    // What the runtime pays instead: map the file and touch every page once, as the upload does.
+    start = Clock::now();
+    MappedFile file;
+    MeshHeader header;
+    if (!file.open(output) || !read_mesh_header(file.data(), file.size(), header)) {
+        std::cerr << "Failed to read back " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::vector<unsigned char> copy(file.data(), file.data() + file.size());
+    double loadTime = milliseconds(start);
+
+    std::cout << input << ": " << mesh.vertices.size() << " vertices, " << triangleCount << " triangles\n"
+              << "  import " << importTime << " ms on " << pool.size() << " threads\n"
+              << "  load   " << loadTime << " ms (" << copy.size() / 1024 << " KB mapped)\n"
+              << "  lods   " << simplifyTime << " ms\n"
+              << "  meshlets " << meshletTime << " ms" << std::endl;
+    const MeshMeshlet* meshlet = mesh.meshlets.data();
+    for (size_t i = 0; i < mesh.lods.size(); i++) {
+        uint32_t vertices = 0;
+        for (uint32_t m = 0; m < mesh.lods[i].meshletCount; m++, meshlet++) {
+            vertices += meshlet->vertexCount;
+        }
+        uint32_t count = std::max(mesh.lods[i].meshletCount, 1u);
+        std::cout << "    lod " << i << ": " << mesh.lods[i].indexCount / 3 << " triangles, error " << mesh.lods[i].error
+                  << ", " << mesh.lods[i].meshletCount << " meshlets (" << mesh.lods[i].indexCount / 3.0f / count
+                  << " triangles, " << (float)vertices / count << " vertices each)" << std::endl;
+    }
+
+    uint32_t stride = mesh_vertex_stride(format);
+    std::cout << "  vertex stream " << stride << " bytes per vertex, " << (size_t)stride * mesh.vertices.size() / 1024
+              << " KB (float: " << sizeof(MeshVertex) * mesh.vertices.size() / 1024 << " KB, "
+              << 100 - 100 * stride / sizeof(MeshVertex) << "% saved)" << std::endl;
+    if (format != MESH_VERTEX_FLOAT) {
+        report_precision(mesh, output);
+    }
+    return EXIT_SUCCESS;
+}
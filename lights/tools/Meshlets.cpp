@@ -0,0 +1,246 @@
+/**
+ * @file Meshlets.cpp
+ * @author Rohan Siddhu
+ * @brief Greedy meshlet builder with bounding spheres and normal cones.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Meshlets.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Meshlet under construction.
+struct MeshletBuilder {
+    std::vector<uint32_t> vertices;     /** Unique vertices, at most MESHLET_MAX_VERTICES. */
+    std::vector<uint32_t> triangles;    /** Triangle numbers within the level. */
+    glm::vec3 centroidSum = glm::vec3(0.0f);
+};
+
+// Bounding sphere around the AABB centre and the normal cone of a finished meshlet. The cone test
+// (see csMeshletCull.glsl) culls a meshlet whose every triangle faces away from the camera: with
+// all normals within acos(minDot) of the axis, that holds when the view direction is within
+// 90 degrees - acos(minDot) of the axis, a cosine of sqrt(1 - minDot^2).
+static MeshMeshlet meshlet_bounds(const MeshData& mesh, const uint32_t* indices, const MeshletBuilder& meshlet) {
+    glm::vec3 lo(INFINITY), hi(-INFINITY);
+    for (uint32_t v : meshlet.vertices) {
+        lo = glm::min(lo, mesh.vertices[v].position);
+        hi = glm::max(hi, mesh.vertices[v].position);
+    }
+    glm::vec3 center = (lo + hi) * 0.5f;
+    float radius = 0.0f;
+    for (uint32_t v : meshlet.vertices) {
+        radius = std::max(radius, glm::length(mesh.vertices[v].position - center));
+    }
+
+    std::vector<glm::vec3> normals;
+    normals.reserve(meshlet.triangles.size());
+    glm::vec3 axis(0.0f);
+    for (uint32_t t : meshlet.triangles) {
+        glm::vec3 p0 = mesh.vertices[indices[t * 3]].position;
+        glm::vec3 p1 = mesh.vertices[indices[t * 3 + 1]].position;
+        glm::vec3 p2 = mesh.vertices[indices[t * 3 + 2]].position;
+        glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        float length = glm::length(n);
+        if (length > 0.0f) {
+            normals.push_back(n / length);
+            axis += n / length;
+        }
+    }
+
+    float cutoff = 1.0f;
+    if (glm::dot(axis, axis) > 0.0f) {
+        axis = glm::normalize(axis);
+        float minDot = 1.0f;
+        for (const glm::vec3& n : normals) {
+            minDot = std::min(minDot, glm::dot(n, axis));
+        }
+        // Cones wider than about 85 degrees would almost never be culled.
+        if (minDot > 0.1f) {
+            cutoff = std::sqrt(1.0f - minDot * minDot);
+        }
+    }
+
+    MeshMeshlet result {};
+    std::memcpy(result.center, &center, sizeof(result.center));
+    result.radius = radius;
+    std::memcpy(result.coneAxis, &axis, sizeof(result.coneAxis));
+    result.coneCutoff = cutoff;
+    result.vertexCount = (uint32_t)meshlet.vertices.size();
+    return result;
+}
+
+/**
+ * @brief Split one level into meshlets and reorder its triangles so that every meshlet is a
+ * contiguous index range. A meshlet grows from a seed triangle by repeatedly taking the
+ * neighbouring triangle that adds the fewest new vertices, ties broken first by how few unused
+ * triangles are left around its vertices, then by distance to the meshlet's centre, which keeps
+ * meshlets full and compact and their bounds tight.
+ *
+ * @param mesh Mesh, the level's range of mesh.indices is reordered in place.
+ * @param lod Level to split.
+ * @return std::vector<MeshMeshlet> Meshlets in index order.
+ */
+static std::vector<MeshMeshlet> build_level(MeshData& mesh, const MeshLod& lod) {
+    uint32_t* indices = mesh.indices.data() + lod.firstIndex;
+    uint32_t triangleCount = lod.indexCount / 3;
+    size_t vertexCount = mesh.vertices.size();
+
+    // Triangles around every vertex.
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t i = 0; i < triangleCount * 3; i++) {
+        offsets[indices[i] + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (uint32_t i = 0; i < triangleCount * 3; i++) {
+        adjacency[fill[indices[i]]++] = i / 3;
+    }
+
+    std::vector<glm::vec3> centroids(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        centroids[t] = (mesh.vertices[indices[t * 3]].position + mesh.vertices[indices[t * 3 + 1]].position +
+            mesh.vertices[indices[t * 3 + 2]].position) / 3.0f;
+    }
+
+    // Unused triangles around every vertex. Preferring triangles whose vertices have few left
+    // finishes regions off instead of leaving slivers behind that become tiny meshlets.
+    std::vector<uint32_t> live(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        live[v] = offsets[v + 1] - offsets[v];
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> owner(vertexCount, UINT32_MAX);  // Meshlet a vertex was last added to.
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> reordered;
+    reordered.reserve(triangleCount * 3);
+    std::vector<MeshMeshlet> meshlets;
+    uint32_t nextSeed = 0;
+    uint32_t remaining = triangleCount;
+
+    MeshletBuilder meshlet;
+    auto add_triangle = [&](uint32_t t) {
+        emitted[t] = true;
+        remaining--;
+        meshlet.triangles.push_back(t);
+        meshlet.centroidSum += centroids[t];
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = indices[t * 3 + k];
+            live[v]--;
+            if (owner[v] != meshlets.size()) {
+                owner[v] = (uint32_t)meshlets.size();
+                meshlet.vertices.push_back(v);
+                for (uint32_t a = offsets[v]; a < offsets[v + 1]; a++) {
+                    if (!emitted[adjacency[a]]) {
+                        candidates.push_back(adjacency[a]);
+                    }
+                }
+            }
+        }
+    };
+
+    while (remaining > 0) {
+        // Seed with the unused neighbour closest to the previous meshlet, if there is one.
+        uint32_t seed = UINT32_MAX;
+        float seedDistance = INFINITY;
+        glm::vec3 previousCenter = meshlet.triangles.empty() ? glm::vec3(0.0f)
+            : meshlet.centroidSum / (float)meshlet.triangles.size();
+        for (uint32_t t : candidates) {
+            float d = glm::dot(centroids[t] - previousCenter, centroids[t] - previousCenter);
+            if (!emitted[t] && d < seedDistance) {
+                seed = t;
+                seedDistance = d;
+            }
+        }
+        if (seed == UINT32_MAX) {
+            while (emitted[nextSeed]) {
+                nextSeed++;
+            }
+            seed = nextSeed;
+        }
+
+        meshlet = MeshletBuilder {};
+        candidates.clear();
+        add_triangle(seed);
+
+        while (meshlet.triangles.size() < MESHLET_MAX_TRIANGLES) {
+            glm::vec3 center = meshlet.centroidSum / (float)meshlet.triangles.size();
+            uint32_t best = UINT32_MAX;
+            int bestNew = 4;
+            uint32_t bestLive = UINT32_MAX;
+            float bestDistance = INFINITY;
+
+            size_t kept = 0;
+            for (uint32_t t : candidates) {
+                if (emitted[t]) {
+                    continue;
+                }
+                candidates[kept++] = t;
+
+                int added = 0;
+                for (int k = 0; k < 3; k++) {
+                    added += owner[indices[t * 3 + k]] != meshlets.size();
+                }
+                if (meshlet.vertices.size() + added > MESHLET_MAX_VERTICES) {
+                    continue;
+                }
+                uint32_t remainingAround = live[indices[t * 3]] + live[indices[t * 3 + 1]] + live[indices[t * 3 + 2]];
+                float d = glm::dot(centroids[t] - center, centroids[t] - center);
+                if (added < bestNew || (added == bestNew && (remainingAround < bestLive ||
+                    (remainingAround == bestLive && d < bestDistance)))) {
+                    best = t;
+                    bestNew = added;
+                    bestLive = remainingAround;
+                    bestDistance = d;
+                }
+            }
+            candidates.resize(kept);
+
+            if (best == UINT32_MAX) {
+                break;
+            }
+            add_triangle(best);
+        }
+
+        MeshMeshlet bounds = meshlet_bounds(mesh, indices, meshlet);
+        bounds.firstIndex = lod.firstIndex + (uint32_t)reordered.size();
+        bounds.indexCount = (uint32_t)meshlet.triangles.size() * 3;
+        for (uint32_t t : meshlet.triangles) {
+            reordered.insert(reordered.end(), indices + t * 3, indices + t * 3 + 3);
+        }
+        meshlets.push_back(bounds);
+    }
+
+    std::copy(reordered.begin(), reordered.end(), indices);
+    return meshlets;
+}
+
+/**
+ * @brief Build the meshlets of every level of detail. Triangles are reordered within their
+ * level, so the LOD table stays valid, and the meshlets of a level follow those of the finer
+ * levels. Levels are split in parallel.
+ *
+ * @param mesh Mesh with its LOD table filled in, or a single level.
+ * @param pool Worker threads.
+ */
+void build_meshlets(MeshData& mesh, ThreadPool& pool) {
+    if (mesh.lods.empty()) {
+        mesh.lods = { { 0, (uint32_t)mesh.indices.size(), 0.0f, 0 } };
+    }
+
+    std::vector<std::vector<MeshMeshlet>> levels(mesh.lods.size());
+    pool.parallelFor((int)levels.size(), [&](int level) {
+        levels[level] = build_level(mesh, mesh.lods[level]);
+    });
+
+    mesh.meshlets.clear();
+    for (size_t level = 0; level < levels.size(); level++) {
+        mesh.lods[level].meshletCount = (uint32_t)levels[level].size();
+        mesh.meshlets.insert(mesh.meshlets.end(), levels[level].begin(), levels[level].end());
+    }
+}
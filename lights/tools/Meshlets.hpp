@@ -0,0 +1,14 @@
+/**
+ * @file Meshlets.hpp
+ * @author Rohan Siddhu
+ * @brief Splits the levels of detail of a mesh into meshlets for GPU culling.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "MeshFile.hpp"
+#include "ThreadPool.hpp"
+
+void build_meshlets(MeshData& mesh, ThreadPool& pool);
@@ -0,0 +1,343 @@
+/**
+ * @file ObjImporter.cpp
+ * @author Rohan Siddhu
+ * @brief Multithreaded Wavefront OBJ parser.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Importers.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+constexpr int OBJ_MISSING = INT_MIN;
+
+// Relative (negative) indices can only be resolved once the element counts of the earlier
+// chunks are known, the flags mark which ones still need the chunk's base added.
+enum : unsigned char {
+    RELATIVE_POSITION = 1,
+    RELATIVE_UV = 2,
+    RELATIVE_NORMAL = 4
+};
+
+struct ObjCorner {
+    int v, t, n;
+    unsigned char relative;
+};
+
+struct ObjChunk {
+    const char* begin;
+    const char* end;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec2> uvs;
+    std::vector<ObjCorner> corners;     /** Three per triangle. */
+    bool failed = false;
+};
+
+const char* skip_space(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    return p;
+}
+
+const char* skip_line(const char* p, const char* end) {
+    const char* newline = (const char*)std::memchr(p, '\n', end - p);
+    return newline ? newline + 1 : end;
+}
+
+// strtof is locale aware and needs a terminated string, this reads the plain decimal and
+// exponent notation OBJ exporters write without either.
+const char* parse_float(const char* p, const char* end, float& out) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    p = skip_space(p, end);
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    const char* start = p;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (digits < 18) {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += mantissa != 0;
+        }
+        else {
+            exponent++;
+        }
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (digits < 18) {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += mantissa != 0;
+                exponent--;
+            }
+            p++;
+        }
+    }
+    if (p == start) {
+        out = 0.0f;
+        return p;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            p++;
+        }
+        int e = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            e = std::min(e * 10 + (*p - '0'), 1000);
+            p++;
+        }
+        exponent += negativeExponent ? -e : e;
+    }
+
+    double value = (double)mantissa;
+    while (exponent > 22) {
+        value *= 1e22;
+        exponent -= 22;
+    }
+    while (exponent < -22) {
+        value /= 1e22;
+        exponent += 22;
+    }
+    value = exponent >= 0 ? value * powers[exponent] : value / powers[-exponent];
+
+    out = (float)(negative ? -value : value);
+    return p;
+}
+
+const char* parse_index(const char* p, const char* end, int& out) {
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        p++;
+    }
+    const char* start = p;
+    int value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        p++;
+    }
+    out = p == start ? OBJ_MISSING : (negative ? -value : value);
+    return p;
+}
+
+// Turns a 1 based or negative OBJ index into a 0 based one. Negative indices count back from
+// the elements seen so far in this chunk and are finished in resolve_chunk.
+int local_index(int index, size_t seen, unsigned char flag, unsigned char& relative) {
+    if (index == OBJ_MISSING || index == 0) {
+        return OBJ_MISSING;
+    }
+    if (index < 0) {
+        relative |= flag;
+        return (int)seen + index;
+    }
+    return index - 1;
+}
+
+void parse_chunk(ObjChunk& chunk) {
+    std::vector<ObjCorner> face;
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+
+    while (p < end) {
+        p = skip_space(p, end);
+        if (p + 1 >= end) {
+            break;
+        }
+
+        if (p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
+            glm::vec3 v;
+            p = parse_float(p + 1, end, v.x);
+            p = parse_float(p, end, v.y);
+            p = parse_float(p, end, v.z);
+            chunk.positions.push_back(v);
+        }
+        else if (p[0] == 'v' && p[1] == 't') {
+            glm::vec2 t;
+            p = parse_float(p + 2, end, t.x);
+            p = parse_float(p, end, t.y);
+            chunk.uvs.push_back(t);
+        }
+        else if (p[0] == 'v' && p[1] == 'n') {
+            glm::vec3 n;
+            p = parse_float(p + 2, end, n.x);
+            p = parse_float(p, end, n.y);
+            p = parse_float(p, end, n.z);
+            chunk.normals.push_back(n);
+        }
+        else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            face.clear();
+            p = skip_space(p + 1, end);
+            while (p < end && *p != '\n' && *p != '\r') {
+                int v, t = OBJ_MISSING, n = OBJ_MISSING;
+                p = parse_index(p, end, v);
+                if (p < end && *p == '/') {
+                    p = parse_index(p + 1, end, t);
+                    if (p < end && *p == '/') {
+                        p = parse_index(p + 1, end, n);
+                    }
+                }
+                if (v == OBJ_MISSING) {
+                    chunk.failed = true;
+                    return;
+                }
+
+                ObjCorner corner { 0, 0, 0, 0 };
+                corner.v = local_index(v, chunk.positions.size(), RELATIVE_POSITION, corner.relative);
+                corner.t = local_index(t, chunk.uvs.size(), RELATIVE_UV, corner.relative);
+                corner.n = local_index(n, chunk.normals.size(), RELATIVE_NORMAL, corner.relative);
+                face.push_back(corner);
+                p = skip_space(p, end);
+            }
+
+            // Polygons are triangulated as fans.
+            for (size_t i = 2; i < face.size(); i++) {
+                chunk.corners.push_back(face[0]);
+                chunk.corners.push_back(face[i - 1]);
+                chunk.corners.push_back(face[i]);
+            }
+        }
+
+        p = skip_line(p, end);
+    }
+}
+
+}
+
+
+/**
+ * @brief Import a Wavefront OBJ file. The file is memory mapped and split at line boundaries
+ * into chunks that are parsed in parallel, each into its own arrays. Corners that share
+ * position, texture coordinate and normal become one vertex. Groups and materials are ignored,
+ * missing normals are left zero for generate_missing_normals.
+ *
+ * @param path Path to the file.
+ * @param mesh Receives the mesh.
+ * @param pool Threads to parse on.
+ * @return bool true on success.
+ */
+bool import_obj(const char* path, MeshData& mesh, ThreadPool& pool) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Failed to open OBJ file: " << path << std::endl;
+        return false;
+    }
+
+    const char* text = (const char*)file.data();
+    size_t size = file.size();
+
+    // A few chunks per thread keeps them busy when lines are unevenly long.
+    size_t chunkCount = std::clamp<size_t>(size / (256 * 1024), 1, (size_t)pool.size() * 4);
+    std::vector<ObjChunk> chunks(chunkCount);
+    const char* begin = text;
+    for (size_t i = 0; i < chunkCount; i++) {
+        const char* end = i + 1 == chunkCount ? text + size : skip_line(text + size * (i + 1) / chunkCount, text + size);
+        chunks[i].begin = begin;
+        chunks[i].end = std::max(begin, end);
+        begin = chunks[i].end;
+    }
+
+    pool.parallelFor((int)chunkCount, [&](int i) {
+        parse_chunk(chunks[i]);
+    });
+
+    // Element bases of every chunk, for the relative indices.
+    std::vector<glm::vec3> positions, normals;
+    std::vector<glm::vec2> uvs;
+    std::vector<size_t> cornerBase(chunkCount + 1, 0);
+    for (size_t i = 0; i < chunkCount; i++) {
+        if (chunks[i].failed) {
+            std::cerr << "Failed to parse face in OBJ file: " << path << std::endl;
+            return false;
+        }
+        cornerBase[i + 1] = cornerBase[i] + chunks[i].corners.size();
+    }
+
+    std::vector<ObjCorner> corners(cornerBase[chunkCount]);
+    std::vector<glm::ivec3> bases(chunkCount);
+    for (size_t i = 0; i < chunkCount; i++) {
+        bases[i] = glm::ivec3(positions.size(), uvs.size(), normals.size());
+        positions.insert(positions.end(), chunks[i].positions.begin(), chunks[i].positions.end());
+        uvs.insert(uvs.end(), chunks[i].uvs.begin(), chunks[i].uvs.end());
+        normals.insert(normals.end(), chunks[i].normals.begin(), chunks[i].normals.end());
+    }
+
+    pool.parallelFor((int)chunkCount, [&](int i) {
+        ObjCorner* out = corners.data() + cornerBase[i];
+        for (const ObjCorner& c : chunks[i].corners) {
+            ObjCorner r = c;
+            if (r.relative & RELATIVE_POSITION) r.v += bases[i].x;
+            if (r.relative & RELATIVE_UV) r.t += bases[i].y;
+            if (r.relative & RELATIVE_NORMAL) r.n += bases[i].z;
+            *out++ = r;
+        }
+        chunks[i] = ObjChunk();
+    });
+
+    // Deduplicate corners with an open addressing table of vertex indices.
+    size_t tableSize = 16;
+    while (tableSize < corners.size() * 2) {
+        tableSize *= 2;
+    }
+    std::vector<uint32_t> table(tableSize, UINT32_MAX);
+    std::vector<ObjCorner> keys;
+
+    mesh.vertices.clear();
+    mesh.indices.clear();
+    mesh.indices.reserve(corners.size());
+
+    for (const ObjCorner& c : corners) {
+        if (c.v < 0 || c.v >= (int)positions.size() ||
+            (c.t != OBJ_MISSING && (c.t < 0 || c.t >= (int)uvs.size())) ||
+            (c.n != OBJ_MISSING && (c.n < 0 || c.n >= (int)normals.size()))) {
+            std::cerr << "Failed to import OBJ file, index out of range: " << path << std::endl;
+            return false;
+        }
+
+        uint32_t hash = (uint32_t)c.v * 73856093u ^ (uint32_t)c.t * 19349663u ^ (uint32_t)c.n * 83492791u;
+        size_t slot = hash & (tableSize - 1);
+        while (table[slot] != UINT32_MAX) {
+            const ObjCorner& k = keys[table[slot]];
+            if (k.v == c.v && k.t == c.t && k.n == c.n) {
+                break;
+            }
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        if (table[slot] == UINT32_MAX) {
+            table[slot] = (uint32_t)keys.size();
+            keys.push_back(c);
+
+            // OBJ puts v = 0 at the bottom of the image, textures are loaded top row first.
+            MeshVertex vertex;
+            vertex.position = positions[c.v];
+            vertex.normal = c.n != OBJ_MISSING ? normals[c.n] : glm::vec3(0.0f);
+            vertex.uv = c.t != OBJ_MISSING ? glm::vec2(uvs[c.t].x, 1.0f - uvs[c.t].y) : glm::vec2(0.0f);
+            mesh.vertices.push_back(vertex);
+        }
+        mesh.indices.push_back(table[slot]);
+    }
+
+    return true;
+}
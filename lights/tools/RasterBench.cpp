@@ -0,0 +1,238 @@
+/**
+ * @file RasterBench.cpp
+ * @author Rohan Siddhu
+ * @brief Throughput benchmark of the software rasterizer on the lit cube scene.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include "Camera.hpp"
+#include "SceneData.hpp"
+#include "SoftRasterizer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchObject {
+    glm::mat4 model;
+    int material;
+};
+
+static void usage() {
+    std::cerr << "Usage: rasterbench [--size WxH] [--cubes N] [--frames N] [--threads N] [--output image.ppm]\n"
+              << "  --size WxH     render target size (default 1280x720)\n"
+              << "  --cubes N      number of cubes, 10 to 100000 (default 1000)\n"
+              << "  --frames N     timed frames per thread count (default 20)\n"
+              << "  --threads N    highest thread count, counts double from 1 (default all cores)\n"
+              << "  --output FILE  write the last image as binary PPM" << std::endl;
+}
+
+// 64 bit FNV-1a of the color buffer.
+static uint64_t hash_pixels(const std::vector<uint32_t>& pixels) {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint32_t pixel : pixels) {
+        for (int i = 0; i < 4; i++) {
+            hash = (hash ^ ((pixel >> (8 * i)) & 0xff)) * 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+static bool write_ppm(const char* path, const SoftRasterizer& raster) {
+    FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+    int width = raster.getWidth();
+    int height = raster.getHeight();
+    std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+    std::vector<unsigned char> row(width * 3);
+    for (int y = height - 1; y >= 0; y--) {
+        for (int x = 0; x < width; x++) {
+            uint32_t pixel = raster.pixels()[(size_t)y * width + x];
+            row[x * 3 + 0] = pixel & 0xff;
+            row[x * 3 + 1] = (pixel >> 8) & 0xff;
+            row[x * 3 + 2] = (pixel >> 16) & 0xff;
+        }
+        std::fwrite(row.data(), 1, row.size(), file);
+    }
+    std::fclose(file);
+    return true;
+}
+
+// The cube field of build_cube_instances in Application.cpp.
+static std::vector<BenchObject> build_cubes(int count, int materialCount) {
+    std::vector<BenchObject> cubes;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> spreadX(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> spreadY(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> spreadZ(-120.0f, -20.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+    std::uniform_int_distribution<int> material(0, materialCount - 1);
+
+    for (int i = 0; i < count; i++) {
+        BenchObject cube;
+        if (i < 10) {
+            cube.model = glm::translate(glm::mat4(1.0f), cubePositions[i]);
+            cube.model = glm::rotate(cube.model, glm::radians(20.0f * i), glm::vec3(1.0f, 0.3, 0.5));
+            cube.material = 0;
+        }
+        else {
+            glm::vec3 position(spreadX(rng), spreadY(rng), spreadZ(rng));
+            cube.model = glm::translate(glm::mat4(1.0f), position);
+            cube.model = glm::rotate(cube.model, glm::radians(angle(rng)), glm::vec3(1.0f, 0.3, 0.5));
+            cube.material = material(rng);
+        }
+        cubes.push_back(cube);
+    }
+    return cubes;
+}
+
+int main(int argc, char* argv[]) {
+    int width = 1280;
+    int height = 720;
+    int cubeCount = 1000;
+    int frames = 20;
+    int maxThreads = (int)std::max(std::thread::hardware_concurrency(), 1u);
+    const char* output = nullptr;
+    int arg = 1;
+    while (arg + 1 < argc && std::strncmp(argv[arg], "--", 2) == 0) {
+        std::string option = argv[arg];
+        const char* value = argv[arg + 1];
+        if (option == "--size" && std::sscanf(value, "%dx%d", &width, &height) == 2) {
+        }
+        else if (option == "--cubes" && std::atoi(value) >= 10 && std::atoi(value) <= 100000) {
+            cubeCount = std::atoi(value);
+        }
+        else if (option == "--frames" && std::atoi(value) >= 1) {
+            frames = std::atoi(value);
+        }
+        else if (option == "--threads" && std::atoi(value) >= 1) {
+            maxThreads = std::atoi(value);
+        }
+        else if (option == "--output") {
+            output = value;
+        }
+        else {
+            usage();
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    if (arg != argc) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    // The materials of Application.cpp. The floor uses the texture its virtual texture is built from.
+    SoftTexture container1, container1Specular, container;
+    if (!container1.load("res/textures/container1.png", true) ||
+        !container1Specular.load("res/textures/container1_specular.png") ||
+        !container.load("res/textures/container.jpg", true)) {
+        return EXIT_FAILURE;
+    }
+    SoftMaterial materials[] = {
+        { &container1, &container1Specular, 32.0f },
+        { &container1, &container1Specular, 128.0f },
+        { &container, nullptr, 8.0f }
+    };
+    std::vector<BenchObject> cubes = build_cubes(cubeCount, (int)std::size(materials));
+    const SoftVertex* cube = reinterpret_cast<const SoftVertex*>(cubeData);
+    const SoftVertex* floor = reinterpret_cast<const SoftVertex*>(floorData);
+    size_t cubeVertices = std::size(cubeData) * sizeof(float) / sizeof(SoftVertex);
+    size_t floorVertices = std::size(floorData) * sizeof(float) / sizeof(SoftVertex);
+
+    // The start up view and lights of the application.
+    Camera cam(glm::vec3(-0.7f, 0.7f, 3.9f), glm::vec3(0.0f, 1.0f, 0.0f), -63.5f, -6.5f);
+    glm::vec3 lightPos(1.0f, 0.5f, 2.0f);
+    glsl::Frame frame {};
+    glsl::PointLights pointLights {};
+    frame.view = cam.getViewMatrix();
+    frame.projection = glm::perspective(glm::radians(cam.fov), (float)width / height, 0.1f, 1000.0f);
+    frame.lightPos = lightPos;
+    frame.light.position = lightPos;
+    frame.light.ambient = glm::vec3(0.2f);
+    frame.light.diffuse = glm::vec3(0.5f);
+    frame.light.specular = glm::vec3(1.0f);
+    frame.light.constant = 1.0f;
+    frame.light.linear = 0.09f;
+    frame.light.quadratic = 0.032f;
+    frame.sun.direction = glm::mat3(frame.view) * glm::normalize(glm::vec3(-0.2f, -1.0f, -0.3f));
+    frame.sun.ambient = glm::vec3(0.06f);
+    frame.sun.diffuse = glm::vec3(0.6f);
+    frame.sun.specular = glm::vec3(0.6f);
+
+    auto render = [&](SoftRasterizer& raster) {
+        raster.clear(glm::vec3(0.0f));
+        raster.setFrame(frame, pointLights, true);
+        raster.draw(floor, floorVertices, glm::mat4(1.0f), materials[2]);
+        for (const BenchObject& object : cubes) {
+            raster.draw(cube, cubeVertices, object.model, materials[object.material]);
+        }
+        raster.flush();
+    };
+
+    std::cout << width << "x" << height << ", " << cubeCount << " cubes, " << frames << " frames, "
+              << SOFT_TILE_SIZE << "x" << SOFT_TILE_SIZE << " tiles" << std::endl;
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    uint64_t reference = 0;
+    bool identical = true;
+    for (int threads : threadCounts) {
+        // The calling thread rasterizes too, so a pool of N - 1 workers makes N threads.
+        std::unique_ptr<ThreadPool> pool;
+        if (threads > 1) {
+            pool = std::make_unique<ThreadPool>(threads - 1);
+        }
+        SoftRasterizer raster;
+        if (!raster.init(width, height, pool.get())) {
+            return EXIT_FAILURE;
+        }
+
+        render(raster);
+        auto start = Clock::now();
+        for (int i = 0; i < frames; i++) {
+            render(raster);
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        uint64_t hash = hash_pixels(raster.pixels());
+        if (threads == 1) {
+            reference = hash;
+        }
+        identical = identical && hash == reference;
+
+        double frameTime = seconds / frames;
+        std::printf("%3d threads: %8.2f ms/frame  %7.2f Mtris/s  %8.2f Mpix/s  binned %llu / %llu  hash %016llx\n",
+            threads, frameTime * 1000.0, raster.triangleCount() / frameTime * 1e-6, raster.pixelCount() / frameTime * 1e-6,
+            (unsigned long long)raster.binnedCount(), (unsigned long long)raster.triangleCount(), (unsigned long long)hash);
+
+        if (output && threads == maxThreads && !write_ppm(output, raster)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!identical) {
+        std::cerr << "Failed to reproduce the image, it differs between thread counts" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,509 @@
+/**
+ * @file ShaderReflect.cpp
+ * @author Rohan Siddhu
+ * @brief Offline generator of the C++ structs matching the std140 uniform blocks of the shaders.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "ShaderPreprocessor.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// GLSL type that may appear in a uniform block, with its std140 size and alignment.
+struct BasicType {
+    const char* glsl;
+    const char* cpp;
+    const char* padded;     /** C++ type of an array element, std140 rounds its stride up to 16 bytes. */
+    int size;
+    int align;
+};
+
+static const BasicType BASIC_TYPES[] = {
+    { "float", "float", "glm::vec4", 4, 4 },
+    { "int", "GLint", "glm::ivec4", 4, 4 },
+    { "uint", "GLuint", "glm::uvec4", 4, 4 },
+    { "bool", "GLint", "glm::ivec4", 4, 4 },
+    { "vec2", "glm::vec2", "glm::vec4", 8, 8 },
+    { "vec3", "glm::vec3", "glm::vec4", 12, 16 },
+    { "vec4", "glm::vec4", "glm::vec4", 16, 16 },
+    { "ivec2", "glm::ivec2", "glm::ivec4", 8, 8 },
+    { "ivec3", "glm::ivec3", "glm::ivec4", 12, 16 },
+    { "ivec4", "glm::ivec4", "glm::ivec4", 16, 16 },
+    { "uvec2", "glm::uvec2", "glm::uvec4", 8, 8 },
+    { "uvec3", "glm::uvec3", "glm::uvec4", 12, 16 },
+    { "uvec4", "glm::uvec4", "glm::uvec4", 16, 16 },
+    { "bvec2", "glm::ivec2", "glm::ivec4", 8, 8 },
+    { "bvec3", "glm::ivec3", "glm::ivec4", 12, 16 },
+    { "bvec4", "glm::ivec4", "glm::ivec4", 16, 16 },
+    // Matrices are arrays of columns, each padded to a vec4.
+    { "mat2", "glm::mat2x4", "glm::mat2x4", 32, 16 },
+    { "mat3", "glm::mat3x4", "glm::mat3x4", 48, 16 },
+    { "mat4", "glm::mat4", "glm::mat4", 64, 16 }
+};
+
+struct Member {
+    std::string type;
+    std::string name;
+    int arraySize = 0;      /** 0 if not an array. */
+    int offset = 0;
+};
+
+// A struct or a uniform block, laid out once it is used by a block.
+struct Declaration {
+    std::string name;
+    std::string file;
+    std::vector<Member> members;
+    int binding = -1;       /** Blocks only. */
+    bool std140 = false;
+    bool laidOut = false;
+    int size = 0;
+    int align = 0;
+};
+
+struct Reflection {
+    std::vector<Declaration> structs;
+    std::vector<Declaration> blocks;
+};
+
+static int round_up(int value, int alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static const BasicType* find_basic(const std::string& name) {
+    for (const BasicType& type : BASIC_TYPES) {
+        if (name == type.glsl) {
+            return &type;
+        }
+    }
+    return nullptr;
+}
+
+static Declaration* find_declaration(std::vector<Declaration>& list, const std::string& name) {
+    for (Declaration& declaration : list) {
+        if (declaration.name == name) {
+            return &declaration;
+        }
+    }
+    return nullptr;
+}
+
+/*
+* Parsing
+*/
+
+// Tokens of a preprocessed source, with the file each one comes from. Comments are dropped, and
+// so are preprocessor lines: blocks are reflected whatever the permutation keys, their layout
+// must not depend on them.
+static void tokenize(const ShaderSource& source, std::vector<std::string>& tokens, std::vector<int>& tokenFiles) {
+    const std::string& text = source.text;
+    int file = 0;
+    size_t i = 0;
+    bool lineStart = true;
+    while (i < text.size()) {
+        char c = text[i];
+        if (c == '\n') {
+            lineStart = true;
+            i++;
+        }
+        else if (std::isspace((unsigned char)c)) {
+            i++;
+        }
+        else if (lineStart && c == '#') {
+            size_t end = text.find('\n', i);
+            std::istringstream line(text.substr(i + 1, end == std::string::npos ? std::string::npos : end - i - 1));
+            std::string directive;
+            int number = 0, index = -1;
+            if (line >> directive >> number >> index && directive == "line") {
+                file = index;
+            }
+            i = end == std::string::npos ? text.size() : end;
+        }
+        else if (text.compare(i, 2, "//") == 0) {
+            i = text.find('\n', i);
+            i = i == std::string::npos ? text.size() : i;
+        }
+        else if (text.compare(i, 2, "/*") == 0) {
+            i = text.find("*/", i + 2);
+            i = i == std::string::npos ? text.size() : i + 2;
+        }
+        else {
+            size_t start = i;
+            if (std::isalnum((unsigned char)c) || c == '_') {
+                while (i < text.size() && (std::isalnum((unsigned char)text[i]) || text[i] == '_' || text[i] == '.')) {
+                    i++;
+                }
+            }
+            else {
+                i++;
+            }
+            tokens.push_back(text.substr(start, i - start));
+            tokenFiles.push_back(file);
+            lineStart = false;
+        }
+    }
+}
+
+// Members between the braces of a struct or block, from the token after '{' up to '}'.
+static bool parse_members(const std::vector<std::string>& tokens, size_t& i, std::vector<Member>& members) {
+    static const char* QUALIFIERS[] = { "highp", "mediump", "lowp", "precise", "invariant", "flat" };
+    while (i < tokens.size() && tokens[i] != "}") {
+        while (i < tokens.size() && std::find(std::begin(QUALIFIERS), std::end(QUALIFIERS), tokens[i]) != std::end(QUALIFIERS)) {
+            i++;
+        }
+        if (i + 1 >= tokens.size()) {
+            return false;
+        }
+        std::string type = tokens[i++];
+        while (i < tokens.size()) {
+            Member member;
+            member.type = type;
+            member.name = tokens[i++];
+            if (i + 2 < tokens.size() && tokens[i] == "[") {
+                member.arraySize = std::atoi(tokens[i + 1].c_str());
+                if (member.arraySize <= 0 || tokens[i + 2] != "]") {
+                    std::cerr << "Failed to reflect " << member.name << ", array sizes must be literals" << std::endl;
+                    return false;
+                }
+                i += 3;
+            }
+            members.push_back(member);
+            if (i < tokens.size() && tokens[i] == ",") {
+                i++;
+                continue;
+            }
+            break;
+        }
+        if (i >= tokens.size() || tokens[i] != ";") {
+            return false;
+        }
+        i++;
+    }
+    i++;
+    return i <= tokens.size();
+}
+
+static bool same_members(const Declaration& a, const Declaration& b) {
+    if (a.members.size() != b.members.size() || a.binding != b.binding) {
+        return false;
+    }
+    for (size_t m = 0; m < a.members.size(); m++) {
+        if (a.members[m].type != b.members[m].type || a.members[m].name != b.members[m].name ||
+            a.members[m].arraySize != b.members[m].arraySize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Keep the first declaration of a name, shaders sharing it must agree on its members.
+static bool add_declaration(std::vector<Declaration>& list, const Declaration& declaration) {
+    Declaration* existing = find_declaration(list, declaration.name);
+    if (!existing) {
+        list.push_back(declaration);
+        return true;
+    }
+    if (!same_members(*existing, declaration)) {
+        std::cerr << "Failed to reflect " << declaration.name << ", declared differently in " << existing->file
+                  << " and " << declaration.file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool parse_shader(const char* path, Reflection& reflection) {
+    ShaderSource source;
+    if (!preprocess_shader(path, {}, source)) {
+        return false;
+    }
+    std::vector<std::string> tokens;
+    std::vector<int> tokenFiles;
+    tokenize(source, tokens, tokenFiles);
+
+    size_t i = 0;
+    while (i < tokens.size()) {
+        if (tokens[i] == "{") {
+            // Function body
+            int depth = 0;
+            do {
+                depth += tokens[i] == "{" ? 1 : tokens[i] == "}" ? -1 : 0;
+                i++;
+            } while (i < tokens.size() && depth > 0);
+        }
+        else if (tokens[i] == "struct" && i + 2 < tokens.size() && tokens[i + 2] == "{") {
+            Declaration declaration;
+            declaration.name = tokens[i + 1];
+            declaration.file = source.files[tokenFiles[i]];
+            i += 3;
+            if (!parse_members(tokens, i, declaration.members)) {
+                std::cerr << "Failed to parse struct " << declaration.name << " in " << declaration.file << std::endl;
+                return false;
+            }
+            if (!add_declaration(reflection.structs, declaration)) {
+                return false;
+            }
+        }
+        else if (tokens[i] == "layout" && i + 1 < tokens.size() && tokens[i + 1] == "(") {
+            Declaration declaration;
+            declaration.file = source.files[tokenFiles[i]];
+            for (i += 2; i < tokens.size() && tokens[i] != ")"; i++) {
+                if (tokens[i] == "std140") {
+                    declaration.std140 = true;
+                }
+                else if (tokens[i] == "binding" && i + 2 < tokens.size() && tokens[i + 1] == "=") {
+                    declaration.binding = std::atoi(tokens[i + 2].c_str());
+                }
+            }
+            i++;
+            if (i + 2 < tokens.size() && tokens[i] == "uniform" && tokens[i + 2] == "{") {
+                declaration.name = tokens[i + 1];
+                i += 3;
+                if (!parse_members(tokens, i, declaration.members)) {
+                    std::cerr << "Failed to parse uniform block " << declaration.name << " in " << declaration.file << std::endl;
+                    return false;
+                }
+                if (!declaration.std140 || declaration.binding < 0) {
+                    std::cerr << "Failed to reflect uniform block " << declaration.name << " in " << declaration.file
+                              << ", it needs std140 and a binding" << std::endl;
+                    return false;
+                }
+                if (i < tokens.size() && tokens[i] != ";") {
+                    std::cerr << "Failed to reflect uniform block " << declaration.name << " in " << declaration.file
+                              << ", instance names are not supported" << std::endl;
+                    return false;
+                }
+                if (!add_declaration(reflection.blocks, declaration)) {
+                    return false;
+                }
+            }
+        }
+        else {
+            i++;
+        }
+    }
+    return true;
+}
+
+/*
+* std140 layout
+*/
+
+static bool lay_out(Declaration& declaration, Reflection& reflection, bool block);
+
+// Size and alignment of a member, arrays included.
+static bool member_layout(const Member& member, Reflection& reflection, int& size, int& align) {
+    if (const BasicType* basic = find_basic(member.type)) {
+        size = basic->size;
+        align = basic->align;
+    }
+    else if (Declaration* type = find_declaration(reflection.structs, member.type)) {
+        if (!lay_out(*type, reflection, false)) {
+            return false;
+        }
+        size = type->size;
+        align = type->align;
+    }
+    else {
+        std::cerr << "Failed to reflect " << member.name << ", type " << member.type << " cannot be in a uniform block" << std::endl;
+        return false;
+    }
+    if (member.arraySize > 0) {
+        align = round_up(align, 16);
+        size = round_up(size, 16) * member.arraySize;
+    }
+    return true;
+}
+
+static bool lay_out(Declaration& declaration, Reflection& reflection, bool block) {
+    if (declaration.laidOut) {
+        return true;
+    }
+    int offset = 0;
+    int maxAlign = 16;
+    for (Member& member : declaration.members) {
+        int size, align;
+        if (!member_layout(member, reflection, size, align)) {
+            return false;
+        }
+        member.offset = round_up(offset, align);
+        offset = member.offset + size;
+        maxAlign = std::max(maxAlign, align);
+    }
+    // Structs align to a vec4 and are padded to it. The block size is rounded the same way, as
+    // drivers report it in GL_BUFFER_DATA_SIZE.
+    declaration.align = block ? 16 : round_up(maxAlign, 16);
+    declaration.size = round_up(offset, declaration.align);
+    declaration.laidOut = true;
+    return true;
+}
+
+/*
+* Code generation
+*/
+
+// C++ type of a member, std140 pads elements of scalar and vector arrays to a vec4.
+static std::string cpp_type(const Member& member) {
+    if (const BasicType* basic = find_basic(member.type)) {
+        return member.arraySize > 0 ? basic->padded : basic->cpp;
+    }
+    return member.type;
+}
+
+static void write_struct(std::ostream& out, const Declaration& declaration, Reflection& reflection, bool block) {
+    out << "// " << (block ? "uniform block " : "struct ") << declaration.name << ", " << declaration.file << "\n";
+    out << "struct " << declaration.name << " {\n";
+    if (block) {
+        out << "    static constexpr GLuint binding = " << declaration.binding << ";\n\n";
+    }
+    int offset = 0;
+    int padding = 0;
+    for (const Member& member : declaration.members) {
+        if (member.offset > offset) {
+            out << "    GLuint padding" << padding++ << "[" << (member.offset - offset) / 4 << "];\n";
+        }
+        out << "    " << cpp_type(member) << " " << member.name;
+        if (member.arraySize > 0) {
+            out << "[" << member.arraySize << "]";
+        }
+        out << ";\n";
+        int size, align;
+        member_layout(member, reflection, size, align);
+        offset = member.offset + size;
+    }
+    if (declaration.size > offset) {
+        out << "    GLuint padding" << padding++ << "[" << (declaration.size - offset) / 4 << "];\n";
+    }
+    out << "};\n";
+    out << "static_assert(sizeof(" << declaration.name << ") == " << declaration.size << ", \"" << declaration.name
+        << " must match the std140 layout\");\n";
+    for (const Member& member : declaration.members) {
+        out << "static_assert(offsetof(" << declaration.name << ", " << member.name << ") == " << member.offset << ");\n";
+    }
+    out << "\n";
+}
+
+// Leaf members under their GL resource names. Arrays are checked on their first element.
+static void flatten(const std::vector<Member>& members, const std::string& prefix, int base, Reflection& reflection,
+                    std::vector<std::pair<std::string, int>>& leaves) {
+    for (const Member& member : members) {
+        std::string name = prefix + member.name + (member.arraySize > 0 ? "[0]" : "");
+        if (Declaration* type = find_declaration(reflection.structs, member.type)) {
+            flatten(type->members, name + ".", base + member.offset, reflection, leaves);
+        }
+        else {
+            leaves.push_back({ name, base + member.offset });
+        }
+    }
+}
+
+// Structs used by the blocks, dependencies first.
+static void collect_structs(const Declaration& declaration, Reflection& reflection, std::vector<std::string>& order) {
+    for (const Member& member : declaration.members) {
+        Declaration* type = find_declaration(reflection.structs, member.type);
+        if (type && std::find(order.begin(), order.end(), type->name) == order.end()) {
+            collect_structs(*type, reflection, order);
+            order.push_back(type->name);
+        }
+    }
+}
+
+static bool write_header(const char* path, Reflection& reflection, const std::vector<std::string>& sources) {
+    std::ostringstream out;
+    out << "// Generated by shaderreflect from";
+    for (const std::string& source : sources) {
+        out << " " << source;
+    }
+    out << ", do not edit.\n"
+        << "// std140 layouts of the uniform blocks, upload them with a single glBufferSubData.\n\n"
+        << "#pragma once\n\n"
+        << "#include \"ShaderReflection.hpp\"\n"
+        << "#include <cstddef>\n"
+        << "#include <glad/glad.h>\n"
+        << "#include <glm/glm.hpp>\n\n"
+        << "namespace glsl {\n\n";
+
+    std::vector<std::string> order;
+    for (const Declaration& block : reflection.blocks) {
+        collect_structs(block, reflection, order);
+    }
+    for (const std::string& name : order) {
+        write_struct(out, *find_declaration(reflection.structs, name), reflection, false);
+    }
+    for (const Declaration& block : reflection.blocks) {
+        write_struct(out, block, reflection, true);
+    }
+
+    for (const Declaration& block : reflection.blocks) {
+        std::vector<std::pair<std::string, int>> leaves;
+        flatten(block.members, "", 0, reflection, leaves);
+        out << "inline const ShaderBlockMember " << block.name << "Members[] = {\n";
+        for (size_t i = 0; i < leaves.size(); i++) {
+            out << "    { \"" << leaves[i].first << "\", " << leaves[i].second << " }" << (i + 1 < leaves.size() ? "," : "") << "\n";
+        }
+        out << "};\n\n";
+    }
+    out << "inline const ShaderBlockLayout BLOCKS[] = {\n";
+    for (size_t i = 0; i < reflection.blocks.size(); i++) {
+        const Declaration& block = reflection.blocks[i];
+        out << "    { \"" << block.name << "\", " << block.binding << ", " << block.size << ", " << block.name << "Members, "
+            << "sizeof(" << block.name << "Members) / sizeof(ShaderBlockMember) }" << (i + 1 < reflection.blocks.size() ? "," : "") << "\n";
+    }
+    out << "};\n\n"
+        << "}\n";
+
+    std::ofstream file(path);
+    file << out.str();
+    if (!file) {
+        std::cerr << "Failed to write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static void usage() {
+    std::cerr << "Usage: shaderreflect <output.hpp> <shader.glsl>...\n"
+              << "       shaderreflect --preprocess <output.glsl> <shader.glsl> [KEY[=VALUE]]...\n"
+              << "  Writes the std140 uniform blocks of the shaders as C++ structs, or a shader with its\n"
+              << "  includes and permutation keys resolved, as the runtime compiles it." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 4 && std::strcmp(argv[1], "--preprocess") == 0) {
+        ShaderSource source;
+        if (!preprocess_shader(argv[3], std::vector<std::string>(argv + 4, argv + argc), source)) {
+            return EXIT_FAILURE;
+        }
+        std::ofstream file(argv[2]);
+        file << source.text;
+        return file ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (argc < 3 || argv[1][0] == '-') {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    Reflection reflection;
+    std::vector<std::string> sources(argv + 2, argv + argc);
+    for (const std::string& source : sources) {
+        if (!parse_shader(source.c_str(), reflection)) {
+            return EXIT_FAILURE;
+        }
+    }
+    for (Declaration& block : reflection.blocks) {
+        if (!lay_out(block, reflection, true)) {
+            return EXIT_FAILURE;
+        }
+    }
+    if (!write_header(argv[1], reflection, sources)) {
+        return EXIT_FAILURE;
+    }
+    std::cout << argv[1] << ": " << reflection.blocks.size() << " uniform blocks" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file Simplifier.cpp
+ * @author Rohan Siddhu
+ * @brief Simplifier class definition.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#include "Simplifier.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+
+void Simplifier::Quadric::add(const Quadric& q) {
+    a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+    a11 += q.a11; a12 += q.a12; a13 += q.a13;
+    a22 += q.a22; a23 += q.a23;
+    a33 += q.a33;
+}
+
+// Sum of squared distances of p to the planes accumulated in the quadric.
+double Simplifier::Quadric::evaluate(const glm::dvec3& p) const {
+    double x = p.x, y = p.y, z = p.z;
+    double e = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x
+             + a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y
+             + a22 * z * z + 2.0 * a23 * z
+             + a33;
+    return std::max(e, 0.0);
+}
+
+/**
+ * @brief Prepare a mesh for simplification. Vertices are collapsed onto one of their neighbours
+ * and never moved, so every level of detail indexes the original vertex stream. Vertices on a
+ * texture seam (several vertices at one position) or on an open border are locked, which keeps
+ * the mesh free of cracks and its silhouette from shrinking.
+ *
+ * @param mesh Mesh to simplify, must outlive the simplifier.
+ */
+Simplifier::Simplifier(const MeshData& mesh) :
+    mesh(mesh),
+    indices(mesh.indices)
+{
+    size_t vertexCount = mesh.vertices.size();
+
+    struct PositionHash {
+        size_t operator()(const glm::vec3& p) const {
+            uint32_t bits[3];
+            std::memcpy(bits, &p, sizeof(bits));
+            return bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u;
+        }
+    };
+    std::unordered_map<glm::vec3, uint32_t, PositionHash> first;
+    first.reserve(vertexCount);
+
+    canonical.resize(vertexCount);
+    std::vector<uint32_t> wedges(vertexCount, 0);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        canonical[v] = first.emplace(mesh.vertices[v].position, v).first->second;
+        wedges[canonical[v]]++;
+    }
+
+    // Border edges belong to a single triangle.
+    std::vector<uint64_t> edges;
+    edges.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        for (int e = 0; e < 3; e++) {
+            uint32_t a = canonical[indices[i + e]];
+            uint32_t b = canonical[indices[i + (e + 1) % 3]];
+            if (a != b) {
+                edges.push_back((uint64_t)std::min(a, b) << 32 | std::max(a, b));
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<bool> lockedCanonical(vertexCount, false);
+    for (size_t i = 0; i < edges.size();) {
+        size_t j = i;
+        while (j < edges.size() && edges[j] == edges[i]) {
+            j++;
+        }
+        if (j - i == 1) {
+            lockedCanonical[edges[i] >> 32] = true;
+            lockedCanonical[edges[i] & 0xFFFFFFFF] = true;
+        }
+        i = j;
+    }
+
+    locked.resize(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        locked[v] = wedges[canonical[v]] > 1 || lockedCanonical[canonical[v]];
+    }
+
+    // Unweighted plane quadrics, so the error is a distance in model units.
+    quadrics.assign(vertexCount, Quadric {});
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        glm::dvec3 p0 = mesh.vertices[indices[i]].position;
+        glm::dvec3 p1 = mesh.vertices[indices[i + 1]].position;
+        glm::dvec3 p2 = mesh.vertices[indices[i + 2]].position;
+        glm::dvec3 n = glm::cross(p1 - p0, p2 - p0);
+        double length = glm::length(n);
+        if (length <= 0.0) {
+            continue;
+        }
+        n /= length;
+        double d = -glm::dot(n, p0);
+
+        Quadric q { n.x * n.x, n.x * n.y, n.x * n.z, n.x * d,
+                    n.y * n.y, n.y * n.z, n.y * d,
+                    n.z * n.z, n.z * d,
+                    d * d };
+        for (int k = 0; k < 3; k++) {
+            quadrics[canonical[indices[i + k]]].add(q);
+        }
+    }
+}
+
+/**
+ * @brief Collapse edges in order of increasing error until the triangle list has at most
+ * targetIndexCount indices, or nothing can be collapsed. Calls continue where the previous one
+ * stopped, so a chain of levels is built by asking for fewer and fewer indices.
+ *
+ * @param targetIndexCount Index count to reach.
+ * @return const std::vector<uint32_t>& The simplified triangle list.
+ */
+const std::vector<uint32_t>& Simplifier::simplify(size_t targetIndexCount) {
+    while (indices.size() > targetIndexCount && collapsePass(targetIndexCount)) {
+    }
+    return indices;
+}
+
+/**
+ * @brief Geometric error of the current level, an estimate of the largest distance between the
+ * simplified and the original surface, in model units.
+ */
+float Simplifier::error() const {
+    return (float)std::sqrt(maxCost);
+}
+
+
+/*
+* Private Methods
+*/
+
+// One round of independent collapses: every vertex takes part in at most one collapse, so the
+// flip test of each collapse sees the final neighbourhood.
+bool Simplifier::collapsePass(size_t targetIndexCount) {
+    size_t vertexCount = mesh.vertices.size();
+    size_t triangleCount = indices.size() / 3;
+
+    // Triangles around every vertex.
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t index : indices) {
+        offsets[index + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++) {
+        adjacency[fill[indices[i]]++] = (uint32_t)(i / 3);
+    }
+
+    std::vector<Collapse> candidates;
+    candidates.reserve(indices.size() * 2);
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        for (int e = 0; e < 3; e++) {
+            uint32_t a = indices[i + e];
+            uint32_t b = indices[i + (e + 1) % 3];
+            for (int direction = 0; direction < 2; direction++) {
+                uint32_t from = direction ? b : a;
+                uint32_t to = direction ? a : b;
+                if (locked[from] || canonical[from] == canonical[to]) {
+                    continue;
+                }
+                Quadric q = quadrics[canonical[from]];
+                q.add(quadrics[canonical[to]]);
+                candidates.push_back({ from, to, q.evaluate(mesh.vertices[to].position) });
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b) {
+        return a.cost < b.cost;
+    });
+
+    std::vector<uint32_t> remap(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        remap[v] = v;
+    }
+    std::vector<bool> touched(vertexCount, false);
+    size_t remaining = triangleCount;
+    size_t targetTriangles = targetIndexCount / 3;
+    bool collapsed = false;
+
+    for (const Collapse& c : candidates) {
+        if (remaining <= targetTriangles) {
+            break;
+        }
+        if (touched[c.from] || touched[c.to] || flips(c.from, c.to, adjacency, offsets)) {
+            continue;
+        }
+
+        remap[c.from] = c.to;
+        quadrics[canonical[c.to]].add(quadrics[canonical[c.from]]);
+        maxCost = std::max(maxCost, c.cost);
+        collapsed = true;
+
+        for (uint32_t k = offsets[c.from]; k < offsets[c.from + 1]; k++) {
+            const uint32_t* tri = &indices[(size_t)adjacency[k] * 3];
+            if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                remaining--;
+            }
+            touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = true;
+        }
+    }
+
+    if (!collapsed) {
+        return false;
+    }
+
+    size_t out = 0;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        uint32_t a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+        if (a != b && b != c && a != c) {
+            indices[out++] = a;
+            indices[out++] = b;
+            indices[out++] = c;
+        }
+    }
+    indices.resize(out);
+    return true;
+}
+
+// Whether moving `from` onto `to` turns any of the remaining triangles around `from` over.
+bool Simplifier::flips(uint32_t from, uint32_t to, const std::vector<uint32_t>& adjacency,
+    const std::vector<uint32_t>& offsets) const {
+    for (uint32_t k = offsets[from]; k < offsets[from + 1]; k++) {
+        const uint32_t* tri = &indices[(size_t)adjacency[k] * 3];
+        if (tri[0] == to || tri[1] == to || tri[2] == to) {
+            continue;
+        }
+
+        glm::vec3 p[3], q[3];
+        for (int i = 0; i < 3; i++) {
+            p[i] = mesh.vertices[tri[i]].position;
+            q[i] = tri[i] == from ? mesh.vertices[to].position : p[i];
+        }
+        glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+        glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+        if (glm::dot(before, after) <= 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
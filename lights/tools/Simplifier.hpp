@@ -0,0 +1,48 @@
+/**
+ * @file Simplifier.hpp
+ * @author Rohan Siddhu
+ * @brief Quadric error metric mesh simplification for LOD chains.
+ * @version 0.1
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include "MeshFile.hpp"
+#include <cstdint>
+#include <vector>
+
+class Simplifier {
+private:
+    // Symmetric 4x4 matrix of the plane equations around a vertex, upper triangle only.
+    struct Quadric {
+        double a00, a01, a02, a03;
+        double a11, a12, a13;
+        double a22, a23;
+        double a33;
+
+        void add(const Quadric& q);
+        double evaluate(const glm::dvec3& p) const;
+    };
+
+    struct Collapse {
+        uint32_t from, to;
+        double cost;
+    };
+
+    const MeshData& mesh;
+    std::vector<uint32_t> indices;      /** Current triangle list. */
+    std::vector<uint32_t> canonical;    /** First vertex with the same position. */
+    std::vector<Quadric> quadrics;      /** Per canonical vertex. */
+    std::vector<bool> locked;           /** Seam and border vertices never move. */
+    double maxCost = 0.0;
+public:
+    Simplifier(const MeshData& mesh);
+
+    const std::vector<uint32_t>& simplify(size_t targetIndexCount);
+    float error() const;
+private:
+    bool collapsePass(size_t targetIndexCount);
+    bool flips(uint32_t from, uint32_t to, const std::vector<uint32_t>& adjacency,
+        const std::vector<uint32_t>& offsets) const;
+};